@@ -1,97 +1,786 @@
 // Application Includes
 #include <AES.h>
+#include <AESNI.h>
+#include <Trace.h>
+#include <Metrics.h>
+#include <Progress.h>
+#include <Provider.h>
 
 // OpenSSL Includes
+#include <openssl/crypto.h>
 #include <openssl/evp.h>
 
+// StdLib Includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <vector>
+
 using namespace SecureMigration;
 
-int AES::Encrypt( const unsigned char* plaintext, int pLen, const unsigned char* key, 
+static std::atomic< AES::Suite >   selected( AES::Suite::AES256 );   ///< Suite of Encrypt, Decrypt, and CTR
+static std::atomic< AES::Backend > used( AES::Backend::EVP );        ///< Implementation of AES-256 ECB, CBC, and CTR
+
+static Metrics::Counter& encrypted = Metrics::GetCounter( "securemigration_cipher_bytes_total{operation=\"encrypt\"}", "Bytes processed by the bulk cipher" );
+static Metrics::Counter& decrypted = Metrics::GetCounter( "securemigration_cipher_bytes_total{operation=\"decrypt\"}", "Bytes processed by the bulk cipher" );
+static Metrics::Counter& streamed  = Metrics::GetCounter( "securemigration_cipher_bytes_total{operation=\"stream\"}", "Bytes processed by the bulk cipher" );
+static Metrics::Counter& failures  = Metrics::GetCounter( "securemigration_failures_total{component=\"cipher\"}", "Failed operations by component" );
+
+static_assert( static_cast< int >( Provider::Cipher::AES192ECB ) == 3 && static_cast< int >( Provider::Cipher::AES256CTR ) == 8,
+               "AES ciphers are grouped by key size in the order of AES::Mode" );
+
+template< AES::Mode M, int KeyBits >
+static constexpr Provider::Cipher algorithm( void );
+template< AES::Mode M, int KeyBits, bool Encrypting >
+static constexpr const char* operation( void );
+template< AES::Mode M, int KeyBits >
+static bool   bypass( void );
+template< AES::Mode M, int KeyBits, bool Encrypting >
+static int    process( EVP_CIPHER_CTX* context, const unsigned char* input, int length,
+                       const typename AES::Cipher< M, KeyBits >::Key& key, const typename AES::Cipher< M, KeyBits >::IV& iv,
+                       unsigned char* output );
+template< AES::Mode M, bool Encrypting >
+static int    native( const unsigned char* input, int length, const unsigned char* key, const unsigned char* iv,
+                      unsigned char* output );
+template< AES::Mode M, bool Encrypting >
+static void   kernel( const AESNI::Schedule& schedule, unsigned char* chain, const unsigned char* input, unsigned char* output,
+                      int blocks );
+template< AES::Mode M, bool Encrypting >
+static int    wrap( EVP_CIPHER_CTX* context, const unsigned char* input, int length, const unsigned char* key,
+                    const unsigned char* iv, unsigned char* output );
+template< bool Encrypting >
+static int    dispatch( EVP_CIPHER_CTX* context, const unsigned char* input, int length, const unsigned char* key,
+                        const unsigned char* iv, unsigned char* output );
+static int    interleave( AES::Job* jobs, int count );
+static double rate( const EVP_CIPHER* cipher, const std::vector< unsigned char >& input, std::vector< unsigned char >& output );
+static int    update( EVP_CIPHER_CTX* context, unsigned char* output, int* outputLen, const unsigned char* input, int length );
+static int    record( int status, int length, Metrics::Counter& bytes );
+
+/**
+ * Encrypts with the selected suite: AES-256-CBC, AES-256-ECB without an IV, or ChaCha20-Poly1305 whose
+ * nonce, the first twelve bytes of the IV, must be given and must never repeat under the key.
+ *
+ * @return Length of the ciphertext, or a negative value on error.
+ */
+int AES::Encrypt( const unsigned char* plaintext, int pLen, const unsigned char* key,
                   const unsigned char* iv, unsigned char* ciphertext )
 {
-   int                  status = 0;
-   EVP_CIPHER_CTX*      context = NULL;
-   const EVP_CIPHER*    cipher   = ( iv == NULL ) ? EVP_aes_256_ecb( ) : EVP_aes_256_cbc( );
-   const unsigned char* bufferIV = ( iv == NULL ) ? NULL : iv;
-   
-   int encryptedLen;
-   int ciphertextLen;
+   return( dispatch< true >( NULL, plaintext, pLen, key, iv, ciphertext ) );
+}
+
+/**
+ * Decrypts with the selected suite, the inverse of Encrypt.
+ *
+ * @return Length of the plaintext, or a negative value on error or when the tag does not match.
+ */
+int AES::Decrypt( const unsigned char* ciphertext, int cLen, const unsigned char* key,
+                  const unsigned char* iv, unsigned char* plaintext )
+{
+   return( dispatch< false >( NULL, ciphertext, cLen, key, iv, plaintext ) );
+}
+
+/**
+ * Encrypts or decrypts with AES-256-CTR starting at the given 128-bit counter block, or with the ChaCha20
+ * key stream when ChaCha20-Poly1305 is the selected suite. The mode is length preserving and seekable,
+ * any block can be processed independently of the others.
+ */
+int AES::CTR( const unsigned char* input, int length, const unsigned char* key,
+              const unsigned char* counter, unsigned char* output )
+{
+   return( ( selected.load( ) == Suite::ChaCha20Poly1305 ) ? wrap< Mode::ChaCha20, true >( NULL, input, length, key, counter, output ) :
+                                                             wrap< Mode::CTR, true >( NULL, input, length, key, counter, output ) );
+}
+
+/**
+ * Encrypts every job of a batch like a call of Encrypt. With AES-NI and the AES-256 suite the jobs are
+ * encrypted by the multi-buffer kernel, up to AESNI::Lanes jobs at a time with their blocks interleaved,
+ * so the serial CBC chain of a small object no longer leaves the AES pipeline idle. Otherwise the jobs
+ * share one cipher context instead of setting up a context per job.
+ *
+ * @return 0 when every job succeeded, otherwise a negative value. The status of every job is set.
+ */
+int AES::EncryptBatch( Job* jobs, int count )
+{
+   int             status  = 0;
+   EVP_CIPHER_CTX* context = NULL;
+   Trace::Span     span( "AES-256 Encrypt Batch", nullptr, count );
 
    /// @par Process Design Language
-   /// -# Create and initialise the context 
-   if( ( context = EVP_CIPHER_CTX_new( ) ) == NULL )
+   /// -# Interleave the jobs when the CPU has the AES instructions
+   if( ( selected.load( ) == Suite::AES256 ) && AESNI::Available( ) )
    {
-      status = -1;
+      return( interleave( jobs, count ) );
    }
-   /// -# Initialise the encryption operation
-   else if( EVP_EncryptInit_ex( context, cipher, NULL, key, bufferIV ) != 1 )
+
+   /// -# Otherwise encrypt the jobs one after the other with a shared context
+   context = EVP_CIPHER_CTX_new( );
+   for( int job = 0; job < count; job++ )
    {
-      status = -2;
-      EVP_CIPHER_CTX_free( context );
+      jobs[ job ].status = dispatch< true >( context, jobs[ job ].input, jobs[ job ].length, jobs[ job ].key, jobs[ job ].iv,
+                                             jobs[ job ].output );
+      status = ( jobs[ job ].status < 0 ) ? -1 : status;
    }
-   /// -# Encrypt the message
-   else if( EVP_EncryptUpdate( context, ciphertext, &encryptedLen, plaintext, pLen ) != 1 )
+   EVP_CIPHER_CTX_free( context );
+
+   return( status );
+}
+
+/**
+ * Decrypts every job of a batch like a call of Decrypt, sharing one cipher context. CBC decryption of a
+ * single stream is parallel already, so the jobs are not interleaved.
+ *
+ * @return 0 when every job succeeded, otherwise a negative value. The status of every job is set.
+ */
+int AES::DecryptBatch( Job* jobs, int count )
+{
+   int             status  = 0;
+   EVP_CIPHER_CTX* context = EVP_CIPHER_CTX_new( );
+   Trace::Span     span( "AES-256 Decrypt Batch", nullptr, count );
+
+   for( int job = 0; job < count; job++ )
    {
-      status = -3;
-      EVP_CIPHER_CTX_free( context );
+      jobs[ job ].status = dispatch< false >( context, jobs[ job ].input, jobs[ job ].length, jobs[ job ].key, jobs[ job ].iv,
+                                              jobs[ job ].output );
+      status = ( jobs[ job ].status < 0 ) ? -1 : status;
    }
-   /// -# Finalize the encryption
-   else if( EVP_EncryptFinal_ex( context, ciphertext + encryptedLen, &ciphertextLen ) != 1 )
+   EVP_CIPHER_CTX_free( context );
+
+   return( status );
+}
+
+template< AES::Mode M, int KeyBits >
+int AES::Cipher< M, KeyBits >::Encrypt( const unsigned char* input, int length, const Key& key, const IV& iv, unsigned char* output )
+{
+   EVP_CIPHER_CTX* context = bypass< M, KeyBits >( ) ? NULL : EVP_CIPHER_CTX_new( );
+   int             status  = process< M, KeyBits, true >( context, input, length, key, iv, output );
+
+   EVP_CIPHER_CTX_free( context );
+
+   return( status );
+}
+
+template< AES::Mode M, int KeyBits >
+int AES::Cipher< M, KeyBits >::Decrypt( const unsigned char* input, int length, const Key& key, const IV& iv, unsigned char* output )
+{
+   EVP_CIPHER_CTX* context = bypass< M, KeyBits >( ) ? NULL : EVP_CIPHER_CTX_new( );
+   int             status  = process< M, KeyBits, false >( context, input, length, key, iv, output );
+
+   EVP_CIPHER_CTX_free( context );
+
+   return( status );
+}
+
+/**
+ * Probes the capabilities of the CPU and measures the throughput of both suites on this host, so a masked
+ * or missing AES unit (as on some virtual machines) shows up in the measurement even when CPUID reports it.
+ *
+ * @return AES-256 when the AES instructions are available, otherwise the faster suite.
+ */
+AES::Suite AES::Probe( Capabilities& capabilities, int size )
+{
+   std::vector< unsigned char > input( static_cast< size_t >( size ) );
+   std::vector< unsigned char > output( static_cast< size_t >( size ) + 32 );
+
+   for( size_t i = 0; i < input.size( ); i++ )
    {
-      status = -4;
-      EVP_CIPHER_CTX_free( context );
+      input[ i ] = static_cast< unsigned char >( i * 31 + ( i >> 11 ) );
+   }
+
+   capabilities.aesni      = AESNI::Available( );
+   capabilities.aesRate    = rate( Provider::Get( Provider::Cipher::AES256CBC ), input, output );
+   capabilities.chachaRate = rate( Provider::Get( Provider::Cipher::ChaCha20Poly1305 ), input, output );
+
+   return( ( !capabilities.aesni && ( capabilities.chachaRate > capabilities.aesRate ) ) ? Suite::ChaCha20Poly1305 : Suite::AES256 );
+}
+
+void AES::Select( Suite suite )
+{
+   selected.store( suite );
+}
+
+AES::Suite AES::Selected( void )
+{
+   return( selected.load( ) );
+}
+
+const char* AES::Name( Suite suite )
+{
+   return( ( suite == Suite::ChaCha20Poly1305 ) ? "ChaCha20-Poly1305" : "AES-256" );
+}
+
+/**
+ * Selects the implementation of AES-256 ECB, CBC, and CTR. The native backend needs the AES instructions,
+ * without them EVP stays in use.
+ */
+void AES::Use( Backend backend )
+{
+   used.store( ( ( backend == Backend::Native ) && !AESNI::Available( ) ) ? Backend::EVP : backend );
+}
+
+AES::Backend AES::Used( void )
+{
+   return( used.load( ) );
+}
+
+const char* AES::Name( Backend backend )
+{
+   return( ( backend == Backend::Native ) ? "Native" : "EVP" );
+}
+
+/**
+ * Measures the encryption throughput of a cipher in MB/s, the best of three passes over the input.
+ */
+static double rate( const EVP_CIPHER* cipher, const std::vector< unsigned char >& input, std::vector< unsigned char >& output )
+{
+   const unsigned char key[ 32 ] = { 0x5A };
+   const unsigned char iv[ 16 ]  = { 0xA5 };
+   EVP_CIPHER_CTX*     context   = EVP_CIPHER_CTX_new( );
+   double              best      = 0.0;
+   int                 length;
+
+   for( int pass = 0; ( context != NULL ) && ( pass < 3 ); pass++ )
+   {
+      auto start = std::chrono::high_resolution_clock::now( );
+
+      if( ( EVP_EncryptInit_ex( context, cipher, NULL, key, iv ) == 1 ) &&
+          ( EVP_EncryptUpdate( context, output.data( ), &length, input.data( ), static_cast< int >( input.size( ) ) ) == 1 ) &&
+          ( EVP_EncryptFinal_ex( context, output.data( ) + length, &length ) == 1 ) )
+      {
+         double elapsed = std::chrono::duration< double, std::milli >( std::chrono::high_resolution_clock::now( ) - start ).count( );
+
+         best = std::max( best, input.size( ) / ( std::max( elapsed, 1e-3 ) * 1000.0 ) );
+      }
+   }
+
+   EVP_CIPHER_CTX_free( context );
+
+   return( best );
+}
+
+/**
+ * Counts the bytes of a successful cipher call, or the failure of a call.
+ *
+ * @return The status of the call.
+ */
+static int record( int status, int length, Metrics::Counter& bytes )
+{
+   if( status < 0 )
+   {
+      failures.Add( );
    }
-   /// -# Cleanup
    else
    {
-      status = ciphertextLen + encryptedLen;
-      EVP_CIPHER_CTX_free( context );
+      bytes.Add( length );
    }
 
    return( status );
 }
 
-int AES::Decrypt( const unsigned char* ciphertext, int cLen, const unsigned char* key, 
-                  const unsigned char* iv, unsigned char* plaintext )
+/**
+ * Runs the cipher over the input in slices, reporting every slice to the progress observer, so a single
+ * call over gigabytes shows its progress. The context chains the slices, the output is the same as from
+ * one update.
+ *
+ * @return 1 on success, otherwise 0 like EVP_CipherUpdate.
+ */
+static int update( EVP_CIPHER_CTX* context, unsigned char* output, int* outputLen, const unsigned char* input, int length )
+{
+   int sliceLen;
+   int written;
+
+   *outputLen = 0;
+   if( length < 0 )
+   {
+      return( 0 );
+   }
+   for( int offset = 0; offset < length; offset += sliceLen )
+   {
+      sliceLen = std::min( Progress::SliceLen, length - offset );
+      if( EVP_CipherUpdate( context, output + *outputLen, &written, input + offset, sliceLen ) != 1 )
+      {
+         return( 0 );
+      }
+      *outputLen += written;
+      Progress::Advance( sliceLen );
+   }
+
+   return( 1 );
+}
+
+/**
+ * Returns the fetched cipher of a mode and key size.
+ */
+template< AES::Mode M, int KeyBits >
+static constexpr Provider::Cipher algorithm( void )
+{
+   if constexpr( M == AES::Mode::ChaCha20Poly1305 )
+   {
+      return( Provider::Cipher::ChaCha20Poly1305 );
+   }
+   else if constexpr( M == AES::Mode::ChaCha20 )
+   {
+      return( Provider::Cipher::ChaCha20 );
+   }
+   else
+   {
+      return( static_cast< Provider::Cipher >( ( KeyBits / 64 - 2 ) * 3 + static_cast< int >( M ) ) );
+   }
+}
+
+/**
+ * Returns the name of the trace span of an operation.
+ */
+template< AES::Mode M, int KeyBits, bool Encrypting >
+static constexpr const char* operation( void )
+{
+   if constexpr( M == AES::Mode::ChaCha20Poly1305 )
+   {
+      return( Encrypting ? "ChaCha20-Poly1305 Seal" : "ChaCha20-Poly1305 Open" );
+   }
+   else if constexpr( M == AES::Mode::ChaCha20 )
+   {
+      return( "ChaCha20" );
+   }
+   else if constexpr( M == AES::Mode::CTR )
+   {
+      return( ( KeyBits == 128 ) ? "AES-128-CTR" : ( KeyBits == 192 ) ? "AES-192-CTR" : "AES-256-CTR" );
+   }
+   else if constexpr( Encrypting )
+   {
+      return( ( KeyBits == 128 ) ? "AES-128 Encrypt" : ( KeyBits == 192 ) ? "AES-192 Encrypt" : "AES-256 Encrypt" );
+   }
+   else
+   {
+      return( ( KeyBits == 128 ) ? "AES-128 Decrypt" : ( KeyBits == 192 ) ? "AES-192 Decrypt" : "AES-256 Decrypt" );
+   }
+}
+
+/**
+ * Returns whether an instantiation runs on the native backend, AES-256 ECB, CBC, and CTR when selected.
+ */
+template< AES::Mode M, int KeyBits >
+static bool bypass( void )
+{
+   if constexpr( ( KeyBits == 256 ) && ( ( M == AES::Mode::ECB ) || ( M == AES::Mode::CBC ) || ( M == AES::Mode::CTR ) ) )
+   {
+      return( used.load( ) == AES::Backend::Native );
+   }
+   else
+   {
+      return( false );
+   }
+}
+
+/**
+ * Runs one cipher operation. Whether there is an IV, a padding block to finalize, or a tag to append or
+ * check is known at compile time, so the instantiation of every mode only contains its own steps. The
+ * ChaCha20-Poly1305 tag follows the ciphertext. ChaCha20 takes an AES-CTR counter block: its last four
+ * bytes (big-endian) are the block counter and its first twelve bytes the nonce, so every chunk keyed by a
+ * distinct counter prefix gets a distinct key stream, exactly as with AES-CTR.
+ *
+ * The context is initialised by the operation, so one context serves any number of operations, and the
+ * bytes or the failure are counted. On the native backend AES-256 ECB, CBC, and CTR bypass the context,
+ * which may then be null.
+ *
+ * @return Length of the output, or a negative value on error or when the tag does not match.
+ */
+template< AES::Mode M, int KeyBits, bool Encrypting >
+static int process( EVP_CIPHER_CTX* context, const unsigned char* input, int length,
+                    const typename AES::Cipher< M, KeyBits >::Key& key, const typename AES::Cipher< M, KeyBits >::IV& iv,
+                    unsigned char* output )
 {
-   int                  status = 0;
-   EVP_CIPHER_CTX*      context = NULL;
-   const EVP_CIPHER*    cipher = ( iv == NULL ) ? EVP_aes_256_ecb( ) : EVP_aes_256_cbc( );
-   const unsigned char* bufferIV = ( iv == NULL ) ? NULL : iv;
+   typedef AES::Cipher< M, KeyBits > Cipher;
 
-   int decryptedLen;
-   int plaintextLen;
+   Metrics::Counter&    bytes   = Cipher::Stream ? streamed : ( Encrypting ? encrypted : decrypted );
+   int                  status  = 0;
+   const unsigned char* start   = ( Cipher::IvLen > 0 ) ? iv.data( ) : NULL;
+   typename Cipher::IV  block;
+   typename Cipher::Tag tag;
+   int                  outputLen;
+   int                  finalLen = 0;
+   Trace::Span          span( operation< M, KeyBits, Encrypting >( ), nullptr, length );
 
    /// @par Process Design Language
-   /// -# Create and initialise the context 
-   if( ( context = EVP_CIPHER_CTX_new( ) ) == NULL )
+   /// -# Run AES-256 on the native kernels when selected
+   if( bypass< M, KeyBits >( ) )
    {
-      status = -1;
+      return( record( native< M, Encrypting >( input, length, key.data( ), start, output ), length, bytes ) );
    }
-   /// -# Initialise the decryption operation
-   else if( EVP_DecryptInit_ex( context, cipher, NULL, key, bufferIV ) != 1 )
+   /// -# Move the block counter to the little-endian front of the ChaCha20 IV
+   if constexpr( M == AES::Mode::ChaCha20 )
+   {
+      for( int i = 0; i < 4; i++ )
+      {
+         block[ i ] = iv[ 15 - i ];
+      }
+      std::memcpy( block.data( ) + 4, iv.data( ), AES::NonceLen );
+      start = block.data( );
+   }
+   /// -# Take the tag from the end of the ciphertext
+   if constexpr( ( Cipher::TagLen > 0 ) && !Encrypting )
+   {
+      if( length < Cipher::TagLen )
+      {
+         return( record( -2, length, bytes ) );
+      }
+      length -= Cipher::TagLen;
+      std::memcpy( tag.data( ), input + length, Cipher::TagLen );
+   }
+
+   /// -# Initialise the operation with the key and IV
+   if( ( context == NULL ) ||
+       ( EVP_CipherInit_ex( context, Provider::Get( algorithm< M, KeyBits >( ) ), NULL, key.data( ), start, Encrypting ? 1 : 0 ) != 1 ) )
    {
       status = -2;
-      EVP_CIPHER_CTX_free( context );
    }
-   /// -# Decrypt the message
-   else if( EVP_DecryptUpdate( context, plaintext, &decryptedLen, ciphertext, cLen ) != 1 )
+   /// -# Process the message
+   else if( update( context, output, &outputLen, input, length ) != 1 )
    {
       status = -3;
-      EVP_CIPHER_CTX_free( context );
    }
-   /// -# Finalize the Decrypt
-   else if( EVP_DecryptFinal_ex( context, plaintext + decryptedLen, &plaintextLen ) != 1 )
+   /// -# Check the tag before accepting the plaintext
+   else if( ( Cipher::TagLen > 0 ) && !Encrypting &&
+            ( EVP_CIPHER_CTX_ctrl( context, EVP_CTRL_AEAD_SET_TAG, Cipher::TagLen, tag.data( ) ) != 1 ) )
    {
       status = -4;
-      EVP_CIPHER_CTX_free( context );
    }
-   /// -# Cleanup
+   /// -# Finalize the padding or the tag, a stream has nothing to finalize
+   else if( !Cipher::Stream && ( EVP_CipherFinal_ex( context, output + outputLen, &finalLen ) != 1 ) )
+   {
+      status = -4;
+   }
+   /// -# Append the tag
+   else if( ( Cipher::TagLen > 0 ) && Encrypting &&
+            ( EVP_CIPHER_CTX_ctrl( context, EVP_CTRL_AEAD_GET_TAG, Cipher::TagLen, output + outputLen + finalLen ) != 1 ) )
+   {
+      status = -4;
+   }
+   else
+   {
+      status = outputLen + finalLen + ( Encrypting ? Cipher::TagLen : 0 );
+   }
+
+   return( record( status, length + ( Encrypting ? 0 : Cipher::TagLen ), bytes ) );
+}
+
+/**
+ * Runs AES-256 ECB, CBC, or CTR on the AESNI kernels, in slices reported to the progress observer like
+ * update, with the same output and PKCS#7 padding as EVP. The key is expanded per call and cleansed.
+ *
+ * @return Length of the output, or a negative value on error or when the padding does not match.
+ */
+template< AES::Mode M, bool Encrypting >
+static int native( const unsigned char* input, int length, const unsigned char* key, const unsigned char* iv,
+                   unsigned char* output )
+{
+   const int       sliceBlocks = Progress::SliceLen / AES::BlockLen;
+   int             blocks      = ( length > 0 ) ? length / AES::BlockLen : 0;
+   int             tail        = ( length > 0 ) ? length % AES::BlockLen : 0;
+   int             whole       = ( Encrypting || ( blocks == 0 ) ) ? blocks : blocks - 1;
+   int             status      = length;
+   int             sliceLen;
+   unsigned char   chain[ AES::BlockLen ] = { };
+   unsigned char   last[ AES::BlockLen ];
+   AESNI::Schedule schedule;
+
+   /// @par Process Design Language
+   /// -# Reject what EVP rejects: a negative length, and a ciphertext that is not whole blocks
+   if( length < 0 )
+   {
+      return( -3 );
+   }
+   if( !Encrypting && ( M != AES::Mode::CTR ) && ( ( length == 0 ) || ( tail != 0 ) ) )
+   {
+      return( -4 );
+   }
+
+   /// -# Expand the key, inverted for decryption
+   AESNI::Expand( key, schedule );
+   if constexpr( !Encrypting && ( M != AES::Mode::CTR ) )
+   {
+      AESNI::Schedule expanded = schedule;
+
+      AESNI::Invert( expanded, schedule );
+      OPENSSL_cleanse( &expanded, sizeof( expanded ) );
+   }
+   if( iv != NULL )
+   {
+      std::memcpy( chain, iv, AES::BlockLen );
+   }
+
+   if constexpr( M == AES::Mode::CTR )
+   {
+      /// -# Run the key stream over the whole message
+      for( int offset = 0; offset < length; offset += sliceLen )
+      {
+         sliceLen = std::min( Progress::SliceLen, length - offset );
+         AESNI::CTR( schedule, chain, input + offset, output + offset, static_cast< size_t >( sliceLen ) );
+         Progress::Advance( sliceLen );
+      }
+   }
+   else
+   {
+      /// -# Run the whole blocks, holding back the padded last block of a ciphertext
+      for( int block = 0; block < whole; block += sliceLen )
+      {
+         sliceLen = std::min( sliceBlocks, whole - block );
+         kernel< M, Encrypting >( schedule, chain, input + block * AES::BlockLen, output + block * AES::BlockLen, sliceLen );
+         Progress::Advance( sliceLen * AES::BlockLen );
+      }
+
+      if constexpr( Encrypting )
+      {
+         /// -# Pad and encrypt the last block
+         std::memcpy( last, input + whole * AES::BlockLen, tail );
+         std::memset( last + tail, AES::BlockLen - tail, AES::BlockLen - tail );
+         kernel< M, Encrypting >( schedule, chain, last, output + whole * AES::BlockLen, 1 );
+         Progress::Advance( tail );
+         status = ( whole + 1 ) * AES::BlockLen;
+      }
+      else
+      {
+         int padLen;
+
+         /// -# Decrypt the last block and strip its padding
+         kernel< M, Encrypting >( schedule, chain, input + whole * AES::BlockLen, last, 1 );
+         Progress::Advance( AES::BlockLen );
+         padLen = last[ AES::BlockLen - 1 ];
+         status = ( ( padLen >= 1 ) && ( padLen <= AES::BlockLen ) ) ? whole * AES::BlockLen + AES::BlockLen - padLen : -4;
+         for( int i = AES::BlockLen - padLen; ( status >= 0 ) && ( i < AES::BlockLen ); i++ )
+         {
+            status = ( last[ i ] == padLen ) ? status : -4;
+         }
+         if( status >= 0 )
+         {
+            std::memcpy( output + whole * AES::BlockLen, last, AES::BlockLen - padLen );
+         }
+      }
+   }
+
+   OPENSSL_cleanse( &schedule, sizeof( schedule ) );
+   OPENSSL_cleanse( last, sizeof( last ) );
+
+   return( status );
+}
+
+/**
+ * Runs whole ECB or CBC blocks on the kernel of the mode and direction, the schedule inverted for
+ * decryption and the chain advanced in place for CBC.
+ */
+template< AES::Mode M, bool Encrypting >
+static void kernel( const AESNI::Schedule& schedule, unsigned char* chain, const unsigned char* input, unsigned char* output,
+                    int blocks )
+{
+   if constexpr( ( M == AES::Mode::ECB ) && Encrypting )
+   {
+      AESNI::EncryptECB( schedule, input, output, static_cast< size_t >( blocks ) );
+   }
+   else if constexpr( M == AES::Mode::ECB )
+   {
+      AESNI::DecryptECB( schedule, input, output, static_cast< size_t >( blocks ) );
+   }
+   else if constexpr( Encrypting )
+   {
+      AESNI::EncryptCBC( schedule, chain, input, output, static_cast< size_t >( blocks ) );
+   }
    else
    {
-      status = plaintextLen + decryptedLen;
-      EVP_CIPHER_CTX_free( context );
+      AESNI::DecryptCBC( schedule, chain, input, output, static_cast< size_t >( blocks ) );
    }
+}
+
+/**
+ * Runs the 256-bit instantiation of a mode on raw buffers: the key and IV are copied into arrays of their
+ * length once per call, an absent IV is all zero. The operation runs on the given context, or on its own
+ * when null.
+ *
+ * @return The status of the instantiation.
+ */
+template< AES::Mode M, bool Encrypting >
+static int wrap( EVP_CIPHER_CTX* context, const unsigned char* input, int length, const unsigned char* key,
+                 const unsigned char* iv, unsigned char* output )
+{
+   typedef AES::Cipher< M, 256 > Cipher;
+
+   typename Cipher::Key typedKey;
+   typename Cipher::IV  typedIV = { };
+   int                  status;
+
+   std::memcpy( typedKey.data( ), key, Cipher::KeyLen );
+   if constexpr( Cipher::IvLen > 0 )
+   {
+      if( iv != NULL )
+      {
+         std::memcpy( typedIV.data( ), iv, Cipher::IvLen );
+      }
+   }
+
+   if( context != NULL )
+   {
+      status = process< M, 256, Encrypting >( context, input, length, typedKey, typedIV, output );
+   }
+   else
+   {
+      status = Encrypting ? Cipher::Encrypt( input, length, typedKey, typedIV, output ) :
+                            Cipher::Decrypt( input, length, typedKey, typedIV, output );
+   }
+
+   OPENSSL_cleanse( typedKey.data( ), typedKey.size( ) );
 
    return( status );
 }
+
+/**
+ * Runs Encrypt or Decrypt of the selected suite: ChaCha20-Poly1305, or AES-256-CBC and AES-256-ECB without
+ * an IV. ChaCha20-Poly1305 has no mode without a nonce, a call without an IV fails rather than fall back to
+ * a fixed nonce that would repeat under the key.
+ *
+ * @return The status of the operation.
+ */
+template< bool Encrypting >
+static int dispatch( EVP_CIPHER_CTX* context, const unsigned char* input, int length, const unsigned char* key,
+                     const unsigned char* iv, unsigned char* output )
+{
+   if( selected.load( ) == AES::Suite::ChaCha20Poly1305 )
+   {
+      return( ( iv == NULL ) ? -1 : wrap< AES::Mode::ChaCha20Poly1305, Encrypting >( context, input, length, key, iv, output ) );
+   }
+
+   return( ( iv == NULL ) ? wrap< AES::Mode::ECB, Encrypting >( context, input, length, key, iv, output ) :
+                            wrap< AES::Mode::CBC, Encrypting >( context, input, length, key, iv, output ) );
+}
+
+/**
+ * Encrypts the jobs with AES-256-CBC, or ECB without an IV, on the multi-buffer kernel. Every lane holds a
+ * job until its padded last block is encrypted and is then refilled with the next job, and every kernel
+ * call runs all lanes for as many blocks as the shortest one has left, so the lanes stay full until the
+ * jobs run out.
+ *
+ * @return 0 when every job succeeded, otherwise a negative value.
+ */
+static int interleave( AES::Job* jobs, int count )
+{
+   struct Stream
+   {
+      int  job;       ///< Job of the lane
+      int  blocks;    ///< Blocks left before the padded last block
+      bool padded;    ///< The padded last block is queued
+      int  slot;      ///< Schedule and last block of the job
+   };
+
+   AESNI::Schedule schedules[ AESNI::Lanes ];
+   unsigned char   lasts[ AESNI::Lanes ][ AES::BlockLen ];
+   AESNI::Lane     lanes[ AESNI::Lanes ];
+   Stream          streams[ AESNI::Lanes ];
+   int             spare[ AESNI::Lanes ];
+   int             spares = AESNI::Lanes;
+   int             active = 0;
+   int             next   = 0;
+   int             status = 0;
+
+   for( int slot = 0; slot < AESNI::Lanes; slot++ )
+   {
+      spare[ slot ] = slot;
+   }
+
+   while( true )
+   {
+      int blocks = INT_MAX;
+
+      /// @par Process Design Language
+      /// -# Fill the idle lanes with the next jobs, expanding their keys and padding their last blocks
+      while( ( active < AESNI::Lanes ) && ( next < count ) )
+      {
+         AES::Job& job  = jobs[ next ];
+         int       full = ( job.length >= 0 ) ? job.length / AES::BlockLen : 0;
+         int       tail = ( job.length >= 0 ) ? job.length % AES::BlockLen : 0;
+         int       slot;
+
+         if( job.length < 0 )
+         {
+            job.status = record( -1, job.length, encrypted );
+            status     = -1;
+            next++;
+            continue;
+         }
+         slot = spare[ --spares ];
+         AESNI::Expand( job.key, schedules[ slot ] );
+         if( tail > 0 )
+         {
+            std::memcpy( lasts[ slot ], job.input + full * AES::BlockLen, tail );
+         }
+         std::memset( lasts[ slot ] + tail, AES::BlockLen - tail, AES::BlockLen - tail );
+
+         lanes[ active ].schedule = &schedules[ slot ];
+         lanes[ active ].chained  = ( job.iv != NULL );
+         lanes[ active ].input    = job.input;
+         lanes[ active ].output   = job.output;
+         if( job.iv != NULL )
+         {
+            std::memcpy( lanes[ active ].chain, job.iv, AES::BlockLen );
+         }
+         else
+         {
+            std::memset( lanes[ active ].chain, 0, AES::BlockLen );
+         }
+         streams[ active ] = Stream{ next, full, false, slot };
+         active++;
+         next++;
+      }
+      if( active == 0 )
+      {
+         break;
+      }
+
+      /// -# Queue the padded last block of the lanes done with their full blocks
+      for( int lane = 0; lane < active; lane++ )
+      {
+         if( streams[ lane ].blocks == 0 )
+         {
+            lanes[ lane ].input    = lasts[ streams[ lane ].slot ];
+            streams[ lane ].blocks = 1;
+            streams[ lane ].padded = true;
+         }
+         blocks = std::min( blocks, streams[ lane ].blocks );
+      }
+
+      /// -# Encrypt the blocks all lanes have left
+      AESNI::EncryptLanes( lanes, active, blocks );
+
+      /// -# Retire the jobs whose padded last block is encrypted, moving the last lane into the gap
+      for( int lane = active - 1; lane >= 0; lane-- )
+      {
+         streams[ lane ].blocks -= blocks;
+         if( streams[ lane ].padded && ( streams[ lane ].blocks == 0 ) )
+         {
+            AES::Job& job = jobs[ streams[ lane ].job ];
+
+            job.status = record( ( job.length / AES::BlockLen + 1 ) * AES::BlockLen, job.length, encrypted );
+            Progress::Advance( job.length );
+            spare[ spares++ ] = streams[ lane ].slot;
+            active--;
+            lanes[ lane ]   = lanes[ active ];
+            streams[ lane ] = streams[ active ];
+         }
+      }
+   }
+
+   OPENSSL_cleanse( schedules, sizeof( schedules ) );
+   OPENSSL_cleanse( lasts, sizeof( lasts ) );
+
+   return( status );
+}
+
+template class AES::Cipher< AES::Mode::ECB, 128 >;
+template class AES::Cipher< AES::Mode::ECB, 192 >;
+template class AES::Cipher< AES::Mode::ECB, 256 >;
+template class AES::Cipher< AES::Mode::CBC, 128 >;
+template class AES::Cipher< AES::Mode::CBC, 192 >;
+template class AES::Cipher< AES::Mode::CBC, 256 >;
+template class AES::Cipher< AES::Mode::CTR, 128 >;
+template class AES::Cipher< AES::Mode::CTR, 192 >;
+template class AES::Cipher< AES::Mode::CTR, 256 >;
+template class AES::Cipher< AES::Mode::ChaCha20Poly1305, 256 >;
+template class AES::Cipher< AES::Mode::ChaCha20, 256 >;
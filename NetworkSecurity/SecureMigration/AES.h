@@ -1,13 +1,111 @@
 #pragma once
 
+// StdLib Includes
+#include <array>
+
 namespace SecureMigration
 {
    namespace AES
    {
-      int Encrypt( const unsigned char* plaintext,  int pLen, const unsigned char* key, 
+      /// Bulk cipher behind Encrypt, Decrypt, and CTR
+      enum class Suite
+      {
+         AES256,             ///< AES-256-CBC (ECB without an IV), AES-256-CTR for seekable chunks
+         ChaCha20Poly1305    ///< ChaCha20-Poly1305 with a 16 byte tag, ChaCha20 for seekable chunks
+      };
+
+      const int TagLen       = 16;                ///< Poly1305 tag appended to a ChaCha20-Poly1305 ciphertext
+      const int BlockLen     = 16;                ///< AES block, the IV of CBC and the counter block of CTR
+      const int NonceLen     = 12;                ///< ChaCha20-Poly1305 nonce taken from the start of the IV
+      const int ProbeSizeDef = 4 * 1024 * 1024;   ///< Bytes encrypted per cipher by the capability probe
+
+      /// Implementation of the AES-256 ECB, CBC, and CTR instantiations
+      enum class Backend
+      {
+         EVP,      ///< OpenSSL through the fetched EVP ciphers
+         Native    ///< AESNI kernels, the selected AESNI::Level, without an EVP context per call
+      };
+
+      /// Mode of a templated cipher
+      enum class Mode
+      {
+         ECB,                ///< AES-ECB with PKCS#7 padding
+         CBC,                ///< AES-CBC with PKCS#7 padding
+         CTR,                ///< AES-CTR, length preserving and seekable
+         ChaCha20Poly1305,   ///< ChaCha20-Poly1305 with the tag appended to the ciphertext
+         ChaCha20            ///< ChaCha20 keyed by an AES-CTR counter block, length preserving and seekable
+      };
+
+      /**
+       * Cipher of a mode and key size fixed at compile time.
+       *
+       * @details
+       * The key, IV, and tag are arrays of exactly their length, so passing a key of the wrong size or an IV
+       * to ECB does not compile, and the algorithm, the padding, and the tag handling are chosen by the
+       * compiler rather than per call. Encrypt, Decrypt, and CTR below are wrappers that pick the
+       * instantiation of the selected suite once per call. Every valid combination is instantiated in
+       * AES.cpp, an invalid one fails its static assertion.
+       */
+      template< Mode M, int KeyBits >
+      class Cipher
+      {
+         static_assert( ( KeyBits == 128 ) || ( KeyBits == 192 ) || ( KeyBits == 256 ), "AES keys are 128, 192, or 256 bits" );
+         static_assert( ( KeyBits == 256 ) || ( M == Mode::ECB ) || ( M == Mode::CBC ) || ( M == Mode::CTR ), "ChaCha20 keys are 256 bits" );
+
+      public:     // Public Attributes
+         static constexpr bool Stream = ( M == Mode::CTR ) || ( M == Mode::ChaCha20 );   ///< Output as long as the input
+         static constexpr int  KeyLen = KeyBits / 8;                                    ///< Key length in bytes
+         static constexpr int  IvLen  = ( M == Mode::ECB ) ? 0 : ( M == Mode::ChaCha20Poly1305 ) ? NonceLen : BlockLen;
+         static constexpr int  TagLen = ( M == Mode::ChaCha20Poly1305 ) ? AES::TagLen : 0;
+         static constexpr int  Growth = Stream ? 0 : ( M == Mode::ChaCha20Poly1305 ) ? TagLen : BlockLen;   ///< Most bytes added by Encrypt
+
+         typedef std::array< unsigned char, KeyLen > Key;   ///< Key of the cipher
+         typedef std::array< unsigned char, IvLen >  IV;    ///< IV, nonce, or counter block, empty for ECB
+         typedef std::array< unsigned char, TagLen > Tag;   ///< Authentication tag, empty without one
+
+      public:     // Public Methods
+         static int Encrypt( const unsigned char* input, int length, const Key& key, const IV& iv, unsigned char* output );
+         static int Decrypt( const unsigned char* input, int length, const Key& key, const IV& iv, unsigned char* output );
+
+      private:    // Private Methods
+         Cipher( void );   // Disabled
+      };
+
+      /// Independent message of a batch, encrypted or decrypted like a call of Encrypt or Decrypt
+      struct Job
+      {
+         const unsigned char* key;      ///< 32 byte key
+         const unsigned char* iv;       ///< 16 byte IV, ECB when null
+         const unsigned char* input;    ///< Message
+         int                  length;   ///< Bytes of the message
+         unsigned char*       output;   ///< Room for the message, a padding block, and a tag
+         int                  status;   ///< Length of the output, or a negative value on error
+      };
+
+      /// Result of the capability probe
+      struct Capabilities
+      {
+         bool   aesni;        ///< The CPU reports AES instructions
+         double aesRate;      ///< Measured AES-256-CBC encryption in MB/s
+         double chachaRate;   ///< Measured ChaCha20-Poly1305 encryption in MB/s
+      };
+
+      int Encrypt( const unsigned char* plaintext,  int pLen, const unsigned char* key,
                    const unsigned char* iv, unsigned char* ciphertext );
-      int Decrypt( const unsigned char* ciphertext, int cLen, const unsigned char* key, 
+      int Decrypt( const unsigned char* ciphertext, int cLen, const unsigned char* key,
                    const unsigned char* iv, unsigned char* plaintext );
+      int CTR( const unsigned char* input, int length, const unsigned char* key,
+               const unsigned char* counter, unsigned char* output );
+
+      int EncryptBatch( Job* jobs, int count );
+      int DecryptBatch( Job* jobs, int count );
+
+      Suite       Probe( Capabilities& capabilities, int size = ProbeSizeDef );
+      void        Select( Suite suite );
+      Suite       Selected( void );
+      const char* Name( Suite suite );
+      void        Use( Backend backend );
+      Backend     Used( void );
+      const char* Name( Backend backend );
    }
 }
-
@@ -0,0 +1,835 @@
+/**
+ * @file
+ * @brief AES-256 with the AES-NI and VAES instructions, interleaving independent blocks so the AES unit stays busy.
+ */
+// Application Includes
+#include <AESNI.h>
+
+// StdLib Includes
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#include <intrin.h>
+#include <immintrin.h>
+#define AESNI_X86
+#define AESNI_TARGET
+#define VAES_TARGET
+#elif defined( __x86_64__ ) || defined( __i386__ )
+#include <cpuid.h>
+#include <immintrin.h>
+#define AESNI_X86
+#define AESNI_TARGET __attribute__( ( target( "aes,sse2,ssse3" ) ) )
+#define VAES_TARGET  __attribute__( ( target( "aes,sse2,ssse3,avx512f,avx512bw,vaes" ) ) )
+#endif
+
+using namespace SecureMigration;
+
+#if defined( AESNI_X86 )
+template< int Count >
+AESNI_TARGET static void    encrypt( AESNI::Lane* lanes, int blocks );
+template< size_t... L >
+AESNI_TARGET static void    step( AESNI::Lane* lanes, const __m128i* const* keys, __m128i* chain, const __m128i* mask, int block,
+                                  std::index_sequence< L... > );
+AESNI_TARGET static __m128i assistLow( __m128i key, __m128i assist );
+AESNI_TARGET static __m128i assistHigh( __m128i low, __m128i key );
+AESNI_TARGET static void    invert( const __m128i* keys, __m128i* inverse );
+template< bool Decrypting, size_t... B >
+AESNI_TARGET static void    rounds( __m128i* blocks, const __m128i* keys, std::index_sequence< B... > );
+template< bool Decrypting, size_t... B >
+AESNI_TARGET static void    ecb( const __m128i* keys, const unsigned char* input, unsigned char* output, std::index_sequence< B... > );
+template< size_t... B >
+AESNI_TARGET static __m128i cbc( const __m128i* keys, __m128i chain, const unsigned char* input, unsigned char* output,
+                                 std::index_sequence< B... > );
+template< size_t... B >
+AESNI_TARGET static void    ctr( const __m128i* keys, __m128i counter, const unsigned char* input, unsigned char* output,
+                                 std::index_sequence< B... > );
+template< bool Decrypting >
+AESNI_TARGET static void    narrowECB( const __m128i* keys, const unsigned char* input, unsigned char* output, size_t blocks );
+AESNI_TARGET static void    narrowEncryptCBC( const __m128i* keys, unsigned char* chain, const unsigned char* input,
+                                              unsigned char* output, size_t blocks );
+AESNI_TARGET static void    narrowDecryptCBC( const __m128i* keys, unsigned char* chain, const unsigned char* input,
+                                              unsigned char* output, size_t blocks );
+AESNI_TARGET static void    narrowCTR( const __m128i* keys, unsigned char* counter, const unsigned char* input, unsigned char* output,
+                                       size_t length );
+template< bool Decrypting, size_t... V >
+VAES_TARGET static void     roundsWide( __m512i* blocks, const __m128i* keys, std::index_sequence< V... > );
+template< bool Decrypting >
+VAES_TARGET static size_t   wideECB( const __m128i* keys, const unsigned char* input, unsigned char* output, size_t blocks );
+VAES_TARGET static size_t   wideDecryptCBC( const __m128i* keys, unsigned char* chain, const unsigned char* input,
+                                            unsigned char* output, size_t blocks );
+VAES_TARGET static size_t   wideCTR( const __m128i* keys, unsigned char* counter, const unsigned char* input, unsigned char* output,
+                                     size_t blocks );
+template< bool Decrypting, size_t... V >
+VAES_TARGET static void     ecbWide( const __m128i* keys, const unsigned char* input, unsigned char* output,
+                                     std::index_sequence< V... > );
+template< size_t... V >
+VAES_TARGET static __m128i  cbcWide( const __m128i* keys, __m128i chain, const unsigned char* input, unsigned char* output,
+                                     std::index_sequence< V... > );
+template< size_t... V >
+VAES_TARGET static void     ctrWide( const __m128i* keys, __m128i counter, const unsigned char* input, unsigned char* output,
+                                     std::index_sequence< V... > );
+AESNI_TARGET static __m128i reversal( void );
+static uint64_t             loadBig( const unsigned char* bytes );
+static void                 storeBig( uint64_t value, unsigned char* bytes );
+static uint64_t             swap( uint64_t value );
+static AESNI::Level         probe( void );
+#endif
+
+static std::atomic< AESNI::Level >& selection( void );
+
+/**
+ * Returns the widest AES instructions of the CPU, probed once: VAES needs AVX-512 enabled by the operating
+ * system as well.
+ */
+AESNI::Level AESNI::Detect( void )
+{
+#if defined( AESNI_X86 )
+   static const Level detected = probe( );
+
+   return( detected );
+#else
+   return( Level::None );
+#endif
+}
+
+/**
+ * Selects the kernels used from now on, at most the detected level, so the narrower kernels can be
+ * measured and tested on a wider CPU.
+ */
+void AESNI::Select( Level level )
+{
+   selection( ).store( std::min( level, Detect( ) ) );
+}
+
+AESNI::Level AESNI::Selected( void )
+{
+   return( selection( ).load( ) );
+}
+
+const char* AESNI::Name( Level level )
+{
+   return( ( level == Level::VAES ) ? "VAES" : ( level == Level::AESNI ) ? "AES-NI" : "None" );
+}
+
+/**
+ * Returns whether the CPU reports the AES instructions (CPUID leaf 1, ECX bit 25 on x86) the kernels need.
+ */
+bool AESNI::Available( void )
+{
+   return( Detect( ) != Level::None );
+}
+
+#if defined( AESNI_X86 )
+/**
+ * Expands a 32 byte key into the AES-256 round keys. Only call when Available.
+ */
+AESNI_TARGET void AESNI::Expand( const unsigned char* key, Schedule& schedule )
+{
+   __m128i* keys = reinterpret_cast< __m128i* >( schedule.keys );
+   __m128i  low  = _mm_loadu_si128( reinterpret_cast< const __m128i* >( key ) );
+   __m128i  high = _mm_loadu_si128( reinterpret_cast< const __m128i* >( key + 16 ) );
+
+   /// @par Process Design Language
+   /// -# Derive every pair of round keys from the previous pair, the round constant is an immediate
+   _mm_storeu_si128( &keys[ 0 ], low );
+   _mm_storeu_si128( &keys[ 1 ], high );
+   low  = assistLow( low, _mm_aeskeygenassist_si128( high, 0x01 ) );
+   high = assistHigh( low, high );
+   _mm_storeu_si128( &keys[ 2 ], low );
+   _mm_storeu_si128( &keys[ 3 ], high );
+   low  = assistLow( low, _mm_aeskeygenassist_si128( high, 0x02 ) );
+   high = assistHigh( low, high );
+   _mm_storeu_si128( &keys[ 4 ], low );
+   _mm_storeu_si128( &keys[ 5 ], high );
+   low  = assistLow( low, _mm_aeskeygenassist_si128( high, 0x04 ) );
+   high = assistHigh( low, high );
+   _mm_storeu_si128( &keys[ 6 ], low );
+   _mm_storeu_si128( &keys[ 7 ], high );
+   low  = assistLow( low, _mm_aeskeygenassist_si128( high, 0x08 ) );
+   high = assistHigh( low, high );
+   _mm_storeu_si128( &keys[ 8 ], low );
+   _mm_storeu_si128( &keys[ 9 ], high );
+   low  = assistLow( low, _mm_aeskeygenassist_si128( high, 0x10 ) );
+   high = assistHigh( low, high );
+   _mm_storeu_si128( &keys[ 10 ], low );
+   _mm_storeu_si128( &keys[ 11 ], high );
+   low  = assistLow( low, _mm_aeskeygenassist_si128( high, 0x20 ) );
+   high = assistHigh( low, high );
+   _mm_storeu_si128( &keys[ 12 ], low );
+   _mm_storeu_si128( &keys[ 13 ], high );
+   low  = assistLow( low, _mm_aeskeygenassist_si128( high, 0x40 ) );
+   _mm_storeu_si128( &keys[ 14 ], low );
+}
+
+/**
+ * Encrypts the given number of blocks of every lane, one block of every lane per step, so the rounds of
+ * the lanes overlap in the AES pipeline even though every CBC lane is serial. Only call when Available.
+ */
+void AESNI::EncryptLanes( Lane* lanes, int count, int blocks )
+{
+   switch( count )
+   {
+      case 1:  encrypt< 1 >( lanes, blocks ); break;
+      case 2:  encrypt< 2 >( lanes, blocks ); break;
+      case 3:  encrypt< 3 >( lanes, blocks ); break;
+      case 4:  encrypt< 4 >( lanes, blocks ); break;
+      case 5:  encrypt< 5 >( lanes, blocks ); break;
+      case 6:  encrypt< 6 >( lanes, blocks ); break;
+      case 7:  encrypt< 7 >( lanes, blocks ); break;
+      case 8:  encrypt< 8 >( lanes, blocks ); break;
+      default: break;
+   }
+}
+
+/**
+ * Inverts an encryption schedule into a separate schedule for the decryption kernels, the equivalent
+ * inverse cipher of FIPS 197. Only call when Available.
+ */
+void AESNI::Invert( const Schedule& schedule, Schedule& inverse )
+{
+   invert( reinterpret_cast< const __m128i* >( schedule.keys ), reinterpret_cast< __m128i* >( inverse.keys ) );
+}
+
+/**
+ * Encrypts whole blocks in ECB, Width blocks in flight with AES-NI and Wide blocks with VAES, so the
+ * latency of every round is hidden behind the other blocks. Only call when Available.
+ */
+void AESNI::EncryptECB( const Schedule& schedule, const unsigned char* input, unsigned char* output, size_t blocks )
+{
+   const __m128i* keys = reinterpret_cast< const __m128i* >( schedule.keys );
+   size_t         done = ( Selected( ) == Level::VAES ) ? wideECB< false >( keys, input, output, blocks ) : 0;
+
+   narrowECB< false >( keys, input + 16 * done, output + 16 * done, blocks - done );
+}
+
+/**
+ * Decrypts whole blocks in ECB with an inverted schedule, interleaved like EncryptECB.
+ */
+void AESNI::DecryptECB( const Schedule& inverse, const unsigned char* input, unsigned char* output, size_t blocks )
+{
+   const __m128i* keys = reinterpret_cast< const __m128i* >( inverse.keys );
+   size_t         done = ( Selected( ) == Level::VAES ) ? wideECB< true >( keys, input, output, blocks ) : 0;
+
+   narrowECB< true >( keys, input + 16 * done, output + 16 * done, blocks - done );
+}
+
+/**
+ * Encrypts whole blocks in CBC, advancing the chain in place. Every block needs the previous ciphertext,
+ * so a single stream runs one block at a time, EncryptLanes interleaves independent streams instead.
+ */
+void AESNI::EncryptCBC( const Schedule& schedule, unsigned char* chain, const unsigned char* input, unsigned char* output,
+                        size_t blocks )
+{
+   narrowEncryptCBC( reinterpret_cast< const __m128i* >( schedule.keys ), chain, input, output, blocks );
+}
+
+/**
+ * Decrypts whole blocks in CBC with an inverted schedule, advancing the chain in place. Every block only
+ * needs ciphertext, so the blocks are interleaved like DecryptECB. Input and output may be the same buffer.
+ */
+void AESNI::DecryptCBC( const Schedule& inverse, unsigned char* chain, const unsigned char* input, unsigned char* output,
+                        size_t blocks )
+{
+   const __m128i* keys = reinterpret_cast< const __m128i* >( inverse.keys );
+   size_t         done = ( Selected( ) == Level::VAES ) ? wideDecryptCBC( keys, chain, input, output, blocks ) : 0;
+
+   narrowDecryptCBC( keys, chain, input + 16 * done, output + 16 * done, blocks - done );
+}
+
+/**
+ * Encrypts or decrypts any length in CTR from a 128-bit big-endian counter block, advancing the counter
+ * in place past every block used, a partial last block included. Interleaved like EncryptECB.
+ */
+void AESNI::CTR( const Schedule& schedule, unsigned char* counter, const unsigned char* input, unsigned char* output,
+                 size_t length )
+{
+   const __m128i* keys = reinterpret_cast< const __m128i* >( schedule.keys );
+   size_t         done = ( Selected( ) == Level::VAES ) ? wideCTR( keys, counter, input, output, length / 16 ) : 0;
+
+   narrowCTR( keys, counter, input + 16 * done, output + 16 * done, length - 16 * done );
+}
+
+/**
+ * Interleaves a fixed number of lanes.
+ */
+template< int Count >
+AESNI_TARGET static void encrypt( AESNI::Lane* lanes, int blocks )
+{
+   const __m128i* keys[ Count ];
+   __m128i        chain[ Count ];
+   __m128i        mask[ Count ];
+
+   /// @par Process Design Language
+   /// -# Load the chaining value of every lane, masked out for ECB
+   for( int lane = 0; lane < Count; lane++ )
+   {
+      keys[ lane ]  = reinterpret_cast< const __m128i* >( lanes[ lane ].schedule->keys );
+      mask[ lane ]  = lanes[ lane ].chained ? _mm_set1_epi32( -1 ) : _mm_setzero_si128( );
+      chain[ lane ] = _mm_and_si128( _mm_loadu_si128( reinterpret_cast< const __m128i* >( lanes[ lane ].chain ) ), mask[ lane ] );
+   }
+
+   /// -# Encrypt one block of every lane per step
+   for( int block = 0; block < blocks; block++ )
+   {
+      step( lanes, keys, chain, mask, block, std::make_index_sequence< Count >( ) );
+   }
+
+   /// -# Advance every lane past the blocks
+   for( int lane = 0; lane < Count; lane++ )
+   {
+      _mm_storeu_si128( reinterpret_cast< __m128i* >( lanes[ lane ].chain ), chain[ lane ] );
+      lanes[ lane ].input  += 16 * blocks;
+      lanes[ lane ].output += 16 * blocks;
+   }
+}
+
+/**
+ * Encrypts one block of every lane, running every round across all lanes before the next round. The lanes
+ * are a parameter pack, so every lane is unrolled and its state stays in a register.
+ */
+template< size_t... L >
+AESNI_TARGET static inline void step( AESNI::Lane* lanes, const __m128i* const* keys, __m128i* chain, const __m128i* mask, int block,
+                                      std::index_sequence< L... > )
+{
+   __m128i state[ sizeof...( L ) ] =
+   {
+      _mm_xor_si128( _mm_xor_si128( _mm_loadu_si128( reinterpret_cast< const __m128i* >( lanes[ L ].input ) + block ), chain[ L ] ),
+                     _mm_loadu_si128( &keys[ L ][ 0 ] ) )...
+   };
+
+   for( int round = 1; round < AESNI::Rounds; round++ )
+   {
+      ( ( state[ L ] = _mm_aesenc_si128( state[ L ], _mm_loadu_si128( &keys[ L ][ round ] ) ) ), ... );
+   }
+   ( ( state[ L ] = _mm_aesenclast_si128( state[ L ], _mm_loadu_si128( &keys[ L ][ AESNI::Rounds ] ) ) ), ... );
+   ( _mm_storeu_si128( reinterpret_cast< __m128i* >( lanes[ L ].output ) + block, state[ L ] ), ... );
+   ( ( chain[ L ] = _mm_and_si128( state[ L ], mask[ L ] ) ), ... );
+}
+
+/**
+ * Derives the next even round key from the previous one and the key generation assist of the odd one.
+ */
+AESNI_TARGET static __m128i assistLow( __m128i key, __m128i assist )
+{
+   assist = _mm_shuffle_epi32( assist, 0xFF );
+   key    = _mm_xor_si128( key, _mm_slli_si128( key, 4 ) );
+   key    = _mm_xor_si128( key, _mm_slli_si128( key, 4 ) );
+   key    = _mm_xor_si128( key, _mm_slli_si128( key, 4 ) );
+
+   return( _mm_xor_si128( key, assist ) );
+}
+
+/**
+ * Derives the next odd round key from the previous one and the even round key just derived.
+ */
+AESNI_TARGET static __m128i assistHigh( __m128i low, __m128i key )
+{
+   __m128i assist = _mm_shuffle_epi32( _mm_aeskeygenassist_si128( low, 0x00 ), 0xAA );
+
+   key = _mm_xor_si128( key, _mm_slli_si128( key, 4 ) );
+   key = _mm_xor_si128( key, _mm_slli_si128( key, 4 ) );
+   key = _mm_xor_si128( key, _mm_slli_si128( key, 4 ) );
+
+   return( _mm_xor_si128( key, assist ) );
+}
+
+/**
+ * Inverts the round keys: reversed, with InvMixColumns applied to all but the first and last.
+ */
+AESNI_TARGET static void invert( const __m128i* keys, __m128i* inverse )
+{
+   _mm_storeu_si128( &inverse[ 0 ], _mm_loadu_si128( &keys[ AESNI::Rounds ] ) );
+   for( int round = 1; round < AESNI::Rounds; round++ )
+   {
+      _mm_storeu_si128( &inverse[ round ], _mm_aesimc_si128( _mm_loadu_si128( &keys[ AESNI::Rounds - round ] ) ) );
+   }
+   _mm_storeu_si128( &inverse[ AESNI::Rounds ], _mm_loadu_si128( &keys[ 0 ] ) );
+}
+
+/**
+ * Runs every round across all blocks before the next round. The blocks are a parameter pack, so every
+ * block is unrolled and stays in a register.
+ */
+template< bool Decrypting, size_t... B >
+AESNI_TARGET static inline void rounds( __m128i* blocks, const __m128i* keys, std::index_sequence< B... > )
+{
+   __m128i key = _mm_loadu_si128( &keys[ 0 ] );
+
+   ( ( blocks[ B ] = _mm_xor_si128( blocks[ B ], key ) ), ... );
+   for( int round = 1; round < AESNI::Rounds; round++ )
+   {
+      key = _mm_loadu_si128( &keys[ round ] );
+      if constexpr( Decrypting )
+      {
+         ( ( blocks[ B ] = _mm_aesdec_si128( blocks[ B ], key ) ), ... );
+      }
+      else
+      {
+         ( ( blocks[ B ] = _mm_aesenc_si128( blocks[ B ], key ) ), ... );
+      }
+   }
+   key = _mm_loadu_si128( &keys[ AESNI::Rounds ] );
+   if constexpr( Decrypting )
+   {
+      ( ( blocks[ B ] = _mm_aesdeclast_si128( blocks[ B ], key ) ), ... );
+   }
+   else
+   {
+      ( ( blocks[ B ] = _mm_aesenclast_si128( blocks[ B ], key ) ), ... );
+   }
+}
+
+/**
+ * Encrypts or decrypts a group of ECB blocks.
+ */
+template< bool Decrypting, size_t... B >
+AESNI_TARGET static inline void ecb( const __m128i* keys, const unsigned char* input, unsigned char* output,
+                                     std::index_sequence< B... > sequence )
+{
+   __m128i blocks[ sizeof...( B ) ] = { _mm_loadu_si128( reinterpret_cast< const __m128i* >( input ) + B )... };
+
+   rounds< Decrypting >( blocks, keys, sequence );
+   ( _mm_storeu_si128( reinterpret_cast< __m128i* >( output ) + B, blocks[ B ] ), ... );
+}
+
+/**
+ * Decrypts a group of CBC blocks, every block XORed with the ciphertext before it.
+ *
+ * @return The last ciphertext block, the chain of the next group.
+ */
+template< size_t... B >
+AESNI_TARGET static inline __m128i cbc( const __m128i* keys, __m128i chain, const unsigned char* input, unsigned char* output,
+                                        std::index_sequence< B... > sequence )
+{
+   __m128i ciphers[ sizeof...( B ) ] = { _mm_loadu_si128( reinterpret_cast< const __m128i* >( input ) + B )... };
+   __m128i blocks[ sizeof...( B ) ]  = { ciphers[ B ]... };
+
+   rounds< true >( blocks, keys, sequence );
+   ( _mm_storeu_si128( reinterpret_cast< __m128i* >( output ) + B,
+                       _mm_xor_si128( blocks[ B ], ( B == 0 ) ? chain : ciphers[ ( B == 0 ) ? 0 : B - 1 ] ) ), ... );
+
+   return( ciphers[ sizeof...( B ) - 1 ] );
+}
+
+/**
+ * Encrypts a group of counter blocks and XORs them into the input. The counter is a little-endian 128-bit
+ * integer whose low half does not carry within the group, so every block is one add and one byte reversal.
+ */
+template< size_t... B >
+AESNI_TARGET static inline void ctr( const __m128i* keys, __m128i counter, const unsigned char* input, unsigned char* output,
+                                     std::index_sequence< B... > sequence )
+{
+   __m128i reverse                  = reversal( );
+   __m128i blocks[ sizeof...( B ) ] = { _mm_shuffle_epi8( _mm_add_epi64( counter, _mm_set_epi64x( 0, B ) ), reverse )... };
+
+   rounds< false >( blocks, keys, sequence );
+   ( _mm_storeu_si128( reinterpret_cast< __m128i* >( output ) + B,
+                       _mm_xor_si128( blocks[ B ], _mm_loadu_si128( reinterpret_cast< const __m128i* >( input ) + B ) ) ), ... );
+}
+
+/**
+ * Runs ECB over whole blocks, Width blocks at a time.
+ */
+template< bool Decrypting >
+AESNI_TARGET static void narrowECB( const __m128i* keys, const unsigned char* input, unsigned char* output, size_t blocks )
+{
+   size_t block = 0;
+
+   for( ; block + AESNI::Width <= blocks; block += AESNI::Width )
+   {
+      ecb< Decrypting >( keys, input + 16 * block, output + 16 * block, std::make_index_sequence< AESNI::Width >( ) );
+   }
+   for( ; block < blocks; block++ )
+   {
+      ecb< Decrypting >( keys, input + 16 * block, output + 16 * block, std::make_index_sequence< 1 >( ) );
+   }
+}
+
+/**
+ * Encrypts whole CBC blocks one after the other.
+ */
+AESNI_TARGET static void narrowEncryptCBC( const __m128i* keys, unsigned char* chain, const unsigned char* input,
+                                           unsigned char* output, size_t blocks )
+{
+   __m128i state = _mm_loadu_si128( reinterpret_cast< const __m128i* >( chain ) );
+
+   for( size_t block = 0; block < blocks; block++ )
+   {
+      state = _mm_xor_si128( state, _mm_loadu_si128( reinterpret_cast< const __m128i* >( input ) + block ) );
+      rounds< false >( &state, keys, std::make_index_sequence< 1 >( ) );
+      _mm_storeu_si128( reinterpret_cast< __m128i* >( output ) + block, state );
+   }
+   _mm_storeu_si128( reinterpret_cast< __m128i* >( chain ), state );
+}
+
+/**
+ * Decrypts whole CBC blocks, Width blocks at a time.
+ */
+AESNI_TARGET static void narrowDecryptCBC( const __m128i* keys, unsigned char* chain, const unsigned char* input,
+                                           unsigned char* output, size_t blocks )
+{
+   __m128i state = _mm_loadu_si128( reinterpret_cast< const __m128i* >( chain ) );
+   size_t  block = 0;
+
+   for( ; block + AESNI::Width <= blocks; block += AESNI::Width )
+   {
+      state = cbc( keys, state, input + 16 * block, output + 16 * block, std::make_index_sequence< AESNI::Width >( ) );
+   }
+   for( ; block < blocks; block++ )
+   {
+      state = cbc( keys, state, input + 16 * block, output + 16 * block, std::make_index_sequence< 1 >( ) );
+   }
+   _mm_storeu_si128( reinterpret_cast< __m128i* >( chain ), state );
+}
+
+/**
+ * Runs CTR over any length, Width blocks at a time, the partial last block through a padded copy. The
+ * blocks around a carry out of the low half of the counter run one at a time.
+ */
+AESNI_TARGET static void narrowCTR( const __m128i* keys, unsigned char* counter, const unsigned char* input, unsigned char* output,
+                                    size_t length )
+{
+   uint64_t high   = loadBig( counter );
+   uint64_t low    = loadBig( counter + 8 );
+   size_t   blocks = length / 16;
+   size_t   tail   = length % 16;
+   size_t   block  = 0;
+
+   while( block < blocks )
+   {
+      __m128i counted = _mm_set_epi64x( static_cast< long long >( high ), static_cast< long long >( low ) );
+
+      if( ( block + AESNI::Width <= blocks ) && ( low <= UINT64_MAX - AESNI::Width ) )
+      {
+         ctr( keys, counted, input + 16 * block, output + 16 * block, std::make_index_sequence< AESNI::Width >( ) );
+         low   += AESNI::Width;
+         block += AESNI::Width;
+      }
+      else
+      {
+         ctr( keys, counted, input + 16 * block, output + 16 * block, std::make_index_sequence< 1 >( ) );
+         low   += 1;
+         high  += ( low == 0 ) ? 1 : 0;
+         block += 1;
+      }
+   }
+   if( tail > 0 )
+   {
+      unsigned char last[ 16 ] = { };
+
+      std::memcpy( last, input + 16 * blocks, tail );
+      ctr( keys, _mm_set_epi64x( static_cast< long long >( high ), static_cast< long long >( low ) ), last, last,
+           std::make_index_sequence< 1 >( ) );
+      std::memcpy( output + 16 * blocks, last, tail );
+      low  += 1;
+      high += ( low == 0 ) ? 1 : 0;
+   }
+   storeBig( high, counter );
+   storeBig( low, counter + 8 );
+}
+
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"   // The AVX-512 headers of GCC 12 self-initialise undefined vectors
+#endif
+/**
+ * Runs every round across all vectors of four blocks before the next round, the round key broadcast to
+ * the four lanes of a vector.
+ */
+template< bool Decrypting, size_t... V >
+VAES_TARGET static inline void roundsWide( __m512i* blocks, const __m128i* keys, std::index_sequence< V... > )
+{
+   __m512i key = _mm512_broadcast_i32x4( _mm_loadu_si128( &keys[ 0 ] ) );
+
+   ( ( blocks[ V ] = _mm512_xor_si512( blocks[ V ], key ) ), ... );
+   for( int round = 1; round < AESNI::Rounds; round++ )
+   {
+      key = _mm512_broadcast_i32x4( _mm_loadu_si128( &keys[ round ] ) );
+      if constexpr( Decrypting )
+      {
+         ( ( blocks[ V ] = _mm512_aesdec_epi128( blocks[ V ], key ) ), ... );
+      }
+      else
+      {
+         ( ( blocks[ V ] = _mm512_aesenc_epi128( blocks[ V ], key ) ), ... );
+      }
+   }
+   key = _mm512_broadcast_i32x4( _mm_loadu_si128( &keys[ AESNI::Rounds ] ) );
+   if constexpr( Decrypting )
+   {
+      ( ( blocks[ V ] = _mm512_aesdeclast_epi128( blocks[ V ], key ) ), ... );
+   }
+   else
+   {
+      ( ( blocks[ V ] = _mm512_aesenclast_epi128( blocks[ V ], key ) ), ... );
+   }
+}
+
+/**
+ * Encrypts or decrypts a group of ECB vectors.
+ */
+template< bool Decrypting, size_t... V >
+VAES_TARGET static inline void ecbWide( const __m128i* keys, const unsigned char* input, unsigned char* output,
+                                        std::index_sequence< V... > sequence )
+{
+   __m512i blocks[ sizeof...( V ) ] = { _mm512_loadu_si512( input + 64 * V )... };
+
+   roundsWide< Decrypting >( blocks, keys, sequence );
+   ( _mm512_storeu_si512( output + 64 * V, blocks[ V ] ), ... );
+}
+
+/**
+ * Decrypts a group of CBC vectors. The ciphertext before every block is the vector shifted up by one
+ * block, with the top block of the previous vector, or the chain, shifted in.
+ *
+ * @return The last ciphertext block, the chain of the next group.
+ */
+template< size_t... V >
+VAES_TARGET static inline __m128i cbcWide( const __m128i* keys, __m128i chain, const unsigned char* input, unsigned char* output,
+                                           std::index_sequence< V... > sequence )
+{
+   __m512i ciphers[ sizeof...( V ) ] = { _mm512_loadu_si512( input + 64 * V )... };
+   __m512i blocks[ sizeof...( V ) ]  = { ciphers[ V ]... };
+   __m512i first                     = _mm512_broadcast_i32x4( chain );
+
+   roundsWide< true >( blocks, keys, sequence );
+   ( _mm512_storeu_si512( output + 64 * V,
+                          _mm512_xor_si512( blocks[ V ], _mm512_alignr_epi64( ciphers[ V ], ( V == 0 ) ? first : ciphers[ ( V == 0 ) ? 0 : V - 1 ], 6 ) ) ),
+     ... );
+
+   return( _mm512_extracti32x4_epi32( ciphers[ sizeof...( V ) - 1 ], 3 ) );
+}
+
+/**
+ * Encrypts a group of vectors of counter blocks and XORs them into the input, the counter as in ctr.
+ */
+template< size_t... V >
+VAES_TARGET static inline void ctrWide( const __m128i* keys, __m128i counter, const unsigned char* input, unsigned char* output,
+                                        std::index_sequence< V... > sequence )
+{
+   __m512i base                     = _mm512_broadcast_i32x4( counter );
+   __m512i reverse                  = _mm512_broadcast_i32x4( reversal( ) );
+   __m512i blocks[ sizeof...( V ) ] =
+   {
+      _mm512_shuffle_epi8( _mm512_add_epi64( base, _mm512_set_epi64( 0, 4 * V + 3, 0, 4 * V + 2, 0, 4 * V + 1, 0, 4 * V ) ), reverse )...
+   };
+
+   roundsWide< false >( blocks, keys, sequence );
+   ( _mm512_storeu_si512( output + 64 * V, _mm512_xor_si512( blocks[ V ], _mm512_loadu_si512( input + 64 * V ) ) ), ... );
+}
+
+/**
+ * Runs ECB over the leading multiple of Wide blocks.
+ *
+ * @return Blocks done, the rest is left to the AES-NI kernel.
+ */
+template< bool Decrypting >
+VAES_TARGET static size_t wideECB( const __m128i* keys, const unsigned char* input, unsigned char* output, size_t blocks )
+{
+   size_t block = 0;
+
+   for( ; block + AESNI::Wide <= blocks; block += AESNI::Wide )
+   {
+      ecbWide< Decrypting >( keys, input + 16 * block, output + 16 * block, std::make_index_sequence< AESNI::Wide / 4 >( ) );
+   }
+
+   return( block );
+}
+
+/**
+ * Decrypts the leading multiple of Wide CBC blocks, advancing the chain in place.
+ *
+ * @return Blocks done, the rest is left to the AES-NI kernel.
+ */
+VAES_TARGET static size_t wideDecryptCBC( const __m128i* keys, unsigned char* chain, const unsigned char* input,
+                                          unsigned char* output, size_t blocks )
+{
+   __m128i state = _mm_loadu_si128( reinterpret_cast< const __m128i* >( chain ) );
+   size_t  block = 0;
+
+   for( ; block + AESNI::Wide <= blocks; block += AESNI::Wide )
+   {
+      state = cbcWide( keys, state, input + 16 * block, output + 16 * block, std::make_index_sequence< AESNI::Wide / 4 >( ) );
+   }
+   _mm_storeu_si128( reinterpret_cast< __m128i* >( chain ), state );
+
+   return( block );
+}
+
+/**
+ * Runs CTR over the leading multiple of Wide blocks up to a carry out of the low half of the counter,
+ * advancing the counter in place.
+ *
+ * @return Blocks done, the rest is left to the AES-NI kernel.
+ */
+VAES_TARGET static size_t wideCTR( const __m128i* keys, unsigned char* counter, const unsigned char* input, unsigned char* output,
+                                   size_t blocks )
+{
+   uint64_t high  = loadBig( counter );
+   uint64_t low   = loadBig( counter + 8 );
+   size_t   block = 0;
+
+   for( ; ( block + AESNI::Wide <= blocks ) && ( low <= UINT64_MAX - AESNI::Wide ); block += AESNI::Wide )
+   {
+      ctrWide( keys, _mm_set_epi64x( static_cast< long long >( high ), static_cast< long long >( low ) ), input + 16 * block,
+               output + 16 * block, std::make_index_sequence< AESNI::Wide / 4 >( ) );
+      low += AESNI::Wide;
+   }
+   storeBig( high, counter );
+   storeBig( low, counter + 8 );
+
+   return( block );
+}
+
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic pop
+#endif
+
+/**
+ * Returns the shuffle reversing the bytes of a block, a little-endian counter into a big-endian one.
+ */
+AESNI_TARGET static inline __m128i reversal( void )
+{
+   return( _mm_set_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 ) );
+}
+
+/**
+ * Reads a big-endian 64-bit half of a counter block.
+ */
+static inline uint64_t loadBig( const unsigned char* bytes )
+{
+   uint64_t value;
+
+   std::memcpy( &value, bytes, sizeof( value ) );
+
+   return( swap( value ) );
+}
+
+/**
+ * Writes a big-endian 64-bit half of a counter block.
+ */
+static inline void storeBig( uint64_t value, unsigned char* bytes )
+{
+   value = swap( value );
+   std::memcpy( bytes, &value, sizeof( value ) );
+}
+
+/**
+ * Reverses the bytes of a 64-bit value, x86 is little-endian.
+ */
+static inline uint64_t swap( uint64_t value )
+{
+#if defined( _MSC_VER )
+   return( _byteswap_uint64( value ) );
+#else
+   return( __builtin_bswap64( value ) );
+#endif
+}
+
+/**
+ * Reads the AES instructions from CPUID: AES-NI and SSSE3 in leaf 1, AVX-512F, AVX-512BW, and VAES in leaf
+ * 7, and whether the operating system saves the AVX-512 state (XCR0 bits 1, 2, and 5 to 7).
+ */
+static AESNI::Level probe( void )
+{
+   unsigned int features   = 0;
+   unsigned int extended   = 0;
+   unsigned int extensions = 0;
+   uint64_t     saved      = 0;
+
+#if defined( _MSC_VER )
+   int info[ 4 ];
+
+   __cpuid( info, 0 );
+   if( info[ 0 ] >= 7 )
+   {
+      __cpuidex( info, 7, 0 );
+      extended   = static_cast< unsigned int >( info[ 1 ] );
+      extensions = static_cast< unsigned int >( info[ 2 ] );
+   }
+   __cpuid( info, 1 );
+   features = static_cast< unsigned int >( info[ 2 ] );
+   if( ( features & ( 1u << 27 ) ) != 0 )
+   {
+      saved = _xgetbv( 0 );
+   }
+#else
+   unsigned int eax, ebx, ecx, edx;
+
+   if( __get_cpuid( 1, &eax, &ebx, &ecx, &edx ) != 0 )
+   {
+      features = ecx;
+   }
+   if( __get_cpuid_count( 7, 0, &eax, &ebx, &ecx, &edx ) != 0 )
+   {
+      extended   = ebx;
+      extensions = ecx;
+   }
+   if( ( features & ( 1u << 27 ) ) != 0 )
+   {
+      __asm__( "xgetbv" : "=a"( eax ), "=d"( edx ) : "c"( 0 ) );
+      saved = ( static_cast< uint64_t >( edx ) << 32 ) | eax;
+   }
+#endif
+
+   if( ( ( features & ( 1u << 25 ) ) == 0 ) || ( ( features & ( 1u << 9 ) ) == 0 ) )
+   {
+      return( AESNI::Level::None );
+   }
+   if( ( ( extended & ( 1u << 16 ) ) != 0 ) && ( ( extended & ( 1u << 30 ) ) != 0 ) && ( ( extensions & ( 1u << 9 ) ) != 0 ) &&
+       ( ( saved & 0xE6 ) == 0xE6 ) )
+   {
+      return( AESNI::Level::VAES );
+   }
+
+   return( AESNI::Level::AESNI );
+}
+#else
+void AESNI::Expand( const unsigned char*, Schedule& schedule )
+{
+   std::memset( schedule.keys, 0, sizeof( schedule.keys ) );
+}
+
+void AESNI::Invert( const Schedule&, Schedule& inverse )
+{
+   std::memset( inverse.keys, 0, sizeof( inverse.keys ) );
+}
+
+void AESNI::EncryptLanes( Lane*, int, int )
+{
+}
+
+void AESNI::EncryptECB( const Schedule&, const unsigned char*, unsigned char*, size_t )
+{
+}
+
+void AESNI::DecryptECB( const Schedule&, const unsigned char*, unsigned char*, size_t )
+{
+}
+
+void AESNI::EncryptCBC( const Schedule&, unsigned char*, const unsigned char*, unsigned char*, size_t )
+{
+}
+
+void AESNI::DecryptCBC( const Schedule&, unsigned char*, const unsigned char*, unsigned char*, size_t )
+{
+}
+
+void AESNI::CTR( const Schedule&, unsigned char*, const unsigned char*, unsigned char*, size_t )
+{
+}
+#endif
+
+/**
+ * Returns the selected kernels, the detected level until Select is called.
+ */
+static std::atomic< AESNI::Level >& selection( void )
+{
+   static std::atomic< AESNI::Level > selected( AESNI::Detect( ) );
+
+   return( selected );
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+// StdLib Includes
+#include <cstddef>
+
+namespace SecureMigration
+{
+   namespace AESNI
+   {
+      const int Rounds = 14;   ///< Rounds of AES-256
+      const int Lanes  = 8;    ///< Streams interleaved by the multi-buffer kernel
+      const int Width  = 8;    ///< Blocks of a stream interleaved by the AES-NI kernels
+      const int Wide   = 32;   ///< Blocks of a stream interleaved by the VAES kernels, four per register
+
+      /// Widest AES instructions of the kernels
+      enum class Level
+      {
+         None,    ///< No AES instructions, the kernels must not be called
+         AESNI,   ///< AES-NI on one block per instruction
+         VAES     ///< VAES with AVX-512F and AVX-512BW on four blocks per instruction
+      };
+
+      /// Expanded AES-256 key, for encryption or inverted for decryption
+      struct Schedule
+      {
+         unsigned char keys[ Rounds + 1 ][ 16 ];   ///< Round keys
+      };
+
+      /// Stream of a multi-buffer call, advanced in place by every call
+      struct Lane
+      {
+         const Schedule*      schedule;      ///< Key of the stream
+         bool                 chained;       ///< CBC when true, ECB otherwise
+         unsigned char        chain[ 16 ];   ///< IV, then the last ciphertext block
+         const unsigned char* input;         ///< Next input block
+         unsigned char*       output;        ///< Next output block
+      };
+
+      Level       Detect( void );
+      void        Select( Level level );
+      Level       Selected( void );
+      const char* Name( Level level );
+      bool        Available( void );
+
+      void Expand( const unsigned char* key, Schedule& schedule );
+      void Invert( const Schedule& schedule, Schedule& inverse );
+      void EncryptLanes( Lane* lanes, int count, int blocks );
+
+      void EncryptECB( const Schedule& schedule, const unsigned char* input, unsigned char* output, size_t blocks );
+      void DecryptECB( const Schedule& inverse, const unsigned char* input, unsigned char* output, size_t blocks );
+      void EncryptCBC( const Schedule& schedule, unsigned char* chain, const unsigned char* input, unsigned char* output,
+                       size_t blocks );
+      void DecryptCBC( const Schedule& inverse, unsigned char* chain, const unsigned char* input, unsigned char* output,
+                       size_t blocks );
+      void CTR( const Schedule& schedule, unsigned char* counter, const unsigned char* input, unsigned char* output,
+                size_t length );
+   }
+}
@@ -0,0 +1,185 @@
+/**
+ * @file
+ * @brief Chunked zlib compression stage applied ahead of the bulk cipher.
+ *
+ * @details
+ * The plaintext is split into fixed size chunks which are compressed independently so that the work
+ * can be spread across all cores. Each chunk is framed by an 8 byte header:
+ * @verbatim
+   +----------------------+----------------------+------------------+
+   | Raw Length (32 bit)  | Stored Length (32)   | Stored Bytes ... |
+   +----------------------+----------------------+------------------+
+   @endverbatim
+ * Both lengths are big endian. When compression does not shrink a chunk it is stored verbatim and the
+ * most significant bit of the stored length is set.
+ */
+// Application Includes
+#include <Compression.h>
+#include <Utility.h>
+#include <Progress.h>
+
+// zlib Includes
+#include <zlib.h>
+
+// StdLib Includes
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+using namespace SecureMigration;
+
+static const int          HeaderLen = 8;
+static const unsigned int StoredRaw = 0x80000000u;
+
+
+/**
+ * Returns the worst case length of the compressed framing.
+ *
+ * @return Bytes of the framing, or a negative value when the chunk size or length is invalid.
+ */
+int Compression::Bound( int pLen, int chunkSize )
+{
+   if( ( chunkSize <= 0 ) || ( pLen < 0 ) )
+   {
+      return( -1 );
+   }
+
+   return( ( ( pLen + chunkSize - 1 ) / chunkSize ) * ( HeaderLen + static_cast< int >( compressBound( chunkSize ) ) ) );
+}
+
+int Compression::Compress( const unsigned char* plaintext, int pLen, unsigned char* compressed, int cMax,
+                           int chunkSize, int level )
+{
+   int                status = 0;
+   int                chunks;
+   int                slot;
+   std::atomic< int > failed( 0 );
+
+   /// @par Process Design Language
+   /// -# Verify the output buffer can hold the worst case framing
+   if( ( chunkSize <= 0 ) || ( pLen < 0 ) || ( cMax < Bound( pLen, chunkSize ) ) )
+   {
+      status = -1;
+   }
+   else
+   {
+      chunks = ( pLen + chunkSize - 1 ) / chunkSize;
+      slot   = HeaderLen + static_cast< int >( compressBound( chunkSize ) );
+
+      /// -# Compress every chunk in parallel into its own worst case slot of the output buffer
+      Utility::ParallelFor( chunks, [ & ]( int chunk )
+      {
+         const unsigned char* src    = plaintext + static_cast< size_t >( chunk ) * chunkSize;
+         unsigned char*       dst    = compressed + static_cast< size_t >( chunk ) * slot;
+         uLong                rawLen = static_cast< uLong >( std::min( chunkSize, pLen - chunk * chunkSize ) );
+         uLongf               dstLen = static_cast< uLongf >( slot - HeaderLen );
+
+         if( compress2( dst + HeaderLen, &dstLen, src, rawLen, level ) != Z_OK )
+         {
+            failed = 1;
+         }
+         /// -# Store the chunk verbatim when compression does not reduce its size
+         else if( dstLen >= rawLen )
+         {
+            std::memcpy( dst + HeaderLen, src, rawLen );
+            Utility::WriteU32( dst, static_cast< unsigned int >( rawLen ) );
+            Utility::WriteU32( dst + 4, static_cast< unsigned int >( rawLen ) | StoredRaw );
+         }
+         else
+         {
+            Utility::WriteU32( dst, static_cast< unsigned int >( rawLen ) );
+            Utility::WriteU32( dst + 4, static_cast< unsigned int >( dstLen ) );
+         }
+         Progress::Advance( static_cast< long long >( rawLen ) );
+      } );
+
+      /// -# Compact the chunks so they are contiguous
+      if( failed != 0 )
+      {
+         status = -2;
+      }
+      else
+      {
+         for( int chunk = 0; chunk < chunks; chunk++ )
+         {
+            unsigned char* src = compressed + static_cast< size_t >( chunk ) * slot;
+            int            len = HeaderLen + static_cast< int >( Utility::ReadU32( src + 4 ) & ~StoredRaw );
+
+            std::memmove( compressed + status, src, len );
+            status += len;
+         }
+      }
+   }
+
+   return( status );
+}
+
+int Compression::Decompress( const unsigned char* compressed, int cLen, unsigned char* plaintext, int pMax, int chunkSize )
+{
+   int                status = 0;
+   int                offset = 0;
+   std::vector< int > source;
+   std::vector< int > target;
+   std::atomic< int > failed( 0 );
+
+   /// @par Process Design Language
+   /// -# Walk the chunk headers to locate every chunk in the input and output buffers, rejecting a chunk
+   ///    larger than the chunk size and a verbatim chunk whose lengths differ
+   while( ( status >= 0 ) && ( offset < cLen ) )
+   {
+      if( ( cLen - offset ) < HeaderLen )
+      {
+         status = -1;
+      }
+      else
+      {
+         int  rawLen    = static_cast< int >( Utility::ReadU32( compressed + offset ) );
+         int  storedLen = static_cast< int >( Utility::ReadU32( compressed + offset + 4 ) & ~StoredRaw );
+         bool raw       = ( Utility::ReadU32( compressed + offset + 4 ) & StoredRaw ) != 0;
+
+         if( ( rawLen < 0 ) || ( rawLen > chunkSize ) || ( storedLen > ( cLen - offset - HeaderLen ) ) ||
+             ( rawLen > ( pMax - status ) ) || ( raw && ( storedLen != rawLen ) ) )
+         {
+            status = -1;
+         }
+         else
+         {
+            source.push_back( offset );
+            target.push_back( status );
+            offset += HeaderLen + storedLen;
+            status += rawLen;
+         }
+      }
+   }
+
+   /// -# Decompress every chunk in parallel directly into its place in the output buffer
+   if( status >= 0 )
+   {
+      Utility::ParallelFor( static_cast< int >( source.size( ) ), [ & ]( int chunk )
+      {
+         const unsigned char* src       = compressed + source[ chunk ];
+         unsigned int         rawLen    = Utility::ReadU32( src );
+         unsigned int         storedLen = Utility::ReadU32( src + 4 );
+         uLongf               dstLen    = static_cast< uLongf >( rawLen );
+
+         if( ( storedLen & StoredRaw ) != 0 )
+         {
+            std::memcpy( plaintext + target[ chunk ], src + HeaderLen, rawLen );
+         }
+         else if( ( uncompress( plaintext + target[ chunk ], &dstLen, src + HeaderLen, storedLen ) != Z_OK ) ||
+                  ( dstLen != rawLen ) )
+         {
+            failed = 1;
+         }
+         Progress::Advance( rawLen );
+      } );
+
+      if( failed != 0 )
+      {
+         status = -2;
+      }
+   }
+
+   return( status );
+}
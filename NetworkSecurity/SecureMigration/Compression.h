@@ -0,0 +1,15 @@
+#pragma once
+
+namespace SecureMigration
+{
+   namespace Compression
+   {
+      const int ChunkSizeDef = 256 * 1024;   ///< Default uncompressed bytes per chunk
+      const int LevelDef     = 6;            ///< Default zlib compression level
+
+      int Bound( int pLen, int chunkSize );
+      int Compress( const unsigned char* plaintext, int pLen, unsigned char* compressed, int cMax,
+                    int chunkSize, int level );
+      int Decompress( const unsigned char* compressed, int cLen, unsigned char* plaintext, int pMax, int chunkSize );
+   }
+}
@@ -0,0 +1,309 @@
+/**
+ * @file
+ * @brief Content-defined chunking and chunk level deduplication ahead of the bulk cipher.
+ *
+ * @details
+ * Bob splits an object into content-defined chunks, looks the SHA-256 digest of every chunk up in
+ * Carol's chunk index, and packs the object into a stream of records:
+ * @verbatim
+   +------------+-------------------+----------------------+-----------------+
+   | Tag (8)    | SHA-256 (256)     | Length (32, Data)    | Bytes (Data)    |
+   +------------+-------------------+----------------------+-----------------+
+   @endverbatim
+ * A reference record carries only the tag and the digest of a chunk Carol already holds, or one that
+ * appeared earlier in the same object. Carol verifies the digest of every data record, adds it to her
+ * index, and resolves references from the index while reassembling the object.
+ */
+// Application Includes
+#include <Deduplication.h>
+#include <Provider.h>
+#include <Utility.h>
+
+// OpenSSL Includes
+#include <openssl/evp.h>
+
+// StdLib Includes
+#include <cstring>
+#include <unordered_set>
+
+using namespace SecureMigration;
+using namespace SecureMigration::Deduplication;
+
+static const unsigned char TagData      = 0;
+static const unsigned char TagReference = 1;
+static const int           RecordLen    = 1 + DigestLen;
+
+static const unsigned long long* gearTable( void );
+static unsigned long long        mask( int bits );
+
+Chunker::Chunker( int average )
+{
+   int bits = 0;
+
+   /// @par Process Design Language
+   /// -# Bound the chunk sizes around the requested average, every chunk at least one byte
+   this->average = average;
+   this->minimum = ( average >= 4 ) ? average / 4 : 1;
+   this->maximum = average * 8;
+
+   /// -# Normalize the chunk size distribution by requiring 2 more bits before and 2 fewer after the average
+   while( ( 1 << ( bits + 1 ) ) <= average )
+   {
+      bits++;
+   }
+   this->maskS = mask( bits + 2 );
+   this->maskL = mask( bits - 2 );
+}
+
+int Chunker::Cut( const unsigned char* data, int length ) const
+{
+   const unsigned long long* gear   = gearTable( );
+   unsigned long long        hash   = 0;
+   int                       limit  = ( length < this->maximum ) ? length : this->maximum;
+   int                       normal = ( limit < this->average ) ? limit : this->average;
+   int                       index  = this->minimum;
+
+   /// @par Process Design Language
+   /// -# Chunks shorter than the minimum are never cut
+   if( length <= this->minimum )
+   {
+      index = length;
+   }
+   else
+   {
+      /// -# Search for a cut point with the stricter mask until the average size is reached
+      for( ; index < normal; index++ )
+      {
+         hash = ( hash << 1 ) + gear[ data[ index ] ];
+         if( ( hash & this->maskS ) == 0 )
+         {
+            return( index + 1 );
+         }
+      }
+
+      /// -# Search for a cut point with the looser mask until the maximum size is reached
+      for( ; index < limit; index++ )
+      {
+         hash = ( hash << 1 ) + gear[ data[ index ] ];
+         if( ( hash & this->maskL ) == 0 )
+         {
+            return( index + 1 );
+         }
+      }
+   }
+
+   return( index );
+}
+
+int Chunker::Minimum( void ) const
+{
+   return( this->minimum );
+}
+
+ChunkIndex::ChunkIndex( void )
+{
+   this->bytes = 0;
+}
+
+bool ChunkIndex::Contains( const unsigned char* digest ) const
+{
+   return( this->Find( digest ) != nullptr );
+}
+
+const std::vector< unsigned char >* ChunkIndex::Find( const unsigned char* digest ) const
+{
+   auto entry = this->chunks.find( std::string( reinterpret_cast< const char* >( digest ), DigestLen ) );
+
+   return( ( entry == this->chunks.end( ) ) ? nullptr : &entry->second );
+}
+
+void ChunkIndex::Insert( const unsigned char* digest, const unsigned char* data, int length )
+{
+   auto result = this->chunks.emplace( std::string( reinterpret_cast< const char* >( digest ), DigestLen ),
+                                       std::vector< unsigned char >( data, data + length ) );
+
+   if( result.second )
+   {
+      this->bytes += length;
+   }
+}
+
+void ChunkIndex::Clear( void )
+{
+   this->chunks.clear( );
+   this->bytes = 0;
+}
+
+size_t ChunkIndex::Count( void ) const
+{
+   return( this->chunks.size( ) );
+}
+
+long long ChunkIndex::Bytes( void ) const
+{
+   return( this->bytes );
+}
+
+int Deduplication::PackBound( int size, const Chunker& chunker )
+{
+   return( size + ( ( size / chunker.Minimum( ) ) + 1 ) * ( RecordLen + 4 ) );
+}
+
+int Deduplication::Pack( const unsigned char* plaintext, int size, const Chunker& chunker, const ChunkIndex& remote,
+                         unsigned char* packed, int max, Stats& stats )
+{
+   int                                status = 0;
+   std::vector< int >                 offsets;
+   std::vector< unsigned char >       digests;
+   std::unordered_set< std::string >  sent;
+
+   /// @par Process Design Language
+   /// -# Split the object into content-defined chunks
+   for( int offset = 0; offset < size; offset += chunker.Cut( plaintext + offset, size - offset ) )
+   {
+      offsets.push_back( offset );
+   }
+   offsets.push_back( size );
+
+   /// -# Hash every chunk in parallel
+   digests.resize( ( offsets.size( ) - 1 ) * DigestLen );
+   Utility::ParallelFor( static_cast< int >( offsets.size( ) - 1 ), [ & ]( int chunk )
+   {
+      ( void )EVP_Digest( plaintext + offsets[ chunk ], offsets[ chunk + 1 ] - offsets[ chunk ],
+                          &digests[ static_cast< size_t >( chunk ) * DigestLen ], NULL, Provider::SHA256( ), NULL );
+   } );
+
+   stats.chunks     = static_cast< int >( offsets.size( ) - 1 );
+   stats.duplicates = 0;
+   stats.logical    = size;
+   stats.unique     = 0;
+
+   /// -# Send a reference for every chunk Carol already holds or which was already sent, otherwise the data
+   if( max < PackBound( size, chunker ) )
+   {
+      status = -1;
+   }
+   else
+   {
+      for( int chunk = 0; chunk < stats.chunks; chunk++ )
+      {
+         const unsigned char* digest = &digests[ static_cast< size_t >( chunk ) * DigestLen ];
+         int                  length = offsets[ chunk + 1 ] - offsets[ chunk ];
+
+         std::memcpy( packed + status + 1, digest, DigestLen );
+         if( remote.Contains( digest ) ||
+             !sent.insert( std::string( reinterpret_cast< const char* >( digest ), DigestLen ) ).second )
+         {
+            packed[ status ] = TagReference;
+            status          += RecordLen;
+            stats.duplicates++;
+         }
+         else
+         {
+            packed[ status ] = TagData;
+            Utility::WriteU32( packed + status + RecordLen, static_cast< unsigned int >( length ) );
+            std::memcpy( packed + status + RecordLen + 4, plaintext + offsets[ chunk ], length );
+            status       += RecordLen + 4 + length;
+            stats.unique += length;
+         }
+      }
+   }
+
+   stats.packed = status;
+
+   return( status );
+}
+
+int Deduplication::Unpack( const unsigned char* packed, int length, ChunkIndex& index, unsigned char* plaintext, int max )
+{
+   int           status = 0;
+   int           offset = 0;
+   unsigned char digest[ DigestLen ];
+
+   /// @par Process Design Language
+   /// -# Walk the records, reassembling the object
+   while( ( status >= 0 ) && ( offset < length ) )
+   {
+      if( ( length - offset ) < RecordLen )
+      {
+         status = -1;
+      }
+      /// -# Resolve references from the chunk index
+      else if( packed[ offset ] == TagReference )
+      {
+         const std::vector< unsigned char >* chunk = index.Find( packed + offset + 1 );
+
+         if( ( chunk == nullptr ) || ( static_cast< int >( chunk->size( ) ) > ( max - status ) ) )
+         {
+            status = -2;
+         }
+         else
+         {
+            std::memcpy( plaintext + status, chunk->data( ), chunk->size( ) );
+            status += static_cast< int >( chunk->size( ) );
+            offset += RecordLen;
+         }
+      }
+      /// -# Verify the digest of new chunks and add them to the chunk index
+      else if( ( length - offset ) < ( RecordLen + 4 ) )
+      {
+         status = -1;
+      }
+      else
+      {
+         int size = static_cast< int >( Utility::ReadU32( packed + offset + RecordLen ) );
+
+         if( ( size < 0 ) || ( size > ( length - offset - RecordLen - 4 ) ) || ( size > ( max - status ) ) )
+         {
+            status = -1;
+         }
+         else if( ( EVP_Digest( packed + offset + RecordLen + 4, size, digest, NULL, Provider::SHA256( ), NULL ) != 1 ) ||
+                  ( std::memcmp( digest, packed + offset + 1, DigestLen ) != 0 ) )
+         {
+            status = -3;
+         }
+         else
+         {
+            std::memcpy( plaintext + status, packed + offset + RecordLen + 4, size );
+            index.Insert( digest, plaintext + status, size );
+            status += size;
+            offset += RecordLen + 4 + size;
+         }
+      }
+   }
+
+   return( status );
+}
+
+/**
+ * Returns the Gear table of 256 pseudo random 64-bit values, generated once with SplitMix64 so that
+ * every site computes identical cut points.
+ */
+static const unsigned long long* gearTable( void )
+{
+   static const std::vector< unsigned long long > table = [ ]( void )
+   {
+      std::vector< unsigned long long > values( 256 );
+      unsigned long long                state = 0x9E3779B97F4A7C15ull;
+
+      for( unsigned long long& value : values )
+      {
+         unsigned long long z = ( state += 0x9E3779B97F4A7C15ull );
+         z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+         z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBull;
+         value = z ^ ( z >> 31 );
+      }
+
+      return( values );
+   }( );
+
+   return( table.data( ) );
+}
+
+/**
+ * Returns a mask of the most significant bits of the Gear hash, which depend on the most recent bytes.
+ */
+static unsigned long long mask( int bits )
+{
+   return( ( bits <= 0 ) ? 0 : ( ~0ull << ( 64 - bits ) ) );
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+// StdLib Includes
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SecureMigration
+{
+   namespace Deduplication
+   {
+      const int DigestLen  = 32;          ///< SHA-256 digest length identifying a chunk
+      const int AverageDef = 8 * 1024;    ///< Default average chunk size
+      const int AverageMin = 64;          ///< Smallest average chunk size accepted for a migration
+
+      /**
+       * Content-defined chunker using a Gear rolling hash with normalized chunking (FastCDC). Cut points
+       * depend only on the surrounding bytes, so an insertion only moves the boundaries next to it.
+       */
+      class Chunker
+      {
+      private:    // Private Attributes
+         int                minimum;   ///< Minimum chunk size
+         int                average;   ///< Target average chunk size
+         int                maximum;   ///< Maximum chunk size
+         unsigned long long maskS;     ///< Stricter mask used before the average size is reached
+         unsigned long long maskL;     ///< Looser mask used after the average size is reached
+
+      public:     // Public Methods
+         Chunker( int average = AverageDef );
+
+         int Cut( const unsigned char* data, int length ) const;
+         int Minimum( void ) const;
+      };
+
+      /**
+       * Index of the chunks stored at a site keyed by the SHA-256 digest of their content.
+       */
+      class ChunkIndex
+      {
+      private:    // Private Attributes
+         std::unordered_map< std::string, std::vector< unsigned char > > chunks;
+         long long                                                       bytes;
+
+      public:     // Public Methods
+         ChunkIndex( void );
+
+         bool                                Contains( const unsigned char* digest ) const;
+         const std::vector< unsigned char >* Find( const unsigned char* digest ) const;
+         void                                Insert( const unsigned char* digest, const unsigned char* data, int length );
+         void                                Clear( void );
+
+         size_t    Count( void ) const;
+         long long Bytes( void ) const;
+      };
+
+      /// Deduplication measurements of a single object
+      struct Stats
+      {
+         int       chunks;       ///< Chunks the object was split into
+         int       duplicates;   ///< Chunks sent as references
+         long long logical;      ///< Bytes of the object
+         long long unique;       ///< Bytes of chunk data sent
+         int       packed;       ///< Bytes of the packed stream including references and framing
+      };
+
+      int PackBound( int size, const Chunker& chunker );
+      int Pack( const unsigned char* plaintext, int size, const Chunker& chunker, const ChunkIndex& remote,
+                unsigned char* packed, int max, Stats& stats );
+      int Unpack( const unsigned char* packed, int length, ChunkIndex& index, unsigned char* plaintext, int max );
+   }
+}
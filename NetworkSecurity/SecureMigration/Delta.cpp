@@ -0,0 +1,287 @@
+/**
+ * @file
+ * @brief Block signature manifest for incremental migration of changed blocks.
+ *
+ * @details
+ * The manifest is stored as a binary file:
+ * @verbatim
+   +-------+---------+------------+----------+-----------+--------+----------+-----------------+----------------+
+   | SMDM  | Version | Block Size | Size     | Key       | Blocks | Versions | Digests         | Versions       |
+   | (32)  | (32)    | (32)       | (64)     | (256)     | (32)   | (32)     | (Blocks * 256)  | (Versions * 32)|
+   +-------+---------+------------+----------+-----------+--------+----------+-----------------+----------------+
+   @endverbatim
+ * All integers are big endian.
+ */
+// Application Includes
+#include <Delta.h>
+#include <Provider.h>
+#include <Utility.h>
+
+// OpenSSL Includes
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/crypto.h>
+
+// StdLib Includes
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+using namespace SecureMigration;
+using namespace SecureMigration::Delta;
+
+static const unsigned int Magic         = 0x534D444Du;   // "SMDM"
+static const unsigned int FormatVersion = 1;
+static const int          HeaderLen     = 4 + 4 + 4 + 8 + DataKeyLen + 4 + 4;
+
+Manifest::Manifest( int blockSize )
+{
+   this->blockSize = blockSize;
+   this->size      = 0;
+   this->keyed     = false;
+   std::memset( this->key, 0, sizeof( this->key ) );
+}
+
+Manifest::~Manifest( void )
+{
+   OPENSSL_cleanse( this->key, sizeof( this->key ) );
+}
+
+int Manifest::Load( const std::string& path )
+{
+   int                          status = 0;
+   std::ifstream                in( path, std::ios::in | std::ios::binary | std::ios::ate );
+   unsigned char                header[ HeaderLen ];
+   unsigned int                 blockSize;
+   long long                    size;
+   unsigned int                 blocks;
+   unsigned int                 versions;
+   long long                    length;
+
+   /// @par Process Design Language
+   /// -# Read and validate the header
+   if( !in.is_open( ) )
+   {
+      status = -1;
+   }
+   else if( ( ( length = static_cast< long long >( in.tellg( ) ) ) < HeaderLen ) || !in.seekg( 0 ) ||
+            !in.read( reinterpret_cast< char* >( header ), HeaderLen ) ||
+            ( Utility::ReadU32( header ) != Magic ) || ( Utility::ReadU32( header + 4 ) != FormatVersion ) )
+   {
+      status = -2;
+   }
+   else
+   {
+      blockSize = Utility::ReadU32( header + 8 );
+      size      = ( static_cast< long long >( Utility::ReadU32( header + 12 ) & 0x7FFFFFFFu ) << 32 ) |
+                  Utility::ReadU32( header + 16 );
+      blocks    = Utility::ReadU32( header + 20 + DataKeyLen );
+      versions  = Utility::ReadU32( header + 24 + DataKeyLen );
+
+      /// -# Reject a block size of zero, a block count which does not cover the size, and tables which do not
+      ///    fill the rest of the file exactly, before anything is allocated
+      if( ( blockSize == 0 ) || ( blockSize > 0x7FFFFFFFu ) || ( Utility::ReadU32( header + 12 ) > 0x7FFFFFFFu ) ||
+          ( static_cast< long long >( blocks ) != ( size + blockSize - 1 ) / blockSize ) ||
+          ( static_cast< long long >( blocks ) * DigestLen + static_cast< long long >( versions ) * 4 != length - HeaderLen ) )
+      {
+         blocks   = 0;
+         versions = 0;
+         status   = -3;
+      }
+
+      /// -# Read the block signatures and versions
+      this->digests.resize( static_cast< size_t >( blocks ) * DigestLen );
+      this->versions.resize( versions );
+      if( ( status != 0 ) || ( versions < blocks ) ||
+          !in.read( reinterpret_cast< char* >( this->digests.data( ) ), this->digests.size( ) ) )
+      {
+         status = -3;
+      }
+      else
+      {
+         for( unsigned int& version : this->versions )
+         {
+            unsigned char buffer[ 4 ];
+
+            if( !in.read( reinterpret_cast< char* >( buffer ), sizeof( buffer ) ) )
+            {
+               status = -3;
+               break;
+            }
+            version = Utility::ReadU32( buffer );
+         }
+      }
+
+      if( status == 0 )
+      {
+         this->blockSize = static_cast< int >( blockSize );
+         this->size      = size;
+         this->keyed     = true;
+         std::memcpy( this->key, header + 20, DataKeyLen );
+      }
+      else
+      {
+         this->digests.clear( );
+         this->versions.clear( );
+      }
+
+      OPENSSL_cleanse( header, sizeof( header ) );
+   }
+
+   return( status );
+}
+
+/**
+ * Saves the manifest to a file only its owner can read or write, since it holds the object key.
+ *
+ * @return Zero on success, otherwise a negative value.
+ */
+int Manifest::Save( const std::string& path ) const
+{
+   int                          status = 0;
+   std::FILE*                   out    = Utility::CreatePrivate( path.c_str( ) );
+   std::vector< unsigned char > buffer( HeaderLen + this->digests.size( ) + this->versions.size( ) * 4 );
+   unsigned char*               cursor = buffer.data( );
+
+   /// @par Process Design Language
+   /// -# Serialize the header, signatures and versions
+   Utility::WriteU32( cursor, Magic );
+   Utility::WriteU32( cursor + 4, FormatVersion );
+   Utility::WriteU32( cursor + 8, static_cast< unsigned int >( this->blockSize ) );
+   Utility::WriteU32( cursor + 12, static_cast< unsigned int >( this->size >> 32 ) );
+   Utility::WriteU32( cursor + 16, static_cast< unsigned int >( this->size ) );
+   std::memcpy( cursor + 20, this->key, DataKeyLen );
+   Utility::WriteU32( cursor + 20 + DataKeyLen, static_cast< unsigned int >( this->Blocks( ) ) );
+   Utility::WriteU32( cursor + 24 + DataKeyLen, static_cast< unsigned int >( this->versions.size( ) ) );
+   cursor += HeaderLen;
+
+   std::memcpy( cursor, this->digests.data( ), this->digests.size( ) );
+   cursor += this->digests.size( );
+   for( unsigned int version : this->versions )
+   {
+      Utility::WriteU32( cursor, version );
+      cursor += 4;
+   }
+
+   /// -# Write the manifest
+   if( out == NULL )
+   {
+      status = -1;
+   }
+   else
+   {
+      if( std::fwrite( buffer.data( ), 1, buffer.size( ), out ) != buffer.size( ) )
+      {
+         status = -2;
+      }
+      if( std::fclose( out ) != 0 )
+      {
+         status = -2;
+      }
+   }
+
+   OPENSSL_cleanse( buffer.data( ), HeaderLen );
+
+   return( status );
+}
+
+/**
+ * Signs every block of the new version of the object, selects the blocks whose signature changed, and
+ * assigns them a new encryption version.
+ *
+ * @return Number of changed blocks, or a negative value on error.
+ */
+int Manifest::Update( const unsigned char* data, long long size, std::vector< int >& changed )
+{
+   int                          status = 0;
+   int                          blocks = static_cast< int >( ( size + this->blockSize - 1 ) / this->blockSize );
+   std::vector< unsigned char > digests( static_cast< size_t >( blocks ) * DigestLen );
+
+   /// @par Process Design Language
+   /// -# Generate the object key on the first migration
+   if( !this->keyed )
+   {
+      if( RAND_bytes( this->key, DataKeyLen ) != 1 )
+      {
+         status = -1;
+      }
+      this->keyed = ( status == 0 );
+   }
+
+   if( status == 0 )
+   {
+      /// -# Sign every block in parallel
+      Utility::ParallelFor( blocks, [ & ]( int block )
+      {
+         long long offset = static_cast< long long >( block ) * this->blockSize;
+         size_t    length = static_cast< size_t >( std::min< long long >( this->blockSize, size - offset ) );
+
+         ( void )EVP_Digest( data + offset, length, &digests[ static_cast< size_t >( block ) * DigestLen ],
+                             NULL, Provider::SHA256( ), NULL );
+      } );
+
+      /// -# Select new blocks and blocks whose signature changed, a changed block is never encrypted
+      ///    twice with the same version even if the object shrank and grew in between
+      changed.clear( );
+      if( this->versions.size( ) < static_cast< size_t >( blocks ) )
+      {
+         this->versions.resize( blocks, 0 );
+      }
+      for( int block = 0; block < blocks; block++ )
+      {
+         if( ( block >= this->Blocks( ) ) ||
+             ( std::memcmp( &digests[ static_cast< size_t >( block ) * DigestLen ],
+                            &this->digests[ static_cast< size_t >( block ) * DigestLen ], DigestLen ) != 0 ) )
+         {
+            this->versions[ block ]++;
+            changed.push_back( block );
+         }
+      }
+
+      this->digests.swap( digests );
+      this->size = size;
+      status     = static_cast< int >( changed.size( ) );
+   }
+
+   return( status );
+}
+
+void Manifest::Counter( int block, unsigned char* counter ) const
+{
+   Manifest::Counter( block, this->versions[ block ], counter );
+}
+
+/**
+ * Builds the initial counter block of a block: block index, version, and a zero block counter.
+ */
+void Manifest::Counter( int block, unsigned int version, unsigned char* counter )
+{
+   std::memset( counter, 0, CounterLen );
+   Utility::WriteU32( counter, static_cast< unsigned int >( block ) );
+   Utility::WriteU32( counter + 4, version );
+}
+
+const unsigned char* Manifest::DataKey( void ) const
+{
+   return( this->key );
+}
+
+int Manifest::BlockSize( void ) const
+{
+   return( this->blockSize );
+}
+
+int Manifest::Blocks( void ) const
+{
+   return( static_cast< int >( this->digests.size( ) / DigestLen ) );
+}
+
+long long Manifest::Size( void ) const
+{
+   return( this->size );
+}
+
+unsigned int Manifest::Version( int block ) const
+{
+   return( this->versions[ block ] );
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+// StdLib Includes
+#include <string>
+#include <vector>
+
+namespace SecureMigration
+{
+   namespace Delta
+   {
+      const int BlockSizeDef = 64 * 1024;   ///< Default bytes per signed block
+      const int DigestLen    = 32;          ///< SHA-256 block signature length
+      const int DataKeyLen   = 32;          ///< AES-256 object key length
+      const int CounterLen   = 16;          ///< AES-CTR counter block length
+
+      /**
+       * Block signature manifest kept by Bob for each migrated object.
+       *
+       * @details
+       * Every block of the object is encrypted with AES-256-CTR under a random per-object key. The
+       * counter block of a block is built from its index and a version number which is incremented each
+       * time the block is re-encrypted, so unchanged ciphertext blocks at Carol stay valid while a
+       * changed block never reuses key stream.
+       *
+       * The manifest holds the object key, it is saved readable by its owner only and must otherwise be
+       * protected like any other key store.
+       */
+      class Manifest
+      {
+      private:    // Private Attributes
+         int                          blockSize;              ///< Bytes per block
+         long long                    size;                   ///< Bytes of the object
+         bool                         keyed;                  ///< Object key has been generated
+         unsigned char                key[ DataKeyLen ];      ///< AES-256 object key
+         std::vector< unsigned char > digests;                ///< SHA-256 signature of every block
+         std::vector< unsigned int >  versions;               ///< Encryption version of every block ever used
+
+      public:     // Public Methods
+         Manifest( int blockSize = BlockSizeDef );
+         ~Manifest( void );
+
+         int Load( const std::string& path );
+         int Save( const std::string& path ) const;
+         int Update( const unsigned char* data, long long size, std::vector< int >& changed );
+
+         void        Counter( int block, unsigned char* counter ) const;
+         static void Counter( int block, unsigned int version, unsigned char* counter );
+
+         const unsigned char* DataKey( void ) const;
+         int                  BlockSize( void ) const;
+         int                  Blocks( void ) const;
+         long long            Size( void ) const;
+         unsigned int         Version( int block ) const;
+      };
+   }
+}
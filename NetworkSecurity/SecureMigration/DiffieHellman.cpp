@@ -1,14 +1,382 @@
 #include <DiffieHellman.h>
+#include <Primes.h>
+#include <Provider.h>
+#include <Utility.h>
+#include <Trace.h>
+#include <Metrics.h>
 
 #include <openssl/pem.h>
 #include <openssl/dh.h>
+#include <openssl/evp.h>
+#include <openssl/core_names.h>
+#include <openssl/param_build.h>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 
 using namespace SecureMigration;
 using namespace SecureMigration::DiffieHellman;
 
-static DH* getDH( const Key& params );
+static const int Generator = 2;   ///< Generator of safe-prime parameters
+
+static Metrics::Histogram& keyPairLatency = Metrics::GetHistogram( "securemigration_dh_latency_seconds{operation=\"keypair\"}",
+                                                                   "Latency of Diffie-Hellman operations" );
+static Metrics::Histogram& deriveLatency  = Metrics::GetHistogram( "securemigration_dh_latency_seconds{operation=\"derive\"}",
+                                                                   "Latency of Diffie-Hellman operations" );
+static Metrics::Histogram& paramsLatency  = Metrics::GetHistogram( "securemigration_dh_latency_seconds{operation=\"params\"}",
+                                                                   "Latency of Diffie-Hellman operations" );
+static Metrics::Counter&   failures       = Metrics::GetCounter( "securemigration_failures_total{component=\"dh\"}",
+                                                                 "Failed operations by component" );
+
+static EVP_PKEY* getDH( const Key& params );
+static Key*      putDH( const EVP_PKEY* dh );
+static EVP_PKEY* makeDH( const BIGNUM* p, const BIGNUM* q, const BIGNUM* g, const BIGNUM* pub, const BIGNUM* priv );
+static int       getPQG( const EVP_PKEY* dh, BIGNUM** p, BIGNUM** q, BIGNUM** g );
+static EVP_PKEY* generateParallel( int size, unsigned int threads );
+static Key*      getKey( const BIGNUM* value );
+static int       load( const Group& group, const Key* privateKey, const Key& publicKey, BIGNUM** a, BIGNUM** B, BN_CTX* ctx );
+static int       deriveGroup( const Group& group, const Key& privateKey, const Key& publicKey, Key** secret );
+
+Group::Group( const Key& params )
+{
+   EVP_PKEY* dh  = getDH( params );
+   BN_CTX*   ctx = BN_CTX_new( );
+   BIGNUM*   p   = NULL;
+   BIGNUM*   q   = NULL;
+   BIGNUM*   g   = NULL;
+   BIGNUM*   base;
+   BIGNUM*   entry;
+   int       rows;
+   size_t    offset;
+
+   this->params = new Key( params );
+   this->p      = NULL;
+   this->q      = NULL;
+   this->g      = NULL;
+   this->mont   = NULL;
+   this->width  = 0;
+   this->bits   = 0;
+
+   /// @par Process Design Language
+   /// -# Extract (p,q,g) and set up the Montgomery context of p once for every session
+   if( ( dh != NULL ) && ( ctx != NULL ) && ( getPQG( dh, &p, &q, &g ) == 0 ) )
+   {
+      this->p    = p;
+      this->q    = q;
+      this->g    = g;
+      this->mont = BN_MONT_CTX_new( );
+      this->bits  = ( q != NULL ) ? BN_num_bits( q ) : ( BN_num_bits( p ) - 1 );
+      this->width = BN_num_bytes( p );
+
+      if( BN_MONT_CTX_set( this->mont, this->p, ctx ) != 1 )
+      {
+         BN_MONT_CTX_free( this->mont );
+         this->mont = NULL;
+      }
+   }
+
+   /// -# Fill the table row by row for every whole byte of a private exponent, every row starts at 1 and
+   ///    multiplies in the 2^WindowBits power of the previous row's base digit by digit
+   if( this->mont != NULL )
+   {
+      rows   = ( ( this->bits + 7 ) / 8 ) * ( 8 / WindowBits );
+      base   = BN_new( );
+      entry  = BN_new( );
+      offset = 0;
+      BN_to_montgomery( base, this->g, this->mont, ctx );
+      this->table.assign( static_cast< size_t >( rows ) * ( 1 << WindowBits ) * this->width, 0 );
+
+      for( int row = 0; row < rows; row++ )
+      {
+         BN_to_montgomery( entry, BN_value_one( ), this->mont, ctx );
+         for( int digit = 0; digit < ( 1 << WindowBits ); digit++ )
+         {
+            BN_bn2lebinpad( entry, &this->table[ offset ], this->width );
+            BN_mod_mul_montgomery( entry, entry, base, this->mont, ctx );
+            offset += this->width;
+         }
+         BN_copy( base, entry );
+      }
+      BN_free( entry );
+      BN_free( base );
+   }
+
+   BN_CTX_free( ctx );
+   EVP_PKEY_free( dh );
+}
+
+Group::~Group( void )
+{
+   BN_MONT_CTX_free( this->mont );
+   BN_free( this->p );
+   BN_free( this->q );
+   BN_free( this->g );
+   delete this->params;
+}
+
+bool Group::Valid( void ) const
+{
+   return( this->mont != NULL );
+}
+
+/**
+ * Chooses a private exponent, uniformly in [1, q - 1] for subgroup parameters, otherwise a random exponent
+ * one bit shorter than p.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+int Group::Private( BIGNUM* exponent ) const
+{
+   int status = 0;
+
+   if( this->q == NULL )
+   {
+      status = ( BN_priv_rand( exponent, this->bits, BN_RAND_TOP_ONE, BN_RAND_BOTTOM_ANY ) == 1 ) ? 0 : -1;
+   }
+   else
+   {
+      do
+      {
+         status = ( BN_priv_rand_range( exponent, this->q ) == 1 ) ? 0 : -1;
+      } while( ( status == 0 ) && BN_is_zero( exponent ) );
+   }
+
+   return( status );
+}
+
+/**
+ * Validates a remote public key: 1 < y < p - 1 and, for subgroup parameters, y^q mod p = 1 so a small
+ * subgroup confinement cannot leak bits of the private exponent.
+ */
+bool Group::Member( const BIGNUM* y, BN_CTX* ctx ) const
+{
+   bool    member = false;
+   BIGNUM* limit  = BN_dup( this->p );
+   BIGNUM* power  = BN_new( );
+
+   if( ( limit != NULL ) && ( power != NULL ) && ( BN_sub_word( limit, 1 ) == 1 ) )
+   {
+      member = !BN_is_zero( y ) && !BN_is_one( y ) && ( BN_cmp( y, limit ) < 0 );
+
+      if( member && ( this->q != NULL ) )
+      {
+         member = ( BN_mod_exp_mont( power, y, this->q, this->p, ctx, this->mont ) == 1 ) && BN_is_one( power );
+      }
+   }
+
+   BN_free( limit );
+   BN_free( power );
+
+   return( member );
+}
+
+/**
+ * Computes g^exponent mod p from the fixed-base table in constant time: every row is multiplied in, with
+ * its entry selected by mask from a scan of the whole row. Exponents longer than the table fall back to a
+ * regular exponentiation with the shared Montgomery context.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+int Group::Power( const BIGNUM* exponent, BIGNUM* result, BN_CTX* ctx ) const
+{
+   static_assert( ( 8 % WindowBits ) == 0, "Digits must not straddle the bytes of the exponent" );
+
+   const int                    entries = 1 << WindowBits;
+   int                          status  = 0;
+   int                          rows    = ( this->width > 0 ) ? static_cast< int >( this->table.size( ) / this->width ) / entries : 0;
+   std::vector< unsigned char > digits( static_cast< size_t >( rows ) * WindowBits / 8 );
+   std::vector< unsigned char > selected( static_cast< size_t >( this->width ) );
+   BIGNUM*                      acc     = NULL;
+   BIGNUM*                      factor  = NULL;
+
+   /// @par Process Design Language
+   /// -# Encode the exponent little endian at the fixed length of the table, longer exponents use the shared
+   ///    Montgomery context
+   if( !this->Valid( ) )
+   {
+      status = -1;
+   }
+   else if( BN_bn2lebinpad( exponent, digits.data( ), static_cast< int >( digits.size( ) ) ) < 0 )
+   {
+      status = this->Power( this->g, exponent, result, ctx );
+   }
+   else if( ( ( acc = BN_new( ) ) == NULL ) || ( ( factor = BN_new( ) ) == NULL ) )
+   {
+      status = -2;
+   }
+   /// -# Start from 1 in Montgomery form
+   else if( BN_to_montgomery( acc, BN_value_one( ), this->mont, ctx ) != 1 )
+   {
+      status = -3;
+   }
+   else
+   {
+      /// -# Multiply in the entry of the digit of every row, selected by mask over every entry of the row
+      BN_set_flags( factor, BN_FLG_CONSTTIME );
+      for( int row = 0; ( row < rows ) && ( status == 0 ); row++ )
+      {
+         const unsigned char* entry = &this->table[ static_cast< size_t >( row ) * entries * this->width ];
+         unsigned int         digit = ( digits[ ( row * WindowBits ) / 8 ] >> ( ( row * WindowBits ) % 8 ) ) & ( entries - 1 );
+
+         std::fill( selected.begin( ), selected.end( ), 0 );
+         for( int candidate = 0; candidate < entries; candidate++ )
+         {
+            unsigned char mask = static_cast< unsigned char >( 0u - ( ( ( candidate ^ digit ) - 1u ) >> 31 ) );
+
+            for( int i = 0; i < this->width; i++ )
+            {
+               selected[ i ] |= entry[ i ] & mask;
+            }
+            entry += this->width;
+         }
+
+         if( ( BN_lebin2bn( selected.data( ), this->width, factor ) == NULL ) ||
+             ( BN_mod_mul_montgomery( acc, acc, factor, this->mont, ctx ) != 1 ) )
+         {
+            status = -4;
+         }
+      }
+
+      /// -# Convert the product out of Montgomery form
+      if( ( status == 0 ) && ( BN_from_montgomery( result, acc, this->mont, ctx ) != 1 ) )
+      {
+         status = -5;
+      }
+   }
+
+   OPENSSL_cleanse( digits.data( ), digits.size( ) );
+   OPENSSL_cleanse( selected.data( ), selected.size( ) );
+   BN_clear_free( factor );
+   BN_clear_free( acc );
+
+   return( status );
+}
+
+/**
+ * Computes base^exponent mod p in constant time with the shared Montgomery context.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+int Group::Power( const BIGNUM* base, const BIGNUM* exponent, BIGNUM* result, BN_CTX* ctx ) const
+{
+   int status = 0;
+
+   if( !this->Valid( ) )
+   {
+      status = -1;
+   }
+   else if( BN_mod_exp_mont_consttime( result, base, exponent, this->p, ctx, this->mont ) != 1 )
+   {
+      status = -2;
+   }
+
+   return( status );
+}
+
+/**
+ * Derives the secrets of a batch of sessions of the group.
+ *
+ * @details
+ * Pairs of derives run through BN_mod_exp_mont_consttime_x2. OpenSSL 3.0 computes a pair with its AVX-512
+ * IFMA multi-buffer kernel only for PairedBits moduli on a CPU with IFMA, every other pair as two
+ * exponentiations, so at other sizes the batch gains from the threads alone. The pairs are spread across the
+ * given number of threads.
+ *
+ * @return 0 when every derive succeeded, otherwise the negated number of failed derives.
+ */
+int Group::Derive( std::vector< Derivation >& batch, unsigned int threads ) const
+{
+   std::atomic< int > failures( 0 );
+
+   Utility::ParallelFor( static_cast< int >( ( batch.size( ) + 1 ) / 2 ), [ & ]( int pair )
+   {
+      Derivation* first = &batch[ 2 * static_cast< size_t >( pair ) ];
+      size_t      count = std::min< size_t >( 2, batch.size( ) - 2 * static_cast< size_t >( pair ) );
+      BN_CTX*     ctx   = BN_CTX_new( );
+      BIGNUM*     a[ 2 ] = { NULL, NULL };
+      BIGNUM*     B[ 2 ] = { NULL, NULL };
+      BIGNUM*     z[ 2 ] = { BN_secure_new( ), BN_secure_new( ) };
+
+      /// @par Process Design Language
+      /// -# Load and validate both derives of the pair
+      for( size_t i = 0; i < count; i++ )
+      {
+         first[ i ].status = ( ( ctx == NULL ) || ( z[ i ] == NULL ) || ( first[ i ].session->group != this ) ) ? -1 :
+                             load( *this, first[ i ].session->keyPri, *first[ i ].peer, &a[ i ], &B[ i ], ctx );
+      }
+
+      /// -# Exponentiate both at once when both are valid, otherwise one by one
+      if( ( count == 2 ) && ( first[ 0 ].status == 0 ) && ( first[ 1 ].status == 0 ) )
+      {
+         if( BN_mod_exp_mont_consttime_x2( z[ 0 ], B[ 0 ], a[ 0 ], this->p, this->mont,
+                                           z[ 1 ], B[ 1 ], a[ 1 ], this->p, this->mont, ctx ) != 1 )
+         {
+            first[ 0 ].status = -5;
+            first[ 1 ].status = -5;
+         }
+      }
+      else
+      {
+         for( size_t i = 0; i < count; i++ )
+         {
+            if( ( first[ i ].status == 0 ) && ( this->Power( B[ i ], a[ i ], z[ i ], ctx ) != 0 ) )
+            {
+               first[ i ].status = -5;
+            }
+         }
+      }
+
+      /// -# Store the secrets in their sessions
+      for( size_t i = 0; i < count; i++ )
+      {
+         if( first[ i ].status == 0 )
+         {
+            delete first[ i ].session->keySec;
+            first[ i ].session->keySec = getKey( z[ i ] );
+         }
+         else
+         {
+            failures++;
+         }
+      }
+
+      for( size_t i = 0; i < 2; i++ )
+      {
+         BN_clear_free( a[ i ] );
+         BN_clear_free( z[ i ] );
+         BN_free( B[ i ] );
+      }
+      BN_CTX_free( ctx );
+   }, threads );
+
+   return( -failures );
+}
+
+const Key& Group::Params( void ) const
+{
+   return( *this->params );
+}
+
+const BIGNUM* Group::Prime( void ) const
+{
+   return( this->p );
+}
+
+const BIGNUM* Group::Order( void ) const
+{
+   return( this->q );
+}
+
+int Group::Bits( void ) const
+{
+   return( this->bits );
+}
+
+size_t Group::Entries( void ) const
+{
+   return( ( this->width > 0 ) ? this->table.size( ) / this->width : 0 );
+}
 
 Session::Session( void )
 {
@@ -16,6 +384,7 @@ Session::Session( void )
    this->keyPub = nullptr;
    this->keyPri = nullptr;
    this->keySec = nullptr;
+   this->group  = nullptr;
 }
 
 Session::~Session( void )
@@ -53,6 +422,8 @@ Session& Session::operator=( const Session& session )
       {
          this->keySec = new Key( *session.keySec );
       }
+
+      this->group = session.group;
    }
 
    return( *this );
@@ -60,41 +431,101 @@ Session& Session::operator=( const Session& session )
 
 int Session::Initialize( const Key& params )
 {
-   int  status = 0;
-   DH*  dh;
-   int            keyLen;
-   unsigned char* keyBuf;
+   int            status  = 0;
+   EVP_PKEY*      dh;
+   EVP_PKEY_CTX*  context = NULL;
+   EVP_PKEY*      keyPair = NULL;
+   BIGNUM*        pub     = NULL;
+   BIGNUM*        priv    = NULL;
+   Trace::Span    span( "DH Key Pair" );
+   Metrics::Timer timer( keyPairLatency );
 
    /// @par Process Design Language
-   /// -# Store the raw Diffie-Hellman Parameters (p&g)
+   /// -# Release a previous key pair and store the raw Diffie-Hellman Parameters (p&g)
+   this->free( );
    this->params = new Key( params );
+   this->group  = nullptr;
 
    /// -# Get Diffie-Hellman instance
    dh = getDH( *this->params );
 
    /// -# Generate the public and private key pair 
-   if( 1 != DH_generate_key( dh ) )
+   if( ( dh == NULL ) ||
+       ( ( context = EVP_PKEY_CTX_new_from_pkey( Provider::Context( ), dh, Provider::Properties ) ) == NULL ) ||
+       ( EVP_PKEY_keygen_init( context ) <= 0 ) || ( EVP_PKEY_keygen( context, &keyPair ) <= 0 ) ||
+       ( EVP_PKEY_get_bn_param( keyPair, OSSL_PKEY_PARAM_PUB_KEY, &pub ) != 1 ) ||
+       ( EVP_PKEY_get_bn_param( keyPair, OSSL_PKEY_PARAM_PRIV_KEY, &priv ) != 1 ) )
    {
       // ERROR
       status = -1;
    }
    else
    {
-      /// -# Extract Public Key
-      keyLen = BN_num_bytes( DH_get0_pub_key( dh ) );
-      keyBuf = new unsigned char[ static_cast< unsigned long long >( keyLen ) + 1 ];
-      keyBuf[ keyLen ] = '\0';
-      BN_bn2bin( DH_get0_pub_key( dh ), keyBuf );
-      this->keyPub = new Key( keyBuf, keyLen );
-      delete[ ] keyBuf;
+      /// -# Extract Public Key and Private Key
+      this->keyPub = getKey( pub );
+      this->keyPri = getKey( priv );
+   }
 
-      /// -# Extract Private Key
-      keyLen = BN_num_bytes( DH_get0_priv_key( dh ) );
-      keyBuf = new unsigned char[ static_cast< unsigned long long >( keyLen ) + 1 ];
-      keyBuf[ keyLen ] = '\0';
-      BN_bn2bin( DH_get0_priv_key( dh ), keyBuf );
-      this->keyPri = new Key( keyBuf, keyLen );
-      delete[ ] keyBuf;
+   BN_free( pub );
+   BN_clear_free( priv );
+   EVP_PKEY_free( keyPair );
+   EVP_PKEY_CTX_free( context );
+   EVP_PKEY_free( dh );
+
+   if( status != 0 )
+   {
+      failures.Add( );
+   }
+
+   return( status );
+}
+
+/**
+ * Generates the key pair from the shared precomputation of the parameters instead of parsing them and
+ * exponentiating from scratch. The group must outlive every Derive of the session.
+ */
+int Session::Initialize( const Group& group )
+{
+   int     status = 0;
+   BN_CTX* ctx    = BN_CTX_new( );
+   BIGNUM* a      = BN_secure_new( );   // Private Key
+   BIGNUM* A      = BN_new( );          // Public Key
+   Trace::Span    span( "DH Key Pair" );
+   Metrics::Timer timer( keyPairLatency );
+
+   /// @par Process Design Language
+   /// -# Release a previous key pair and keep a reference to the group
+   this->free( );
+   this->params = new Key( group.Params( ) );
+   this->group  = &group;
+
+   /// -# Choose the private key a at random, below q for subgroup parameters
+   if( ( ctx == NULL ) || ( a == NULL ) || ( A == NULL ) || !group.Valid( ) )
+   {
+      status = -1;
+   }
+   else if( group.Private( a ) != 0 )
+   {
+      status = -2;
+   }
+   /// -# Compute the public key g^a mod p from the fixed-base table
+   else if( group.Power( a, A, ctx ) != 0 )
+   {
+      status = -3;
+   }
+   else
+   {
+      this->keyPub = getKey( A );
+      this->keyPri = getKey( a );
+   }
+
+   BN_clear_free( a );
+   BN_free( A );
+   BN_CTX_free( ctx );
+
+   if( status != 0 )
+   {
+      failures.Add( );
    }
 
    return( status );
@@ -102,49 +533,88 @@ int Session::Initialize( const Key& params )
 
 int Session::Derive( const Key& publicKey )
 {
-   int            status = 0;
-   int            keyLen;
-   unsigned char* keyBuf;
-   DH*            dh = NULL;
+   int            status  = 0;
+   size_t         keyLen  = 0;
+   unsigned char* keyBuf  = NULL;
+   EVP_PKEY*      dh      = NULL;
+   EVP_PKEY*      local   = NULL;
+   EVP_PKEY*      remote  = NULL;
+   EVP_PKEY_CTX*  context = NULL;
+   BIGNUM*        p       = NULL;
+   BIGNUM*        q       = NULL;
+   BIGNUM*        g       = NULL;
    BIGNUM*        a;  // Local  Private Key
    BIGNUM*        A;  // Local  Public Key
    BIGNUM*        B;  // Remote Public key
+   Trace::Span    span( "DH Derive" );
+   Metrics::Timer timer( deriveLatency );
 
    /// @par Process Design Language
+   /// -# Sessions of a group reuse its Montgomery context
+   if( this->group != nullptr )
+   {
+      status = deriveGroup( *this->group, *this->keyPri, publicKey, &this->keySec );
+      if( status != 0 )
+      {
+         failures.Add( );
+      }
+      return( status );
+   }
+
    /// -# Convert Private Key and Public Key to BIGNUMs
-   a = BN_bin2bn( this->keyPri->Buffer( ), this->keyPri->Length( ), NULL );
+   a = BN_bin2bn( this->keyPri->Buffer( ), this->keyPri->Length( ), BN_secure_new( ) );
    A = BN_bin2bn( this->keyPub->Buffer( ), this->keyPub->Length( ), NULL );
    B = BN_bin2bn( publicKey.Buffer( ), publicKey.Length( ), NULL );
 
    /// -# Get Diffie-Hellman instance
    dh = getDH( *this->params );
 
-   if( dh == NULL )
+   if( ( dh == NULL ) || ( a == NULL ) || ( A == NULL ) || ( B == NULL ) || ( getPQG( dh, &p, &q, &g ) != 0 ) )
    {
       status = -1;
    }
-   else if( NULL == ( keyBuf = ( unsigned char* )OPENSSL_malloc( sizeof( unsigned char ) * ( DH_size( dh ) + 1 ) ) ) )
+   /// -# Build the local key pair and the remote public key, the remote key is validated as the peer
+   else if( ( ( local = makeDH( p, q, g, A, a ) ) == NULL ) || ( ( remote = makeDH( p, q, g, B, NULL ) ) == NULL ) ||
+            ( ( context = EVP_PKEY_CTX_new_from_pkey( Provider::Context( ), local, Provider::Properties ) ) == NULL ) ||
+            ( EVP_PKEY_derive_init( context ) <= 0 ) || ( EVP_PKEY_derive_set_peer( context, remote ) <= 0 ) ||
+            ( EVP_PKEY_derive( context, NULL, &keyLen ) <= 0 ) )
+   {
+      status = -3;
+   }
+   else if( NULL == ( keyBuf = ( unsigned char* )OPENSSL_malloc( sizeof( unsigned char ) * ( keyLen + 1 ) ) ) )
    {
       status = -2;
-      DH_free( dh );
    }
-   else if( DH_set0_key( dh, A, a ) != 1 )
+   /// -# Compute the unpadded secret
+   else if( EVP_PKEY_derive( context, keyBuf, &keyLen ) <= 0 )
    {
       status = -3;
-      DH_free( dh );
    }
    else
    {
-      keyLen = DH_compute_key( keyBuf, B, dh );
-      keyBuf[ keyLen + 1 ] = '\0';
-      DH_free( dh );
-      this->keySec = new Key( keyBuf, keyLen );
+      keyBuf[ keyLen ] = '\0';
+      delete this->keySec;
+      this->keySec = new Key( keyBuf, static_cast< int >( keyLen ) );
    }
 
-   /// -# Free allocated memory for a and B
-   BN_free( a );
+   /// -# Free allocated memory
+   OPENSSL_clear_free( keyBuf, keyLen + 1 );
+   EVP_PKEY_CTX_free( context );
+   EVP_PKEY_free( local );
+   EVP_PKEY_free( remote );
+   EVP_PKEY_free( dh );
+   BN_free( p );
+   BN_free( q );
+   BN_free( g );
+   BN_clear_free( a );
+   BN_free( A );
    BN_free( B );
 
+   if( status != 0 )
+   {
+      failures.Add( );
+   }
+
    return( status );
 }
 
@@ -163,87 +633,281 @@ const Key* Session::Secret( void ) const
    return( this->keySec );
 }
 
-int Session::GenerateParams( const unsigned int size, Key** params )
+/**
+ * Generates safe-prime parameters (p,2). With a single thread OpenSSL searches the prime, otherwise the
+ * search races on the given number of threads (0 for one per hardware thread).
+ */
+int Session::GenerateParams( const unsigned int size, Key** params, unsigned int threads )
 {
-   int status = 0;
-   int codes;
-   DH* dh;
+   int           status  = 0;
+   int           codes;
+   EVP_PKEY_CTX* context = EVP_PKEY_CTX_new_from_name( Provider::Context( ), "DH", Provider::Properties );
+   EVP_PKEY_CTX* check   = NULL;
+   EVP_PKEY*     dh      = NULL;
 
-   unsigned int   prmLen;
-   unsigned char* prmBuf;
-   BIO* prmBio;
+   Trace::Span    span( "DH Parameters" );
+   Metrics::Timer timer( paramsLatency );
 
    /// @par Process Design Language
-   /// -# Create new DH structure
-   if( ( dh = DH_new( ) ) == NULL )
+   /// -# Create the parameter generation context, generator parameters are the default of DH
+   if( ( context == NULL ) || ( EVP_PKEY_paramgen_init( context ) <= 0 ) ||
+       ( EVP_PKEY_CTX_set_dh_paramgen_prime_len( context, static_cast< int >( size ) ) <= 0 ) ||
+       ( EVP_PKEY_CTX_set_dh_paramgen_generator( context, Generator ) <= 0 ) )
    {
       status = -1;
    }
    /// -# Generate DH parameters
-   else if( DH_generate_parameters_ex( dh, size, DH_GENERATOR_2, NULL ) != 1 )
+   else if( ( threads == 1 ) ? ( EVP_PKEY_paramgen( context, &dh ) <= 0 ) :
+                               ( ( dh = generateParallel( static_cast< int >( size ), threads ) ) == NULL ) )
    {
       status = -2;
-      DH_free( dh );
    }
    /// -# Verify DH parameters are valid
-   else if( DH_check( dh, &codes ) != 1 )
+   else if( ( check = EVP_PKEY_CTX_new_from_pkey( Provider::Context( ), dh, Provider::Properties ) ) == NULL )
    {
       status = -3;
-      DH_free( dh );
    }
    /// -# Verify no error codes were encountered
-   else if( codes != 0 )
+   else if( ( codes = EVP_PKEY_param_check( check ) ) != 1 )
    {
-      status = -4;
-      DH_free( dh );
+      status = ( codes < 0 ) ? -3 : -4;
    }
    else
    {
-      /// -# Allocate BIO memory
-      prmBio = BIO_new( BIO_s_mem( ) );
+      /// -# Store the raw DHparams
+      *params = putDH( dh );
+   }
 
-      /// -# Write the DHparams to the BIO
-      PEM_write_bio_DHparams( prmBio, dh );
+   EVP_PKEY_CTX_free( check );
+   EVP_PKEY_CTX_free( context );
+   EVP_PKEY_free( dh );
 
-      /// -# Allocate memory and store raw DHparams
-      prmLen = BIO_pending( prmBio );
-      prmBuf = new unsigned char[ static_cast< unsigned long long >( prmLen ) + 1 ];
-      BIO_read( prmBio, prmBuf, prmLen );
-      prmBuf[ prmLen ] = '\0';
+   if( status != 0 )
+   {
+      failures.Add( );
+   }
 
-      /// -# Create new key to return
-      *params = new Key( prmBuf, prmLen );
-      delete[ ] prmBuf;
+   return( status );
+}
 
-      /// -# Free BIO memory
-      BIO_free( prmBio );
+/**
+ * Generates DSA-style parameters (p,q,g) (FIPS 186-4) with a 256-bit prime order subgroup, so private
+ * exponents are 256 bits long regardless of the size of p. FIPS 186-4 pairs a 1024-bit p with a 160-bit q.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+int Session::SubgroupParams( const unsigned int size, Key** params )
+{
+   int            status  = 0;
+   EVP_PKEY_CTX*  context = EVP_PKEY_CTX_new_from_name( Provider::Context( ), "DHX", Provider::Properties );
+   EVP_PKEY*      pkey    = NULL;
+   Metrics::Timer timer( paramsLatency );
 
-      /// -# Free DH memory
-      DH_free( dh );
+   /// @par Process Design Language
+   /// -# Generate (p,q,g) with a 256-bit q, 160 bits for a 1024-bit p
+   if( context == NULL )
+   {
+      status = -1;
+   }
+   else if( ( EVP_PKEY_paramgen_init( context ) <= 0 ) ||
+            ( EVP_PKEY_CTX_set_dh_paramgen_prime_len( context, static_cast< int >( size ) ) <= 0 ) ||
+            ( EVP_PKEY_CTX_set_dh_paramgen_subprime_len( context, ( size >= 2048 ) ? SubgroupBits : 160 ) <= 0 ) ||
+            ( EVP_PKEY_paramgen( context, &pkey ) <= 0 ) )
+   {
+      status = -2;
+   }
+   else
+   {
+      /// -# Store the raw X9.42 DHparams
+      *params = putDH( pkey );
+   }
+
+   EVP_PKEY_free( pkey );
+   EVP_PKEY_CTX_free( context );
+
+   if( status != 0 )
+   {
+      failures.Add( );
    }
 
    return( status );
 }
 
-static DH* getDH( const Key& params )
+/**
+ * Creates the parameters of the RFC 3526 MODP group of the given size (1536, 2048, 3072, 4096, 6144, or
+ * 8192 bits) instead of generating new ones.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+int Session::NamedParams( const unsigned int size, Key** params )
 {
-   DH*  dh = NULL;
-   BIO* prmBio = NULL;
+   int       status = 0;
+   EVP_PKEY* dh     = NULL;
+   BIGNUM*   p      = NULL;
+   BIGNUM*   g      = BN_new( );
 
    /// @par Process Design Language
-   /// -# Create a new Diffie-Hellman instance
-   dh = DH_new( );
+   /// -# Look up the prime of the group
+   switch( size )
+   {
+      case 1536: p = BN_get_rfc3526_prime_1536( NULL ); break;
+      case 2048: p = BN_get_rfc3526_prime_2048( NULL ); break;
+      case 3072: p = BN_get_rfc3526_prime_3072( NULL ); break;
+      case 4096: p = BN_get_rfc3526_prime_4096( NULL ); break;
+      case 6144: p = BN_get_rfc3526_prime_6144( NULL ); break;
+      case 8192: p = BN_get_rfc3526_prime_8192( NULL ); break;
+      default:   break;
+   }
+
+   if( g == NULL )
+   {
+      status = -1;
+   }
+   else if( p == NULL )
+   {
+      status = -2;
+   }
+   /// -# Build (p,2)
+   else if( ( BN_set_word( g, 2 ) != 1 ) || ( ( dh = makeDH( p, NULL, g, NULL, NULL ) ) == NULL ) )
+   {
+      status = -3;
+   }
+   else
+   {
+      /// -# Store the raw DHparams
+      *params = putDH( dh );
+   }
+
+   BN_free( p );
+   BN_free( g );
+   EVP_PKEY_free( dh );
+
+   return( status );
+}
+
+/**
+ * Builds (p,2) with a safe prime p found by a parallel prime search.
+ *
+ * @return The parameters, or NULL on error.
+ */
+static EVP_PKEY* generateParallel( int size, unsigned int threads )
+{
+   EVP_PKEY* dh = NULL;
+   BIGNUM*   p  = BN_new( );
+   BIGNUM*   g  = BN_new( );
+
+   if( ( p != NULL ) && ( g != NULL ) && ( BN_set_word( g, Generator ) == 1 ) &&
+       ( Primes::SafePrime( p, size, Generator, threads ) == 0 ) )
+   {
+      dh = makeDH( p, NULL, g, NULL, NULL );
+   }
+
+   BN_free( p );
+   BN_free( g );
+
+   return( dh );
+}
 
-   if( dh != NULL )
+/**
+ * Builds parameters, a public key, or a key pair in the library context, X9.42 when the subgroup order q
+ * is given.
+ *
+ * @return The key, or NULL on error.
+ */
+static EVP_PKEY* makeDH( const BIGNUM* p, const BIGNUM* q, const BIGNUM* g, const BIGNUM* pub, const BIGNUM* priv )
+{
+   EVP_PKEY*       dh        = NULL;
+   EVP_PKEY_CTX*   context   = EVP_PKEY_CTX_new_from_name( Provider::Context( ), ( q != NULL ) ? "DHX" : "DH",
+                                                           Provider::Properties );
+   OSSL_PARAM_BLD* build     = OSSL_PARAM_BLD_new( );
+   OSSL_PARAM*     params    = NULL;
+   int             selection = ( priv != NULL ) ? EVP_PKEY_KEYPAIR : ( pub != NULL ) ? EVP_PKEY_PUBLIC_KEY : EVP_PKEY_KEY_PARAMETERS;
+
+   if( ( context != NULL ) && ( build != NULL ) &&
+       ( OSSL_PARAM_BLD_push_BN( build, OSSL_PKEY_PARAM_FFC_P, p ) == 1 ) &&
+       ( OSSL_PARAM_BLD_push_BN( build, OSSL_PKEY_PARAM_FFC_G, g ) == 1 ) &&
+       ( ( q == NULL ) || ( OSSL_PARAM_BLD_push_BN( build, OSSL_PKEY_PARAM_FFC_Q, q ) == 1 ) ) &&
+       ( ( pub == NULL ) || ( OSSL_PARAM_BLD_push_BN( build, OSSL_PKEY_PARAM_PUB_KEY, pub ) == 1 ) ) &&
+       ( ( priv == NULL ) || ( OSSL_PARAM_BLD_push_BN( build, OSSL_PKEY_PARAM_PRIV_KEY, priv ) == 1 ) ) &&
+       ( ( params = OSSL_PARAM_BLD_to_param( build ) ) != NULL ) && ( EVP_PKEY_fromdata_init( context ) == 1 ) )
    {
-      /// -# Allocate memory for BIO
-      prmBio = BIO_new( BIO_s_mem( ) );
+      /// A failed import leaves the key NULL
+      ( void )EVP_PKEY_fromdata( context, &dh, selection, params );
+   }
+
+   OSSL_PARAM_free( params );
+   OSSL_PARAM_BLD_free( build );
+   EVP_PKEY_CTX_free( context );
+
+   return( dh );
+}
+
+/**
+ * Extracts (p,q,g) of parameters, q is NULL for safe-prime parameters.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+static int getPQG( const EVP_PKEY* dh, BIGNUM** p, BIGNUM** q, BIGNUM** g )
+{
+   if( ( EVP_PKEY_get_bn_param( dh, OSSL_PKEY_PARAM_FFC_P, p ) != 1 ) ||
+       ( EVP_PKEY_get_bn_param( dh, OSSL_PKEY_PARAM_FFC_G, g ) != 1 ) )
+   {
+      return( -1 );
+   }
+   if( EVP_PKEY_get_bn_param( dh, OSSL_PKEY_PARAM_FFC_Q, q ) != 1 )
+   {
+      *q = NULL;
+   }
+
+   return( 0 );
+}
+
+static Key* putDH( const EVP_PKEY* dh )
+{
+   unsigned int   prmLen;
+   unsigned char* prmBuf;
+   BIO*           prmBio;
+   Key*           params;
+
+   /// @par Process Design Language
+   /// -# Allocate BIO memory
+   prmBio = BIO_new( BIO_s_mem( ) );
+
+   /// -# Write the parameters to the BIO, DHparams or X9.42 DHparams keeping the subgroup order q
+   PEM_write_bio_Parameters( prmBio, dh );
+
+   /// -# Allocate memory and store raw DHparams
+   prmLen = BIO_pending( prmBio );
+   prmBuf = new unsigned char[ static_cast< unsigned long long >( prmLen ) + 1 ];
+   BIO_read( prmBio, prmBuf, prmLen );
+   prmBuf[ prmLen ] = '\0';
+
+   /// -# Create new key to return
+   params = new Key( prmBuf, prmLen );
+   delete[ ] prmBuf;
+
+   /// -# Free BIO memory
+   BIO_free( prmBio );
+
+   return( params );
+}
 
+static EVP_PKEY* getDH( const Key& params )
+{
+   EVP_PKEY* dh     = NULL;
+   BIO*      prmBio = NULL;
+
+   /// @par Process Design Language
+   /// -# Allocate memory for BIO
+   prmBio = BIO_new( BIO_s_mem( ) );
+
+   if( prmBio != NULL )
+   {
       /// -# Write the raw parameters into BIO buffer
       BIO_write( prmBio, params.Buffer( ), params.Length( ) );
 
-      /// -# Read DHparams from BIO into DH structure
-      PEM_read_bio_DHparams( prmBio, &dh, NULL, NULL );
+      /// -# Read DHparams or X9.42 DHparams from BIO into the library context
+      dh = PEM_read_bio_Parameters_ex( prmBio, NULL, Provider::Context( ), Provider::Properties );
 
       /// -# Free the BIO memory
       BIO_free( prmBio );
@@ -252,6 +916,90 @@ static DH* getDH( const Key& params )
    return( dh );
 }
 
+/**
+ * Derives the secret from the remote public key with the Montgomery context of the group.
+ */
+static int deriveGroup( const Group& group, const Key& privateKey, const Key& publicKey, Key** secret )
+{
+   BN_CTX* ctx    = BN_CTX_new( );
+   BIGNUM* a      = NULL;
+   BIGNUM* B      = NULL;
+   BIGNUM* z      = BN_secure_new( );
+   int     status = 0;
+
+   /// @par Process Design Language
+   /// -# Load the private key and the validated remote public key
+   if( ( ctx == NULL ) || ( z == NULL ) )
+   {
+      status = -1;
+   }
+   else
+   {
+      status = load( group, &privateKey, publicKey, &a, &B, ctx );
+   }
+
+   /// -# Compute B^a mod p
+   if( ( status == 0 ) && ( group.Power( B, a, z, ctx ) != 0 ) )
+   {
+      status = -5;
+   }
+   else if( status == 0 )
+   {
+      delete *secret;
+      *secret = getKey( z );
+   }
+
+   BN_clear_free( a );
+   BN_clear_free( z );
+   BN_free( B );
+   BN_CTX_free( ctx );
+
+   return( status );
+}
+
+/**
+ * Converts the private key and the remote public key of a derive, rejecting remote public keys which are
+ * not members of the group.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+static int load( const Group& group, const Key* privateKey, const Key& publicKey, BIGNUM** a, BIGNUM** B, BN_CTX* ctx )
+{
+   int status = 0;
+
+   if( privateKey != nullptr )
+   {
+      *a = BN_bin2bn( privateKey->Buffer( ), privateKey->Length( ), BN_secure_new( ) );
+   }
+   *B = BN_bin2bn( publicKey.Buffer( ), publicKey.Length( ), NULL );
+
+   if( ( privateKey == nullptr ) || ( *a == NULL ) || ( *B == NULL ) )
+   {
+      status = -1;
+   }
+   else if( !group.Member( *B, ctx ) )
+   {
+      status = -4;
+   }
+
+   return( status );
+}
+
+static Key* getKey( const BIGNUM* value )
+{
+   int            keyLen = BN_num_bytes( value );
+   unsigned char* keyBuf = new unsigned char[ static_cast< unsigned long long >( keyLen ) + 1 ];
+   Key*           key;
+
+   keyBuf[ keyLen ] = '\0';
+   BN_bn2bin( value, keyBuf );
+   key = new Key( keyBuf, keyLen );
+   OPENSSL_cleanse( keyBuf, static_cast< size_t >( keyLen ) );
+   delete[ ] keyBuf;
+
+   return( key );
+}
+
 void Session::free( void )
 {
    if( this->params != nullptr )
@@ -278,5 +1026,6 @@ void Session::free( void )
    this->keyPub = nullptr;
    this->keyPri = nullptr;
    this->keySec = nullptr;
+   this->group  = nullptr;
 }
 
@@ -2,17 +2,85 @@
 
 #include <Key.h>
 
+#include <openssl/bn.h>
+
+#include <vector>
+
 namespace SecureMigration
 {
    namespace DiffieHellman
    {
+      const int WindowBits   = 4;     ///< Exponent bits per row of the fixed-base table
+      const int SubgroupBits = 256;   ///< Bits of the prime order q of subgroup parameters
+      const int PairedBits   = 1024;  ///< Only modulus size OpenSSL 3.0 pairs on its AVX-512 IFMA kernel
+
+      class Session;
+
+      /// Derive of a session of a group within a batch
+      struct Derivation
+      {
+         Session*   session;   ///< Session deriving the secret
+         const Key* peer;      ///< Remote public key
+         int        status;    ///< 0 once the secret is derived, otherwise a negative value
+      };
+
+      /**
+       * Precomputation shared by every session using the same parameters (p,g).
+       *
+       * @details
+       * Holds the Montgomery context of p and a fixed-base window table of g. Row r of the table holds
+       * g^( d * 2^( WindowBits * r ) ) for every digit d in Montgomery form, stored little endian in entries
+       * of the width of p, so g^x costs one Montgomery multiplication per digit of x and no squarings. Every
+       * row is read in full and its entry selected by mask, so neither the memory accesses nor the number
+       * of multiplications depend on the secret exponent. When the parameters carry the
+       * order q of the subgroup generated by g, private exponents are drawn below q and remote public keys
+       * must lie in the subgroup. The group is read-only once constructed and may be shared by sessions on
+       * any thread.
+       */
+      class Group
+      {
+      private:    // Private Attributes
+         Key*                         params;   ///< Diffie-Hellman Key Exchange Parameters (p,g)
+         BIGNUM*                      p;        ///< Prime modulus
+         BIGNUM*                      q;        ///< Order of the subgroup generated by g, NULL for safe-prime parameters
+         BIGNUM*                      g;        ///< Generator
+         BN_MONT_CTX*                 mont;     ///< Montgomery context of p
+         std::vector< unsigned char > table;    ///< Fixed-base window table of g
+         int                          width;    ///< Bytes of a table entry
+         int                          bits;     ///< Bits of a private exponent
+
+      public:     // Public Methods
+         Group( const Key& params );
+         ~Group( void );
+
+         bool Valid( void ) const;
+         int  Private( BIGNUM* exponent ) const;
+         bool Member( const BIGNUM* y, BN_CTX* ctx ) const;
+         int  Power( const BIGNUM* exponent, BIGNUM* result, BN_CTX* ctx ) const;
+         int  Power( const BIGNUM* base, const BIGNUM* exponent, BIGNUM* result, BN_CTX* ctx ) const;
+         int  Derive( std::vector< Derivation >& batch, unsigned int threads = 0 ) const;
+
+         const Key&    Params( void ) const;
+         const BIGNUM* Prime( void ) const;
+         const BIGNUM* Order( void ) const;
+         int           Bits( void ) const;
+         size_t        Entries( void ) const;
+
+      private:    // Private Methods
+         Group( const Group& );              // Disabled
+         Group& operator=( const Group& );   // Disabled
+      };
+
       class Session
       {
+         friend class Group;
+
       private:    // Private Attributes
-         Key* params;   ///< Diffie-Hellman Key Exchange Parameters (p,g)
-         Key* keyPub;   ///< Diffie-Hellman Public Key
-         Key* keyPri;   ///< Diffie-Hellman Private Key
-         Key* keySec;   ///< Diffie-Hellman Secret Key;
+         Key*         params;   ///< Diffie-Hellman Key Exchange Parameters (p,g)
+         Key*         keyPub;   ///< Diffie-Hellman Public Key
+         Key*         keyPri;   ///< Diffie-Hellman Private Key
+         Key*         keySec;   ///< Diffie-Hellman Secret Key;
+         const Group* group;    ///< Shared precomputation of the parameters, if any
 
       public:     // Public Methods
          Session( void );
@@ -22,13 +90,16 @@ namespace SecureMigration
          Session& operator=( const Session& session );
 
          int Initialize( const Key& params );
+         int Initialize( const Group& group );
          int Derive( const Key& publicKey );
 
          const Key* PublicKey( void ) const;
          const Key* PrivateKey( void ) const;
          const Key* Secret( void ) const;
 
-         static int GenerateParams( const unsigned int size, Key** params );
+         static int GenerateParams( const unsigned int size, Key** params, unsigned int threads = 1 );
+         static int NamedParams( const unsigned int size, Key** params );
+         static int SubgroupParams( const unsigned int size, Key** params );
 
       private:    // Private Methods
          void free( void );
@@ -0,0 +1,150 @@
+/**
+ * @file
+ * @brief Ed25519 signatures authenticating the public values of a key exchange.
+ */
+// Application Includes
+#include <Ed25519.h>
+#include <Provider.h>
+#include <Utility.h>
+
+// OpenSSL Includes
+#include <openssl/evp.h>
+
+// StdLib Includes
+#include <atomic>
+
+using namespace SecureMigration;
+using namespace SecureMigration::Ed25519;
+
+Signer::Signer( void )
+{
+   this->key = nullptr;
+}
+
+Signer::~Signer( void )
+{
+   EVP_PKEY_free( this->key );
+}
+
+/**
+ * Generates a new key pair.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+int Signer::Initialize( void )
+{
+   int           status  = 0;
+   size_t        length  = PublicKeyLen;
+   EVP_PKEY*     keyPair = NULL;
+   EVP_PKEY_CTX* context = EVP_PKEY_CTX_new_from_name( Provider::Context( ), "ED25519", Provider::Properties );
+
+   /// @par Process Design Language
+   /// -# Generate the key pair
+   if( ( context == NULL ) || ( EVP_PKEY_keygen_init( context ) <= 0 ) || ( EVP_PKEY_keygen( context, &keyPair ) <= 0 ) )
+   {
+      status = -1;
+   }
+   /// -# Keep the raw public key sent to the peers
+   else if( ( EVP_PKEY_get_raw_public_key( keyPair, this->publicKey, &length ) <= 0 ) || ( length != PublicKeyLen ) )
+   {
+      status = -2;
+      EVP_PKEY_free( keyPair );
+   }
+   else
+   {
+      EVP_PKEY_free( this->key );
+      this->key = keyPair;
+   }
+
+   EVP_PKEY_CTX_free( context );
+
+   return( status );
+}
+
+/**
+ * Signs a message.
+ *
+ * @return SignatureLen, or a negative value on error.
+ */
+int Signer::Sign( const unsigned char* message, size_t length, unsigned char* signature ) const
+{
+   int         status  = SignatureLen;
+   size_t      sigLen  = SignatureLen;
+   EVP_MD_CTX* context = EVP_MD_CTX_new( );
+
+   if( this->key == nullptr )
+   {
+      status = -3;
+   }
+   else if( ( context == NULL ) || ( EVP_DigestSignInit_ex( context, NULL, NULL, Provider::Context( ), Provider::Properties, this->key, NULL ) <= 0 ) )
+   {
+      status = -1;
+   }
+   else if( ( EVP_DigestSign( context, signature, &sigLen, message, length ) <= 0 ) || ( sigLen != SignatureLen ) )
+   {
+      status = -2;
+   }
+
+   EVP_MD_CTX_free( context );
+
+   return( status );
+}
+
+const unsigned char* Signer::PublicKey( void ) const
+{
+   return( this->publicKey );
+}
+
+/**
+ * Verifies the signature of a message with the raw public key of the signer.
+ *
+ * @return 0 when the signature is valid, otherwise a negative value.
+ */
+int Ed25519::Verify( const unsigned char* message, size_t length, const unsigned char* signature, const unsigned char* publicKey )
+{
+   int         status  = 0;
+   EVP_PKEY*   key     = EVP_PKEY_new_raw_public_key_ex( Provider::Context( ), "ED25519", Provider::Properties, publicKey, PublicKeyLen );
+   EVP_MD_CTX* context = EVP_MD_CTX_new( );
+
+   if( ( key == NULL ) || ( context == NULL ) || ( EVP_DigestVerifyInit_ex( context, NULL, NULL, Provider::Context( ), Provider::Properties, key, NULL ) <= 0 ) )
+   {
+      status = -1;
+   }
+   else if( EVP_DigestVerify( context, signature, SignatureLen, message, length ) != 1 )
+   {
+      status = -2;
+   }
+
+   EVP_MD_CTX_free( context );
+   EVP_PKEY_free( key );
+
+   return( status );
+}
+
+/**
+ * Verifies a batch of signatures on the given number of threads (0 for one per hardware thread), recording
+ * the result of every signature in its item.
+ *
+ * @details
+ * OpenSSL offers no combined multi-scalar Ed25519 batch check, so the signatures are verified
+ * independently in parallel. A failing item therefore identifies exactly the forged signature.
+ *
+ * @return 0 when every signature is valid, otherwise a negative value.
+ */
+int Ed25519::VerifyBatch( std::vector< Item >& batch, unsigned int threads )
+{
+   std::atomic< int > failures( 0 );
+
+   Utility::ParallelFor( static_cast< int >( batch.size( ) ), [ & ]( int index )
+   {
+      Item& item = batch[ static_cast< size_t >( index ) ];
+
+      item.status = Verify( item.message, item.length, item.signature, item.publicKey );
+      if( item.status != 0 )
+      {
+         failures++;
+      }
+   }, threads );
+
+   return( ( failures.load( ) == 0 ) ? 0 : -1 );
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+// OpenSSL Includes
+#include <openssl/ossl_typ.h>
+
+// StdLib Includes
+#include <cstddef>
+#include <vector>
+
+namespace SecureMigration
+{
+   namespace Ed25519
+   {
+      const int PublicKeyLen = 32;   ///< Length of an Ed25519 public key
+      const int SignatureLen = 64;   ///< Length of an Ed25519 signature
+
+      /// Signature within a batch verification
+      struct Item
+      {
+         const unsigned char* message;     ///< Signed message
+         size_t               length;      ///< Length of the signed message
+         const unsigned char* signature;   ///< Signature of SignatureLen bytes
+         const unsigned char* publicKey;   ///< Public key of the signer, PublicKeyLen bytes
+         int                  status;      ///< 0 once the signature is verified, otherwise a negative value
+      };
+
+      /**
+       * Ed25519 (RFC 8032) signing key of a party.
+       *
+       * @details
+       * Signing and verifying take tens of microseconds against milliseconds for an RSA private key
+       * operation, so every public value of a key exchange can be signed without dominating the exchange.
+       */
+      class Signer
+      {
+      private:    // Private Attributes
+         EVP_PKEY*     key;                         ///< Private key
+         unsigned char publicKey[ PublicKeyLen ];   ///< Raw public key
+
+      public:     // Public Methods
+         Signer( void );
+         ~Signer( void );
+
+         int Initialize( void );
+         int Sign( const unsigned char* message, size_t length, unsigned char* signature ) const;
+
+         const unsigned char* PublicKey( void ) const;
+
+      private:    // Private Methods
+         Signer( const Signer& );              // Disabled
+         Signer& operator=( const Signer& );   // Disabled
+      };
+
+      int Verify( const unsigned char* message, size_t length, const unsigned char* signature, const unsigned char* publicKey );
+      int VerifyBatch( std::vector< Item >& batch, unsigned int threads = 0 );
+   }
+}
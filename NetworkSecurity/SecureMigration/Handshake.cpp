@@ -0,0 +1,372 @@
+/**
+ * @file
+ * @brief Coroutine based engine running many concurrent key exchange sessions.
+ *
+ * @details
+ * Every participant of a session (Alice, Bob, and Carol) is a coroutine. A participant suspends while
+ * it waits for a message from another participant and is resumed on the worker pool when the message
+ * arrives, so the exponentiations of thousands of sessions interleave on a few threads without a thread
+ * or a blocking wait per session.
+ */
+// Application Includes
+#include <Handshake.h>
+#include <DiffieHellman.h>
+#include <RSACryptosystem.h>
+
+// OpenSSL Includes
+#include <openssl/rand.h>
+
+// StdLib Includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+
+using HighResClock = std::chrono::high_resolution_clock;
+using Milliseconds = std::chrono::duration< double, std::ratio< 1, 1000 > >;
+
+using namespace SecureMigration;
+using namespace SecureMigration::Handshake;
+
+static const int Parties   = 3;    ///< Alice, Bob, and Carol
+static const int Stages    = 2;    ///< Message stages of a protocol
+static const int SecretLen = 32;   ///< Bytes of the secret key distributed with RSA
+
+static unsigned char FailedValue[ 1 ] = { 0 };              ///< Value no participant accepts as a key
+static const Key     Failed( FailedValue, 1 );              ///< Sent in place of every value by a failed participant
+
+/// Completion of a batch of sessions
+struct Completion
+{
+   std::mutex              mutex;       ///< Protects the counters
+   std::condition_variable signal;      ///< Signalled when a session completes
+   int                     completed;   ///< Sessions completed
+   int                     failures;    ///< Sessions whose participants disagree on the secret
+};
+
+/// State shared by the participants of a session
+struct Context
+{
+   Scheduler::Pool&                        pool;                   ///< Workers driving the participants
+   Completion&                             completion;             ///< Completion of the batch
+   const DiffieHellman::Group*             group;                  ///< Precomputed Diffie-Hellman parameters (p,g)
+   int                                     keyLen;                 ///< RSA key length in bits
+   Mailbox*                                mailboxes[ Parties ];   ///< Mailbox of every participant
+   DiffieHellman::Session                  dh[ Parties ];          ///< Diffie-Hellman session of every participant
+   RSACryptosystem::Cipher                 rsa[ Parties ];         ///< RSA cipher of every participant
+   std::vector< unsigned char >            secrets[ Parties ];     ///< Secret established by every participant
+   std::atomic< int >                      remaining;              ///< Participants still running
+   std::chrono::time_point< HighResClock > start;                  ///< Start of the session
+   double                                  latency;                ///< Milliseconds until the last participant completed
+
+   Context( Scheduler::Pool& pool, Completion& completion, const DiffieHellman::Group* group, int keyLen )
+      : pool( pool ), completion( completion ), group( group ), keyLen( keyLen ), remaining( Parties ), latency( 0.0 )
+   {
+      for( int i = 0; i < Parties; i++ )
+      {
+         this->mailboxes[ i ] = new Mailbox( pool );
+      }
+   }
+
+   ~Context( void )
+   {
+      for( int i = 0; i < Parties; i++ )
+      {
+         delete this->mailboxes[ i ];
+      }
+   }
+};
+
+static Participant diffieHellman( Context& context, int self );
+static Participant rsa( Context& context, int self );
+static void        send( Context& context, int from, int to, int stage, const Key& key );
+static void        finish( Context& context, int self, std::vector< unsigned char >& secret );
+
+Mailbox::Mailbox( Scheduler::Pool& pool )
+   : pool( pool )
+{
+}
+
+/**
+ * Delivers a message, resuming the receiver on the pool when it is waiting.
+ */
+void Mailbox::Send( Message message )
+{
+   std::coroutine_handle< > handle;
+
+   {
+      std::lock_guard< std::mutex > lock( this->mutex );
+
+      this->messages.push_back( std::move( message ) );
+      handle         = this->receiver;
+      this->receiver = nullptr;
+   }
+
+   if( handle )
+   {
+      this->pool.Submit( [ handle ]( void ) { handle.resume( ); } );
+   }
+}
+
+Mailbox::Receive Mailbox::Next( void )
+{
+   return( Receive{ *this } );
+}
+
+/**
+ * Suspends the receiver unless a message is already waiting.
+ */
+bool Mailbox::Receive::await_suspend( std::coroutine_handle< > handle ) const
+{
+   std::lock_guard< std::mutex > lock( this->mailbox.mutex );
+   bool                          suspend = this->mailbox.messages.empty( );
+
+   if( suspend )
+   {
+      this->mailbox.receiver = handle;
+   }
+
+   return( suspend );
+}
+
+Message Mailbox::Receive::await_resume( void ) const
+{
+   std::lock_guard< std::mutex > lock( this->mailbox.mutex );
+   Message                       message = std::move( this->mailbox.messages.front( ) );
+
+   this->mailbox.messages.pop_front( );
+
+   return( message );
+}
+
+Engine::Engine( Protocol protocol, int keyLen, const Key* params, unsigned int threads )
+   : pool( threads )
+{
+   this->protocol = protocol;
+   this->keyLen   = keyLen;
+   this->params   = params;
+   this->group    = ( params != nullptr ) ? new DiffieHellman::Group( *params ) : nullptr;
+}
+
+Engine::~Engine( void )
+{
+   delete this->group;
+}
+
+/**
+ * Starts the given number of sessions at once and waits for all of them to complete.
+ *
+ * @return 0 when every session established a common secret, otherwise a negative value.
+ */
+int Engine::Run( int sessions, Stats& stats )
+{
+   Completion              completion;
+   std::vector< Context* > contexts;
+   std::vector< double >   latencies;
+   std::chrono::time_point< HighResClock > start = HighResClock::now( );
+
+   completion.completed = 0;
+   completion.failures  = 0;
+
+   /// @par Process Design Language
+   /// -# Start the participants of every session, each moves onto the pool at its first suspension
+   for( int i = 0; i < sessions; i++ )
+   {
+      contexts.push_back( new Context( this->pool, completion, this->group, this->keyLen ) );
+   }
+   for( Context* context : contexts )
+   {
+      context->start = HighResClock::now( );
+      for( int self = 0; self < Parties; self++ )
+      {
+         if( this->protocol == Protocol::DiffieHellman )
+         {
+            diffieHellman( *context, self );
+         }
+         else
+         {
+            rsa( *context, self );
+         }
+      }
+   }
+
+   /// -# Wait for every session to complete
+   {
+      std::unique_lock< std::mutex > lock( completion.mutex );
+
+      completion.signal.wait( lock, [ & ]( void ) { return( completion.completed == sessions ); } );
+   }
+   stats.elapsed = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+
+   /// -# Compute throughput and latency percentiles
+   for( Context* context : contexts )
+   {
+      latencies.push_back( context->latency );
+      delete context;
+   }
+   std::sort( latencies.begin( ), latencies.end( ) );
+
+   stats.sessions  = sessions;
+   stats.failures  = completion.failures;
+   stats.perSecond = sessions / ( stats.elapsed / 1000.0 );
+   stats.p50       = latencies.empty( ) ? 0.0 : latencies[ static_cast< size_t >( std::ceil( 0.50 * sessions ) ) - 1 ];
+   stats.p99       = latencies.empty( ) ? 0.0 : latencies[ static_cast< size_t >( std::ceil( 0.99 * sessions ) ) - 1 ];
+
+   return( ( completion.failures == 0 ) ? 0 : -1 );
+}
+
+unsigned int Engine::Threads( void ) const
+{
+   return( this->pool.Threads( ) );
+}
+
+/**
+ * Participant of the three party Diffie-Hellman exchange. Participant x sends g^x to the others, sends
+ * g^yx derived from the public key of participant y to the third participant z, and derives g^zyx twice.
+ * A participant which fails sends Failed in place of every later value, so the others fail their derives
+ * instead of waiting, and finishes with an empty secret.
+ */
+static Participant diffieHellman( Context& context, int self )
+{
+   DiffieHellman::Session&      session = context.dh[ self ];
+   Mailbox&                     mailbox = *context.mailboxes[ self ];
+   int                          first   = ( self + 1 ) % Parties;
+   int                          second  = ( self + 2 ) % Parties;
+   std::vector< unsigned char > received[ Stages ][ Parties ];
+   std::vector< unsigned char > secret;
+   bool                         valid;
+
+   /// @par Process Design Language
+   /// -# Leave the thread which started the session
+   co_await Reschedule{ context.pool };
+
+   /// -# Generate the key pair and send g^x to the other participants
+   valid = ( context.group != nullptr ) && ( session.Initialize( *context.group ) == 0 );
+   send( context, self, first, 0, valid ? *session.PublicKey( ) : Failed );
+   send( context, self, second, 0, valid ? *session.PublicKey( ) : Failed );
+
+   /// -# Receive g^y and g^z, send g^yx to z and g^zx to y
+   while( received[ 0 ][ first ].empty( ) || received[ 0 ][ second ].empty( ) )
+   {
+      Message message = co_await mailbox.Next( );
+
+      received[ message.stage ][ message.from ] = std::move( message.key );
+   }
+   valid = valid && ( session.Derive( Key( received[ 0 ][ first ].data( ), static_cast< unsigned int >( received[ 0 ][ first ].size( ) ) ) ) == 0 );
+   send( context, self, second, 1, valid ? *session.Secret( ) : Failed );
+   valid = valid && ( session.Derive( Key( received[ 0 ][ second ].data( ), static_cast< unsigned int >( received[ 0 ][ second ].size( ) ) ) ) == 0 );
+   send( context, self, first, 1, valid ? *session.Secret( ) : Failed );
+
+   /// -# Receive g^zy and g^yz, derive the shared secret from both and verify they match
+   while( received[ 1 ][ first ].empty( ) || received[ 1 ][ second ].empty( ) )
+   {
+      Message message = co_await mailbox.Next( );
+
+      received[ message.stage ][ message.from ] = std::move( message.key );
+   }
+   valid = valid && ( session.Derive( Key( received[ 1 ][ first ].data( ), static_cast< unsigned int >( received[ 1 ][ first ].size( ) ) ) ) == 0 );
+   if( valid )
+   {
+      secret.assign( session.Secret( )->Buffer( ), session.Secret( )->Buffer( ) + session.Secret( )->Length( ) );
+   }
+   valid = valid && ( session.Derive( Key( received[ 1 ][ second ].data( ), static_cast< unsigned int >( received[ 1 ][ second ].size( ) ) ) ) == 0 );
+   if( !valid ||
+       !std::equal( secret.begin( ), secret.end( ), session.Secret( )->Buffer( ), session.Secret( )->Buffer( ) + session.Secret( )->Length( ) ) )
+   {
+      secret.clear( );
+   }
+
+   finish( context, self, secret );
+}
+
+/**
+ * Participant of the RSA key distribution. Bob and Carol generate key pairs and send their public keys to
+ * Alice, who encrypts a random secret key with each public key. Like in the Diffie-Hellman exchange, a
+ * participant which fails sends Failed in place of its value.
+ */
+static Participant rsa( Context& context, int self )
+{
+   RSACryptosystem::Cipher&     cipher  = context.rsa[ self ];
+   Mailbox&                     mailbox = *context.mailboxes[ self ];
+   std::vector< unsigned char > received[ Stages ][ Parties ];
+   std::vector< unsigned char > secret;
+   std::vector< unsigned char > buffer( ( context.keyLen + 7 ) / 8 );
+   int                          length;
+
+   /// @par Process Design Language
+   /// -# Leave the thread which started the session
+   co_await Reschedule{ context.pool };
+
+   if( self == 0 )
+   {
+      /// -# Alice generates the secret key and waits for the public keys of Bob and Carol
+      secret.resize( SecretLen );
+      if( RAND_bytes( secret.data( ), SecretLen ) != 1 )
+      {
+         secret.clear( );
+      }
+      while( received[ 0 ][ 1 ].empty( ) || received[ 0 ][ 2 ].empty( ) )
+      {
+         Message message = co_await mailbox.Next( );
+
+         received[ message.stage ][ message.from ] = std::move( message.key );
+      }
+
+      /// -# Alice sends the secret key encrypted with each public key
+      for( int recipient = 1; recipient < Parties; recipient++ )
+      {
+         length = secret.empty( ) ? -1 :
+                  cipher.Encrypt( secret.data( ), buffer.data( ), SecretLen,
+                                  Key( received[ 0 ][ recipient ].data( ), static_cast< unsigned int >( received[ 0 ][ recipient ].size( ) ) ) );
+         send( context, self, recipient, 1, ( length > 0 ) ? Key( buffer.data( ), static_cast< unsigned int >( length ) ) : Failed );
+      }
+   }
+   else
+   {
+      /// -# Bob and Carol generate key pairs and send their public keys to Alice
+      length = cipher.Initialize( context.keyLen );
+      send( context, self, 0, 0, ( length == 0 ) ? *cipher.PublicKey( ) : Failed );
+
+      /// -# Bob and Carol decrypt the secret key
+      while( received[ 1 ][ 0 ].empty( ) )
+      {
+         Message message = co_await mailbox.Next( );
+
+         received[ message.stage ][ message.from ] = std::move( message.key );
+      }
+      length = cipher.Decrypt( received[ 1 ][ 0 ].data( ), buffer.data( ), static_cast< int >( received[ 1 ][ 0 ].size( ) ) );
+      secret.assign( buffer.begin( ), buffer.begin( ) + std::max( length, 0 ) );
+   }
+
+   finish( context, self, secret );
+}
+
+static void send( Context& context, int from, int to, int stage, const Key& key )
+{
+   context.mailboxes[ to ]->Send( Message{ from, stage, std::vector< unsigned char >( key.Buffer( ), key.Buffer( ) + key.Length( ) ) } );
+}
+
+/**
+ * Records the secret of a participant. The last participant of the session verifies all participants
+ * agree and signals the completion, after which the context may be deleted at any time.
+ */
+static void finish( Context& context, int self, std::vector< unsigned char >& secret )
+{
+   bool agreed = true;
+
+   context.secrets[ self ].swap( secret );
+   if( --context.remaining == 0 )
+   {
+      context.latency = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - context.start ).count( );
+      for( int i = 0; i < Parties; i++ )
+      {
+         agreed = agreed && !context.secrets[ i ].empty( ) && ( context.secrets[ i ] == context.secrets[ 0 ] );
+      }
+
+      std::lock_guard< std::mutex > lock( context.completion.mutex );
+      context.completion.completed++;
+      context.completion.failures += agreed ? 0 : 1;
+      context.completion.signal.notify_all( );
+   }
+}
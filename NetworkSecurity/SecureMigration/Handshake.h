@@ -0,0 +1,128 @@
+#pragma once
+
+// Application Includes
+#include <DiffieHellman.h>
+#include <Key.h>
+#include <Scheduler.h>
+
+// StdLib Includes
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace SecureMigration
+{
+   namespace Handshake
+   {
+      enum class Protocol
+      {
+         DiffieHellman,   ///< Three party Diffie-Hellman key exchange
+         RSA              ///< Secret key distribution with RSA public key encryption
+      };
+
+      /// Measurements of a batch of concurrent handshakes
+      struct Stats
+      {
+         int    sessions;    ///< Handshakes started concurrently
+         int    failures;    ///< Handshakes whose participants did not agree on the secret
+         double elapsed;     ///< Milliseconds until the last handshake completed
+         double perSecond;   ///< Completed handshakes per second
+         double p50;         ///< Median handshake latency in milliseconds
+         double p99;         ///< 99th percentile handshake latency in milliseconds
+      };
+
+      /**
+       * Coroutine type of a protocol participant. The coroutine starts immediately, runs until its first
+       * suspension, and frees itself when it completes.
+       */
+      struct Participant
+      {
+         struct promise_type
+         {
+            Participant         get_return_object( void ) { return( Participant( ) ); }
+            std::suspend_never  initial_suspend( void ) noexcept { return( std::suspend_never( ) ); }
+            std::suspend_never  final_suspend( void ) noexcept { return( std::suspend_never( ) ); }
+            void                return_void( void ) { }
+            void                unhandled_exception( void ) { std::terminate( ); }
+         };
+      };
+
+      /// Awaitable moving the awaiting coroutine onto a worker of the pool
+      struct Reschedule
+      {
+         Scheduler::Pool& pool;
+
+         bool await_ready( void ) const noexcept { return( false ); }
+         void await_suspend( std::coroutine_handle< > handle ) const { this->pool.Submit( [ handle ]( void ) { handle.resume( ); } ); }
+         void await_resume( void ) const noexcept { }
+      };
+
+      /// Message sent between the participants of a session
+      struct Message
+      {
+         int                          from;    ///< Participant which sent the message
+         int                          stage;   ///< Protocol stage of the message
+         std::vector< unsigned char > key;     ///< Key material carried by the message
+      };
+
+      /**
+       * Single consumer mailbox of a participant. Receiving from an empty mailbox suspends the participant,
+       * and the next message sent resumes it on the pool.
+       */
+      class Mailbox
+      {
+      private:    // Private Attributes
+         Scheduler::Pool&          pool;       ///< Pool resuming the receiver
+         std::mutex                mutex;      ///< Protects the messages and the receiver
+         std::deque< Message >     messages;   ///< Messages not yet received
+         std::coroutine_handle< >  receiver;   ///< Suspended receiver, if any
+
+      public:     // Public Types
+         struct Receive
+         {
+            Mailbox& mailbox;
+
+            bool    await_ready( void ) const noexcept { return( false ); }
+            bool    await_suspend( std::coroutine_handle< > handle ) const;
+            Message await_resume( void ) const;
+         };
+
+      public:     // Public Methods
+         Mailbox( Scheduler::Pool& pool );
+
+         void    Send( Message message );
+         Receive Next( void );
+
+      private:    // Private Methods
+         Mailbox( const Mailbox& );              // Disabled
+         Mailbox& operator=( const Mailbox& );   // Disabled
+      };
+
+      /**
+       * Runs thousands of simultaneous handshakes whose participants are coroutines interleaved on a small
+       * fixed pool of threads.
+       */
+      class Engine
+      {
+      private:    // Private Attributes
+         Protocol              protocol;   ///< Protocol of every handshake
+         int                   keyLen;     ///< Key length in bits
+         const Key*            params;     ///< Diffie-Hellman parameters (p,g) shared by all sessions
+         DiffieHellman::Group* group;      ///< Precomputation of the parameters shared by all sessions
+         Scheduler::Pool       pool;       ///< Workers driving the participants
+
+      public:     // Public Methods
+         Engine( Protocol protocol, int keyLen, const Key* params, unsigned int threads = 0 );
+         ~Engine( void );
+
+         int          Run( int sessions, Stats& stats );
+         unsigned int Threads( void ) const;
+
+      private:    // Private Methods
+         Engine( const Engine& );              // Disabled
+         Engine& operator=( const Engine& );   // Disabled
+      };
+   }
+}
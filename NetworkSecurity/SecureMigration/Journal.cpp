@@ -0,0 +1,397 @@
+/**
+ * @file
+ * @brief Chunk level checkpoint journal for resumable migrations.
+ *
+ * @details
+ * The journal is an append only binary file:
+ * @verbatim
+   +-------+---------+----------+--------+------------+--------+------------------------------------+
+   | SMJL  | Version | Key Id   | Nonce  | Chunk Size | Size   | Commit Records ...                 |
+   | (32)  | (32)    | (128)    | (64)   | (32)       | (64)   | Chunk (32) | CRC-32 of Chunk (32)  |
+   +-------+---------+----------+--------+------------+--------+------------------------------------+
+   @endverbatim
+ * All integers are big endian. Reading stops at the first torn or corrupt commit record.
+ *
+ * The key store holds the raw session key so that a restarted migration can skip parameter generation
+ * and key exchange. It is created readable by its owner only and overwritten and removed once the
+ * migration completes, it must otherwise be protected like any other key store.
+ */
+// Application Includes
+#include <Journal.h>
+#include <Provider.h>
+#include <Utility.h>
+
+// OpenSSL Includes
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+// zlib Includes
+#include <zlib.h>
+
+// StdLib Includes
+#include <cstring>
+
+using namespace SecureMigration;
+using namespace SecureMigration::Journal;
+
+static const unsigned int Magic         = 0x534D4A4Cu;   // "SMJL"
+static const unsigned int FormatVersion = 1;
+static const int          HeaderLen     = 4 + 4 + KeyIdLen + NonceLen + 4 + 8;
+static const int          RecordLen     = 8;
+
+static unsigned int check( const unsigned char* chunk );
+
+/**
+ * Stores the session key of a migration in a file only its owner can read or write.
+ *
+ * @return Zero on success, otherwise a negative value.
+ */
+int Journal::StoreKey( const std::string& path, const unsigned char* key )
+{
+   int        status = 0;
+   std::FILE* file   = Utility::CreatePrivate( path.c_str( ) );
+
+   /// @par Process Design Language
+   /// -# Write and sync the key
+   if( file == NULL )
+   {
+      status = -1;
+   }
+   else
+   {
+      if( ( std::fwrite( key, 1, KeyLen, file ) != static_cast< size_t >( KeyLen ) ) || ( Utility::Sync( file ) != 0 ) )
+      {
+         status = -2;
+      }
+      std::fclose( file );
+   }
+
+   return( status );
+}
+
+int Journal::LoadKey( const std::string& path, unsigned char* key )
+{
+   int        status = 0;
+   std::FILE* file   = std::fopen( path.c_str( ), "rb" );
+
+   if( file == NULL )
+   {
+      status = -1;
+   }
+   else
+   {
+      if( std::fread( key, 1, KeyLen, file ) != static_cast< size_t >( KeyLen ) )
+      {
+         status = -2;
+      }
+      std::fclose( file );
+   }
+
+   return( status );
+}
+
+/**
+ * Erases the key store of a completed migration, overwriting the key before the file is removed.
+ *
+ * @return Zero on success, otherwise a negative value.
+ */
+int Journal::EraseKey( const std::string& path )
+{
+   int           status = 0;
+   unsigned char zeros[ KeyLen ] = { };
+   std::FILE*    file   = std::fopen( path.c_str( ), "r+b" );
+
+   if( file == NULL )
+   {
+      status = -1;
+   }
+   else
+   {
+      if( ( std::fwrite( zeros, 1, KeyLen, file ) != static_cast< size_t >( KeyLen ) ) || ( Utility::Sync( file ) != 0 ) )
+      {
+         status = -2;
+      }
+      std::fclose( file );
+      if( std::remove( path.c_str( ) ) != 0 )
+      {
+         status = -3;
+      }
+   }
+
+   return( status );
+}
+
+/**
+ * Derives the identifier of a session key, the truncated SHA-256 digest of the key.
+ */
+void Journal::KeyId( const unsigned char* key, unsigned char* id )
+{
+   unsigned char digest[ EVP_MAX_MD_SIZE ];
+
+   ( void )EVP_Digest( key, KeyLen, digest, NULL, Provider::SHA256( ), NULL );
+   std::memcpy( id, digest, KeyIdLen );
+}
+
+/**
+ * Returns whether a journal exists which was written for the given session key.
+ */
+bool Journal::Matches( const std::string& path, const unsigned char* key )
+{
+   bool          status = false;
+   unsigned char header[ HeaderLen ];
+   unsigned char id[ KeyIdLen ];
+   std::FILE*    file   = std::fopen( path.c_str( ), "rb" );
+
+   if( file != NULL )
+   {
+      KeyId( key, id );
+      status = ( std::fread( header, 1, HeaderLen, file ) == static_cast< size_t >( HeaderLen ) ) &&
+               ( Utility::ReadU32( header ) == Magic ) && ( Utility::ReadU32( header + 4 ) == FormatVersion ) &&
+               ( std::memcmp( header + 8, id, KeyIdLen ) == 0 );
+      std::fclose( file );
+   }
+
+   return( status );
+}
+
+Checkpoint::Checkpoint( int batch )
+{
+   this->file      = NULL;
+   this->chunkSize = 0;
+   this->size      = 0;
+   this->batch     = ( batch > 0 ) ? batch : 1;
+   this->syncs     = 0;
+   std::memset( this->keyId, 0, sizeof( this->keyId ) );
+   std::memset( this->nonce, 0, sizeof( this->nonce ) );
+}
+
+Checkpoint::~Checkpoint( void )
+{
+   this->Close( );
+}
+
+/**
+ * Opens the journal of a migration. An existing journal is resumed when it was written for the same
+ * session key, object size and chunk size, otherwise a new journal is started.
+ *
+ * @return Number of chunks already migrated, or a negative value on error.
+ */
+int Checkpoint::Open( const std::string& path, const unsigned char* key, long long size, int chunkSize )
+{
+   int           status = 0;
+   unsigned char header[ HeaderLen ];
+   unsigned char record[ RecordLen ];
+   long          valid  = HeaderLen;
+
+   /// @par Process Design Language
+   /// -# Reject a migration without chunks of at least one byte
+   this->Close( );
+   if( ( chunkSize <= 0 ) || ( size < 0 ) )
+   {
+      return( -4 );
+   }
+
+   /// -# Record the migration the journal describes
+   KeyId( key, this->keyId );
+   this->size      = size;
+   this->chunkSize = chunkSize;
+   this->completed.assign( static_cast< size_t >( ( size + chunkSize - 1 ) / chunkSize ), false );
+
+   /// -# Resume an existing journal of the same migration
+   this->file = std::fopen( path.c_str( ), "r+b" );
+   if( this->file != NULL )
+   {
+      if( ( std::fread( header, 1, HeaderLen, this->file ) != static_cast< size_t >( HeaderLen ) ) ||
+          ( Utility::ReadU32( header ) != Magic ) || ( Utility::ReadU32( header + 4 ) != FormatVersion ) ||
+          ( std::memcmp( header + 8, this->keyId, KeyIdLen ) != 0 ) ||
+          ( Utility::ReadU32( header + 8 + KeyIdLen + NonceLen ) != static_cast< unsigned int >( chunkSize ) ) ||
+          ( Utility::ReadU32( header + 12 + KeyIdLen + NonceLen ) != static_cast< unsigned int >( size >> 32 ) ) ||
+          ( Utility::ReadU32( header + 16 + KeyIdLen + NonceLen ) != static_cast< unsigned int >( size ) ) )
+      {
+         std::fclose( this->file );
+         this->file = NULL;
+      }
+      else
+      {
+         /// -# Replay the commit records up to the first torn or corrupt record
+         std::memcpy( this->nonce, header + 8 + KeyIdLen, NonceLen );
+         while( std::fread( record, 1, RecordLen, this->file ) == static_cast< size_t >( RecordLen ) )
+         {
+            unsigned int chunk = Utility::ReadU32( record );
+
+            if( ( Utility::ReadU32( record + 4 ) != check( record ) ) || ( chunk >= this->completed.size( ) ) )
+            {
+               break;
+            }
+            if( !this->completed[ chunk ] )
+            {
+               this->completed[ chunk ] = true;
+               status++;
+            }
+            valid += RecordLen;
+         }
+
+         /// -# Continue appending after the last valid record
+         std::fseek( this->file, valid, SEEK_SET );
+      }
+   }
+
+   /// -# Otherwise start a new journal with a fresh nonce
+   if( this->file == NULL )
+   {
+      Utility::WriteU32( header, Magic );
+      Utility::WriteU32( header + 4, FormatVersion );
+      std::memcpy( header + 8, this->keyId, KeyIdLen );
+      if( RAND_bytes( this->nonce, NonceLen ) != 1 )
+      {
+         status = -1;
+      }
+      std::memcpy( header + 8 + KeyIdLen, this->nonce, NonceLen );
+      Utility::WriteU32( header + 8 + KeyIdLen + NonceLen, static_cast< unsigned int >( chunkSize ) );
+      Utility::WriteU32( header + 12 + KeyIdLen + NonceLen, static_cast< unsigned int >( size >> 32 ) );
+      Utility::WriteU32( header + 16 + KeyIdLen + NonceLen, static_cast< unsigned int >( size ) );
+
+      if( status != 0 )
+      {
+      }
+      else if( ( this->file = std::fopen( path.c_str( ), "w+b" ) ) == NULL )
+      {
+         status = -2;
+      }
+      else if( ( std::fwrite( header, 1, HeaderLen, this->file ) != static_cast< size_t >( HeaderLen ) ) ||
+               ( Utility::Sync( this->file ) != 0 ) )
+      {
+         status = -3;
+      }
+      else
+      {
+         this->syncs++;
+      }
+   }
+
+   return( status );
+}
+
+/**
+ * Records that a chunk has been written to the data file. The record is written once a batch of
+ * commits has accumulated.
+ */
+int Checkpoint::Commit( int chunk, std::FILE* data )
+{
+   int           status = 0;
+   unsigned char record[ RecordLen ];
+
+   Utility::WriteU32( record, static_cast< unsigned int >( chunk ) );
+   Utility::WriteU32( record + 4, check( record ) );
+   this->pending.insert( this->pending.end( ), record, record + RecordLen );
+   this->completed[ chunk ] = true;
+
+   if( this->pending.size( ) >= static_cast< size_t >( this->batch ) * RecordLen )
+   {
+      status = this->Flush( data );
+   }
+
+   return( status );
+}
+
+/**
+ * Syncs the data file, then writes and syncs the pending commit records so that no record can become
+ * durable before the chunk it describes.
+ */
+int Checkpoint::Flush( std::FILE* data )
+{
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# Nothing to do without pending records
+   if( this->pending.empty( ) )
+   {
+   }
+   else if( this->file == NULL )
+   {
+      status = -1;
+   }
+   /// -# Make the chunk data durable first
+   else if( ( data != NULL ) && ( Utility::Sync( data ) != 0 ) )
+   {
+      status = -2;
+   }
+   /// -# Write the batch of records with a single sync
+   else if( ( std::fwrite( this->pending.data( ), 1, this->pending.size( ), this->file ) != this->pending.size( ) ) ||
+            ( Utility::Sync( this->file ) != 0 ) )
+   {
+      status = -3;
+   }
+   else
+   {
+      this->pending.clear( );
+      this->syncs++;
+   }
+
+   return( status );
+}
+
+/**
+ * Closes the journal discarding the pending commit records, as happens when a migration is interrupted.
+ */
+void Checkpoint::Abandon( void )
+{
+   this->Close( );
+}
+
+/**
+ * Closes the journal. Pending commit records are discarded rather than written, since the chunks they
+ * describe may not be durable without a sync of the data file, see Flush.
+ */
+void Checkpoint::Close( void )
+{
+   this->pending.clear( );
+   if( this->file != NULL )
+   {
+      std::fclose( this->file );
+      this->file = NULL;
+   }
+}
+
+bool Checkpoint::Completed( int chunk ) const
+{
+   return( this->completed[ chunk ] );
+}
+
+int Checkpoint::Next( void ) const
+{
+   int chunk = 0;
+
+   while( ( chunk < this->Chunks( ) ) && this->completed[ chunk ] )
+   {
+      chunk++;
+   }
+
+   return( chunk );
+}
+
+int Checkpoint::Chunks( void ) const
+{
+   return( static_cast< int >( this->completed.size( ) ) );
+}
+
+int Checkpoint::Syncs( void ) const
+{
+   return( this->syncs );
+}
+
+/**
+ * Builds the initial AES-CTR counter block of a chunk from the nonce and the chunk index.
+ */
+void Checkpoint::Counter( int chunk, unsigned char* counter ) const
+{
+   std::memset( counter, 0, CounterLen );
+   std::memcpy( counter, this->nonce, NonceLen );
+   Utility::WriteU32( counter + NonceLen, static_cast< unsigned int >( chunk ) );
+}
+
+static unsigned int check( const unsigned char* chunk )
+{
+   return( static_cast< unsigned int >( crc32( 0L, chunk, 4 ) ) );
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+// StdLib Includes
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace SecureMigration
+{
+   namespace Journal
+   {
+      const int KeyLen     = 32;   ///< AES-256 session key length
+      const int KeyIdLen   = 16;   ///< Length of the key identifier recorded in the journal
+      const int NonceLen   = 8;    ///< Length of the AES-CTR nonce recorded in the journal
+      const int CounterLen = 16;   ///< AES-CTR counter block length
+      const int BatchDef   = 64;   ///< Default chunk commits per journal sync
+
+      int  StoreKey( const std::string& path, const unsigned char* key );
+      int  LoadKey( const std::string& path, unsigned char* key );
+      int  EraseKey( const std::string& path );
+      void KeyId( const unsigned char* key, unsigned char* id );
+      bool Matches( const std::string& path, const unsigned char* key );
+
+      /**
+       * Chunk level checkpoint journal of a resumable migration.
+       *
+       * @details
+       * The journal records the identifier of the session key, the AES-CTR nonce, and every chunk Carol
+       * has durably written. Commits are buffered and written with a single sync per batch, after the
+       * data file has been synced, so a crash loses at most one batch of chunks which are then simply
+       * migrated again.
+       */
+      class Checkpoint
+      {
+      private:    // Private Attributes
+         std::FILE*                   file;                  ///< Journal file
+         unsigned char                keyId[ KeyIdLen ];     ///< Identifier of the session key
+         unsigned char                nonce[ NonceLen ];     ///< AES-CTR nonce of the migration
+         int                          chunkSize;             ///< Bytes per chunk
+         long long                    size;                  ///< Bytes of the object
+         int                          batch;                 ///< Chunk commits per sync
+         int                          syncs;                 ///< Journal syncs performed
+         std::vector< bool >          completed;             ///< Chunks durably migrated
+         std::vector< unsigned char > pending;               ///< Commit records not yet written
+
+      public:     // Public Methods
+         Checkpoint( int batch = BatchDef );
+         ~Checkpoint( void );
+
+         int  Open( const std::string& path, const unsigned char* key, long long size, int chunkSize );
+         int  Commit( int chunk, std::FILE* data );
+         int  Flush( std::FILE* data );
+         void Abandon( void );
+         void Close( void );
+
+         bool Completed( int chunk ) const;
+         int  Next( void ) const;
+         int  Chunks( void ) const;
+         int  Syncs( void ) const;
+         void Counter( int chunk, unsigned char* counter ) const;
+
+      private:    // Private Methods
+         Checkpoint( const Checkpoint& );              // Disabled
+         Checkpoint& operator=( const Checkpoint& );   // Disabled
+      };
+   }
+}
@@ -2,6 +2,7 @@
 #include <Key.h>
 
 // StdLib Includes
+#include <cstring>
 #include <string>
 #include <iostream>
 
@@ -21,7 +22,7 @@ Key::~Key( void )
 {
    try
    {
-      //delete[ ] this->buffer;
+      delete[ ] this->buffer;
    }
    catch( std::exception& ex )
    {
@@ -31,6 +32,8 @@ Key::~Key( void )
 
 Key::Key( const Key& key )
 {
+   this->buffer = nullptr;
+   this->length = 0;
    *this = key;
 }
 
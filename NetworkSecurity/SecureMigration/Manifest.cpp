@@ -0,0 +1,204 @@
+/**
+ * @file
+ * @brief Message manifest of a migration authenticated by a single RSA-PSS signature.
+ */
+// Application Includes
+#include <Manifest.h>
+#include <Provider.h>
+#include <RSACryptosystem.h>
+#include <Utility.h>
+
+// OpenSSL Includes
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+
+// StdLib Includes
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+using namespace SecureMigration;
+using namespace SecureMigration::Manifest;
+
+static const char* const Label = "SecureMigration manifest";   ///< Domain of the signed manifest digest
+
+static void hash( const unsigned char* message, size_t length, unsigned char* digest );
+
+Builder::Builder( void )
+{
+}
+
+Builder::~Builder( void )
+{
+}
+
+/**
+ * Records the digest of the next message.
+ *
+ * @return Index of the message in the manifest.
+ */
+size_t Builder::Add( const unsigned char* message, size_t length )
+{
+   size_t index = this->Count( );
+
+   this->entries.resize( this->entries.size( ) + DigestLen );
+   hash( message, length, this->entries.data( ) + index * DigestLen );
+
+   return( index );
+}
+
+/**
+ * Records the digests of a buffer sent as consecutive messages of the given length, the last one possibly
+ * shorter, hashing the messages in parallel on the given number of threads (0 for one per hardware thread).
+ *
+ * @return Number of messages recorded.
+ */
+size_t Builder::AddAll( const unsigned char* data, size_t length, size_t messageLen, unsigned int threads )
+{
+   size_t first    = this->Count( );
+   size_t messages = ( messageLen == 0 ) ? 0 : ( length + messageLen - 1 ) / messageLen;
+
+   this->entries.resize( this->entries.size( ) + messages * DigestLen );
+   Utility::ParallelFor( static_cast< int >( messages ), [ & ]( int message )
+   {
+      size_t offset = static_cast< size_t >( message ) * messageLen;
+
+      hash( data + offset, std::min( messageLen, length - offset ), this->entries.data( ) + ( first + message ) * DigestLen );
+   }, threads );
+
+   return( messages );
+}
+
+void Builder::Clear( void )
+{
+   this->entries.clear( );
+}
+
+/**
+ * Computes the digest of the manifest, binding the number of messages and their order.
+ */
+void Builder::Digest( unsigned char* digest ) const
+{
+   EVP_MD_CTX*   context = EVP_MD_CTX_new( );
+   unsigned char count[ 8 ];
+   size_t        messages = this->Count( );
+
+   for( int i = 7; i >= 0; i-- )
+   {
+      count[ i ] = static_cast< unsigned char >( messages & 0xFF );
+      messages >>= 8;
+   }
+
+   EVP_DigestInit_ex( context, Provider::SHA256( ), NULL );
+   EVP_DigestUpdate( context, Label, std::strlen( Label ) );
+   EVP_DigestUpdate( context, count, sizeof( count ) );
+   EVP_DigestUpdate( context, this->entries.data( ), this->entries.size( ) );
+   EVP_DigestFinal_ex( context, digest, NULL );
+   EVP_MD_CTX_free( context );
+}
+
+/**
+ * Signs the digest of the manifest with the private key of the signer.
+ *
+ * @return Length of the signature, or a negative value on error.
+ */
+int Builder::Sign( RSACryptosystem::Cipher& signer, std::vector< unsigned char >& signature ) const
+{
+   int           status;
+   unsigned char digest[ DigestLen ];
+
+   this->Digest( digest );
+   signature.resize( static_cast< size_t >( signer.Size( ) ) );
+   status = signature.empty( ) ? -1 : signer.SignDigest( digest, signature.data( ) );
+   signature.resize( static_cast< size_t >( std::max( status, 0 ) ) );
+
+   return( status );
+}
+
+/**
+ * Checks the signature of the manifest with the public key of the sender.
+ *
+ * @return 0 when the signature is valid, otherwise a negative value.
+ */
+int Builder::Verify( const unsigned char* signature, int length, const Key& keyPub ) const
+{
+   unsigned char digest[ DigestLen ];
+
+   this->Digest( digest );
+
+   return( RSACryptosystem::Cipher::VerifyDigest( digest, signature, length, keyPub ) );
+}
+
+/**
+ * Compares the digests of the received messages against the manifest, hashing the messages in parallel.
+ *
+ * @return Index of the first message not matching the manifest, or -1 when every message matches.
+ */
+long long Builder::Check( const unsigned char* data, size_t length, size_t messageLen, unsigned int threads ) const
+{
+   size_t                   messages = ( messageLen == 0 ) ? 0 : ( length + messageLen - 1 ) / messageLen;
+   std::atomic< long long > first( static_cast< long long >( std::min( messages, this->Count( ) ) ) );
+
+   /// @par Process Design Language
+   /// -# Hash every message present in both and keep the lowest mismatching index
+   Utility::ParallelFor( static_cast< int >( first.load( ) ), [ & ]( int message )
+   {
+      size_t        offset = static_cast< size_t >( message ) * messageLen;
+      unsigned char digest[ DigestLen ];
+      long long     current;
+
+      hash( data + offset, std::min( messageLen, length - offset ), digest );
+      if( CRYPTO_memcmp( digest, this->Entry( static_cast< size_t >( message ) ), DigestLen ) != 0 )
+      {
+         current = first.load( );
+         while( ( message < current ) && !first.compare_exchange_weak( current, message ) )
+         {
+         }
+      }
+   }, threads );
+
+   /// -# A missing or surplus message mismatches at the end of the shorter sequence
+   return( ( ( first.load( ) == static_cast< long long >( messages ) ) && ( messages == this->Count( ) ) ) ? -1 : first.load( ) );
+}
+
+size_t Builder::Count( void ) const
+{
+   return( this->entries.size( ) / DigestLen );
+}
+
+const unsigned char* Builder::Entry( size_t index ) const
+{
+   return( this->entries.data( ) + index * DigestLen );
+}
+
+/**
+ * Authenticates every message of a migration at the receiver: one signature check of the manifest and a
+ * parallel comparison of the received messages against it.
+ *
+ * @return 0 when the manifest is signed by the sender and every message matches, -1 for an invalid
+ *         signature, -2 when a message was altered, dropped, or added.
+ */
+int Manifest::VerifyBatch( const Builder& manifest, const unsigned char* signature, int length, const Key& keyPub,
+                           const unsigned char* data, size_t size, size_t messageLen, unsigned int threads )
+{
+   int status = 0;
+
+   if( manifest.Verify( signature, length, keyPub ) != 0 )
+   {
+      status = -1;
+   }
+   else if( manifest.Check( data, size, messageLen, threads ) >= 0 )
+   {
+      status = -2;
+   }
+
+   return( status );
+}
+
+/**
+ * Computes the SHA-256 digest of a message.
+ */
+static void hash( const unsigned char* message, size_t length, unsigned char* digest )
+{
+   EVP_Digest( message, length, digest, NULL, Provider::SHA256( ), NULL );
+}
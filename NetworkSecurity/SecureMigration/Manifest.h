@@ -0,0 +1,59 @@
+#pragma once
+
+// Application Includes
+#include <Key.h>
+
+// StdLib Includes
+#include <cstddef>
+#include <vector>
+
+namespace SecureMigration
+{
+   namespace RSACryptosystem
+   {
+      class Cipher;
+   }
+
+   namespace Manifest
+   {
+      const int DigestLen = 32;   ///< SHA-256 digest of a message and of the manifest
+
+      /**
+       * Manifest of every message of a migration, authenticated by a single RSA-PSS signature.
+       *
+       * @details
+       * The sender records the SHA-256 digest of every message it sends and signs the digest of the
+       * manifest once. The receiver checks the signature once and compares the digests of all received
+       * messages against the manifest in parallel, so the migration costs one private key operation at
+       * the sender and one public key operation at the receiver however many messages it has.
+       */
+      class Builder
+      {
+      private:    // Private Attributes
+         std::vector< unsigned char > entries;   ///< Digest of every message in order
+
+      public:     // Public Methods
+         Builder( void );
+         ~Builder( void );
+
+         size_t Add( const unsigned char* message, size_t length );
+         size_t AddAll( const unsigned char* data, size_t length, size_t messageLen, unsigned int threads = 0 );
+         void   Clear( void );
+
+         void Digest( unsigned char* digest ) const;
+         int  Sign( RSACryptosystem::Cipher& signer, std::vector< unsigned char >& signature ) const;
+         int  Verify( const unsigned char* signature, int length, const Key& keyPub ) const;
+         long long Check( const unsigned char* data, size_t length, size_t messageLen, unsigned int threads = 0 ) const;
+
+         size_t               Count( void ) const;
+         const unsigned char* Entry( size_t index ) const;
+
+      private:    // Private Methods
+         Builder( const Builder& );              // Disabled
+         Builder& operator=( const Builder& );   // Disabled
+      };
+
+      int VerifyBatch( const Builder& manifest, const unsigned char* signature, int length, const Key& keyPub,
+                       const unsigned char* data, size_t size, size_t messageLen, unsigned int threads = 0 );
+   }
+}
@@ -0,0 +1,435 @@
+/**
+ * @file
+ * @brief Allocation accounting of operator new and OpenSSL, and resident set size sampling per phase.
+ */
+// Application Includes
+#include <Memory.h>
+
+// OpenSSL Includes
+#include <openssl/crypto.h>
+
+// StdLib Includes
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <new>
+#include <sstream>
+
+#if defined( __linux__ )
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace SecureMigration;
+using namespace SecureMigration::Memory;
+
+static const size_t HeaderLen = alignof( std::max_align_t );   ///< Bytes before every block holding its size, keeping the block aligned
+
+std::atomic< bool > Memory::enabled( false );
+
+static std::atomic< long long > allocationCount( 0 );   ///< Blocks allocated while enabled
+static std::atomic< long long > allocatedBytes( 0 );    ///< Bytes allocated while enabled
+static std::atomic< long long > liveBytes( 0 );         ///< Bytes allocated less bytes freed while enabled
+static std::atomic< long long > peakLive( 0 );          ///< Highest live bytes since the last reset
+
+static void*       allocate( size_t size );
+static void        release( void* pointer );
+static void        allocated( size_t size );
+static void        freed( size_t size );
+static void*       cryptoMalloc( size_t size, const char* file, int line );
+static void*       cryptoRealloc( void* pointer, size_t size, const char* file, int line );
+static void        cryptoFree( void* pointer, const char* file, int line );
+static long long   procStatus( const char* field );
+static std::string format( long long bytes );
+
+void Usage::Add( const Usage& usage )
+{
+   this->valid       = this->valid && usage.valid;
+   this->peakLive    = std::max( this->peakLive, this->live + usage.peakLive );
+   this->peakRss     = std::max( this->peakRss, usage.peakRss );
+   this->allocations += usage.allocations;
+   this->bytes       += usage.bytes;
+   this->live        += usage.live;
+}
+
+/**
+ * Describes the allocations, the bytes allocated and still live, and the peaks of the phase, or why it was
+ * not measured.
+ */
+std::string Usage::Describe( void ) const
+{
+   std::ostringstream text;
+
+   if( !this->valid )
+   {
+      text << "Not measured (accounting disabled)";
+   }
+   else
+   {
+      text << this->allocations << " Allocations, " << format( this->bytes ) << " Allocated, " << format( this->live )
+           << " Live, " << format( this->peakLive ) << " Peak Live, "
+           << ( ( this->peakRss > 0 ) ? format( this->peakRss ) : std::string( "Unknown" ) ) << " Peak RSS";
+   }
+
+   return( text.str( ) );
+}
+
+Phase::Phase( void )
+{
+   this->started     = false;
+   this->allocations = 0;
+   this->bytes       = 0;
+   this->live        = 0;
+}
+
+/**
+ * Resets the peaks and takes the counts at the start of the phase. The resident set size is reset first so
+ * sampling it is not part of the phase.
+ */
+void Phase::Start( void )
+{
+   this->started = enabled.load( std::memory_order_relaxed );
+   if( this->started )
+   {
+      ( void )ResetPeakRss( );
+      this->allocations = allocationCount.load( std::memory_order_relaxed );
+      this->bytes       = allocatedBytes.load( std::memory_order_relaxed );
+      this->live        = liveBytes.load( std::memory_order_relaxed );
+      peakLive.store( this->live, std::memory_order_relaxed );
+   }
+}
+
+/**
+ * Returns the usage since Start, invalid when accounting was disabled at Start or is disabled now.
+ */
+Usage Phase::Stop( void )
+{
+   Usage usage = { };
+
+   usage.valid = this->started && enabled.load( std::memory_order_relaxed );
+   if( usage.valid )
+   {
+      usage.allocations = allocationCount.load( std::memory_order_relaxed ) - this->allocations;
+      usage.bytes       = allocatedBytes.load( std::memory_order_relaxed ) - this->bytes;
+      usage.live        = liveBytes.load( std::memory_order_relaxed ) - this->live;
+      usage.peakLive    = peakLive.load( std::memory_order_relaxed ) - this->live;
+      usage.peakRss     = PeakRss( );
+   }
+
+   return( usage );
+}
+
+/**
+ * Routes OpenSSL's allocations through the accounting. Must be called before OpenSSL allocates anything,
+ * so every block OpenSSL frees or reallocates carries the size header.
+ *
+ * @return 0 on success, otherwise a negative value when OpenSSL already allocated.
+ */
+int Memory::Install( void )
+{
+   return( ( CRYPTO_set_mem_functions( cryptoMalloc, cryptoRealloc, cryptoFree ) == 1 ) ? 0 : -1 );
+}
+
+/**
+ * Starts or stops counting allocations. Blocks allocated before counting started are still subtracted from
+ * the live bytes when freed.
+ */
+void Memory::Enable( bool enable )
+{
+   enabled.store( enable );
+}
+
+long long Memory::Allocations( void )
+{
+   return( allocationCount.load( std::memory_order_relaxed ) );
+}
+
+long long Memory::Live( void )
+{
+   return( liveBytes.load( std::memory_order_relaxed ) );
+}
+
+/**
+ * Returns the resident set size of the process in bytes, 0 when unknown.
+ */
+long long Memory::Rss( void )
+{
+   return( procStatus( "VmRSS:" ) );
+}
+
+/**
+ * Returns the peak resident set size of the process since start or the last reset in bytes, 0 when unknown.
+ */
+long long Memory::PeakRss( void )
+{
+   return( procStatus( "VmHWM:" ) );
+}
+
+/**
+ * Resets the peak resident set size to the current one (Linux 4.0 and later).
+ *
+ * @return True when reset, otherwise the peak keeps counting from the start of the process.
+ */
+bool Memory::ResetPeakRss( void )
+{
+   bool reset = false;
+
+   #if defined( __linux__ )
+   int fd = ::open( "/proc/self/clear_refs", O_WRONLY );
+
+   if( fd >= 0 )
+   {
+      reset = ( ::write( fd, "5", 1 ) == 1 );
+      ::close( fd );
+   }
+   #endif
+
+   return( reset );
+}
+
+/**
+ * Replaces the global operator new: every block carries its size in a header so operator delete can
+ * subtract it from the live bytes. Over-aligned allocations keep the library's implementation and are not
+ * counted.
+ */
+void* operator new( std::size_t size )
+{
+   void* pointer;
+
+   while( ( pointer = allocate( size ) ) == nullptr )
+   {
+      std::new_handler handler = std::get_new_handler( );
+
+      if( handler == nullptr )
+      {
+         throw std::bad_alloc( );
+      }
+      handler( );
+   }
+
+   return( pointer );
+}
+
+void* operator new[ ]( std::size_t size )
+{
+   return( operator new( size ) );
+}
+
+void* operator new( std::size_t size, const std::nothrow_t& ) noexcept
+{
+   try
+   {
+      return( operator new( size ) );
+   }
+   catch( std::bad_alloc& )
+   {
+      return( nullptr );
+   }
+}
+
+void* operator new[ ]( std::size_t size, const std::nothrow_t& ) noexcept
+{
+   return( operator new( size, std::nothrow ) );
+}
+
+void operator delete( void* pointer ) noexcept
+{
+   release( pointer );
+}
+
+void operator delete[ ]( void* pointer ) noexcept
+{
+   release( pointer );
+}
+
+void operator delete( void* pointer, std::size_t ) noexcept
+{
+   release( pointer );
+}
+
+void operator delete[ ]( void* pointer, std::size_t ) noexcept
+{
+   release( pointer );
+}
+
+void operator delete( void* pointer, const std::nothrow_t& ) noexcept
+{
+   release( pointer );
+}
+
+void operator delete[ ]( void* pointer, const std::nothrow_t& ) noexcept
+{
+   release( pointer );
+}
+
+/**
+ * Allocates a block with the size header and counts it.
+ */
+static void* allocate( size_t size )
+{
+   unsigned char* block = static_cast< unsigned char* >( std::malloc( size + HeaderLen ) );
+
+   if( block == nullptr )
+   {
+      return( nullptr );
+   }
+   *reinterpret_cast< size_t* >( block ) = size;
+   allocated( size );
+
+   return( block + HeaderLen );
+}
+
+/**
+ * Frees a block allocated by allocate and subtracts it from the live bytes.
+ */
+static void release( void* pointer )
+{
+   unsigned char* block;
+
+   if( pointer != nullptr )
+   {
+      block = static_cast< unsigned char* >( pointer ) - HeaderLen;
+      freed( *reinterpret_cast< size_t* >( block ) );
+      std::free( block );
+   }
+}
+
+static void allocated( size_t size )
+{
+   long long live;
+   long long peak;
+
+   if( enabled.load( std::memory_order_relaxed ) )
+   {
+      allocationCount.fetch_add( 1, std::memory_order_relaxed );
+      allocatedBytes.fetch_add( static_cast< long long >( size ), std::memory_order_relaxed );
+      live = liveBytes.fetch_add( static_cast< long long >( size ), std::memory_order_relaxed ) + static_cast< long long >( size );
+      peak = peakLive.load( std::memory_order_relaxed );
+      while( ( live > peak ) && !peakLive.compare_exchange_weak( peak, live, std::memory_order_relaxed ) )
+      {
+      }
+   }
+}
+
+static void freed( size_t size )
+{
+   if( enabled.load( std::memory_order_relaxed ) )
+   {
+      liveBytes.fetch_sub( static_cast< long long >( size ), std::memory_order_relaxed );
+   }
+}
+
+/**
+ * OpenSSL allocation, returning no block for 0 bytes like OpenSSL's own.
+ */
+static void* cryptoMalloc( size_t size, const char* file, int line )
+{
+   ( void )file;
+   ( void )line;
+
+   return( ( size == 0 ) ? nullptr : allocate( size ) );
+}
+
+/**
+ * OpenSSL reallocation, counted as freeing the old block and allocating the new one.
+ */
+static void* cryptoRealloc( void* pointer, size_t size, const char* file, int line )
+{
+   unsigned char* block;
+   unsigned char* resized;
+   size_t         previous;
+
+   if( pointer == nullptr )
+   {
+      return( cryptoMalloc( size, file, line ) );
+   }
+   if( size == 0 )
+   {
+      release( pointer );
+      return( nullptr );
+   }
+
+   block    = static_cast< unsigned char* >( pointer ) - HeaderLen;
+   previous = *reinterpret_cast< size_t* >( block );
+   if( ( resized = static_cast< unsigned char* >( std::realloc( block, size + HeaderLen ) ) ) == nullptr )
+   {
+      return( nullptr );
+   }
+   *reinterpret_cast< size_t* >( resized ) = size;
+   freed( previous );
+   allocated( size );
+
+   return( resized + HeaderLen );
+}
+
+static void cryptoFree( void* pointer, const char* file, int line )
+{
+   ( void )file;
+   ( void )line;
+
+   release( pointer );
+}
+
+/**
+ * Returns a size field of /proc/self/status in bytes, 0 when unknown. Reads with system calls only, so
+ * sampling allocates nothing.
+ */
+static long long procStatus( const char* field )
+{
+   long long value = 0;
+
+   #if defined( __linux__ )
+   char        text[ 4096 ];
+   ssize_t     length;
+   const char* found;
+   int         fd = ::open( "/proc/self/status", O_RDONLY );
+
+   if( fd >= 0 )
+   {
+      length = ::read( fd, text, sizeof( text ) - 1 );
+      ::close( fd );
+      if( length > 0 )
+      {
+         text[ length ] = '\0';
+         if( ( found = std::strstr( text, field ) ) != nullptr )
+         {
+            value = std::strtoll( found + std::strlen( field ), nullptr, 10 ) * 1024;
+         }
+      }
+   }
+   #else
+   ( void )field;
+   #endif
+
+   return( value );
+}
+
+/**
+ * Formats bytes with a binary unit.
+ */
+static std::string format( long long bytes )
+{
+   const char*        units[ ] = { "Bytes", "KiB", "MiB", "GiB", "TiB" };
+   double             value    = static_cast< double >( bytes );
+   int                unit     = 0;
+   std::ostringstream text;
+
+   while( ( std::abs( value ) >= 1024.0 ) && ( unit < 4 ) )
+   {
+      value /= 1024.0;
+      unit++;
+   }
+   if( unit == 0 )
+   {
+      text << bytes << " " << units[ unit ];
+   }
+   else
+   {
+      text << std::fixed << std::setprecision( 2 ) << value << " " << units[ unit ];
+   }
+
+   return( text.str( ) );
+}
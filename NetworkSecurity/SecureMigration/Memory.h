@@ -0,0 +1,62 @@
+#pragma once
+
+// StdLib Includes
+#include <atomic>
+#include <string>
+
+namespace SecureMigration
+{
+   namespace Memory
+   {
+      extern std::atomic< bool > enabled;   ///< Allocations are counted, checked by every allocation before anything else
+
+      /// Allocations and memory of a phase
+      struct Usage
+      {
+         bool      valid;         ///< Measured while accounting was enabled
+         long long allocations;   ///< Blocks allocated by operator new and OpenSSL
+         long long bytes;         ///< Bytes allocated
+         long long live;          ///< Bytes allocated and not yet freed at the end, negative when more was freed
+         long long peakLive;      ///< Highest live bytes above the start of the phase
+         long long peakRss;       ///< Peak resident set size of the process during the phase, 0 when unknown
+
+         void        Add( const Usage& usage );
+         std::string Describe( void ) const;
+      };
+
+      /**
+       * Measures the allocations and the peak memory of a phase between Start and Stop.
+       *
+       * @details
+       * The peak live bytes and the peak resident set size are process-wide high-water marks reset by
+       * Start, so phases are measured one after another and never nested. Allocations of every thread
+       * count towards the phase.
+       */
+      class Phase
+      {
+      private:    // Private Attributes
+         bool      started;       ///< Started while accounting was enabled
+         long long allocations;   ///< Allocations at Start
+         long long bytes;         ///< Bytes allocated at Start
+         long long live;          ///< Live bytes at Start
+
+      public:     // Public Methods
+         Phase( void );
+
+         void  Start( void );
+         Usage Stop( void );
+
+      private:    // Private Methods
+         Phase( const Phase& );              // Disabled
+         Phase& operator=( const Phase& );   // Disabled
+      };
+
+      int       Install( void );
+      void      Enable( bool enable );
+      long long Allocations( void );
+      long long Live( void );
+      long long Rss( void );
+      long long PeakRss( void );
+      bool      ResetPeakRss( void );
+   }
+}
@@ -0,0 +1,429 @@
+/**
+ * @file
+ * @brief Registry of counters, gauges, and latency histograms exported as a Prometheus text file.
+ */
+// Application Includes
+#include <Metrics.h>
+
+// StdLib Includes
+#include <algorithm>
+#include <bit>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <sstream>
+
+using namespace SecureMigration;
+using namespace SecureMigration::Metrics;
+
+/// Kind of a registered metric
+enum class Type
+{
+   Counter,
+   Gauge,
+   Histogram
+};
+
+/// Registered metric
+struct Entry
+{
+   Type                         type;        ///< Kind of the metric
+   std::string                  help;        ///< Description of the metric family
+   std::unique_ptr< Counter >   counter;     ///< Counter, when a counter
+   std::unique_ptr< Gauge >     gauge;       ///< Gauge, when a gauge
+   std::unique_ptr< Histogram > histogram;   ///< Histogram, when a histogram
+};
+
+static const double Quantiles[ ] = { 0.5, 0.9, 0.99, 0.999 };   ///< Quantiles exported per histogram
+
+static std::mutex&                      registryMutex( void );
+static std::map< std::string, Entry >& registry( void );
+static Entry&                           find( const std::string& name, const std::string& help, Type type );
+static void                             split( const std::string& name, std::string& family, std::string& labels );
+static std::string                      label( const std::string& labels, const std::string& extra );
+
+Counter::Counter( void )
+{
+   this->value.store( 0 );
+}
+
+void Counter::Add( long long value )
+{
+   this->value.fetch_add( value, std::memory_order_relaxed );
+}
+
+long long Counter::Value( void ) const
+{
+   return( this->value.load( std::memory_order_relaxed ) );
+}
+
+Gauge::Gauge( void )
+{
+   this->value.store( 0.0 );
+}
+
+void Gauge::Set( double value )
+{
+   this->value.store( value, std::memory_order_relaxed );
+}
+
+void Gauge::Add( double value )
+{
+   double current = this->value.load( std::memory_order_relaxed );
+
+   while( !this->value.compare_exchange_weak( current, current + value, std::memory_order_relaxed ) )
+   {
+   }
+}
+
+double Gauge::Value( void ) const
+{
+   return( this->value.load( std::memory_order_relaxed ) );
+}
+
+Histogram::Histogram( void )
+{
+   for( std::atomic< long long >& bucket : this->counts )
+   {
+      bucket.store( 0 );
+   }
+   this->count.store( 0 );
+   this->sum.store( 0 );
+   this->max.store( 0 );
+}
+
+/**
+ * Records a value in nanoseconds, clamped to the recordable range.
+ */
+void Histogram::Record( long long value )
+{
+   long long largest = this->max.load( std::memory_order_relaxed );
+
+   value = std::max( 0LL, std::min( value, ( 1LL << ValueBits ) - 1 ) );
+   this->counts[ Bucket( value ) ].fetch_add( 1, std::memory_order_relaxed );
+   this->count.fetch_add( 1, std::memory_order_relaxed );
+   this->sum.fetch_add( value, std::memory_order_relaxed );
+   while( ( value > largest ) && !this->max.compare_exchange_weak( largest, value, std::memory_order_relaxed ) )
+   {
+   }
+}
+
+long long Histogram::Count( void ) const
+{
+   return( this->count.load( std::memory_order_relaxed ) );
+}
+
+long long Histogram::Sum( void ) const
+{
+   return( this->sum.load( std::memory_order_relaxed ) );
+}
+
+long long Histogram::Max( void ) const
+{
+   return( this->max.load( std::memory_order_relaxed ) );
+}
+
+/**
+ * Returns the value below or at which the given fraction of the recorded values lie, as the highest value
+ * of its bucket and never above the largest recorded value.
+ *
+ * @return The quantile in nanoseconds, 0 without any recorded value.
+ */
+long long Histogram::Quantile( double quantile ) const
+{
+   long long total = 0;
+   long long rank;
+   long long seen  = 0;
+
+   for( const std::atomic< long long >& bucket : this->counts )
+   {
+      total += bucket.load( std::memory_order_relaxed );
+   }
+   if( total == 0 )
+   {
+      return( 0 );
+   }
+
+   /// @par Process Design Language
+   /// -# Find the bucket holding the value of the requested rank
+   rank = std::max( 1LL, static_cast< long long >( quantile * static_cast< double >( total ) + 0.999999 ) );
+   for( int bucket = 0; bucket < Buckets; bucket++ )
+   {
+      seen += this->counts[ bucket ].load( std::memory_order_relaxed );
+      if( seen >= rank )
+      {
+         return( std::min( Highest( bucket ), this->Max( ) ) );
+      }
+   }
+
+   return( this->Max( ) );
+}
+
+/**
+ * Returns the bucket of a value: values below 2 * SubBuckets have a bucket each, every higher power of two
+ * is split into SubBuckets buckets.
+ */
+int Histogram::Bucket( long long value )
+{
+   int magnitude = static_cast< int >( std::bit_width( static_cast< unsigned long long >( value ) ) ) - 1;
+   int shift     = magnitude - SubBucketBits;
+
+   if( shift <= 0 )
+   {
+      return( static_cast< int >( value ) );
+   }
+
+   return( ( shift + 1 ) * SubBuckets + static_cast< int >( ( value >> shift ) - SubBuckets ) );
+}
+
+/**
+ * Returns the highest value of a bucket.
+ */
+long long Histogram::Highest( int bucket )
+{
+   int       shift = bucket / SubBuckets - 1;
+   long long sub   = bucket % SubBuckets + SubBuckets;
+
+   if( shift <= 0 )
+   {
+      return( bucket );
+   }
+
+   return( ( ( sub + 1 ) << shift ) - 1 );
+}
+
+Exporter::Exporter( void )
+{
+   this->interval = 0;
+   this->stop     = true;
+}
+
+Exporter::~Exporter( void )
+{
+   ( void )this->Stop( );
+}
+
+/**
+ * Writes the registry to the Prometheus text file now and then every interval seconds on a writer thread.
+ * Without an interval the file is written again only when stopped.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+int Exporter::Start( const std::string& path, int interval )
+{
+   int status = this->Stop( );
+
+   this->path     = path;
+   this->interval = interval;
+   this->stop     = false;
+   status        |= Write( path );
+
+   if( interval > 0 )
+   {
+      this->writer = std::thread( [ this ]( void )
+      {
+         std::unique_lock< std::mutex > lock( this->mutex );
+
+         while( !this->wake.wait_for( lock, std::chrono::seconds( this->interval ), [ this ]( void ) { return( this->stop ); } ) )
+         {
+            lock.unlock( );
+            ( void )Write( this->path );
+            lock.lock( );
+         }
+      } );
+   }
+
+   return( status );
+}
+
+/**
+ * Stops the writer thread and writes the final values.
+ *
+ * @return 0 on success or when not started, otherwise a negative value.
+ */
+int Exporter::Stop( void )
+{
+   {
+      std::lock_guard< std::mutex > lock( this->mutex );
+
+      if( this->stop )
+      {
+         return( 0 );
+      }
+      this->stop = true;
+   }
+   this->wake.notify_all( );
+   if( this->writer.joinable( ) )
+   {
+      this->writer.join( );
+   }
+
+   return( Write( this->path ) );
+}
+
+/**
+ * Returns the counter of the given name, registering it on the first call. The name may carry Prometheus
+ * labels, e.g. name{operation="derive"}, and metrics of one family share the help text of the first.
+ */
+Counter& Metrics::GetCounter( const std::string& name, const std::string& help )
+{
+   return( *find( name, help, Type::Counter ).counter );
+}
+
+Gauge& Metrics::GetGauge( const std::string& name, const std::string& help )
+{
+   return( *find( name, help, Type::Gauge ).gauge );
+}
+
+Histogram& Metrics::GetHistogram( const std::string& name, const std::string& help )
+{
+   return( *find( name, help, Type::Histogram ).histogram );
+}
+
+/**
+ * Returns every registered metric in the Prometheus text exposition format. Histograms are exported as
+ * summaries in seconds.
+ */
+std::string Metrics::Text( void )
+{
+   std::lock_guard< std::mutex > lock( registryMutex( ) );
+   std::ostringstream            text;
+   std::string                   previous;
+   std::string                   family;
+   std::string                   labels;
+
+   text << std::setprecision( 9 );
+   for( const std::pair< const std::string, Entry >& metric : registry( ) )
+   {
+      const Entry& entry = metric.second;
+
+      /// @par Process Design Language
+      /// -# Describe every family once, its metrics are adjacent in the ordered registry
+      split( metric.first, family, labels );
+      if( family != previous )
+      {
+         text << "# HELP " << family << " " << entry.help << "\n"
+              << "# TYPE " << family << " " << ( ( entry.type == Type::Counter ) ? "counter" : ( entry.type == Type::Gauge ) ? "gauge" : "summary" )
+              << "\n";
+         previous = family;
+      }
+
+      /// -# Write the value, or the quantiles, sum, and count of a histogram
+      if( entry.type == Type::Counter )
+      {
+         text << metric.first << " " << entry.counter->Value( ) << "\n";
+      }
+      else if( entry.type == Type::Gauge )
+      {
+         text << metric.first << " " << entry.gauge->Value( ) << "\n";
+      }
+      else
+      {
+         for( double quantile : Quantiles )
+         {
+            std::ostringstream value;
+
+            value << quantile;
+            text << family << label( labels, "quantile=\"" + value.str( ) + "\"" ) << " " << entry.histogram->Quantile( quantile ) / 1e9 << "\n";
+         }
+         text << family << "_sum" << labels << " " << entry.histogram->Sum( ) / 1e9 << "\n"
+              << family << "_count" << labels << " " << entry.histogram->Count( ) << "\n";
+      }
+   }
+
+   return( text.str( ) );
+}
+
+/**
+ * Writes the registry to a Prometheus text file, replacing it at once so a scraper never reads a partial
+ * file.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+int Metrics::Write( const std::string& path )
+{
+   const std::string temporary = path + ".tmp";
+   std::error_code   error;
+
+   {
+      std::ofstream file( temporary, std::ios::out | std::ios::trunc );
+
+      if( !file )
+      {
+         return( -1 );
+      }
+      file << Text( );
+      if( !file.good( ) )
+      {
+         return( -2 );
+      }
+   }
+   std::filesystem::rename( temporary, path, error );
+
+   return( error ? -3 : 0 );
+}
+
+static std::mutex& registryMutex( void )
+{
+   static std::mutex mutex;
+
+   return( mutex );
+}
+
+/**
+ * Returns the registry, constructed on first use so metrics can be registered during static
+ * initialization of any translation unit.
+ */
+static std::map< std::string, Entry >& registry( void )
+{
+   static std::map< std::string, Entry > metrics;
+
+   return( metrics );
+}
+
+static Entry& find( const std::string& name, const std::string& help, Type type )
+{
+   std::lock_guard< std::mutex > lock( registryMutex( ) );
+   Entry&                        entry = registry( )[ name ];
+
+   if( ( entry.counter == nullptr ) && ( entry.gauge == nullptr ) && ( entry.histogram == nullptr ) )
+   {
+      entry.type = type;
+      entry.help = help;
+   }
+   if( ( type == Type::Counter ) && ( entry.counter == nullptr ) )
+   {
+      entry.counter.reset( new Counter( ) );
+   }
+   else if( ( type == Type::Gauge ) && ( entry.gauge == nullptr ) )
+   {
+      entry.gauge.reset( new Gauge( ) );
+   }
+   else if( ( type == Type::Histogram ) && ( entry.histogram == nullptr ) )
+   {
+      entry.histogram.reset( new Histogram( ) );
+   }
+
+   return( entry );
+}
+
+/**
+ * Splits a metric name into its family and its label set including the braces.
+ */
+static void split( const std::string& name, std::string& family, std::string& labels )
+{
+   size_t brace = name.find( '{' );
+
+   family = name.substr( 0, brace );
+   labels = ( brace == std::string::npos ) ? std::string( ) : name.substr( brace );
+}
+
+/**
+ * Returns a label set with one more label.
+ */
+static std::string label( const std::string& labels, const std::string& extra )
+{
+   return( labels.empty( ) ? "{" + extra + "}" : labels.substr( 0, labels.size( ) - 1 ) + "," + extra + "}" );
+}
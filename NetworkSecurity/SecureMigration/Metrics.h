@@ -0,0 +1,143 @@
+#pragma once
+
+// StdLib Includes
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace SecureMigration
+{
+   namespace Metrics
+   {
+      const int SubBucketBits = 5;                                                ///< log2 of the linear sub-buckets per power of two
+      const int SubBuckets    = 1 << SubBucketBits;                               ///< Sub-buckets per power of two, about 3% relative error
+      const int ValueBits     = 44;                                               ///< Largest recordable value 2^44-1 ns (about 4.9 hours)
+      const int Buckets       = ( ValueBits - SubBucketBits + 1 ) * SubBuckets;   ///< Buckets of a histogram
+
+      /// Monotonic count, exported as a Prometheus counter
+      class Counter
+      {
+      private:    // Private Attributes
+         std::atomic< long long > value;   ///< Count
+
+      public:     // Public Methods
+         Counter( void );
+
+         void      Add( long long value = 1 );
+         long long Value( void ) const;
+
+      private:    // Private Methods
+         Counter( const Counter& );              // Disabled
+         Counter& operator=( const Counter& );   // Disabled
+      };
+
+      /// Value which goes up and down, exported as a Prometheus gauge
+      class Gauge
+      {
+      private:    // Private Attributes
+         std::atomic< double > value;   ///< Current value
+
+      public:     // Public Methods
+         Gauge( void );
+
+         void   Set( double value );
+         void   Add( double value );
+         double Value( void ) const;
+
+      private:    // Private Methods
+         Gauge( const Gauge& );              // Disabled
+         Gauge& operator=( const Gauge& );   // Disabled
+      };
+
+      /**
+       * Latency histogram in nanoseconds with HDR-style log-linear buckets, exported as a Prometheus summary
+       * in seconds.
+       *
+       * @details
+       * Every power of two is split into SubBuckets linear buckets, so a quantile is within 1/SubBuckets of
+       * the recorded value from nanoseconds to hours in a fixed array of counters. Recording is a few atomic
+       * increments without any lock.
+       */
+      class Histogram
+      {
+      private:    // Private Attributes
+         std::atomic< long long > counts[ Buckets ];   ///< Values recorded per bucket
+         std::atomic< long long > count;               ///< Values recorded
+         std::atomic< long long > sum;                 ///< Sum of the recorded values
+         std::atomic< long long > max;                 ///< Largest recorded value
+
+      public:     // Public Methods
+         Histogram( void );
+
+         void      Record( long long value );
+         long long Count( void ) const;
+         long long Sum( void ) const;
+         long long Max( void ) const;
+         long long Quantile( double quantile ) const;
+
+         static int       Bucket( long long value );
+         static long long Highest( int bucket );
+
+      private:    // Private Methods
+         Histogram( const Histogram& );              // Disabled
+         Histogram& operator=( const Histogram& );   // Disabled
+      };
+
+      /// Records the lifetime of the scope into a histogram
+      class Timer
+      {
+      private:    // Private Attributes
+         Histogram&                                           histogram;   ///< Histogram of the scope
+         std::chrono::time_point< std::chrono::steady_clock > start;       ///< Start of the scope
+
+      public:     // Public Methods
+         Timer( Histogram& histogram ) : histogram( histogram ), start( std::chrono::steady_clock::now( ) )
+         {
+         }
+
+         ~Timer( void )
+         {
+            this->histogram.Record( std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now( ) - this->start ).count( ) );
+         }
+
+      private:    // Private Methods
+         Timer( const Timer& );              // Disabled
+         Timer& operator=( const Timer& );   // Disabled
+      };
+
+      /**
+       * Writes the registry to a Prometheus text file periodically and once more when stopped.
+       */
+      class Exporter
+      {
+      private:    // Private Attributes
+         std::string             path;       ///< Prometheus text file
+         int                     interval;   ///< Seconds between writes
+         bool                    stop;       ///< The writer thread ends
+         std::mutex              mutex;      ///< Protects stop
+         std::condition_variable wake;       ///< Wakes the writer thread when stopped
+         std::thread             writer;     ///< Writer thread, not started without an interval
+
+      public:     // Public Methods
+         Exporter( void );
+         ~Exporter( void );
+
+         int Start( const std::string& path, int interval );
+         int Stop( void );
+
+      private:    // Private Methods
+         Exporter( const Exporter& );              // Disabled
+         Exporter& operator=( const Exporter& );   // Disabled
+      };
+
+      Counter&   GetCounter( const std::string& name, const std::string& help );
+      Gauge&     GetGauge( const std::string& name, const std::string& help );
+      Histogram& GetHistogram( const std::string& name, const std::string& help );
+
+      std::string Text( void );
+      int         Write( const std::string& path );
+   }
+}
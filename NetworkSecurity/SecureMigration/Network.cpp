@@ -0,0 +1,296 @@
+/**
+ * @file
+ * @brief Emulated links between the parties of a migration on a virtual clock.
+ */
+// Application Includes
+#include <Network.h>
+
+// StdLib Includes
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+using namespace SecureMigration;
+using namespace SecureMigration::Network;
+
+static const char* const Names[ Parties ] = { "Alice", "Bob", "Carol" };   ///< Names of the parties
+
+static bool number( const char*& text, double& value );
+
+Usage Usage::Since( const Usage& start ) const
+{
+   Usage usage;
+
+   usage.messages = this->messages - start.messages;
+   usage.bytes    = this->bytes - start.bytes;
+   usage.finish   = this->finish - start.finish;
+
+   return( usage );
+}
+
+/**
+ * Parses a link given as <RTT>,<Mbit/s>[,<Jitter>] in milliseconds and Mbit/s.
+ *
+ * @return 0 on success, otherwise a negative value and the link is unchanged.
+ */
+int Network::Parse( const std::string& text, Link& link )
+{
+   const char* next = text.c_str( );
+   Link        parsed;
+
+   /// @par Process Design Language
+   /// -# Parse the round trip time and the bandwidth, and the jitter when given
+   parsed.jitter = JitterDef;
+   if( !number( next, parsed.rtt ) || ( *next++ != ',' ) || !number( next, parsed.bandwidth ) )
+   {
+      return( -1 );
+   }
+   if( ( *next == ',' ) && !number( ++next, parsed.jitter ) )
+   {
+      return( -2 );
+   }
+   if( *next != '\0' )
+   {
+      return( -3 );
+   }
+
+   link = parsed;
+
+   return( 0 );
+}
+
+/**
+ * Returns the party of the given name, or a negative value when there is none.
+ */
+int Network::ParseParty( const std::string& name )
+{
+   for( int party = 0; party < Parties; party++ )
+   {
+      if( name == Names[ party ] )
+      {
+         return( party );
+      }
+   }
+
+   return( -1 );
+}
+
+/**
+ * Creates the network with the default link between every pair of parties.
+ */
+Emulator::Emulator( void )
+{
+   this->Configure( Link{ RttDef, BandwidthDef, JitterDef } );
+}
+
+/**
+ * Sets the link between every pair of parties.
+ */
+void Emulator::Configure( const Link& link )
+{
+   for( int first = 0; first < Parties; first++ )
+   {
+      for( int second = 0; second < Parties; second++ )
+      {
+         this->links[ first ][ second ] = link;
+      }
+   }
+   this->Reset( );
+}
+
+/**
+ * Sets the link between two parties in both directions.
+ */
+void Emulator::Configure( Party first, Party second, const Link& link )
+{
+   this->links[ first ][ second ] = link;
+   this->links[ second ][ first ] = link;
+   this->Reset( );
+}
+
+/**
+ * Starts a new migration: every clock at zero, no message on any link, and the jitter reseeded.
+ */
+void Emulator::Reset( void )
+{
+   for( int first = 0; first < Parties; first++ )
+   {
+      this->clocks[ first ] = 0.0;
+      for( int second = 0; second < Parties; second++ )
+      {
+         this->busy[ first ][ second ]    = 0.0;
+         this->arrived[ first ][ second ] = 0.0;
+         this->inboxes[ first ][ second ].clear( );
+      }
+   }
+   this->random.seed( SeedDef );
+   this->messages = 0;
+   this->bytes    = 0;
+}
+
+/**
+ * Advances the clock of a party by the milliseconds it spent computing.
+ */
+void Emulator::Compute( Party party, double elapsed )
+{
+   this->clocks[ party ] += elapsed;
+}
+
+/**
+ * Sends a message of the given payload length on the link. The sender's clock is not advanced, the
+ * message is serialized by the link.
+ */
+void Emulator::Send( Party from, Party to, long long length )
+{
+   const Link& link   = this->links[ from ][ to ];
+   double      depart = std::max( this->clocks[ from ], this->busy[ from ][ to ] );
+   double      delay  = link.rtt / 2.0;
+   double      arrival;
+
+   /// @par Process Design Language
+   /// -# Serialize the message at the bandwidth once the link is free
+   if( link.bandwidth > 0.0 )
+   {
+      depart += ( length * 8.0 ) / ( link.bandwidth * 1000.0 );
+   }
+   this->busy[ from ][ to ] = depart;
+
+   /// -# Propagate it for half the round trip plus the jitter, in order behind the previous message
+   if( link.jitter > 0.0 )
+   {
+      delay = std::max( 0.0, delay + std::uniform_real_distribution< double >( -link.jitter, link.jitter )( this->random ) );
+   }
+   arrival = std::max( depart + delay, this->arrived[ from ][ to ] );
+   this->arrived[ from ][ to ] = arrival;
+   this->inboxes[ from ][ to ].push_back( arrival );
+
+   this->messages++;
+   this->bytes += length;
+}
+
+/**
+ * Receives the next message on the link, waiting for its arrival.
+ *
+ * @return 0 on success, otherwise a negative value when no message was sent.
+ */
+int Emulator::Receive( Party from, Party to )
+{
+   std::deque< double >& inbox = this->inboxes[ from ][ to ];
+
+   if( inbox.empty( ) )
+   {
+      return( -1 );
+   }
+   this->clocks[ to ] = std::max( this->clocks[ to ], inbox.front( ) );
+   inbox.pop_front( );
+
+   return( 0 );
+}
+
+const Link& Emulator::Get( Party first, Party second ) const
+{
+   return( this->links[ first ][ second ] );
+}
+
+double Emulator::Clock( Party party ) const
+{
+   return( this->clocks[ party ] );
+}
+
+/**
+ * Returns the messages and bytes sent since the reset, and the time the last party finished.
+ */
+Usage Emulator::Measure( void ) const
+{
+   Usage usage;
+
+   usage.messages = this->messages;
+   usage.bytes    = this->bytes;
+   usage.finish   = *std::max_element( this->clocks, this->clocks + Parties );
+
+   return( usage );
+}
+
+/**
+ * Describes the links, once when all are the same.
+ */
+std::string Emulator::Describe( void ) const
+{
+   std::ostringstream text;
+   bool               uniform = true;
+
+   for( int first = 0; first < Parties; first++ )
+   {
+      for( int second = first + 1; second < Parties; second++ )
+      {
+         const Link& link = this->links[ first ][ second ];
+
+         uniform = uniform && ( link.rtt == this->links[ 0 ][ 1 ].rtt ) &&
+                   ( link.bandwidth == this->links[ 0 ][ 1 ].bandwidth ) && ( link.jitter == this->links[ 0 ][ 1 ].jitter );
+      }
+   }
+   for( int first = 0; first < Parties; first++ )
+   {
+      for( int second = first + 1; second < Parties; second++ )
+      {
+         const Link& link = this->links[ first ][ second ];
+
+         if( !uniform || ( ( first == 0 ) && ( second == 1 ) ) )
+         {
+            text << ( ( text.tellp( ) > 0 ) ? ", " : "" );
+            if( !uniform )
+            {
+               text << Names[ first ] << "-" << Names[ second ] << " ";
+            }
+            text << std::setprecision( 6 ) << link.rtt << " ms RTT, ";
+            if( link.bandwidth > 0.0 )
+            {
+               text << link.bandwidth << " Mbit/s";
+            }
+            else
+            {
+               text << "unlimited bandwidth";
+            }
+            if( link.jitter > 0.0 )
+            {
+               text << ", +/-" << link.jitter << " ms";
+            }
+         }
+      }
+   }
+
+   return( text.str( ) );
+}
+
+Step::Step( Emulator* emulator, Party party )
+{
+   this->emulator = emulator;
+   this->party    = party;
+   this->start    = std::chrono::steady_clock::now( );
+}
+
+Step::~Step( void )
+{
+   if( this->emulator != nullptr )
+   {
+      this->emulator->Compute( this->party, std::chrono::duration< double, std::milli >( std::chrono::steady_clock::now( ) - this->start ).count( ) );
+   }
+}
+
+/**
+ * Parses a non-negative number, moving the text past it.
+ */
+static bool number( const char*& text, double& value )
+{
+   char* end;
+
+   value = std::strtod( text, &end );
+   if( ( end == text ) || !( value >= 0.0 ) )
+   {
+      return( false );
+   }
+   text = end;
+
+   return( true );
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+// StdLib Includes
+#include <chrono>
+#include <deque>
+#include <random>
+#include <string>
+
+namespace SecureMigration
+{
+   namespace Network
+   {
+      const int          Parties      = 3;        ///< Alice, Bob, and Carol
+      const double       RttDef       = 80.0;     ///< Default round trip time in milliseconds
+      const double       BandwidthDef = 1000.0;   ///< Default bandwidth in Mbit/s
+      const double       JitterDef    = 0.0;      ///< Default jitter of the one-way delay in milliseconds
+      const unsigned int SeedDef      = 1;        ///< Seed of the jitter, so runs are reproducible
+
+      /// Party of a migration
+      enum Party
+      {
+         Alice,
+         Bob,
+         Carol
+      };
+
+      /// Emulated link between two parties, the same in both directions
+      struct Link
+      {
+         double rtt;         ///< Round trip time in milliseconds
+         double bandwidth;   ///< Bandwidth in Mbit/s, unlimited when 0
+         double jitter;      ///< Maximum deviation of the one-way delay in milliseconds
+      };
+
+      /// Messages, bytes, and virtual time of a migration, or of a phase as the difference of two
+      struct Usage
+      {
+         long long messages;   ///< Messages sent
+         long long bytes;      ///< Payload bytes sent
+         double    finish;     ///< Milliseconds until the last party finished
+
+         Usage Since( const Usage& start ) const;
+      };
+
+      int Parse( const std::string& text, Link& link );
+      int ParseParty( const std::string& name );
+
+      /**
+       * Emulated network between Alice, Bob, and Carol on a virtual clock.
+       *
+       * @details
+       * Every party keeps its own clock in milliseconds. Compute advances the clock of a party by the time
+       * it actually spent, Send queues a message on the link, and Receive moves the clock of the receiver
+       * up to the arrival of the next message on the link. A message departs once the sender's clock and
+       * the link are free, is serialized at the bandwidth of the link, and arrives half a round trip later,
+       * give or take the jitter, never before the previous message on the link. Nothing sleeps, so an 80 ms
+       * link costs no wall time. Not thread safe, the parties are driven by one thread.
+       */
+      class Emulator
+      {
+      private:    // Private Attributes
+         Link                 links[ Parties ][ Parties ];      ///< Link of every pair of parties
+         double               clocks[ Parties ];                ///< Virtual time of every party
+         double               busy[ Parties ][ Parties ];       ///< Time every directed link is free
+         double               arrived[ Parties ][ Parties ];    ///< Arrival of the last message on every directed link
+         std::deque< double > inboxes[ Parties ][ Parties ];    ///< Arrivals of the messages not yet received
+         std::mt19937         random;                           ///< Source of the jitter
+         long long            messages;                         ///< Messages sent
+         long long            bytes;                            ///< Payload bytes sent
+
+      public:     // Public Methods
+         Emulator( void );
+
+         void Configure( const Link& link );
+         void Configure( Party first, Party second, const Link& link );
+         void Reset( void );
+
+         void Compute( Party party, double elapsed );
+         void Send( Party from, Party to, long long length );
+         int  Receive( Party from, Party to );
+
+         const Link& Get( Party first, Party second ) const;
+         double      Clock( Party party ) const;
+         Usage       Measure( void ) const;
+         std::string Describe( void ) const;
+
+      private:    // Private Methods
+         Emulator( const Emulator& );              // Disabled
+         Emulator& operator=( const Emulator& );   // Disabled
+      };
+
+      /**
+       * Advances the clock of a party by the wall time of the enclosing scope, nothing when the network is
+       * not emulated.
+       */
+      class Step
+      {
+      private:    // Private Attributes
+         Emulator*                             emulator;   ///< Network of the party, null when not emulated
+         Party                                 party;      ///< Party computing
+         std::chrono::steady_clock::time_point start;      ///< Start of the scope
+
+      public:     // Public Methods
+         Step( Emulator* emulator, Party party );
+         ~Step( void );
+
+      private:    // Private Methods
+         Step( const Step& );              // Disabled
+         Step& operator=( const Step& );   // Disabled
+      };
+   }
+}
@@ -0,0 +1,224 @@
+/**
+ * @file
+ * @brief Hardware performance counters around the phases of a migration.
+ */
+// Application Includes
+#include <Perf.h>
+
+// StdLib Includes
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#if defined( __linux__ )
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#include <intrin.h>
+#elif defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+
+using namespace SecureMigration;
+using namespace SecureMigration::Perf;
+
+#if defined( __linux__ )
+static const unsigned long long Configs[ Events ] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                      PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };   ///< perf_event config per event
+#endif
+
+static std::string reason( int error );
+
+/**
+ * Returns the time-stamp counter, reference cycles at the nominal frequency of the CPU that are available
+ * where the hardware counters are not, or 0 when the CPU has none.
+ */
+long long Perf::Ticks( void )
+{
+#if ( defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) ) ) || defined( __x86_64__ ) || defined( __i386__ )
+   return( static_cast< long long >( __rdtsc( ) ) );
+#else
+   return( 0 );
+#endif
+}
+
+void Sample::Add( const Sample& sample )
+{
+   this->valid = this->valid && sample.valid;
+   this->error = ( this->error != 0 ) ? this->error : sample.error;
+   for( int event = 0; event < Events; event++ )
+   {
+      this->values[ event ] += sample.values[ event ];
+   }
+}
+
+/**
+ * Returns the instructions per cycle, 0 without cycles.
+ */
+double Sample::IPC( void ) const
+{
+   return( ( this->values[ Cycles ] > 0 ) ? static_cast< double >( this->values[ Instructions ] ) / this->values[ Cycles ] : 0.0 );
+}
+
+/**
+ * Describes the sample as cycles per unit (bytes or operations), IPC, and misses per unit, or the reason the
+ * counters are unavailable.
+ */
+std::string Sample::Describe( double units, const std::string& unit ) const
+{
+   std::ostringstream text;
+
+   if( !this->valid )
+   {
+      text << "Unavailable (" << reason( this->error ) << ")";
+   }
+   else
+   {
+      text << std::fixed << std::setprecision( ( this->values[ Cycles ] / units < 100.0 ) ? 3 : 0 )
+           << this->values[ Cycles ] / units << " Cycles/" << unit << ", IPC " << std::setprecision( 2 ) << this->IPC( )
+           << ", " << std::setprecision( 3 ) << this->values[ CacheMisses ] / units << " Cache Misses/" << unit
+           << ", " << this->values[ BranchMisses ] / units << " Branch Misses/" << unit;
+   }
+
+   return( text.str( ) );
+}
+
+Counters::Counters( void )
+{
+   for( int& fd : this->fds )
+   {
+      fd = -1;
+   }
+   this->error = ENOSYS;
+}
+
+Counters::~Counters( void )
+{
+   this->close( );
+}
+
+/**
+ * Opens the counters of the calling thread, disabled until Start.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+int Counters::Initialize( void )
+{
+   this->close( );
+   this->error = ENOSYS;
+
+   #if defined( __linux__ )
+   /// @par Process Design Language
+   /// -# Open one counter per event, counting user space of this thread and of the threads it creates
+   for( int event = 0; event < Events; event++ )
+   {
+      struct perf_event_attr attributes;
+
+      std::memset( &attributes, 0, sizeof( attributes ) );
+      attributes.size           = sizeof( attributes );
+      attributes.type           = PERF_TYPE_HARDWARE;
+      attributes.config         = Configs[ event ];
+      attributes.disabled       = 1;
+      attributes.inherit        = 1;
+      attributes.exclude_kernel = 1;
+      attributes.exclude_hv     = 1;
+      attributes.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      this->fds[ event ] = static_cast< int >( syscall( SYS_perf_event_open, &attributes, 0, -1, -1, 0 ) );
+      if( this->fds[ event ] < 0 )
+      {
+         /// -# Every event is required, a phase is reported completely or not at all
+         this->error = errno;
+         this->close( );
+         return( -1 );
+      }
+   }
+   this->error = 0;
+
+   return( 0 );
+   #else
+   return( -1 );
+   #endif
+}
+
+void Counters::Start( void )
+{
+   #if defined( __linux__ )
+   for( int fd : this->fds )
+   {
+      if( fd >= 0 )
+      {
+         ioctl( fd, PERF_EVENT_IOC_RESET, 0 );
+         ioctl( fd, PERF_EVENT_IOC_ENABLE, 0 );
+      }
+   }
+   #endif
+}
+
+/**
+ * Stops the counters and reads the events since Start, scaled up when the kernel multiplexed them.
+ */
+Sample Counters::Stop( void )
+{
+   Sample sample = { this->error == 0, this->error, { } };
+
+   #if defined( __linux__ )
+   for( int event = 0; ( event < Events ) && sample.valid; event++ )
+   {
+      unsigned long long values[ 3 ];   // Count, time enabled, time running
+
+      ioctl( this->fds[ event ], PERF_EVENT_IOC_DISABLE, 0 );
+      if( read( this->fds[ event ], values, sizeof( values ) ) != static_cast< ssize_t >( sizeof( values ) ) )
+      {
+         sample.valid = false;
+         sample.error = errno;
+      }
+      else
+      {
+         sample.values[ event ] = ( values[ 2 ] == 0 ) ? 0 :
+                                  static_cast< long long >( static_cast< double >( values[ 0 ] ) * values[ 1 ] / values[ 2 ] );
+      }
+   }
+   #endif
+
+   return( sample );
+}
+
+void Counters::close( void )
+{
+   for( int& fd : this->fds )
+   {
+      #if defined( __linux__ )
+      if( fd >= 0 )
+      {
+         ::close( fd );
+      }
+      #endif
+      fd = -1;
+   }
+}
+
+/**
+ * Returns why the counters could not be opened.
+ */
+static std::string reason( int error )
+{
+   switch( error )
+   {
+      case ENOSYS:
+         return( "perf_event_open not supported" );
+      case ENOENT:
+      case EOPNOTSUPP:
+         return( "no hardware events, e.g. a virtual machine without a virtual PMU" );
+      case EACCES:
+      case EPERM:
+         return( "not permitted by kernel.perf_event_paranoid" );
+      default:
+         return( "errno " + std::to_string( error ) );
+   }
+}
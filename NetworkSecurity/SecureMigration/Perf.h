@@ -0,0 +1,64 @@
+#pragma once
+
+// StdLib Includes
+#include <string>
+
+namespace SecureMigration
+{
+   namespace Perf
+   {
+      /// Hardware events counted per phase
+      enum Event
+      {
+         Cycles,         ///< CPU cycles
+         Instructions,   ///< Retired instructions
+         CacheMisses,    ///< Last level cache misses
+         BranchMisses,   ///< Mispredicted branches
+         Events          ///< Number of events
+      };
+
+      /// Hardware events of a phase
+      struct Sample
+      {
+         bool      valid;              ///< The counters were read
+         int       error;              ///< errno of opening the counters, 0 when opened
+         long long values[ Events ];   ///< Count per event, scaled when the counters were multiplexed
+
+         void        Add( const Sample& sample );
+         double      IPC( void ) const;
+         std::string Describe( double units, const std::string& unit ) const;
+      };
+
+      long long Ticks( void );
+
+      /**
+       * Linux hardware performance counters (perf_event_open) of the calling thread and the threads it creates
+       * afterwards, user space only.
+       *
+       * @details
+       * Counters are unavailable on other platforms, in virtual machines without a virtual PMU, and when
+       * kernel.perf_event_paranoid forbids them. Start and Stop then do nothing and Stop returns an invalid
+       * sample holding the reason.
+       */
+      class Counters
+      {
+      private:    // Private Attributes
+         int fds[ Events ];   ///< Counter file descriptors, negative when closed
+         int error;           ///< errno of opening the counters
+
+      public:     // Public Methods
+         Counters( void );
+         ~Counters( void );
+
+         int    Initialize( void );
+         void   Start( void );
+         Sample Stop( void );
+
+      private:    // Private Methods
+         Counters( const Counters& );              // Disabled
+         Counters& operator=( const Counters& );   // Disabled
+
+         void close( void );
+      };
+   }
+}
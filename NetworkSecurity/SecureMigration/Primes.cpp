@@ -0,0 +1,111 @@
+/**
+ * @file
+ * @brief Random prime search racing independent candidate searches on all cores.
+ */
+// Application Includes
+#include <Primes.h>
+#include <Utility.h>
+
+// StdLib Includes
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+using namespace SecureMigration;
+
+static int abortSearch( int event, int count, BN_GENCB* callback );
+
+/**
+ * Searches a random prime of the given size on several threads at once.
+ *
+ * @details
+ * Every thread sieves and tests its own random candidates with BN_generate_prime_ex2. The first thread to
+ * find a prime publishes it and the progress callback aborts the searches of all other threads at their
+ * next candidate or Miller-Rabin round. Since the search time of a single thread is roughly geometric,
+ * the wall time of the race falls about linearly with the number of threads.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+int Primes::Search( BIGNUM* prime, int bits, bool safe, const BIGNUM* add, const BIGNUM* rem, unsigned int threads )
+{
+   std::atomic< bool > found( false );
+   std::mutex          mutex;
+
+   /// @par Process Design Language
+   /// -# Default to one searcher per hardware thread
+   if( threads == 0 )
+   {
+      threads = std::max( 1u, std::thread::hardware_concurrency( ) );
+   }
+
+   /// -# Race the searchers, the first prime found wins and stops the others
+   Utility::ParallelFor( static_cast< int >( threads ), [ & ]( int )
+   {
+      BN_CTX*   ctx       = BN_CTX_new( );
+      BIGNUM*   candidate = BN_new( );
+      BN_GENCB* callback  = BN_GENCB_new( );
+
+      if( ( ctx != NULL ) && ( candidate != NULL ) && ( callback != NULL ) )
+      {
+         BN_GENCB_set( callback, abortSearch, &found );
+
+         if( ( BN_generate_prime_ex2( candidate, bits, safe ? 1 : 0, add, rem, callback, ctx ) == 1 ) &&
+             !found.exchange( true ) )
+         {
+            std::lock_guard< std::mutex > lock( mutex );
+
+            BN_copy( prime, candidate );
+         }
+      }
+
+      BN_GENCB_free( callback );
+      BN_clear_free( candidate );
+      BN_CTX_free( ctx );
+   }, threads );
+
+   return( found ? 0 : -1 );
+}
+
+/**
+ * Searches a safe prime p = 2q + 1 for which the given generator (2 or 5) generates the subgroup of order
+ * q, using the congruences of DH_generate_parameters_ex.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+int Primes::SafePrime( BIGNUM* prime, int bits, unsigned long generator, unsigned int threads )
+{
+   int     status = 0;
+   BIGNUM* add    = BN_new( );
+   BIGNUM* rem    = BN_new( );
+
+   /// @par Process Design Language
+   /// -# p = 23 mod 24 for generator 2, p = 59 mod 60 for generator 5, otherwise p = 11 mod 12
+   if( ( add == NULL ) || ( rem == NULL ) )
+   {
+      status = -1;
+   }
+   else if( ( BN_set_word( add, ( generator == 2 ) ? 24 : ( generator == 5 ) ? 60 : 12 ) != 1 ) ||
+            ( BN_set_word( rem, ( generator == 2 ) ? 23 : ( generator == 5 ) ? 59 : 11 ) != 1 ) )
+   {
+      status = -2;
+   }
+   /// -# Race the safe prime searches
+   else if( Search( prime, bits, true, add, rem, threads ) != 0 )
+   {
+      status = -3;
+   }
+
+   BN_free( add );
+   BN_free( rem );
+
+   return( status );
+}
+
+/**
+ * Progress callback of a searcher, aborts the search once another searcher found a prime.
+ */
+static int abortSearch( int, int, BN_GENCB* callback )
+{
+   return( static_cast< std::atomic< bool >* >( BN_GENCB_get_arg( callback ) )->load( ) ? 0 : 1 );
+}
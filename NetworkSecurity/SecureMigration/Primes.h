@@ -0,0 +1,13 @@
+#pragma once
+
+// OpenSSL Includes
+#include <openssl/bn.h>
+
+namespace SecureMigration
+{
+   namespace Primes
+   {
+      int Search( BIGNUM* prime, int bits, bool safe, const BIGNUM* add, const BIGNUM* rem, unsigned int threads = 0 );
+      int SafePrime( BIGNUM* prime, int bits, unsigned long generator, unsigned int threads = 0 );
+   }
+}
@@ -0,0 +1,161 @@
+/**
+ * @file
+ * @brief Lock-free progress of the migration phases reported to an observer at a fixed interval.
+ */
+// Application Includes
+#include <Progress.h>
+
+// StdLib Includes
+#include <chrono>
+
+using namespace SecureMigration;
+using namespace SecureMigration::Progress;
+
+std::atomic< Observer* > Progress::attached( nullptr );
+
+static std::atomic< int >       current( static_cast< int >( Phase::Idle ) );   ///< Phase running
+static std::atomic< long long > intervalNs( 0 );                                 ///< Nanoseconds between reports
+static std::atomic< long long > totalBytes( 0 );                                 ///< Bytes of the phase, 0 when unknown
+static std::atomic< long long > processed( 0 );                                  ///< Bytes processed in the phase
+static std::atomic< long long > began( 0 );                                      ///< Start of the phase
+static std::atomic< long long > deadline( 0 );                                   ///< Earliest time of the next report
+static std::atomic< long long > reportedBytes( 0 );                              ///< Bytes processed at the previous report
+static std::atomic< long long > reportedTime( 0 );                               ///< Time of the previous report
+
+static long long now( void );
+static Report    snapshot( Phase phase, long long bytes, long long time, long long since, long long sinceBytes );
+
+/**
+ * Attaches the observer receiving the progress of later phases, or detaches it when null.
+ */
+void Progress::Attach( Observer* observer, int interval )
+{
+   intervalNs.store( static_cast< long long >( interval ) * 1000000 );
+   attached.store( observer );
+}
+
+/**
+ * Ends the running phase and begins the next one.
+ */
+void Progress::Begin( Phase phase, long long total )
+{
+   Observer* observer = attached.load( );
+   long long time;
+
+   End( );
+   if( observer != nullptr )
+   {
+      /// @par Process Design Language
+      /// -# Reset the counts before publishing the phase, advances of the new phase count from zero
+      time = now( );
+      totalBytes.store( total, std::memory_order_relaxed );
+      processed.store( 0, std::memory_order_relaxed );
+      reportedBytes.store( 0, std::memory_order_relaxed );
+      reportedTime.store( time, std::memory_order_relaxed );
+      began.store( time, std::memory_order_relaxed );
+      deadline.store( time + intervalNs.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+      current.store( static_cast< int >( phase ), std::memory_order_release );
+
+      observer->Began( snapshot( phase, 0, time, time, 0 ) );
+   }
+}
+
+/**
+ * Ends the running phase, reporting its bytes and average rate.
+ */
+void Progress::End( void )
+{
+   Observer* observer = attached.load( );
+   Phase     phase    = static_cast< Phase >( current.exchange( static_cast< int >( Phase::Idle ) ) );
+   long long start    = began.load( std::memory_order_relaxed );
+
+   if( ( observer != nullptr ) && ( phase != Phase::Idle ) )
+   {
+      observer->Ended( snapshot( phase, processed.load( std::memory_order_relaxed ), now( ), start, 0 ) );
+   }
+}
+
+/**
+ * Counts bytes processed by the running phase and reports the progress once the interval passed. The
+ * thread which moves the deadline on reports, every other thread only counts.
+ */
+void Progress::Tick( long long bytes )
+{
+   Phase     phase = static_cast< Phase >( current.load( std::memory_order_acquire ) );
+   long long done;
+   long long time;
+   long long due;
+   Observer* observer;
+
+   /// @par Process Design Language
+   /// -# Count nothing outside of a phase
+   if( phase == Phase::Idle )
+   {
+      return;
+   }
+
+   /// -# Count the bytes, and report when the deadline passed and this thread claimed the report
+   done = processed.fetch_add( bytes, std::memory_order_relaxed ) + bytes;
+   time = now( );
+   due  = deadline.load( std::memory_order_relaxed );
+   if( ( time >= due ) && deadline.compare_exchange_strong( due, time + intervalNs.load( std::memory_order_relaxed ),
+                                                            std::memory_order_relaxed ) &&
+       ( ( observer = attached.load( ) ) != nullptr ) )
+   {
+      observer->Advanced( snapshot( phase, done, time, reportedTime.load( std::memory_order_relaxed ),
+                                    reportedBytes.load( std::memory_order_relaxed ) ) );
+      reportedBytes.store( done, std::memory_order_relaxed );
+      reportedTime.store( time, std::memory_order_relaxed );
+   }
+}
+
+const char* Progress::Name( Phase phase )
+{
+   switch( phase )
+   {
+      case Phase::Parameters:
+         return( "Parameters" );
+      case Phase::Exchange:
+         return( "Key Exchange" );
+      case Phase::Deduplicate:
+         return( "Deduplicate" );
+      case Phase::Compress:
+         return( "Compress" );
+      case Phase::Encrypt:
+         return( "Encrypt" );
+      case Phase::Decrypt:
+         return( "Decrypt" );
+      case Phase::Decompress:
+         return( "Decompress" );
+      case Phase::Reassemble:
+         return( "Reassemble" );
+      case Phase::Transfer:
+         return( "Transfer" );
+      default:
+         return( "Idle" );
+   }
+}
+
+/**
+ * Returns nanoseconds of the steady clock.
+ */
+static long long now( void )
+{
+   return( std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now( ).time_since_epoch( ) ).count( ) );
+}
+
+/**
+ * Returns the progress of a phase with the rate since the given time and bytes.
+ */
+static Report snapshot( Phase phase, long long bytes, long long time, long long since, long long sinceBytes )
+{
+   Report report;
+
+   report.phase   = phase;
+   report.bytes   = bytes;
+   report.total   = totalBytes.load( std::memory_order_relaxed );
+   report.elapsed = ( time - began.load( std::memory_order_relaxed ) ) / 1e6;
+   report.rate    = ( time > since ) ? ( bytes - sinceBytes ) * 1e3 / ( time - since ) : 0.0;
+
+   return( report );
+}
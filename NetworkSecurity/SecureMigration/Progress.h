@@ -0,0 +1,78 @@
+#pragma once
+
+// StdLib Includes
+#include <atomic>
+
+namespace SecureMigration
+{
+   namespace Progress
+   {
+      const int SliceLen    = 1024 * 1024;   ///< Bytes per cipher update between progress checks, a multiple of every cipher block
+      const int IntervalDef = 250;           ///< Default milliseconds between progress reports
+
+      /// Phase of a migration
+      enum class Phase
+      {
+         Idle,          ///< No migration phase running
+         Parameters,    ///< Diffie-Hellman parameter or RSA secret key generation
+         Exchange,      ///< Key exchange or key distribution
+         Deduplicate,   ///< Chunking and index lookup at Bob
+         Compress,      ///< Compression at Bob
+         Encrypt,       ///< Encryption at Bob
+         Decrypt,       ///< Decryption at Carol
+         Decompress,    ///< Decompression at Carol
+         Reassemble,    ///< Reassembly from the chunk index at Carol
+         Transfer       ///< Encryption and decryption of chunks or blocks by Bob and Carol
+      };
+
+      /// Progress of the current phase
+      struct Report
+      {
+         Phase     phase;     ///< Phase reported
+         long long bytes;     ///< Bytes processed in the phase
+         long long total;     ///< Bytes of the phase, 0 when unknown
+         double    elapsed;   ///< Milliseconds since the phase began
+         double    rate;      ///< MB/s since the previous report, the average of the phase when it ended
+      };
+
+      /**
+       * Receives the progress of a migration.
+       *
+       * @details
+       * Began and Ended are called by the thread driving the migration. Advanced is called at most once per
+       * interval by whichever thread processes the phase, workers included, so it must be thread safe and
+       * must not block.
+       */
+      class Observer
+      {
+      public:     // Public Methods
+         virtual ~Observer( void )
+         {
+         }
+
+         virtual void Began( const Report& report )    = 0;
+         virtual void Advanced( const Report& report ) = 0;
+         virtual void Ended( const Report& report )    = 0;
+      };
+
+      extern std::atomic< Observer* > attached;   ///< Observer of the migration, checked by every advance before anything else
+
+      void        Attach( Observer* observer, int interval = IntervalDef );
+      void        Begin( Phase phase, long long total = 0 );
+      void        End( void );
+      void        Tick( long long bytes );
+      const char* Name( Phase phase );
+
+      /**
+       * Counts bytes processed by the current phase from a hot loop. Without an observer this costs one
+       * relaxed atomic load, with one a few atomic operations and a clock read, never a lock or an allocation.
+       */
+      inline void Advance( long long bytes )
+      {
+         if( attached.load( std::memory_order_relaxed ) != nullptr )
+         {
+            Tick( bytes );
+         }
+      }
+   }
+}
@@ -0,0 +1,128 @@
+/**
+ * @file
+ * @brief Dedicated OpenSSL library context with the algorithms of a migration fetched once per process.
+ */
+// Application Includes
+#include <Provider.h>
+
+// OpenSSL Includes
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
+#include <openssl/provider.h>
+
+using namespace SecureMigration;
+using namespace SecureMigration::Provider;
+
+static const char* const CipherNames[ static_cast< int >( Cipher::Count ) ] =
+{
+   "AES-128-ECB", "AES-128-CBC", "AES-128-CTR", "AES-192-ECB", "AES-192-CBC", "AES-192-CTR",
+   "AES-256-ECB", "AES-256-CBC", "AES-256-CTR", "ChaCha20-Poly1305", "ChaCha20"
+};   ///< Names fetched per cipher
+
+/**
+ * Library context and the algorithms fetched from it.
+ *
+ * @details
+ * Fetching by name takes the locks of the provider store and the method cache, which contends when many
+ * threads encrypt small messages and EVP_aes_256_cbc() and the like fetch implicitly on every init. The
+ * objects fetched here are immutable and shared by all threads, so an operation only takes a reference.
+ */
+class Library
+{
+public:     // Public Attributes
+   OSSL_LIB_CTX*  context;                                         ///< Dedicated library context
+   OSSL_PROVIDER* provider;                                        ///< Default provider loaded into the context
+   EVP_CIPHER*    ciphers[ static_cast< int >( Cipher::Count ) ];   ///< Fetched ciphers
+   EVP_MD*        sha256;                                          ///< Fetched SHA-256
+   EVP_KDF*       hkdf;                                            ///< Fetched HKDF
+
+public:     // Public Methods
+   Library( void );
+   ~Library( void );
+
+private:    // Private Methods
+   Library( const Library& );              // Disabled
+   Library& operator=( const Library& );   // Disabled
+};
+
+static Library& library( void );
+
+/**
+ * Returns the library context of the migration, created on first use.
+ */
+OSSL_LIB_CTX* Provider::Context( void )
+{
+   return( library( ).context );
+}
+
+/**
+ * Returns the fetched cipher, or null when the provider does not offer it.
+ */
+const EVP_CIPHER* Provider::Get( Cipher cipher )
+{
+   return( library( ).ciphers[ static_cast< int >( cipher ) ] );
+}
+
+const EVP_MD* Provider::SHA256( void )
+{
+   return( library( ).sha256 );
+}
+
+EVP_KDF* Provider::HKDF( void )
+{
+   return( library( ).hkdf );
+}
+
+/**
+ * Returns whether the provider was loaded and every algorithm fetched.
+ */
+bool Provider::Loaded( void )
+{
+   Library& loaded = library( );
+   bool     status = ( loaded.provider != NULL ) && ( loaded.sha256 != NULL ) && ( loaded.hkdf != NULL );
+
+   for( int cipher = 0; cipher < static_cast< int >( Cipher::Count ); cipher++ )
+   {
+      status = status && ( loaded.ciphers[ cipher ] != NULL );
+   }
+
+   return( status );
+}
+
+Library::Library( void )
+{
+   /// @par Process Design Language
+   /// -# Create the context and load the default provider into it
+   this->context  = OSSL_LIB_CTX_new( );
+   this->provider = OSSL_PROVIDER_load( this->context, "default" );
+
+   /// -# Fetch every algorithm once, a failed fetch stays null
+   for( int cipher = 0; cipher < static_cast< int >( Cipher::Count ); cipher++ )
+   {
+      this->ciphers[ cipher ] = EVP_CIPHER_fetch( this->context, CipherNames[ cipher ], Properties );
+   }
+   this->sha256 = EVP_MD_fetch( this->context, "SHA256", Properties );
+   this->hkdf   = EVP_KDF_fetch( this->context, "HKDF", Properties );
+}
+
+Library::~Library( void )
+{
+   for( int cipher = 0; cipher < static_cast< int >( Cipher::Count ); cipher++ )
+   {
+      EVP_CIPHER_free( this->ciphers[ cipher ] );
+   }
+   EVP_MD_free( this->sha256 );
+   EVP_KDF_free( this->hkdf );
+   OSSL_PROVIDER_unload( this->provider );
+   OSSL_LIB_CTX_free( this->context );
+}
+
+/**
+ * Returns the library, created by the first caller of any thread.
+ */
+static Library& library( void )
+{
+   static Library instance;
+
+   return( instance );
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+// OpenSSL Includes
+#include <openssl/ossl_typ.h>
+
+namespace SecureMigration
+{
+   namespace Provider
+   {
+      const char* const Properties = "provider=default";   ///< Property query of every fetch
+
+      /// Cipher fetched once from the library context, AES grouped by key size in the order ECB, CBC, CTR
+      enum class Cipher
+      {
+         AES128ECB,          ///< AES-128-ECB
+         AES128CBC,          ///< AES-128-CBC
+         AES128CTR,          ///< AES-128-CTR
+         AES192ECB,          ///< AES-192-ECB
+         AES192CBC,          ///< AES-192-CBC
+         AES192CTR,          ///< AES-192-CTR
+         AES256ECB,          ///< AES-256-ECB
+         AES256CBC,          ///< AES-256-CBC
+         AES256CTR,          ///< AES-256-CTR
+         ChaCha20Poly1305,   ///< ChaCha20-Poly1305
+         ChaCha20,           ///< ChaCha20
+         Count               ///< Number of ciphers
+      };
+
+      OSSL_LIB_CTX*     Context( void );
+      const EVP_CIPHER* Get( Cipher cipher );
+      const EVP_MD*     SHA256( void );
+      EVP_KDF*          HKDF( void );
+      bool              Loaded( void );
+   }
+}
@@ -1,28 +1,60 @@
 // Application Includes
 #include <Key.h>
+#include <Primes.h>
+#include <Provider.h>
 #include <RSACryptosystem.h>
+#include <Trace.h>
+#include <Metrics.h>
 
 // openssl Includes
 #include <openssl/rsa.h>
 #include <openssl/pem.h>
+#include <openssl/evp.h>
+#include <openssl/core_names.h>
+#include <openssl/param_build.h>
+
+// StdLib Includes
+#include <string>
 
 using namespace SecureMigration;
 using namespace SecureMigration::RSACryptosystem;
 
+static Metrics::Histogram& keyPairLatency = Metrics::GetHistogram( "securemigration_rsa_latency_seconds{operation=\"keypair\"}",
+                                                                   "Latency of RSA operations" );
+static Metrics::Histogram& encryptLatency = Metrics::GetHistogram( "securemigration_rsa_latency_seconds{operation=\"encrypt\"}",
+                                                                   "Latency of RSA operations" );
+static Metrics::Histogram& decryptLatency = Metrics::GetHistogram( "securemigration_rsa_latency_seconds{operation=\"decrypt\"}",
+                                                                   "Latency of RSA operations" );
+static Metrics::Histogram& signLatency    = Metrics::GetHistogram( "securemigration_rsa_latency_seconds{operation=\"sign\"}",
+                                                                   "Latency of RSA operations" );
+static Metrics::Counter&   failures       = Metrics::GetCounter( "securemigration_failures_total{component=\"rsa\"}",
+                                                                 "Failed operations by component" );
+
+static EVP_PKEY*     generateParallel( unsigned int keySize, unsigned int threads );
+static bool          completeCRT( const EVP_PKEY* keyPair );
+static int           countPrimes( const EVP_PKEY* keyPair );
+static bool          hasParam( const EVP_PKEY* keyPair, const std::string& name );
+static EVP_PKEY*     parsePublic( const Key& keyPub );
+static EVP_PKEY_CTX* operation( EVP_PKEY* key );
+static int           padPSS( EVP_PKEY_CTX* context );
+
 Cipher::Cipher( void )
 {
    this->keyPublic = nullptr;
    this->keyPrivate = nullptr;
+   this->keyPair = nullptr;
 }
 
 Cipher::~Cipher( void )
 {
-   delete this->keyPrivate;
-   delete this->keyPublic;
+   this->free( );
 }
 
 Cipher::Cipher( const Cipher& cipher )
 {
+   this->keyPublic = nullptr;
+   this->keyPrivate = nullptr;
+   this->keyPair = nullptr;
    *this = cipher;
 }
 
@@ -30,6 +62,13 @@ Cipher& Cipher::Cipher::operator=( const Cipher& cipher )
 {
    if( this != &cipher )
    {
+      this->free( );
+
+      if( cipher.keyPair != nullptr )
+      {
+         EVP_PKEY_up_ref( cipher.keyPair );
+         this->keyPair = cipher.keyPair;
+      }
       if( cipher.keyPrivate != nullptr )
       {
          this->keyPrivate = new Key( *cipher.keyPrivate );
@@ -43,10 +82,20 @@ Cipher& Cipher::Cipher::operator=( const Cipher& cipher )
    return( *this );
 }
 
-int Cipher::Initialize( unsigned int keySize )
+/**
+ * Generates a new key pair. With a single thread OpenSSL generates the key, otherwise the primes are
+ * searched by racing candidate searches on the given number of threads (0 for one per hardware thread).
+ * More than two primes (at most MaxPrimes) generate a multi-prime key with OpenSSL.
+ *
+ * @details
+ * The private key is parsed once and kept with its CRT parameters, so every Decrypt and SignDigest runs
+ * the CRT path with the Montgomery contexts of the primes cached across calls. A key without complete
+ * CRT parameters is rejected.
+ */
+int Cipher::Initialize( unsigned int keySize, unsigned int threads, unsigned int primes )
 {
    int           status = 0;
-   EVP_PKEY_CTX* context = EVP_PKEY_CTX_new_id( EVP_PKEY_RSA, NULL );
+   EVP_PKEY_CTX* context = EVP_PKEY_CTX_new_from_name( Provider::Context( ), "RSA", Provider::Properties );
    EVP_PKEY* keyPair = NULL;
 
    unsigned int   priLen;
@@ -56,18 +105,24 @@ int Cipher::Initialize( unsigned int keySize )
    unsigned char* pubBuf;
    BIO* pubBio;
 
+   Trace::Span    span( "RSA Key Pair" );
+   Metrics::Timer timer( keyPairLatency );
+
    /// -# Initialize key generation context
    if( EVP_PKEY_keygen_init( context ) <= 0 )
    {
       status = -1;
    }
-   /// -# Set the number of bits for the rsa keygen
-   else if( EVP_PKEY_CTX_set_rsa_keygen_bits( context, keySize ) <= 0 )
+   /// -# Set the number of bits and primes for the rsa keygen
+   else if( ( EVP_PKEY_CTX_set_rsa_keygen_bits( context, keySize ) <= 0 ) ||
+            ( ( primes > 2 ) && ( ( primes > MaxPrimes( keySize ) ) ||
+                                  ( EVP_PKEY_CTX_set_rsa_keygen_primes( context, static_cast< int >( primes ) ) <= 0 ) ) ) )
    {
       status = -2;
    }
    /// -# Generate key pair
-   else if( EVP_PKEY_keygen( context, &keyPair ) <= 0 )
+   else if( ( ( threads == 1 ) || ( primes > 2 ) ) ? ( EVP_PKEY_keygen( context, &keyPair ) <= 0 ) :
+                                                     ( ( keyPair = generateParallel( keySize, threads ) ) == NULL ) )
    {
       status = -3;
    }
@@ -95,34 +150,62 @@ int Cipher::Initialize( unsigned int keySize )
       this->keyPublic = new Key( pubBuf, pubLen );
       delete[ ] priBuf;
       delete[ ] pubBuf;
+
+      /// -# Keep the parsed private key for the private operations
+      if( !completeCRT( keyPair ) )
+      {
+         status = -4;
+      }
+      else
+      {
+         this->keyPair = keyPair;
+         keyPair       = NULL;
+      }
    }
 
+   EVP_PKEY_free( keyPair );
    EVP_PKEY_CTX_free( context );
 
+   if( status != 0 )
+   {
+      failures.Add( );
+   }
+
    return( status );
 }
 
 int Cipher::Encrypt( const unsigned char* plaintext, unsigned char* ciphertext, int length, const Key& keyPub )
 {
-   int status = 0;
+   int           status  = 0;
+   EVP_PKEY*     key     = NULL;
+   EVP_PKEY_CTX* context = NULL;
+   size_t        outLen;
 
-   BIO* key = NULL;
-   RSA* rsa = NULL;
+   Trace::Span    span( "RSA Encrypt", nullptr, length );
+   Metrics::Timer timer( encryptLatency );
 
-   if( ( key = BIO_new_mem_buf( keyPub.Buffer( ), -1 ) ) == NULL )
+   if( ( key = parsePublic( keyPub ) ) == NULL )
    {
-      status = -1;
+      status = -2;
    }
-   else if( ( rsa = PEM_read_bio_RSA_PUBKEY( key, &rsa, NULL, NULL ) ) == NULL )
+   else if( ( ( context = operation( key ) ) == NULL ) || ( EVP_PKEY_encrypt_init( context ) <= 0 ) ||
+            ( EVP_PKEY_CTX_set_rsa_padding( context, RSA_PKCS1_PADDING ) <= 0 ) )
    {
-      status = -2;
-      BIO_free( key );
+      status = -1;
    }
    else
    {
-      status = RSA_public_encrypt( length, plaintext, ciphertext, rsa, RSA_PKCS1_PADDING );
-      BIO_free( key );
-      RSA_free( rsa );
+      outLen = static_cast< size_t >( EVP_PKEY_get_size( key ) );
+      status = ( EVP_PKEY_encrypt( context, ciphertext, &outLen, plaintext, static_cast< size_t >( length ) ) > 0 ) ?
+               static_cast< int >( outLen ) : -1;
+   }
+
+   EVP_PKEY_CTX_free( context );
+   EVP_PKEY_free( key );
+
+   if( status < 0 )
+   {
+      failures.Add( );
    }
 
    return( status );
@@ -130,87 +213,139 @@ int Cipher::Encrypt( const unsigned char* plaintext, unsigned char* ciphertext,
 
 int Cipher::Decrypt( const unsigned char* ciphertext, unsigned char* plaintext, int length )
 {
-   int status = 0;
+   int            status  = 0;
+   EVP_PKEY_CTX*  context = NULL;
+   size_t         outLen  = static_cast< size_t >( this->Size( ) );
+   Trace::Span    span( "RSA Decrypt", nullptr, length );
+   Metrics::Timer timer( decryptLatency );
 
-   BIO* key = nullptr;
-   RSA* rsa = nullptr;
-
-   if( this->keyPrivate == nullptr )
+   if( this->keyPair == nullptr )
    {
       status = -3;
    }
-   else if( ( key = BIO_new_mem_buf( this->keyPrivate->Buffer( ), -1 ) ) == NULL )
+   else if( ( ( context = operation( this->keyPair ) ) == NULL ) || ( EVP_PKEY_decrypt_init( context ) <= 0 ) ||
+            ( EVP_PKEY_CTX_set_rsa_padding( context, RSA_PKCS1_PADDING ) <= 0 ) ||
+            ( EVP_PKEY_decrypt( context, plaintext, &outLen, ciphertext, static_cast< size_t >( length ) ) <= 0 ) )
    {
       status = -1;
    }
-   else if( ( rsa = PEM_read_bio_RSAPrivateKey( key, &rsa, NULL, NULL ) ) == NULL )
+   else
    {
-      status = -2;
-      BIO_free( key );
+      status = static_cast< int >( outLen );
    }
-   else
+
+   EVP_PKEY_CTX_free( context );
+
+   if( status < 0 )
    {
-      status = RSA_private_decrypt( length, ciphertext, plaintext, rsa, RSA_PKCS1_PADDING );
-      BIO_free( key );
-      RSA_free( rsa );
+      failures.Add( );
    }
 
    return( status );
 }
 
-int Cipher::Sign( const unsigned char* plaintext, unsigned char* ciphertext, int length )
+/**
+ * Signs a message with RSA-PSS over its SHA-256 digest.
+ *
+ * @return Length of the signature, or a negative value on error.
+ */
+int Cipher::Sign( const unsigned char* message, int length, unsigned char* signature )
 {
-   int status = 0;
+   unsigned char digest[ SignatureDigestLen ];
 
-   BIO* key = NULL;
-   RSA* rsa = NULL;
+   EVP_Digest( message, static_cast< size_t >( length ), digest, NULL, Provider::SHA256( ), NULL );
+
+   return( this->SignDigest( digest, signature ) );
+}
+
+/**
+ * Checks the RSA-PSS signature of a message with the public key of the signer.
+ *
+ * @return 0 when the signature is valid, otherwise a negative value.
+ */
+int Cipher::Verify( const unsigned char* message, int length, const unsigned char* signature, int sigLen, const Key& keyPub )
+{
+   unsigned char digest[ SignatureDigestLen ];
 
-   if( this->keyPrivate == nullptr )
+   EVP_Digest( message, static_cast< size_t >( length ), digest, NULL, Provider::SHA256( ), NULL );
+
+   return( VerifyDigest( digest, signature, sigLen, keyPub ) );
+}
+
+/**
+ * Signs a SHA-256 digest with RSA-PSS (MGF1 SHA-256, salt as long as the digest) using the cached private
+ * key.
+ *
+ * @return Length of the signature, or a negative value on error.
+ */
+int Cipher::SignDigest( const unsigned char* digest, unsigned char* signature )
+{
+   int            status  = 0;
+   EVP_PKEY_CTX*  context = NULL;
+   size_t         sigLen  = static_cast< size_t >( this->Size( ) );
+   Trace::Span    span( "RSA Sign" );
+   Metrics::Timer timer( signLatency );
+
+   /// @par Process Design Language
+   /// -# Encode the digest with PSS padding and apply the private key to the encoded message
+   if( this->keyPair == nullptr )
    {
       status = -3;
    }
-   else if( ( key = BIO_new_mem_buf( this->keyPrivate->Buffer( ), -1 ) ) == NULL )
+   else if( ( ( context = operation( this->keyPair ) ) == NULL ) || ( EVP_PKEY_sign_init( context ) <= 0 ) ||
+            ( padPSS( context ) != 0 ) ||
+            ( EVP_PKEY_sign( context, signature, &sigLen, digest, SignatureDigestLen ) <= 0 ) )
    {
       status = -1;
    }
-   else if( ( rsa = PEM_read_bio_RSA_PUBKEY( key, &rsa, NULL, NULL ) ) == NULL )
+   else
    {
-      status = -2;
-      BIO_free( key );
+      status = static_cast< int >( sigLen );
    }
-   else
+
+   EVP_PKEY_CTX_free( context );
+
+   if( status < 0 )
    {
-      status = RSA_public_encrypt( length, plaintext, ciphertext, rsa, RSA_PKCS1_PADDING );
-      BIO_free( key );
-      RSA_free( rsa );
+      failures.Add( );
    }
 
    return( status );
 }
 
-int Cipher::Verify( const unsigned char* ciphertext, unsigned char* plaintext, int length, const Key& keyPub )
+/**
+ * Checks an RSA-PSS signature of a SHA-256 digest (MGF1 SHA-256, salt as long as the digest) with a public
+ * key.
+ *
+ * @return 0 when the signature is valid, otherwise a negative value.
+ */
+int Cipher::VerifyDigest( const unsigned char* digest, const unsigned char* signature, int length, const Key& keyPub )
 {
-   int status = 0;
-
-   BIO* key = nullptr;
-   RSA* rsa = nullptr;
+   int           status  = 0;
+   EVP_PKEY*     key     = NULL;
+   EVP_PKEY_CTX* context = NULL;
 
-   if( ( key = BIO_new_mem_buf( keyPub.Buffer( ), -1 ) ) == NULL )
+   /// @par Process Design Language
+   /// -# Parse the public key
+   if( ( key = parsePublic( keyPub ) ) == NULL )
    {
-      status = -1;
+      status = -2;
    }
-   else if( ( rsa = PEM_read_bio_RSAPrivateKey( key, &rsa, NULL, NULL ) ) == NULL )
+   /// -# Recover the encoded message and check its PSS padding against the digest
+   else if( length != EVP_PKEY_get_size( key ) )
    {
-      status = -2;
-      BIO_free( key );
+      status = -3;
    }
-   else
+   else if( ( ( context = operation( key ) ) == NULL ) || ( EVP_PKEY_verify_init( context ) <= 0 ) ||
+            ( padPSS( context ) != 0 ) ||
+            ( EVP_PKEY_verify( context, signature, static_cast< size_t >( length ), digest, SignatureDigestLen ) != 1 ) )
    {
-      status = RSA_private_decrypt( length, ciphertext, plaintext, rsa, RSA_PKCS1_PADDING );
-      BIO_free( key );
-      RSA_free( rsa );
+      status = -4;
    }
 
+   EVP_PKEY_CTX_free( context );
+   EVP_PKEY_free( key );
+
    return( status );
 }
 
@@ -219,6 +354,30 @@ const Key* Cipher::PublicKey( void ) const
    return( this->keyPublic );
 }
 
+/**
+ * Returns the length of the modulus and of a signature in bytes, 0 before initialization.
+ */
+int Cipher::Size( void ) const
+{
+   return( ( this->keyPair == nullptr ) ? 0 : EVP_PKEY_get_size( this->keyPair ) );
+}
+
+/**
+ * Returns the number of primes of the key, 0 before initialization.
+ */
+int Cipher::PrimeCount( void ) const
+{
+   return( ( this->keyPair == nullptr ) ? 0 : countPrimes( this->keyPair ) );
+}
+
+/**
+ * Returns the largest number of primes OpenSSL generates for a modulus of the given size.
+ */
+unsigned int Cipher::MaxPrimes( unsigned int keySize )
+{
+   return( ( keySize < 1024 ) ? 2 : ( keySize < 4096 ) ? 3 : ( keySize < 8192 ) ? 4 : 5 );
+}
+
 void Cipher::free( void )
 {
    if( this->keyPublic != nullptr )
@@ -231,7 +390,197 @@ void Cipher::free( void )
       delete this->keyPrivate;
    }
 
+   EVP_PKEY_free( this->keyPair );
+
    this->keyPublic = nullptr;
    this->keyPrivate = nullptr;
+   this->keyPair = nullptr;
+}
+
+/**
+ * Generates an RSA key pair with public exponent 65537 from primes found by parallel prime searches.
+ *
+ * @return The key pair, or NULL on error.
+ */
+static EVP_PKEY* generateParallel( unsigned int keySize, unsigned int threads )
+{
+   EVP_PKEY*       keyPair = NULL;
+   EVP_PKEY_CTX*   context = EVP_PKEY_CTX_new_from_name( Provider::Context( ), "RSA", Provider::Properties );
+   EVP_PKEY_CTX*   check   = NULL;
+   OSSL_PARAM_BLD* build   = OSSL_PARAM_BLD_new( );
+   OSSL_PARAM*     params  = NULL;
+   BN_CTX*         ctx     = BN_CTX_new( );
+   BIGNUM*         e       = BN_new( );
+   BIGNUM*         p       = BN_secure_new( );
+   BIGNUM*         q       = BN_secure_new( );
+   BIGNUM*         n       = BN_new( );
+   BIGNUM*         d       = BN_secure_new( );
+   BIGNUM*         dmp1    = BN_secure_new( );
+   BIGNUM*         dmq1    = BN_secure_new( );
+   BIGNUM*         iqmp    = BN_secure_new( );
+   BIGNUM*         p1      = BN_secure_new( );
+   BIGNUM*         q1      = BN_secure_new( );
+   BIGNUM*         lambda  = BN_secure_new( );
+   bool            ok      = ( context != NULL ) && ( build != NULL ) && ( ctx != NULL ) && ( e != NULL ) &&
+                             ( p != NULL ) && ( q != NULL ) && ( n != NULL ) && ( d != NULL ) && ( dmp1 != NULL ) && ( dmq1 != NULL ) && ( iqmp != NULL ) &&
+                             ( p1 != NULL ) && ( q1 != NULL ) && ( lambda != NULL ) && ( BN_set_word( e, RSA_F4 ) == 1 );
+   auto            search  = [ & ]( BIGNUM* prime, int bits )
+   {
+      /// Primes with p = 1 mod e are skipped so e is invertible mod p - 1
+      do
+      {
+         ok = ( Primes::Search( prime, bits, false, NULL, NULL, threads ) == 0 );
+      } while( ok && ( BN_mod_word( prime, RSA_F4 ) == 1 ) );
+   };
+
+   /// @par Process Design Language
+   /// -# Search both halves of the modulus, the top two bits of each are set so n has exactly keySize bits
+   if( ok )
+   {
+      search( p, static_cast< int >( ( keySize + 1 ) / 2 ) );
+   }
+   while( ok )
+   {
+      search( q, static_cast< int >( keySize / 2 ) );
+      if( BN_cmp( p, q ) != 0 )
+      {
+         break;
+      }
+   }
+
+   /// -# n = pq, d = e^-1 mod lcm(p - 1, q - 1), and the CRT exponents and coefficient
+   ok = ok && ( BN_mul( n, p, q, ctx ) == 1 ) &&
+        ( BN_sub( p1, p, BN_value_one( ) ) == 1 ) && ( BN_sub( q1, q, BN_value_one( ) ) == 1 ) &&
+        ( BN_mul( lambda, p1, q1, ctx ) == 1 ) && ( BN_gcd( d, p1, q1, ctx ) == 1 ) &&
+        ( BN_div( lambda, NULL, lambda, d, ctx ) == 1 ) &&
+        ( BN_mod_inverse( d, e, lambda, ctx ) != NULL ) &&
+        ( BN_mod( dmp1, d, p1, ctx ) == 1 ) && ( BN_mod( dmq1, d, q1, ctx ) == 1 ) &&
+        ( BN_mod_inverse( iqmp, q, p, ctx ) != NULL );
+
+   /// -# Build the key from its components
+   ok = ok && ( OSSL_PARAM_BLD_push_BN( build, OSSL_PKEY_PARAM_RSA_N, n ) == 1 ) &&
+        ( OSSL_PARAM_BLD_push_BN( build, OSSL_PKEY_PARAM_RSA_E, e ) == 1 ) &&
+        ( OSSL_PARAM_BLD_push_BN( build, OSSL_PKEY_PARAM_RSA_D, d ) == 1 ) &&
+        ( OSSL_PARAM_BLD_push_BN( build, OSSL_PKEY_PARAM_RSA_FACTOR1, p ) == 1 ) &&
+        ( OSSL_PARAM_BLD_push_BN( build, OSSL_PKEY_PARAM_RSA_FACTOR2, q ) == 1 ) &&
+        ( OSSL_PARAM_BLD_push_BN( build, OSSL_PKEY_PARAM_RSA_EXPONENT1, dmp1 ) == 1 ) &&
+        ( OSSL_PARAM_BLD_push_BN( build, OSSL_PKEY_PARAM_RSA_EXPONENT2, dmq1 ) == 1 ) &&
+        ( OSSL_PARAM_BLD_push_BN( build, OSSL_PKEY_PARAM_RSA_COEFFICIENT1, iqmp ) == 1 ) &&
+        ( ( params = OSSL_PARAM_BLD_to_param( build ) ) != NULL ) &&
+        ( EVP_PKEY_fromdata_init( context ) == 1 ) && ( EVP_PKEY_fromdata( context, &keyPair, EVP_PKEY_KEYPAIR, params ) == 1 );
+
+   /// -# Verify the key
+   if( ok && ( ( ( check = EVP_PKEY_CTX_new_from_pkey( Provider::Context( ), keyPair, Provider::Properties ) ) == NULL ) ||
+               ( EVP_PKEY_check( check ) != 1 ) ) )
+   {
+      EVP_PKEY_free( keyPair );
+      keyPair = NULL;
+   }
+
+   EVP_PKEY_CTX_free( check );
+   EVP_PKEY_CTX_free( context );
+   OSSL_PARAM_free( params );
+   OSSL_PARAM_BLD_free( build );
+   BN_free( e );
+   BN_free( n );
+   BN_clear_free( p );
+   BN_clear_free( q );
+   BN_clear_free( d );
+   BN_clear_free( dmp1 );
+   BN_clear_free( dmq1 );
+   BN_clear_free( iqmp );
+   BN_clear_free( p1 );
+   BN_clear_free( q1 );
+   BN_clear_free( lambda );
+   BN_CTX_free( ctx );
+
+   return( keyPair );
+}
+
+/**
+ * Checks that a private key carries the CRT parameters of all of its primes, so the private operations
+ * never fall back to a full-size exponentiation.
+ */
+static bool completeCRT( const EVP_PKEY* keyPair )
+{
+   int  primes = countPrimes( keyPair );
+   bool status = ( primes >= 2 );
+
+   for( int prime = 1; status && ( prime <= primes ); prime++ )
+   {
+      status = hasParam( keyPair, OSSL_PKEY_PARAM_RSA_EXPONENT + std::to_string( prime ) ) &&
+               ( ( prime == primes ) || hasParam( keyPair, OSSL_PKEY_PARAM_RSA_COEFFICIENT + std::to_string( prime ) ) );
+   }
+
+   return( status );
 }
 
+/**
+ * Returns the number of primes of a private key, 0 for a public key.
+ */
+static int countPrimes( const EVP_PKEY* keyPair )
+{
+   int primes = 0;
+
+   while( hasParam( keyPair, OSSL_PKEY_PARAM_RSA_FACTOR + std::to_string( primes + 1 ) ) )
+   {
+      primes++;
+   }
+
+   return( primes );
+}
+
+/**
+ * Returns whether a key has the big number parameter of the given name.
+ */
+static bool hasParam( const EVP_PKEY* keyPair, const std::string& name )
+{
+   BIGNUM* value  = NULL;
+   bool    status = ( EVP_PKEY_get_bn_param( keyPair, name.c_str( ), &value ) == 1 );
+
+   BN_clear_free( value );
+
+   return( status );
+}
+
+/**
+ * Parses a PEM public key into the library context.
+ *
+ * @return The public key, or NULL on error.
+ */
+static EVP_PKEY* parsePublic( const Key& keyPub )
+{
+   EVP_PKEY* key = NULL;
+   BIO*      bio = BIO_new_mem_buf( keyPub.Buffer( ), static_cast< int >( keyPub.Length( ) ) );
+
+   if( bio != NULL )
+   {
+      key = PEM_read_bio_PUBKEY_ex( bio, NULL, NULL, NULL, Provider::Context( ), Provider::Properties );
+   }
+
+   BIO_free( bio );
+
+   return( key );
+}
+
+/**
+ * Creates the context of a public or private key operation in the library context.
+ */
+static EVP_PKEY_CTX* operation( EVP_PKEY* key )
+{
+   return( EVP_PKEY_CTX_new_from_pkey( Provider::Context( ), key, Provider::Properties ) );
+}
+
+/**
+ * Sets PSS padding with SHA-256, MGF1 SHA-256, and a salt as long as the digest on an initialized signature
+ * operation.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+static int padPSS( EVP_PKEY_CTX* context )
+{
+   return( ( ( EVP_PKEY_CTX_set_rsa_padding( context, RSA_PKCS1_PSS_PADDING ) > 0 ) &&
+             ( EVP_PKEY_CTX_set_signature_md( context, Provider::SHA256( ) ) > 0 ) &&
+             ( EVP_PKEY_CTX_set_rsa_mgf1_md( context, Provider::SHA256( ) ) > 0 ) &&
+             ( EVP_PKEY_CTX_set_rsa_pss_saltlen( context, SignatureDigestLen ) > 0 ) ) ? 0 : -1 );
+}
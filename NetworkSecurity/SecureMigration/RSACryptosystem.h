@@ -2,15 +2,20 @@
 
 #include <Key.h>
 
+#include <openssl/ossl_typ.h>
+
 namespace SecureMigration
 {
    namespace RSACryptosystem
    {
+      const int SignatureDigestLen = 32;   ///< SHA-256 digest signed by SignDigest
+
       class Cipher
       {
       private:    // Private Attributes
-         Key* keyPublic;    ///< Public Key
-         Key* keyPrivate;   ///< Private Key
+         Key*      keyPublic;    ///< Public Key
+         Key*      keyPrivate;   ///< Private Key
+         EVP_PKEY* keyPair;      ///< Parsed private key with its CRT parameters, reused by every private operation
 
       public:     // Public Methods
          Cipher( void );
@@ -19,13 +24,21 @@ namespace SecureMigration
          Cipher( const Cipher& cipher );
          Cipher& operator=( const Cipher& cipher );
 
-         int Initialize( unsigned int keySize );
+         int Initialize( unsigned int keySize, unsigned int threads = 1, unsigned int primes = 2 );
          int Encrypt( const unsigned char* plaintext, unsigned char* ciphertext, int length, const Key& keyPub );
          int Decrypt( const unsigned char* ciphertext, unsigned char* plaintext, int length );
-         int Sign( const unsigned char* plaintext, unsigned char* ciphertext, int length );
-         int Verify( const unsigned char* ciphertext, unsigned char* plaintext, int length, const Key& keyPub );
+         int Sign( const unsigned char* message, int length, unsigned char* signature );
+         int SignDigest( const unsigned char* digest, unsigned char* signature );
 
          const Key* PublicKey( void ) const;
+         int        PrimeCount( void ) const;
+         int        Size( void ) const;
+
+         static int          Verify( const unsigned char* message, int length, const unsigned char* signature, int sigLen,
+                                     const Key& keyPub );
+         static int          VerifyDigest( const unsigned char* digest, const unsigned char* signature, int length,
+                                           const Key& keyPub );
+         static unsigned int MaxPrimes( unsigned int keySize );
 
       private:    // Private Methods
          void free( void );
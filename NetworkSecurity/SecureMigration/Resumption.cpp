@@ -0,0 +1,205 @@
+/**
+ * @file
+ * @brief Session resumption cache deriving per-migration keys from cached master secrets.
+ */
+// Application Includes
+#include <Provider.h>
+#include <Resumption.h>
+
+// OpenSSL Includes
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/core_names.h>
+#include <openssl/kdf.h>
+#include <openssl/params.h>
+
+using namespace SecureMigration;
+using namespace SecureMigration::Resumption;
+
+static const char* const Label = "SecureMigration resumption";   ///< HKDF info of resumed migration keys
+
+/**
+ * Derives key material with HKDF-SHA256 (RFC 5869).
+ *
+ * @return Length of the derived key, or a negative value on error.
+ */
+int Resumption::HKDF( const unsigned char* secret, int secretLen, const unsigned char* salt, int saltLen,
+                      const std::string& info, unsigned char* key, int keyLen )
+{
+   int          status  = keyLen;
+   EVP_KDF_CTX* context = EVP_KDF_CTX_new( Provider::HKDF( ) );
+   OSSL_PARAM   params[ 5 ];
+
+   /// @par Process Design Language
+   /// -# Set up the HKDF parameters
+   params[ 0 ] = OSSL_PARAM_construct_utf8_string( OSSL_KDF_PARAM_DIGEST, const_cast< char* >( "SHA256" ), 0 );
+   params[ 1 ] = OSSL_PARAM_construct_octet_string( OSSL_KDF_PARAM_SALT, const_cast< unsigned char* >( salt ),
+                                                    static_cast< size_t >( saltLen ) );
+   params[ 2 ] = OSSL_PARAM_construct_octet_string( OSSL_KDF_PARAM_KEY, const_cast< unsigned char* >( secret ),
+                                                    static_cast< size_t >( secretLen ) );
+   params[ 3 ] = OSSL_PARAM_construct_octet_string( OSSL_KDF_PARAM_INFO, const_cast< char* >( info.data( ) ), info.size( ) );
+   params[ 4 ] = OSSL_PARAM_construct_end( );
+   if( context == NULL )
+   {
+      status = -1;
+   }
+   /// -# Extract and expand the key
+   else if( EVP_KDF_derive( context, key, static_cast< size_t >( keyLen ), params ) <= 0 )
+   {
+      status = -2;
+   }
+
+   EVP_KDF_CTX_free( context );
+
+   return( status );
+}
+
+Cache::Cache( size_t capacity, std::chrono::steady_clock::duration lifetime )
+{
+   this->capacity  = ( capacity > 0 ) ? capacity : 1;
+   this->lifetime  = lifetime;
+   this->hits      = 0;
+   this->misses    = 0;
+   this->evictions = 0;
+}
+
+Cache::~Cache( void )
+{
+   this->Clear( );
+}
+
+/**
+ * Caches the master secret of a full key exchange between the parties, replacing a previous one, and
+ * records the cost of the full exchange as the key setup of the first migration.
+ */
+void Cache::Store( const std::string& peers, const unsigned char* master, int length, double setup )
+{
+   std::lock_guard< std::mutex > lock( this->mutex );
+   auto                          found = this->lookup.find( peers );
+
+   /// @par Process Design Language
+   /// -# Replace an existing entry of the parties
+   if( found != this->lookup.end( ) )
+   {
+      this->erase( found->second );
+   }
+
+   /// -# Evict the least recently used entry when the cache is full
+   if( this->entries.size( ) >= this->capacity )
+   {
+      this->erase( std::prev( this->entries.end( ) ) );
+      this->evictions++;
+   }
+
+   /// -# Insert the entry as the most recently used
+   this->entries.push_front( Entry{ peers, std::vector< unsigned char >( master, master + length ),
+                                    std::chrono::steady_clock::now( ) + this->lifetime, setup, 1 } );
+   this->lookup[ peers ] = this->entries.begin( );
+}
+
+/**
+ * Derives a per-migration key from the cached master secret of the parties and the nonce.
+ *
+ * @return Length of the derived key, or a negative value when no valid master secret is cached.
+ */
+int Cache::Derive( const std::string& peers, const unsigned char* nonce, unsigned char* key, int keyLen )
+{
+   int                           status = -1;
+   std::lock_guard< std::mutex > lock( this->mutex );
+   auto                          found  = this->lookup.find( peers );
+
+   /// @par Process Design Language
+   /// -# Expired master secrets are removed and never used
+   if( ( found != this->lookup.end( ) ) && ( std::chrono::steady_clock::now( ) >= found->second->expires ) )
+   {
+      this->erase( found->second );
+      this->evictions++;
+      found = this->lookup.end( );
+   }
+
+   if( found == this->lookup.end( ) )
+   {
+      this->misses++;
+   }
+   /// -# Mark the entry most recently used and derive the key bound to the parties and the nonce
+   else
+   {
+      this->entries.splice( this->entries.begin( ), this->entries, found->second );
+      this->hits++;
+      status = HKDF( found->second->master.data( ), static_cast< int >( found->second->master.size( ) ),
+                     nonce, NonceLen, std::string( Label ) + "|" + peers, key, keyLen );
+   }
+
+   return( status );
+}
+
+/**
+ * Accounts the key setup cost of a migration resumed from the master secret of the parties.
+ */
+void Cache::Account( const std::string& peers, double setup )
+{
+   std::lock_guard< std::mutex > lock( this->mutex );
+   auto                          found = this->lookup.find( peers );
+
+   if( found != this->lookup.end( ) )
+   {
+      found->second->setup += setup;
+      found->second->migrations++;
+   }
+}
+
+void Cache::Clear( void )
+{
+   std::lock_guard< std::mutex > lock( this->mutex );
+
+   while( !this->entries.empty( ) )
+   {
+      this->erase( this->entries.begin( ) );
+   }
+}
+
+size_t Cache::Count( void ) const
+{
+   std::lock_guard< std::mutex > lock( this->mutex );
+
+   return( this->entries.size( ) );
+}
+
+long long Cache::Hits( void ) const
+{
+   return( this->hits );
+}
+
+long long Cache::Misses( void ) const
+{
+   return( this->misses );
+}
+
+long long Cache::Evictions( void ) const
+{
+   return( this->evictions );
+}
+
+/**
+ * Returns the key setup cost per migration between the parties, the full key exchange amortized over
+ * every migration keyed from its master secret.
+ */
+double Cache::Amortized( const std::string& peers, int& migrations ) const
+{
+   std::lock_guard< std::mutex > lock( this->mutex );
+   auto                          found = this->lookup.find( peers );
+
+   migrations = ( found == this->lookup.end( ) ) ? 0 : found->second->migrations;
+
+   return( ( migrations == 0 ) ? 0.0 : ( found->second->setup / migrations ) );
+}
+
+/**
+ * Removes an entry, wiping its master secret.
+ */
+void Cache::erase( std::list< Entry >::iterator entry )
+{
+   OPENSSL_cleanse( entry->master.data( ), entry->master.size( ) );
+   this->lookup.erase( entry->peers );
+   this->entries.erase( entry );
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+// StdLib Includes
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SecureMigration
+{
+   namespace Resumption
+   {
+      const size_t               CapacityDef = 1024;                      ///< Default number of cached master secrets
+      const std::chrono::seconds LifetimeDef = std::chrono::hours( 1 );   ///< Default lifetime of a master secret
+      const int                  NonceLen    = 16;                        ///< Length of the per-migration nonce
+
+      int HKDF( const unsigned char* secret, int secretLen, const unsigned char* salt, int saltLen,
+                const std::string& info, unsigned char* key, int keyLen );
+
+      /**
+       * Bounded cache of the master secrets established by full key exchanges, keyed by the parties of the
+       * exchange.
+       *
+       * @details
+       * A later migration between the same parties derives a fresh key from the cached master secret and
+       * a per-migration nonce with HKDF-SHA256 instead of exchanging keys again. Entries expire after
+       * their lifetime, and the least recently used entry is evicted when the cache is full. The cache
+       * also accounts the key setup cost of every migration between the parties.
+       */
+      class Cache
+      {
+      private:    // Private Types
+         struct Entry
+         {
+            std::string                             peers;        ///< Parties of the key exchange
+            std::vector< unsigned char >            master;       ///< Master secret of the key exchange
+            std::chrono::steady_clock::time_point   expires;      ///< Time the master secret expires
+            double                                  setup;        ///< Milliseconds of key setup of all migrations
+            int                                     migrations;   ///< Migrations keyed from the master secret
+         };
+
+      private:    // Private Attributes
+         size_t                                                         capacity;    ///< Maximum number of entries
+         std::chrono::steady_clock::duration                            lifetime;    ///< Lifetime of an entry
+         std::list< Entry >                                             entries;     ///< Entries, most recently used first
+         std::unordered_map< std::string, std::list< Entry >::iterator > lookup;      ///< Entries by parties
+         mutable std::mutex                                             mutex;       ///< Protects the entries
+         long long                                                      hits;        ///< Lookups of a valid entry
+         long long                                                      misses;      ///< Lookups of a missing or expired entry
+         long long                                                      evictions;   ///< Entries evicted or expired
+
+      public:     // Public Methods
+         Cache( size_t capacity = CapacityDef, std::chrono::steady_clock::duration lifetime = LifetimeDef );
+         ~Cache( void );
+
+         void Store( const std::string& peers, const unsigned char* master, int length, double setup );
+         int  Derive( const std::string& peers, const unsigned char* nonce, unsigned char* key, int keyLen );
+         void Account( const std::string& peers, double setup );
+         void Clear( void );
+
+         size_t    Count( void ) const;
+         long long Hits( void ) const;
+         long long Misses( void ) const;
+         long long Evictions( void ) const;
+         double    Amortized( const std::string& peers, int& migrations ) const;
+
+      private:    // Private Methods
+         Cache( const Cache& );              // Disabled
+         Cache& operator=( const Cache& );   // Disabled
+
+         void erase( std::list< Entry >::iterator entry );
+      };
+   }
+}
@@ -0,0 +1,168 @@
+/**
+ * @file
+ * @brief Work-stealing thread pool scheduling the objects and object chunks of a multi-object migration.
+ */
+// Application Includes
+#include <Scheduler.h>
+
+// StdLib Includes
+#include <algorithm>
+
+using namespace SecureMigration;
+using namespace SecureMigration::Scheduler;
+
+static thread_local const Pool* owner  = nullptr;   ///< Pool of the calling worker thread
+static thread_local unsigned int worker = 0;         ///< Index of the calling worker thread
+
+Pool::Pool( unsigned int threads )
+   : pending( 0 ), queued( 0 ), steals( 0 ), next( 0 )
+{
+   /// @par Process Design Language
+   /// -# Default to one worker per hardware thread
+   this->threads = ( threads > 0 ) ? threads : std::max( 1u, std::thread::hardware_concurrency( ) );
+   this->queues  = new Queue[ this->threads ];
+   this->stop    = false;
+
+   /// -# Start the workers
+   for( unsigned int i = 0; i < this->threads; i++ )
+   {
+      this->workers.emplace_back( &Pool::work, this, i );
+   }
+}
+
+Pool::~Pool( void )
+{
+   {
+      std::lock_guard< std::mutex > lock( this->mutex );
+      this->stop = true;
+   }
+   this->idle.notify_all( );
+
+   for( std::thread& thread : this->workers )
+   {
+      thread.join( );
+   }
+
+   delete[ ] this->queues;
+}
+
+/**
+ * Queues a task. A task submitted by a worker of the pool goes to the back of that worker's deque,
+ * otherwise tasks are distributed round robin.
+ */
+void Pool::Submit( Task task )
+{
+   unsigned int target = ( owner == this ) ? worker : ( this->next++ % this->threads );
+
+   this->pending++;
+   {
+      std::lock_guard< std::mutex > lock( this->queues[ target ].mutex );
+      this->queues[ target ].tasks.push_back( std::move( task ) );
+   }
+   this->queued++;
+
+   {
+      std::lock_guard< std::mutex > lock( this->mutex );
+   }
+   this->idle.notify_one( );
+}
+
+/**
+ * Blocks until every submitted task, including the tasks they spawned, has completed.
+ */
+void Pool::Wait( void )
+{
+   std::unique_lock< std::mutex > lock( this->mutex );
+
+   this->done.wait( lock, [ this ]( void ) { return( this->pending == 0 ); } );
+}
+
+unsigned int Pool::Threads( void ) const
+{
+   return( this->threads );
+}
+
+long long Pool::Steals( void ) const
+{
+   return( this->steals );
+}
+
+/**
+ * Takes the newest task of the worker's own deque, or steals the oldest task of another deque.
+ */
+bool Pool::take( unsigned int self, Task& task )
+{
+   bool status = false;
+
+   /// @par Process Design Language
+   /// -# Pop from the back of the own deque
+   {
+      std::lock_guard< std::mutex > lock( this->queues[ self ].mutex );
+
+      if( !this->queues[ self ].tasks.empty( ) )
+      {
+         task = std::move( this->queues[ self ].tasks.back( ) );
+         this->queues[ self ].tasks.pop_back( );
+         status = true;
+      }
+   }
+
+   /// -# Steal from the front of the other deques, starting with the next worker
+   for( unsigned int i = 1; !status && ( i < this->threads ); i++ )
+   {
+      Queue&                        victim = this->queues[ ( self + i ) % this->threads ];
+      std::lock_guard< std::mutex > lock( victim.mutex );
+
+      if( !victim.tasks.empty( ) )
+      {
+         task = std::move( victim.tasks.front( ) );
+         victim.tasks.pop_front( );
+         this->steals++;
+         status = true;
+      }
+   }
+
+   if( status )
+   {
+      this->queued--;
+   }
+
+   return( status );
+}
+
+void Pool::work( unsigned int self )
+{
+   Task task;
+
+   owner  = this;
+   worker = self;
+
+   while( true )
+   {
+      /// @par Process Design Language
+      /// -# Run tasks while any deque holds one
+      if( this->take( self, task ) )
+      {
+         task( );
+         task = nullptr;
+
+         /// -# Wake the waiting thread when the last pending task completes
+         if( --this->pending == 0 )
+         {
+            std::lock_guard< std::mutex > lock( this->mutex );
+            this->done.notify_all( );
+         }
+      }
+      /// -# Sleep until a task is queued or the pool stops
+      else
+      {
+         std::unique_lock< std::mutex > lock( this->mutex );
+
+         this->idle.wait( lock, [ this ]( void ) { return( this->stop || ( this->queued > 0 ) ); } );
+         if( this->stop )
+         {
+            break;
+         }
+      }
+   }
+}
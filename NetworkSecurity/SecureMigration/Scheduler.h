@@ -0,0 +1,67 @@
+#pragma once
+
+// StdLib Includes
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SecureMigration
+{
+   namespace Scheduler
+   {
+      using Task = std::function< void( void ) >;
+
+      /**
+       * Fixed size thread pool with one task deque per worker.
+       *
+       * @details
+       * A worker pushes the tasks it spawns onto the back of its own deque and pops from the back, so the
+       * chunks of an object it split are processed while the object is still in cache. An idle worker
+       * steals from the front of the other deques, taking the oldest and usually largest piece of work,
+       * so the chunks of a large object spread across all workers at the tail of a migration.
+       */
+      class Pool
+      {
+      private:    // Private Types
+         struct Queue
+         {
+            std::mutex         mutex;   ///< Protects the deque
+            std::deque< Task > tasks;   ///< Tasks of the worker
+         };
+
+      private:    // Private Attributes
+         unsigned int                threads;    ///< Number of workers
+         Queue*                      queues;     ///< Deque of every worker
+         std::vector< std::thread >  workers;    ///< Worker threads
+         std::atomic< long long >    pending;    ///< Tasks submitted and not yet completed
+         std::atomic< long long >    queued;     ///< Tasks waiting in a deque
+         std::atomic< long long >    steals;     ///< Tasks taken from another worker's deque
+         std::atomic< unsigned int > next;       ///< Deque receiving the next task submitted from outside the pool
+         bool                        stop;       ///< Workers exit once set
+         std::mutex                  mutex;      ///< Protects stop and the condition variables
+         std::condition_variable     idle;       ///< Signalled when a task is queued or the pool stops
+         std::condition_variable     done;       ///< Signalled when the last pending task completes
+
+      public:     // Public Methods
+         Pool( unsigned int threads = 0 );
+         ~Pool( void );
+
+         void Submit( Task task );
+         void Wait( void );
+
+         unsigned int Threads( void ) const;
+         long long    Steals( void ) const;
+
+      private:    // Private Methods
+         Pool( const Pool& );              // Disabled
+         Pool& operator=( const Pool& );   // Disabled
+
+         bool take( unsigned int self, Task& task );
+         void work( unsigned int self );
+      };
+   }
+}
@@ -13,20 +13,191 @@
 #include <DiffieHellman.h>
 #include <AES.h>
 #include <RSACryptosystem.h>
+#include <Compression.h>
+#include <Deduplication.h>
+#include <Delta.h>
+#include <Journal.h>
+#include <Scheduler.h>
+#include <Handshake.h>
+#include <Resumption.h>
+#include <Manifest.h>
+#include <Ed25519.h>
+#include <Trace.h>
+#include <Metrics.h>
+#include <Perf.h>
+#include <Memory.h>
+#include <Progress.h>
+#include <Network.h>
+#include <Provider.h>
+#include <AESNI.h>
 
 // OpenSSL Includes
 #include <openssl/bn.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
 
 // StdLib Includes
 #include <iostream>
 #include <chrono>
 #include <iomanip>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
 
 using HighResClock = std::chrono::high_resolution_clock;
 using Milliseconds = std::chrono::duration< double, std::ratio< 1, 1000 > >;
 
 using namespace SecureMigration;
 
+static const int SessionKeyLen = 48;   ///< AES-256 key and IV derived for a resumed migration
+
+/// Measurements of the bulk transfer from Bob to Carol
+struct TransferStats
+{
+   int       migrated;       ///< Ciphertext bytes sent from Bob to Carol
+   int       migratedRaw;    ///< Ciphertext bytes sent without the compression stage
+   int       compressed;     ///< Bytes produced by the compression stage
+   double    elapsed;        ///< Milliseconds for the complete transfer
+   double    elapsedZip;     ///< Milliseconds spent compressing at Bob
+   double    elapsedUnzip;   ///< Milliseconds spent decompressing at Carol
+   double    elapsedRaw;     ///< Milliseconds to encrypt/decrypt the uncompressed plaintext
+   double    elapsedDedup;   ///< Milliseconds spent chunking, hashing and packing at Bob
+   double    elapsedUndedup; ///< Milliseconds spent verifying and reassembling at Carol
+   double    elapsedSign;    ///< Milliseconds spent signing blocks at Bob
+   int       messages;       ///< Messages authenticated by the signed manifest
+   double    elapsedSigning; ///< Milliseconds spent hashing and signing the manifest at Bob
+   double    elapsedVerify;  ///< Milliseconds spent verifying the manifest and the messages at Carol
+   int       blocks;         ///< Blocks of the object in incremental mode
+   int       changed;        ///< Blocks sent in incremental mode
+   long long changedLen;     ///< Bytes of the blocks sent in incremental mode
+   int       resumed;        ///< Chunks already migrated before a resumed migration
+   int       syncs;          ///< Checkpoint journal syncs
+   bool      resumedKey;     ///< Session key was restored from an interrupted migration
+
+   Perf::Sample perfEncrypt;   ///< Hardware events of the encryption at Bob
+   Perf::Sample perfDecrypt;   ///< Hardware events of the decryption at Carol
+
+   Memory::Usage memory;   ///< Allocations and peak memory of the transfer
+
+   Network::Usage network;   ///< Emulated messages, bytes, and time of the migration until the transfer began
+
+   Deduplication::Stats dedup;   ///< Deduplication measurements
+};
+
+/// Long-term signing key of a party authenticating its Diffie-Hellman public values
+struct Identity
+{
+   Ed25519::Signer         ed25519;   ///< Ed25519 signing key
+   RSACryptosystem::Cipher rsa;       ///< RSA signing key
+};
+
+/// Measurements of a multi-object migration, updated concurrently by the workers
+struct ObjectStats
+{
+   std::atomic< long long > objects;    ///< Objects completely migrated
+   std::atomic< long long > bytes;      ///< Bytes of the objects read at Bob
+   std::atomic< long long > chunks;     ///< Chunk tasks executed
+   std::atomic< long long > failures;   ///< Objects which could not be read or did not decrypt correctly
+};
+
+static void listObjects( const std::string& path, std::vector< std::string >& objects );
+static void migrateObject( Scheduler::Pool& pool, const std::string& path, unsigned int index,
+                           const unsigned char* keyBob, const unsigned char* keyCarol, int split, ObjectStats& stats );
+static bool migrateChunk( const std::vector< unsigned char >& object, unsigned int index, int chunk, int split,
+                          const unsigned char* keyBob, const unsigned char* keyCarol );
+static bool resume( const Simulation::Options& options, unsigned char* key );
+static int  generateParams( int keyLen, const Simulation::Options& options, Key** params );
+static bool resumeSession( const Simulation::Options& options, const std::string& peers,
+                           unsigned char* keyBob, unsigned char* keyCarol, double& elapsed );
+static void printSetup( const Simulation::Options& options, const std::string& peers, bool resumed );
+static int  initIdentity( const std::string& scheme, Identity& identity );
+static int  signValue( const std::string& scheme, Identity& identity, const Key& value, std::vector< unsigned char >& signature );
+static int  verifyValue( const std::string& scheme, const Identity& signer, const Key& value,
+                         const std::vector< unsigned char >& signature );
+static int  exchangeDiffieHellman( int keyLen, const Simulation::Options& options, DiffieHellman::Session& Alice,
+                                   DiffieHellman::Session& Bob, DiffieHellman::Session& Carol,
+                                   double& elapsedGen, double& elapsedExc, double& elapsedAuth, Perf::Sample& perfExc,
+                                   Memory::Usage& memoryGen, Memory::Usage& memoryExc );
+static unsigned int rsaPrimes( int keyLen, const Simulation::Options& options );
+static int  exchangeRSA( int keyLen, const Simulation::Options& options, unsigned char* keyBobP, unsigned char* keyCarolP,
+                         double& elapsedGen, double& elapsedExc, Perf::Sample& perfExc, Memory::Usage& memoryGen,
+                         Memory::Usage& memoryExc );
+static int  transfer( const unsigned char* plaintext, int size,
+                      const unsigned char* keyBob, const unsigned char* ivBob,
+                      const unsigned char* keyCarol, const unsigned char* ivCarol,
+                      unsigned char* decrypted, const Simulation::Options& options, TransferStats& stats );
+static int  incrementalTransfer( const unsigned char* plaintext, int size,
+                                 const unsigned char* keyBob, const unsigned char* ivBob,
+                                 const unsigned char* keyCarol, const unsigned char* ivCarol,
+                                 unsigned char* decrypted, const Simulation::Options& options, TransferStats& stats );
+static int  resumableTransfer( const unsigned char* plaintext, int size,
+                               const unsigned char* keyBob, const unsigned char* keyCarol,
+                               unsigned char* decrypted, const Simulation::Options& options, TransferStats& stats );
+static int  authenticate( const unsigned char* ciphertext, int length, const Simulation::Options& options,
+                          TransferStats& stats );
+static const unsigned char* messageIV( const unsigned char* iv, unsigned char* nonce );
+static std::string cipherName( const char* mode );
+static int  runBackend( int operation, const unsigned char* input, int length, const std::array< unsigned char, 32 >& key,
+                        const std::array< unsigned char, 16 >& iv, unsigned char* output );
+static void printTransfer( int size, const TransferStats& stats, const Simulation::Options& options );
+static void printCounters( const char* label, const Perf::Sample& sample, double units, const std::string& unit,
+                           const Simulation::Options& options );
+static void recordMigration( const char* protocol, int status, double elapsedExc, long long bytes, long long chunks,
+                             double elapsedCmp );
+static void printMemory( const char* label, const Memory::Usage& usage, const Simulation::Options& options );
+static void recordMemory( const char* protocol, const char* phase, const Memory::Usage& usage );
+static void compute( Network::Emulator* wan, Network::Party party, double elapsed );
+static void send( Network::Emulator* wan, Network::Party from, Network::Party to, long long length );
+static void receive( Network::Emulator* wan, Network::Party from, Network::Party to );
+static Network::Usage measure( const Network::Emulator* wan );
+static void printNetwork( const Network::Usage& exchange, const Network::Usage& migration, const Simulation::Options& options );
+static void recordNetwork( const char* protocol, const char* phase, const Network::Usage& usage, const Simulation::Options& options );
+
+Simulation::Options::Options( void )
+{
+   this->compress         = false;
+   this->level            = Compression::LevelDef;
+   this->chunkSize        = Compression::ChunkSizeDef;
+   this->index            = nullptr;
+   this->average          = Deduplication::AverageDef;
+   this->blockSize        = Delta::BlockSizeDef;
+   this->batch            = Journal::BatchDef;
+   this->interrupt        = 0;
+   this->objects          = false;
+   this->split            = SplitDef;
+   this->threads          = 0;
+   this->sessions         = 0;
+   this->derives          = 0;
+   this->subgroup         = false;
+   this->keygen           = 1;
+   this->primes           = 0;
+   this->rsaPrimes        = 2;
+   this->unwraps          = 0;
+   this->fetches          = 0;
+   this->multibuffer      = 0;
+   this->backend          = "evp";
+   this->backends         = 0;
+   this->signedHandshakes = 0;
+   this->signer           = nullptr;
+   this->cipher           = "auto";
+   this->capabilities     = nullptr;
+   this->cache            = nullptr;
+   this->migrations       = 1;
+   this->perf             = false;
+   this->memory           = false;
+   this->progress         = 0;
+   this->network          = nullptr;
+   this->metricsInterval  = 0;
+}
+
 /**
  * Secure Data Migration Simulation using Diffie-Hellman Key Exchange.
  *
@@ -71,178 +242,88 @@ using namespace SecureMigration;
  *  Carol=>Carol [label="Verify g^abc == g^bac"];
  * @endmsc
  */
-int Simulation::RunDiffieHellman( const unsigned char* plaintext, const int size, const int keyLen )
+int Simulation::RunDiffieHellman( const unsigned char* plaintext, const int size, const int keyLen,
+                                  const Options& options )
 {
    const int BytesPerLineDef = 32;
    int status = 0;
-   unsigned char* ciphertext = new unsigned char[ size + 32 ];
    unsigned char* decrypted = new unsigned char[ size + 32 ];
+   unsigned char  resumeKey[ Journal::KeyLen ];
+   unsigned char  keyBob[ SessionKeyLen ];
+   unsigned char  keyCarol[ SessionKeyLen ];
+   bool           resumed = false;
+   TransferStats  stats = { };
+   const std::string peers = "Alice,Bob,Carol/DH-" + std::to_string( keyLen );
 
    DiffieHellman::Session Alice;
    DiffieHellman::Session Bob;
    DiffieHellman::Session Carol;
-   Key* keyGab;
-   Key* keyGac;
-   Key* keyGba;
-   Key* keyGbc;
-   Key* keyGca;
-   Key* keyGcb;
-   Key* keyGabc;
-   Key* keyGacb;
-   Key* keyGbca;
-   Key* keyGbac;
-   Key* keyGcab;
-   Key* keyGcba;
-   Key* dhParams;
 
-   std::chrono::time_point< HighResClock > start;
-   double elapsedGen;
-   double elapsedExc;
+   double elapsedGen  = 0.0;
+   double elapsedExc  = 0.0;
+   double elapsedAuth = 0.0;
    double elapsedCmp;
 
-   std::cout << "Secure Migration (Diffie-Hellman, AES-256-CBC) BEGIN" << std::endl;
-
-   /// @par Process Design Language
-   /// -# Alice generates Diffie-Hellman Parameters (p,g)
-   start = std::chrono::high_resolution_clock::now( );
-   DiffieHellman::Session::GenerateParams( keyLen, &dhParams );
-   #ifdef _DEBUG
-   std::cout << "> Alice Generated (p,g)" << std::endl;
-   #endif
-   elapsedGen = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
-   start = std::chrono::high_resolution_clock::now( );
-
-   /// -# Alice Initializes Private Key a
-   Alice.Initialize( *dhParams );
-   #ifdef _DEBUG
-   std::cout << "> Alice Initialized a" << std::endl;
-   #endif
-
-   /// -# Alice sends parameters (p,g) to Bob
-   Bob.Initialize( *dhParams );
-   #ifdef _DEBUG
-   std::cout << "> Alice->Bob [p,g]" << std::endl;
-   #endif
-
-   /// -# Alice sends parameters (p,g) to Carol
-   Carol.Initialize( *dhParams );
-   #ifdef _DEBUG
-   std::cout << "> Alice->Carol [p,g]" << std::endl;
-   #endif
-
-   /// -# Alice sends g^a mod p to Bob
-   Bob.Derive( *Alice.PublicKey( ) );
-   keyGab = new Key( *Bob.Secret( ) );
-   #ifdef _DEBUG
-   std::cout << "> Alice->Bob [g^a mod p]" << std::endl;
-   #endif
-
-   /// -# Alice sends g^a mod p to Carol
-   Carol.Derive( *Alice.PublicKey( ) );
-   keyGac = new Key( *Carol.Secret( ) );
-   #ifdef _DEBUG
-   std::cout << "> Alice->Carol [g^a mod p]" << std::endl;
-   #endif
-
-   /// -# Bob sends g^b mod p to Alice
-   Alice.Derive( *Bob.PublicKey( ) );
-   keyGba = new Key( *Alice.Secret( ) );
-   #ifdef _DEBUG
-   std::cout << "> Bob->Alice [g^b mod p]" << std::endl;
-   #endif
-
-   /// -# Bob sends g^b mod p to Carol
-   Carol.Derive( *Bob.PublicKey( ) );
-   keyGbc = new Key( *Carol.Secret( ) );
-   #ifdef _DEBUG
-   std::cout << "> Bob->Carol [g^b mod p]" << std::endl;
-   #endif
-
-   /// -# Carol sends g^c mod p to Alice
-   Alice.Derive( *Carol.PublicKey( ) );
-   keyGca = new Key( *Alice.Secret( ) );
-   #ifdef _DEBUG
-   std::cout << "> Carol->Alice [g^c mod p]" << std::endl;
-   #endif
-
-   /// -# Carol sends g^c mod p to Bob
-   Bob.Derive( *Carol.PublicKey( ) );
-   keyGcb = new Key( *Bob.Secret( ) );
-   #ifdef _DEBUG
-   std::cout << "> Carol->Bob [g^c mod p]" << std::endl;
-   #endif
-
-   /// -# Alice sends Bob   [g^ca mod p]
-   /// -# Alice sends Carol [g^ba mod p]
-   /// -# Bob   sends Alice [g^cb mod p]
-   /// -# Bob   sends Carol [g^ab mod p]
-   /// -# Carol sends Alice [g^bc mod p]
-   /// -# Carol sends Bob   [g^ac mod p]
-
-   /// -# Alice Derives Shared Secrets g^bca and g^cba
-   /// -# Alice verifies g^bca == g^cba
-   Alice.Derive( *keyGbc ); 
-   keyGbca = new Key( *Alice.Secret( ) );
-   #ifdef _DEBUG
-   std::cout << "> Alice derived [g^bca mod p]" << std::endl;
-   #endif
-   
-   Alice.Derive( *keyGcb );
-   keyGcba = new Key( *Alice.Secret( ) );
-   #ifdef _DEBUG
-   std::cout << "> Alice derived [g^cba mod p]" << std::endl;
-   std::cout << "> Alice verifies [g^bca == g^cba]" << ( ( *keyGbca == *keyGcba ) ? "" : " ERROR" ) << std::endl;
-   #endif
-
-   /// -# Bob Derives Shared Secrets g^acb and g^cab
-   /// -# Bob verifies g^acb == g^cab
-   Bob.Derive( *keyGac );
-   keyGacb = new Key( *Bob.Secret( ) );
-   #ifdef _DEBUG
-   std::cout << "> Bob derived [g^acb mod p]" << std::endl;
-   #endif
-   
-   Bob.Derive( *keyGca );
-   keyGcab = new Key( *Bob.Secret( ) );
-   #ifdef _DEBUG
-   std::cout << "> Bob derived [g^cab mod p]" << std::endl;
-   std::cout << "> Bob verifies [g^acb == g^cab]" << ( ( *keyGbca == *keyGcba ) ? "" : " ERROR" ) << std::endl;
-   #endif
-
-   /// -# Carol Derives Shared Secrets g^abc and g^bac
-   /// -# Bob verifies g^abc == g^bac
-   Carol.Derive( *keyGab );
-   keyGabc = new Key( *Carol.Secret( ) );
-   #ifdef _DEBUG
-   std::cout << "> Carol derived [g^abc mod p]" << std::endl;
-   #endif
+   Perf::Sample  perfExc   = { };
+   Memory::Usage memoryGen = { };
+   Memory::Usage memoryExc = { };
 
-   Carol.Derive( *keyGba );
-   keyGbac = new Key( *Carol.Secret( ) );
-   #ifdef _DEBUG  
-   std::cout << "> Carol derived [g^bac mod p]" << std::endl;
-   std::cout << "> Carol verifies [g^abc == g^bac]" << ( ( *keyGbca == *keyGcba ) ? "" : " ERROR" ) << std::endl;
-   #endif
+   Network::Usage migration;
 
-   elapsedExc = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
-   start = std::chrono::high_resolution_clock::now( );
+   std::cout << "Secure Migration (Diffie-Hellman, " << cipherName( "CBC" ) << ") BEGIN" << std::endl;
 
-   /// -# Encrypt data at Bob and send to Carol
-   status = AES::Encrypt( plaintext, size, Bob.Secret( )->Buffer( ), &Bob.Secret( )->Buffer( )[ 32 ], ciphertext );
-   #ifdef _DEBUG
-   std::cout << "> Bob encrypted plaintext and sent ciphertext to Carol" << std::endl;
-   #endif
+   /// @par Process Design Language
+   /// -# Start the emulated links of the migration with the clock of every party at zero
+   if( options.network != nullptr )
+   {
+      options.network->Reset( );
+   }
 
-   /// -# Decrypt data at Carol received from Bob
-   status = AES::Decrypt( ciphertext, status, Carol.Secret( )->Buffer( ), &Carol.Secret( )->Buffer( )[ 32 ], decrypted );
-   #ifdef _DEBUG
-   std::cout << "> Carol received ciphertext from Bob and decrypted plaintext" << std::endl;
-   #endif
+   /// -# Resume an interrupted migration with its stored session key, skipping parameter generation and key exchange
+   if( resume( options, resumeKey ) )
+   {
+      status = transfer( plaintext, size, resumeKey, NULL, resumeKey, NULL, decrypted, options, stats );
+      stats.resumedKey = true;
+   }
+   /// -# Resume the session of the same parties from the cached master secret without any exponentiation
+   else if( ( resumed = resumeSession( options, peers, keyBob, keyCarol, elapsedExc ) ) )
+   {
+      status = transfer( plaintext, size, keyBob, &keyBob[ 32 ], keyCarol, &keyCarol[ 32 ], decrypted, options, stats );
+   }
+   else
+   {
+      /// -# Alice generates (p,g), and Alice, Bob, and Carol exchange keys, signing their public values
+      if( exchangeDiffieHellman( keyLen, options, Alice, Bob, Carol, elapsedGen, elapsedExc, elapsedAuth, perfExc,
+                                 memoryGen, memoryExc ) != 0 )
+      {
+         std::cout << "> FAILURE: Key exchange failed or public values could not be authenticated" << std::endl;
+         status = -1;
+      }
+      else
+      {
+         /// -# Bob and Carol cache the shared secret as the master secret of later migrations
+         if( options.cache != nullptr )
+         {
+            options.cache->Store( peers, Bob.Secret( )->Buffer( ), Bob.Secret( )->Length( ), elapsedGen + elapsedExc );
+         }
 
-   elapsedCmp = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+         /// -# Encrypt data at Bob, send to Carol, and decrypt data at Carol
+         status = transfer( plaintext, size, Bob.Secret( )->Buffer( ), &Bob.Secret( )->Buffer( )[ 32 ],
+                            Carol.Secret( )->Buffer( ), &Carol.Secret( )->Buffer( )[ 32 ], decrypted, options, stats );
+      }
+   }
+   Progress::End( );
+   elapsedCmp = stats.elapsed;
+   migration  = measure( options.network );
+   OPENSSL_cleanse( resumeKey, sizeof( resumeKey ) );
+   OPENSSL_cleanse( keyBob, sizeof( keyBob ) );
+   OPENSSL_cleanse( keyCarol, sizeof( keyCarol ) );
 
    /// -# Verify the decrypted data matches the plaintext
-   status = std::memcmp( reinterpret_cast< const void* >( plaintext ), reinterpret_cast< const void* >( decrypted ), status );
+   if( status >= 0 )
+   {
+      status = std::memcmp( reinterpret_cast< const void* >( plaintext ), reinterpret_cast< const void* >( decrypted ), status );
+   }
    if( status == 0 )
    {
       std::cout << "> SUCCESS: Decrypted text matches plaintext" << std::endl;
@@ -257,27 +338,31 @@ int Simulation::RunDiffieHellman( const unsigned char* plaintext, const int size
    std::cout << "> Plaintext Size:        " << size << " Bytes" << std::endl;
    std::cout << "> Key Length:            " << keyLen << " Bits" << std::endl;
    std::cout << "> Parameter Generation:  " << std::setprecision( 6 ) << elapsedGen << " Milliseconds" << std::endl;
+   printMemory( "> Parameter Memory:      ", memoryGen, options );
    std::cout << "> Key Exchange:          " << std::setprecision( 6 ) << elapsedExc << " Milliseconds" << std::endl;
+   printCounters( "> Exchange Counters:     ", perfExc, 15.0, "Exponentiation", options );
+   printMemory( "> Exchange Memory:       ", memoryExc, options );
+   if( !options.auth.empty( ) )
+   {
+      std::cout << "> Authentication:        " << std::setprecision( 6 ) << elapsedAuth << " Milliseconds ("
+                << options.auth << ", 3 Signatures, 6 Verifications)" << std::endl;
+   }
+   printSetup( options, peers, resumed );
    std::cout << "> Encryption/Decryption: " << std::setprecision( 6 ) << elapsedCmp << " Milliseconds" << std::endl;
+   printTransfer( size, stats, options );
+   printNetwork( stats.network, migration, options );
    std::cout << "> Total:                 " << std::setprecision( 6 ) 
              << ( elapsedGen + elapsedExc + elapsedCmp ) << " Milliseconds" << std::endl;
+   recordMigration( "dh", status, elapsedExc, size, ( options.state.empty( ) && options.journal.empty( ) ) ? 1 : stats.changed, elapsedCmp );
+   recordMemory( "dh", "parameters", memoryGen );
+   recordMemory( "dh", "exchange", memoryExc );
+   recordMemory( "dh", "transfer", stats.memory );
+   recordNetwork( "dh", "exchange", stats.network, options );
+   recordNetwork( "dh", "transfer", migration.Since( stats.network ), options );
 
-   delete keyGab;
-   delete keyGac;
-   delete keyGba;
-   delete keyGbc;
-   delete keyGca;
-   delete keyGcb;
-   delete keyGabc;
-   delete keyGacb;
-   delete keyGbca;
-   delete keyGbac;
-   delete keyGcab;
-   delete keyGcba;
-   delete[ ] ciphertext;
    delete[ ] decrypted;
 
-   std::cout << "Secure Migration (Diffie-Hellman,AES-256-CBC) END" << std::endl << std::endl;
+   std::cout << "Secure Migration (Diffie-Hellman," << cipherName( "CBC" ) << ") END" << std::endl << std::endl;
 
    return( status );
 }
@@ -294,127 +379,93 @@ int Simulation::RunDiffieHellman( const unsigned char* plaintext, const int size
  *
  *  ---          [label="Distributed Secret Key", ID="*"];
  *  Alice->Bob   [label="Requests B"];
+ *  Alice->Carol [label="Requests C"];
  *  Alice<<Bob   [label="B"];
+ *  Alice<<Carol [label="C"];
  *  Alice<=Alice [label="Encrypt Secret Key", URL="@ref RSACryptosystem::Cipher::Encrypt"];
  *  Alice->Bob   [label="Encrypted Secret Key"];
  *  Bob=>Bob     [label="Decrypt Secret Key", URL="@ref RSACryptosystem::Cipher::Decrypt"];
- *  Alice->Carol [label="Requests C"];
- *  Alice<<Carol [label="C"];
  *  Alice<=Alice [label="Encrypt Secret Key", URL="@ref RSACryptosystem::Cipher::Encrypt"];
  *  Alice->Carol [label="Encrypted Secret Key"];
  *  Carol=>Carol [label="Decrypt Secret Key", URL="@ref RSACryptosystem::Cipher::Decrypt"];
  * @endmsc
  */
-int Simulation::RunRSA( const unsigned char* plaintext, const int size, const int keyLen )
+int Simulation::RunRSA( const unsigned char* plaintext, const int size, const int keyLen,
+                        const Options& options )
 {
    int                     status = 0;
-   BIGNUM*                 prime;
-   Key*                    rsaKey;
-   int                     bytes = ( ( keyLen + 7 ) / 8 ) - 11;
-   int                     length;
-   unsigned char*          buffer;
    unsigned char*          keyBobP    = new unsigned char[ ( keyLen + 7 ) / 8 ];
-   unsigned char*          keyBobC    = new unsigned char[ ( keyLen + 7 ) / 8 ];
    unsigned char*          keyCarolP  = new unsigned char[ ( keyLen + 7 ) / 8 ];
-   unsigned char*          keyCarolC  = new unsigned char[ ( keyLen + 7 ) / 8 ];
-   unsigned char*          ciphertext = new unsigned char[ size + 32 ];
    unsigned char*          decrypted  = new unsigned char[ size + 32 ];
-   RSACryptosystem::Cipher Alice;
-   RSACryptosystem::Cipher Bob;
-   RSACryptosystem::Cipher Carol;
+   unsigned char           resumeKey[ Journal::KeyLen ];
+   unsigned char           keyBob[ SessionKeyLen ];
+   unsigned char           keyCarol[ SessionKeyLen ];
+   bool                    resumed = false;
+   TransferStats           stats = { };
+   const std::string       peers = "Alice,Bob,Carol/RSA-" + std::to_string( keyLen );
 
-   std::chrono::time_point< HighResClock > start;
-   double elapsedGen;
-   double elapsedExc;
+   double elapsedGen = 0.0;
+   double elapsedExc = 0.0;
    double elapsedCmp;
-    
-   std::cout << "Secure Migration (RSA Cryptosystem, AES-256-EBC) BEGIN" << std::endl;
-
-   /// @par Process Design Language
-   /// -# Alice generates a secret key
-   start = std::chrono::high_resolution_clock::now( );
-   prime = BN_generate_prime( NULL, keyLen, 1, NULL, NULL, NULL, NULL );
-   buffer = new unsigned char[ ( keyLen + 7 ) / 8 ];
-   BN_bn2bin( prime, buffer );
-   rsaKey = new Key( buffer, ( keyLen + 7 ) / 8 );
-   BN_free( prime );
-   delete[ ] buffer;
-   #ifdef _DEBUG
-   std::cout << "> Alice generated Secret Key" << std::endl;
-   #endif
-   elapsedGen = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
-   start = std::chrono::high_resolution_clock::now( );
-
-   /// -# Alice, Bob, and Carol generate Public/Private Key Pair
-   Alice.Initialize( keyLen );
-   #ifdef _DEBUG
-   std::cout << "> Alice generate Public/Private Key Pair" << std::endl;
-   #endif
-   Bob.Initialize( keyLen );
-   #ifdef _DEBUG
-   std::cout << "> Bob generate Public/Private Key Pair" << std::endl;
-   #endif
-   Carol.Initialize( keyLen );
-   #ifdef _DEBUG
-   std::cout << "> Carol generate Public/Private Key Pair" << std::endl; 
-   #endif   
-   
-   /// -# Alice requests Bob's Public Key B
-   /// -# Bob sends his Public Key B to Alice
-   /// -# Alice encrypts the Secret Key using B
-   length = Alice.Encrypt( rsaKey->Buffer( ), keyBobC, bytes, *Bob.PublicKey( ) );
-   #ifdef _DEBUG
-   std::cout << "> Alice encrypted " << ( bytes * 8 ) << " bits of " << keyLen << " bit Secret Key using Bob's Public Key" << std::endl;
-   #endif   
-
-   /// -# Alice Sends Encrypted Secret Key to Bob
-   /// -# Bob Decrypts Secret Key
-   ( void )Bob.Decrypt( keyBobC, keyBobP, length );
-   #ifdef _DEBUG  
-   std::cout << "> Alice sent the Encrypted Secret Key to Bob" << std::endl;
-   std::cout << "> Bob Decypts the Secret Key" << std::endl;
-   #endif
-   
-   /// -# Alice requests Carol's Public Key C
-   /// -# Carol sends her Public Key C to Alice
-   /// -# Alice encrypts the Secret Key using C
-   length = Alice.Encrypt( rsaKey->Buffer( ), keyCarolC, bytes, *Carol.PublicKey( ) );
-   #ifdef _DEBUG
-   std::cout << "> Alice encrypted " << ( bytes * 8 ) << " bits of " << keyLen << " bit Secret Key using Carol's Public Key" << std::endl;
-   #endif
-   
-   /// -# Alice Sends Encrypted Secret Key to Carol
-   /// -# Carol Decrypts Secret Key
-   ( void )Carol.Decrypt( keyCarolC, keyCarolP, length );
-   #ifdef _DEBUG
-   std::cout << "> Alice sent the Encrypted Secret Key to Carol" << std::endl;
-   std::cout << "> Carol Decypts the Secret Key" << std::endl;
-   #endif
-
-   elapsedExc = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
 
-   status = std::memcmp( reinterpret_cast< const void* >( keyBobP ),
-                         reinterpret_cast< const void* >( keyCarolP ),
-                         bytes );
+   Perf::Sample  perfExc   = { };
+   Memory::Usage memoryGen = { };
+   Memory::Usage memoryExc = { };
 
-   start = std::chrono::high_resolution_clock::now( );
+   Network::Usage migration;
+    
+   std::cout << "Secure Migration (RSA Cryptosystem, " << cipherName( "EBC" ) << ") BEGIN" << std::endl;
 
-   /// -# Encrypt data at Bob and send to Carol
-   status = AES::Encrypt( plaintext, size, keyBobP, NULL, ciphertext );
-   #ifdef _DEBUG
-   std::cout << "> Bob encrypted plaintext and sent ciphertext to Carol" << std::endl;
-   #endif
+   /// @par Process Design Language
+   /// -# Start the emulated links of the migration with the clock of every party at zero
+   if( options.network != nullptr )
+   {
+      options.network->Reset( );
+   }
 
-   /// -# Decrypt data at Carol received from Bob
-   status = AES::Decrypt( ciphertext, status, keyCarolP, NULL, decrypted );
-   #ifdef _DEBUG
-   std::cout << "> Carol received ciphertext from Bob and decrypted plaintext" << std::endl;
-   #endif
+   /// -# Resume an interrupted migration with its stored session key, skipping key generation and distribution
+   if( resume( options, resumeKey ) )
+   {
+      status = transfer( plaintext, size, resumeKey, NULL, resumeKey, NULL, decrypted, options, stats );
+      stats.resumedKey = true;
+   }
+   /// -# Resume the session of the same parties from the cached master secret without any RSA operation
+   else if( ( resumed = resumeSession( options, peers, keyBob, keyCarol, elapsedExc ) ) )
+   {
+      status = transfer( plaintext, size, keyBob, NULL, keyCarol, NULL, decrypted, options, stats );
+   }
+   else
+   {
+      /// -# Alice generates the secret key and distributes it to Bob and Carol
+      if( exchangeRSA( keyLen, options, keyBobP, keyCarolP, elapsedGen, elapsedExc, perfExc, memoryGen, memoryExc ) != 0 )
+      {
+         std::cout << "> FAILURE: Secret key could not be distributed" << std::endl;
+         status = -1;
+      }
+      else
+      {
+         /// -# Bob and Carol cache the distributed secret key as the master secret of later migrations
+         if( options.cache != nullptr )
+         {
+            options.cache->Store( peers, keyBobP, Journal::KeyLen, elapsedGen + elapsedExc );
+         }
 
-   elapsedCmp = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+         /// -# Encrypt data at Bob, send to Carol, and decrypt data at Carol
+         status = transfer( plaintext, size, keyBobP, NULL, keyCarolP, NULL, decrypted, options, stats );
+      }
+   }
+   Progress::End( );
+   elapsedCmp = stats.elapsed;
+   migration  = measure( options.network );
+   OPENSSL_cleanse( resumeKey, sizeof( resumeKey ) );
+   OPENSSL_cleanse( keyBob, sizeof( keyBob ) );
+   OPENSSL_cleanse( keyCarol, sizeof( keyCarol ) );
 
    /// -# Verify the decrypted data matches the plaintext
-   status = std::memcmp( reinterpret_cast< const void* >( plaintext ), reinterpret_cast< const void* >( decrypted ), status );
+   if( status >= 0 )
+   {
+      status = std::memcmp( reinterpret_cast< const void* >( plaintext ), reinterpret_cast< const void* >( decrypted ), status );
+   }
    if( status == 0 )
    {
       std::cout << "> SUCCESS: Decrypted text matches plaintext" << std::endl;
@@ -429,18 +480,2728 @@ int Simulation::RunRSA( const unsigned char* plaintext, const int size, const in
    std::cout << "> Plaintext Size:        " << size << " Bytes" << std::endl;
    std::cout << "> Key Length:            " << keyLen << " Bits" << std::endl;
    std::cout << "> Secret Key:            " << std::setprecision( 6 ) << elapsedGen << " Milliseconds" << std::endl;
+   printMemory( "> Secret Key Memory:     ", memoryGen, options );
    std::cout << "> Key Distribution:      " << std::setprecision( 6 ) << elapsedExc << " Milliseconds" << std::endl;
+   printCounters( "> Distribution Counters: ", perfExc, 4.0, "RSA Operation", options );
+   printMemory( "> Distribution Memory:   ", memoryExc, options );
+   printSetup( options, peers, resumed );
    std::cout << "> Encryption/Decryption: " << std::setprecision( 6 ) << elapsedCmp << " Milliseconds" << std::endl;
+   printTransfer( size, stats, options );
+   printNetwork( stats.network, migration, options );
    std::cout << "> Total:                 " << std::setprecision( 6 )
              << ( elapsedGen + elapsedExc + elapsedCmp ) << " Milliseconds" << std::endl;
+   recordMigration( "rsa", status, elapsedExc, size, ( options.state.empty( ) && options.journal.empty( ) ) ? 1 : stats.changed, elapsedCmp );
+   recordMemory( "rsa", "parameters", memoryGen );
+   recordMemory( "rsa", "exchange", memoryExc );
+   recordMemory( "rsa", "transfer", stats.memory );
+   recordNetwork( "rsa", "exchange", stats.network, options );
+   recordNetwork( "rsa", "transfer", migration.Since( stats.network ), options );
 
-   delete rsaKey;
    delete[ ] keyBobP;
-   delete[ ] keyBobC;
    delete[ ] keyCarolP;
-   delete[ ] keyCarolC;
+   delete[ ] decrypted;
 
-   std::cout << "Secure Migration (RSA Cryptosystem,AES-256-EBC) END" << std::endl << std::endl;
+   std::cout << "Secure Migration (RSA Cryptosystem," << cipherName( "EBC" ) << ") END" << std::endl << std::endl;
 
    return( status );
 }
+
+/**
+ * Migrates every object of a directory, or of a list file naming one object per line, from Bob to Carol.
+ *
+ * @details
+ * The session key is negotiated once for all objects. Every object is a task of a work-stealing pool,
+ * and an object larger than the split size spawns a chunk task per additional chunk, so the chunks of
+ * the largest objects are spread across all workers instead of leaving them idle at the tail. Chunks are
+ * encrypted with AES-256-CTR from a counter block holding the object and chunk index, so each chunk is
+ * processed independently.
+ */
+int Simulation::RunObjects( const std::string& path, const int keyLen, const bool rsa, const Options& options )
+{
+   int                        status = 0;
+   std::vector< std::string > objects;
+   ObjectStats                stats  = { };
+   Memory::Phase              phase;
+   Memory::Usage              memoryCmp = { };
+   long long                  expected  = 0;
+   unsigned char              keyBob[ Journal::KeyLen ];
+   unsigned char              keyCarol[ Journal::KeyLen ];
+   unsigned int               workers;
+   long long                  steals;
+
+   std::chrono::time_point< HighResClock > start;
+   double elapsedGen = 0.0;
+   double elapsedExc = 0.0;
+   double elapsedCmp;
+
+   Perf::Sample  perfExc   = { };
+   Memory::Usage memoryGen = { };
+   Memory::Usage memoryExc = { };
+
+   std::cout << "Secure Migration (" << ( rsa ? "RSA Cryptosystem" : "Diffie-Hellman" ) << ", " << cipherName( "CTR" ) << ", Objects) BEGIN"
+             << std::endl;
+
+   /// @par Process Design Language
+   /// -# Enumerate the objects of the bucket
+   listObjects( path, objects );
+
+   /// -# Negotiate the session key once for all objects
+   if( rsa )
+   {
+      unsigned char* keyBobP   = new unsigned char[ ( keyLen + 7 ) / 8 ];
+      unsigned char* keyCarolP = new unsigned char[ ( keyLen + 7 ) / 8 ];
+
+      if( exchangeRSA( keyLen, options, keyBobP, keyCarolP, elapsedGen, elapsedExc, perfExc, memoryGen, memoryExc ) != 0 )
+      {
+         /// -# No object is migrated without the distributed secret key
+         std::cout << "> FAILURE: Secret key could not be distributed" << std::endl;
+         stats.failures = static_cast< long long >( objects.size( ) );
+         objects.clear( );
+      }
+      else
+      {
+         std::memcpy( keyBob, keyBobP, Journal::KeyLen );
+         std::memcpy( keyCarol, keyCarolP, Journal::KeyLen );
+      }
+      OPENSSL_cleanse( keyBobP, ( keyLen + 7 ) / 8 );
+      OPENSSL_cleanse( keyCarolP, ( keyLen + 7 ) / 8 );
+      delete[ ] keyBobP;
+      delete[ ] keyCarolP;
+   }
+   else
+   {
+      DiffieHellman::Session Alice;
+      DiffieHellman::Session Bob;
+      DiffieHellman::Session Carol;
+      double                 elapsedAuth;
+
+      if( exchangeDiffieHellman( keyLen, options, Alice, Bob, Carol, elapsedGen, elapsedExc, elapsedAuth, perfExc,
+                                 memoryGen, memoryExc ) != 0 )
+      {
+         /// -# No object is migrated without an authenticated key exchange
+         std::cout << "> FAILURE: Key exchange failed or public values could not be authenticated" << std::endl;
+         stats.failures = static_cast< long long >( objects.size( ) );
+         objects.clear( );
+      }
+      else
+      {
+         std::memcpy( keyBob, Bob.Secret( )->Buffer( ), Journal::KeyLen );
+         std::memcpy( keyCarol, Carol.Secret( )->Buffer( ), Journal::KeyLen );
+      }
+   }
+
+   /// -# Report the progress against every byte of the objects, encrypted by Bob and decrypted by Carol
+   for( const std::string& object : objects )
+   {
+      std::error_code error;
+      std::uintmax_t  size = std::filesystem::file_size( object, error );
+
+      expected += error ? 0 : 2 * static_cast< long long >( size );
+   }
+
+   /// -# Spread the objects across the work-stealing pool and wait for every object and chunk task
+   phase.Start( );
+   Progress::Begin( Progress::Phase::Transfer, expected );
+   {
+      Scheduler::Pool pool( options.threads );
+
+      start = HighResClock::now( );
+      for( size_t i = 0; i < objects.size( ); i++ )
+      {
+         pool.Submit( [ &, i ]( void )
+         {
+            migrateObject( pool, objects[ i ], static_cast< unsigned int >( i ), keyBob, keyCarol, options.split, stats );
+         } );
+      }
+      pool.Wait( );
+      elapsedCmp = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+      workers    = pool.Threads( );
+      steals     = pool.Steals( );
+   }
+   Progress::End( );
+   memoryCmp = phase.Stop( );
+   OPENSSL_cleanse( keyBob, sizeof( keyBob ) );
+   OPENSSL_cleanse( keyCarol, sizeof( keyCarol ) );
+
+   /// -# Verify every object was migrated
+   status = ( ( stats.failures == 0 ) && ( stats.objects == static_cast< long long >( objects.size( ) ) ) ) ? 0 : -1;
+   if( status == 0 )
+   {
+      std::cout << "> SUCCESS: Decrypted objects match plaintext" << std::endl;
+   }
+   else
+   {
+      std::cout << "> FAILURE: " << stats.failures << " objects failed to migrate" << std::endl;
+   }
+
+   std::cout << "> Objects:               " << stats.objects << " (" << stats.bytes << " Bytes)" << std::endl;
+   std::cout << "> Key Length:            " << keyLen << " Bits" << std::endl;
+   std::cout << ( rsa ? "> Secret Key:            " : "> Parameter Generation:  " )
+             << std::setprecision( 6 ) << elapsedGen << " Milliseconds" << std::endl;
+   printMemory( rsa ? "> Secret Key Memory:     " : "> Parameter Memory:      ", memoryGen, options );
+   std::cout << ( rsa ? "> Key Distribution:      " : "> Key Exchange:          " )
+             << std::setprecision( 6 ) << elapsedExc << " Milliseconds (once for all objects)" << std::endl;
+   printCounters( rsa ? "> Distribution Counters: " : "> Exchange Counters:     ", perfExc, rsa ? 4.0 : 15.0,
+                  rsa ? "RSA Operation" : "Exponentiation", options );
+   printMemory( rsa ? "> Distribution Memory:   " : "> Exchange Memory:       ", memoryExc, options );
+   std::cout << "> Encryption/Decryption: " << std::setprecision( 6 ) << elapsedCmp << " Milliseconds" << std::endl;
+   printMemory( "> Transfer Memory:       ", memoryCmp, options );
+   std::cout << "> Workers:               " << workers << " (" << stats.chunks << " Chunk Tasks of " << options.split
+             << " Bytes, " << steals << " Steals)" << std::endl;
+   std::cout << "> Throughput:            " << std::setprecision( 6 )
+             << ( stats.objects / ( elapsedCmp / 1000.0 ) ) << " Objects/s, "
+             << ( stats.bytes / ( elapsedCmp * 1000000.0 ) ) << " GB/s" << std::endl;
+   std::cout << "> Total:                 " << std::setprecision( 6 )
+             << ( elapsedGen + elapsedExc + elapsedCmp ) << " Milliseconds" << std::endl;
+   recordMigration( rsa ? "rsa" : "dh", status, elapsedExc, stats.bytes, stats.chunks + stats.objects, elapsedCmp );
+   recordMemory( rsa ? "rsa" : "dh", "parameters", memoryGen );
+   recordMemory( rsa ? "rsa" : "dh", "exchange", memoryExc );
+   recordMemory( rsa ? "rsa" : "dh", "transfer", memoryCmp );
+
+   std::cout << "Secure Migration (" << ( rsa ? "RSA Cryptosystem" : "Diffie-Hellman" ) << ", " << cipherName( "CTR" ) << ", Objects) END"
+             << std::endl << std::endl;
+
+   return( status );
+}
+
+/**
+ * Measures how many key exchanges one node sustains. Batches of sessions of growing size are started at
+ * once on the coroutine handshake engine, and the handshake rate and latency percentiles are reported
+ * for every level of concurrency.
+ */
+int Simulation::RunHandshakes( const int keyLen, const bool rsa, const Options& options )
+{
+   int                status   = 0;
+   Key*               dhParams = nullptr;
+   Handshake::Stats   stats;
+   std::chrono::time_point< HighResClock > start;
+   double             elapsedGen = 0.0;
+
+   std::cout << "Secure Migration Handshakes (" << ( rsa ? "RSA Cryptosystem" : "Diffie-Hellman" ) << ") BEGIN" << std::endl;
+
+   /// @par Process Design Language
+   /// -# Generate the Diffie-Hellman parameters shared by all sessions
+   if( !rsa )
+   {
+      start = HighResClock::now( );
+      if( generateParams( keyLen, options, &dhParams ) != 0 )
+      {
+         std::cout << "> FAILURE: Diffie-Hellman parameters could not be generated" << std::endl;
+         status = -1;
+      }
+      elapsedGen = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+   }
+
+   /// -# Run batches of concurrent sessions, quadrupling the concurrency up to the maximum
+   if( status == 0 )
+   {
+      Handshake::Engine engine( rsa ? Handshake::Protocol::RSA : Handshake::Protocol::DiffieHellman, keyLen, dhParams,
+                                options.threads );
+
+      std::cout << "> Key Length:            " << keyLen << " Bits" << std::endl;
+      std::cout << "> Parameter Generation:  " << std::setprecision( 6 ) << elapsedGen << " Milliseconds" << std::endl;
+      std::cout << "> Workers:               " << engine.Threads( ) << std::endl;
+      std::cout << ">   Sessions   Handshakes/s       p50 (ms)       p99 (ms)" << std::endl;
+
+      for( int sessions = 1; ; sessions = std::min( sessions * 4, options.sessions ) )
+      {
+         status |= engine.Run( sessions, stats );
+         std::cout << "> " << std::setw( 10 ) << sessions << std::fixed << std::setprecision( 1 )
+                   << std::setw( 15 ) << stats.perSecond << std::setprecision( 3 )
+                   << std::setw( 15 ) << stats.p50 << std::setw( 15 ) << stats.p99
+                   << ( ( stats.failures == 0 ) ? "" : " FAILURE" ) << std::defaultfloat << std::endl;
+
+         if( sessions >= options.sessions )
+         {
+            break;
+         }
+      }
+   }
+
+   if( status == 0 )
+   {
+      std::cout << "> SUCCESS: All participants agreed on the shared secret" << std::endl;
+   }
+   else
+   {
+      std::cout << "> FAILURE: Participants did not agree on the shared secret" << std::endl;
+   }
+
+   delete dhParams;
+
+   std::cout << "Secure Migration Handshakes (" << ( rsa ? "RSA Cryptosystem" : "Diffie-Hellman" ) << ") END"
+             << std::endl << std::endl;
+
+   return( status );
+}
+
+/**
+ * Benchmarks Diffie-Hellman derives of many independent sessions of one group, one at a time against the
+ * batch derive API on a single thread and on all workers. The RFC 3526 group of the key length is used when
+ * there is one, otherwise new parameters are generated.
+ *
+ * @return 0 when every batch derive matches the scalar derive, otherwise a negative value.
+ */
+int Simulation::RunDerives( const int keyLen, const Options& options )
+{
+   int                                       status   = 0;
+   Key*                                      dhParams = nullptr;
+   std::vector< DiffieHellman::Session >     sessions( static_cast< size_t >( options.derives ) );
+   std::vector< Key >                        secrets;
+   std::vector< DiffieHellman::Derivation >  batch;
+   std::chrono::time_point< HighResClock >   start;
+   double                                    elapsed;
+   const unsigned int                        workers[ 2 ] = { 1, options.threads };
+
+   std::cout << "Secure Migration Batch Derive (Diffie-Hellman) BEGIN" << std::endl;
+
+   /// @par Process Design Language
+   /// -# Set up the group and one key pair per session, every session derives with the next session's public key
+   if( ( options.subgroup || ( DiffieHellman::Session::NamedParams( keyLen, &dhParams ) != 0 ) ) &&
+       ( generateParams( keyLen, options, &dhParams ) != 0 ) )
+   {
+      std::cout << "> FAILURE: Diffie-Hellman parameters could not be generated" << std::endl;
+      status = -1;
+   }
+   if( status == 0 )
+   {
+      DiffieHellman::Group group( *dhParams );
+
+      for( DiffieHellman::Session& session : sessions )
+      {
+         status |= session.Initialize( group );
+      }
+
+      std::cout << "> Key Length:            " << keyLen << " Bits" << std::endl;
+      std::cout << "> Exponent Length:       " << group.Bits( ) << " Bits" << std::endl;
+      std::cout << "> Derives:               " << options.derives << std::endl;
+      std::cout << "> Batch Pairs:           "
+                << ( ( keyLen == DiffieHellman::PairedBits ) ? "AVX-512 IFMA multi-buffer kernel where the CPU supports it" :
+                                                               "Two exponentiations, multi-buffer needs a " +
+                                                               std::to_string( DiffieHellman::PairedBits ) + " bit modulus" )
+                << std::endl;
+
+      /// -# Derive one session at a time
+      start = HighResClock::now( );
+      for( size_t i = 0; i < sessions.size( ); i++ )
+      {
+         status |= sessions[ i ].Derive( *sessions[ ( i + 1 ) % sessions.size( ) ].PublicKey( ) );
+         secrets.push_back( *sessions[ i ].Secret( ) );
+      }
+      elapsed = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+      std::cout << "> Scalar:                " << std::fixed << std::setprecision( 1 ) << options.derives * 1000.0 / elapsed
+                << " Derives/s" << std::defaultfloat << std::endl;
+
+      /// -# Derive the whole batch on one thread, then on all workers, and verify every secret
+      for( size_t i = 0; i < sessions.size( ); i++ )
+      {
+         batch.push_back( DiffieHellman::Derivation{ &sessions[ i ], sessions[ ( i + 1 ) % sessions.size( ) ].PublicKey( ), 0 } );
+      }
+      for( unsigned int threads : workers )
+      {
+         start = HighResClock::now( );
+         status |= group.Derive( batch, threads );
+         elapsed = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+
+         for( size_t i = 0; i < sessions.size( ); i++ )
+         {
+            status |= ( *sessions[ i ].Secret( ) == secrets[ i ] ) ? 0 : -1;
+         }
+         std::cout << std::left << std::setw( 25 )
+                   << ( "> Batch, " + std::to_string( ( threads == 0 ) ? std::thread::hardware_concurrency( ) : threads ) + " Threads:" )
+                   << std::right << std::fixed << std::setprecision( 1 ) << options.derives * 1000.0 / elapsed << " Derives/s"
+                   << std::defaultfloat << std::endl;
+      }
+   }
+
+   if( status == 0 )
+   {
+      std::cout << "> SUCCESS: Batch derives match the scalar derives" << std::endl;
+   }
+   else
+   {
+      std::cout << "> FAILURE: Batch derives do not match the scalar derives" << std::endl;
+   }
+
+   delete dhParams;
+
+   std::cout << "Secure Migration Batch Derive (Diffie-Hellman) END" << std::endl << std::endl;
+
+   return( status );
+}
+
+/**
+ * Benchmarks the distribution of key generation times, OpenSSL's single-threaded prime search against the
+ * prime search racing on all workers, for Diffie-Hellman safe-prime parameters or RSA key pairs.
+ *
+ * @return 0 when every generation succeeded, otherwise a negative value.
+ */
+int Simulation::RunPrimes( const int keyLen, const bool rsa, const Options& options )
+{
+   int                                     status     = 0;
+   const unsigned int                      threads    = ( options.threads != 0 ) ? options.threads :
+                                                        std::max( 1u, std::thread::hardware_concurrency( ) );
+   const unsigned int                      configs[ 2 ] = { 1, threads };
+   std::chrono::time_point< HighResClock > start;
+
+   std::cout << "Secure Migration Key Generation (" << ( rsa ? "RSA Cryptosystem" : "Diffie-Hellman" ) << ") BEGIN" << std::endl;
+   std::cout << "> Key Length:            " << keyLen << " Bits" << std::endl;
+   std::cout << "> Generations:           " << options.primes << std::endl;
+   std::cout << ">   Search   Threads       min (ms)       p50 (ms)       p90 (ms)       max (ms)      mean (ms)" << std::endl;
+
+   /// @par Process Design Language
+   /// -# Time every generation of each configuration
+   for( int config = 0; config < 2; config++ )
+   {
+      std::vector< double > elapsed;
+
+      for( int run = 0; run < options.primes; run++ )
+      {
+         start = HighResClock::now( );
+         if( rsa )
+         {
+            RSACryptosystem::Cipher cipher;
+
+            status |= cipher.Initialize( keyLen, ( config == 0 ) ? 1 : configs[ config ] );
+         }
+         else
+         {
+            Key* dhParams = nullptr;
+
+            status |= DiffieHellman::Session::GenerateParams( keyLen, &dhParams, ( config == 0 ) ? 1 : configs[ config ] );
+            delete dhParams;
+         }
+         elapsed.push_back( std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( ) );
+      }
+
+      /// -# Report the distribution
+      std::sort( elapsed.begin( ), elapsed.end( ) );
+      if( !elapsed.empty( ) )
+      {
+         double mean = 0.0;
+
+         for( double value : elapsed )
+         {
+            mean += value / elapsed.size( );
+         }
+         std::cout << "> " << std::setw( 8 ) << ( ( config == 0 ) ? "OpenSSL" : "Race" ) << std::setw( 10 ) << configs[ config ]
+                   << std::fixed << std::setprecision( 1 )
+                   << std::setw( 15 ) << elapsed.front( ) << std::setw( 15 ) << elapsed[ elapsed.size( ) / 2 ]
+                   << std::setw( 15 ) << elapsed[ std::min( elapsed.size( ) - 1, elapsed.size( ) * 9 / 10 ) ]
+                   << std::setw( 15 ) << elapsed.back( ) << std::setw( 15 ) << mean << std::defaultfloat << std::endl;
+      }
+   }
+
+   if( status == 0 )
+   {
+      std::cout << "> SUCCESS: All keys generated" << std::endl;
+   }
+   else
+   {
+      std::cout << "> FAILURE: Key generation failed" << std::endl;
+   }
+
+   std::cout << "Secure Migration Key Generation (" << ( rsa ? "RSA Cryptosystem" : "Diffie-Hellman" ) << ") END"
+             << std::endl << std::endl;
+
+   return( status );
+}
+
+/**
+ * Benchmarks the private operations of a receiver unwrapping secret keys, RSA decryption and RSA-PSS signing
+ * with a two-prime key against a multi-prime key (the most primes the key length allows unless --multiprime
+ * names more than two), both on the cached CRT parameters.
+ *
+ * @return 0 when every operation succeeded, otherwise a negative value.
+ */
+int Simulation::RunUnwrap( const int keyLen, const Options& options )
+{
+   int                                     status = 0;
+   const unsigned int                      multi  = ( options.rsaPrimes > 2 ) ? options.rsaPrimes :
+                                                    RSACryptosystem::Cipher::MaxPrimes( keyLen );
+   const unsigned int                      primes[ 2 ] = { 2, multi };
+   const int                               bytes  = ( keyLen + 7 ) / 8;
+   std::vector< unsigned char >            secret( bytes - 11 );
+   std::vector< unsigned char >            wrapped( bytes );
+   std::vector< unsigned char >            unwrapped( bytes );
+   std::vector< unsigned char >            signature( bytes );
+   unsigned char                           digest[ RSACryptosystem::SignatureDigestLen ];
+   std::chrono::time_point< HighResClock > start;
+
+   std::cout << "Secure Migration Key Unwrap (RSA Cryptosystem) BEGIN" << std::endl;
+   std::cout << "> Key Length:            " << keyLen << " Bits" << std::endl;
+   std::cout << "> Operations:            " << options.unwraps << std::endl;
+   std::cout << ">   Primes   Decrypt (ops/s)   Sign (ops/s)" << std::endl;
+
+   RAND_bytes( secret.data( ), static_cast< int >( secret.size( ) ) );
+   RAND_bytes( digest, sizeof( digest ) );
+
+   /// @par Process Design Language
+   /// -# Generate a key of each configuration, only the two-prime one when the key length allows no more
+   for( int config = 0; config < ( ( multi > 2 ) ? 2 : 1 ); config++ )
+   {
+      RSACryptosystem::Cipher cipher;
+      double                  elapsedDec;
+      double                  elapsedSig;
+
+      if( ( cipher.Initialize( keyLen, options.keygen, primes[ config ] ) != 0 ) ||
+          ( cipher.PrimeCount( ) != static_cast< int >( primes[ config ] ) ) ||
+          ( cipher.Encrypt( secret.data( ), wrapped.data( ), static_cast< int >( secret.size( ) ), *cipher.PublicKey( ) ) != bytes ) )
+      {
+         status = -1;
+         break;
+      }
+
+      /// -# Time the decryption of the wrapped secret key, checking every unwrapped key
+      start = HighResClock::now( );
+      for( int op = 0; op < options.unwraps; op++ )
+      {
+         if( ( cipher.Decrypt( wrapped.data( ), unwrapped.data( ), bytes ) != static_cast< int >( secret.size( ) ) ) ||
+             ( std::memcmp( unwrapped.data( ), secret.data( ), secret.size( ) ) != 0 ) )
+         {
+            status = -2;
+         }
+      }
+      elapsedDec = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+
+      /// -# Time the signing of a digest
+      start = HighResClock::now( );
+      for( int op = 0; op < options.unwraps; op++ )
+      {
+         if( cipher.SignDigest( digest, signature.data( ) ) != bytes )
+         {
+            status = -3;
+         }
+      }
+      elapsedSig = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+
+      std::cout << "> " << std::setw( 8 ) << primes[ config ] << std::fixed << std::setprecision( 1 )
+                << std::setw( 18 ) << ( options.unwraps * 1000.0 / std::max( elapsedDec, 1e-3 ) )
+                << std::setw( 15 ) << ( options.unwraps * 1000.0 / std::max( elapsedSig, 1e-3 ) )
+                << std::defaultfloat << std::endl;
+   }
+
+   if( status == 0 )
+   {
+      std::cout << "> SUCCESS: All keys unwrapped" << std::endl;
+   }
+   else
+   {
+      std::cout << "> FAILURE: Key unwrap failed" << std::endl;
+   }
+
+   std::cout << "Secure Migration Key Unwrap (RSA Cryptosystem) END" << std::endl << std::endl;
+
+   return( status );
+}
+
+/**
+ * Benchmarks threads encrypting small messages with AES-256-CBC, one context per message as AES::Encrypt
+ * does: the cipher of EVP_aes_256_cbc( ), which OpenSSL fetches again on every init, against the cipher
+ * fetched once from the library context, and AES::Encrypt itself, on one thread and on all workers.
+ *
+ * @return 0 when both ciphers produce the same ciphertext and every encryption succeeded, otherwise a
+ * negative value.
+ */
+int Simulation::RunFetch( const Options& options )
+{
+   int                                     status  = 0;
+   const unsigned int                      threads = ( options.threads != 0 ) ? options.threads :
+                                                     std::max( 1u, std::thread::hardware_concurrency( ) );
+   const unsigned int                      configs[ 2 ] = { 1, threads };
+   const EVP_CIPHER*                       ciphers[ 2 ] = { EVP_aes_256_cbc( ), Provider::Get( Provider::Cipher::AES256CBC ) };
+   unsigned char                           key[ 32 ];
+   unsigned char                           iv[ 16 ];
+   unsigned char                           message[ FetchMessageLen ];
+   unsigned char                           expected[ 3 ][ FetchMessageLen + 32 ];
+   int                                     lengths[ 3 ];
+   std::chrono::time_point< HighResClock > start;
+   auto                                    encrypt = [ & ]( int variant, unsigned char* output )
+   {
+      EVP_CIPHER_CTX* context = ( variant < 2 ) ? EVP_CIPHER_CTX_new( ) : NULL;
+      int             length  = -1;
+      int             finalLen;
+
+      if( variant == 2 )
+      {
+         length = AES::Encrypt( message, FetchMessageLen, key, iv, output );
+      }
+      else if( ( context != NULL ) && ( EVP_EncryptInit_ex( context, ciphers[ variant ], NULL, key, iv ) == 1 ) &&
+               ( EVP_EncryptUpdate( context, output, &length, message, FetchMessageLen ) == 1 ) &&
+               ( EVP_EncryptFinal_ex( context, output + length, &finalLen ) == 1 ) )
+      {
+         length += finalLen;
+      }
+      else
+      {
+         length = -1;
+      }
+      EVP_CIPHER_CTX_free( context );
+
+      return( length );
+   };
+
+   std::cout << "Secure Migration Cipher Fetch (AES-256-CBC) BEGIN" << std::endl;
+   std::cout << "> Message Length:        " << FetchMessageLen << " Bytes" << std::endl;
+   std::cout << "> Messages:              " << options.fetches << " per Thread" << std::endl;
+   std::cout << "> Bulk Cipher:           " << AES::Name( AES::Selected( ) ) << std::endl;
+   std::cout << ">  Threads   Implicit (ops/s)   Fetched (ops/s)   Encrypt (ops/s)   Speedup" << std::endl;
+
+   RAND_bytes( key, sizeof( key ) );
+   RAND_bytes( iv, sizeof( iv ) );
+   RAND_bytes( message, sizeof( message ) );
+
+   /// @par Process Design Language
+   /// -# Both ciphers, and AES::Encrypt when AES is the bulk cipher, produce the same ciphertext
+   for( int variant = 0; variant < 3; variant++ )
+   {
+      lengths[ variant ] = encrypt( variant, expected[ variant ] );
+   }
+   if( ( lengths[ 0 ] < 0 ) || ( lengths[ 1 ] != lengths[ 0 ] ) ||
+       ( std::memcmp( expected[ 0 ], expected[ 1 ], static_cast< size_t >( lengths[ 0 ] ) ) != 0 ) ||
+       ( ( AES::Selected( ) == AES::Suite::AES256 ) &&
+         ( ( lengths[ 2 ] != lengths[ 0 ] ) || ( std::memcmp( expected[ 0 ], expected[ 2 ], static_cast< size_t >( lengths[ 0 ] ) ) != 0 ) ) ) )
+   {
+      status = -1;
+   }
+
+   /// -# Time every variant with all threads encrypting at once
+   for( int config = 0; ( status == 0 ) && ( config < 2 ); config++ )
+   {
+      double rates[ 3 ];
+
+      for( int variant = 0; variant < 3; variant++ )
+      {
+         std::atomic< int >         failed( 0 );
+         std::vector< std::thread > workers;
+         double                     elapsed;
+
+         start = HighResClock::now( );
+         for( unsigned int worker = 0; worker < configs[ config ]; worker++ )
+         {
+            workers.emplace_back( [ & ]( )
+            {
+               unsigned char output[ FetchMessageLen + 32 ];
+
+               for( int m = 0; m < options.fetches; m++ )
+               {
+                  if( encrypt( variant, output ) < 0 )
+                  {
+                     failed++;
+                  }
+               }
+            } );
+         }
+         for( std::thread& worker : workers )
+         {
+            worker.join( );
+         }
+         elapsed = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+
+         rates[ variant ] = configs[ config ] * static_cast< double >( options.fetches ) * 1000.0 / std::max( elapsed, 1e-3 );
+         status |= ( failed.load( ) == 0 ) ? 0 : -2;
+      }
+
+      std::cout << "> " << std::setw( 8 ) << configs[ config ] << std::fixed << std::setprecision( 1 )
+                << std::setw( 19 ) << rates[ 0 ] << std::setw( 18 ) << rates[ 1 ] << std::setw( 18 ) << rates[ 2 ]
+                << std::setw( 9 ) << std::setprecision( 2 ) << ( rates[ 1 ] / rates[ 0 ] ) << "x" << std::defaultfloat << std::endl;
+   }
+
+   if( status == 0 )
+   {
+      std::cout << "> SUCCESS: The fetched cipher matches the implicit fetch" << std::endl;
+   }
+   else
+   {
+      std::cout << "> FAILURE: Encryption with the fetched cipher failed" << std::endl;
+   }
+
+   std::cout << "Secure Migration Cipher Fetch (AES-256-CBC) END" << std::endl << std::endl;
+
+   return( status );
+}
+
+/**
+ * Benchmarks the encryption and decryption of many small objects of ObjectMinLen to ObjectMaxLen bytes,
+ * every object with its own key and IV, with one AES::Encrypt or AES::Decrypt call per object against one
+ * AES::EncryptBatch or AES::DecryptBatch call for all objects, on one thread. Reports objects/s, MB/s, and
+ * cycles/byte, counted by the hardware counters or else by the time-stamp counter, of the best of three
+ * passes.
+ *
+ * @return 0 when the batch produces the output of one call per object and every object decrypts to its
+ * plaintext, otherwise a negative value.
+ */
+int Simulation::RunMultiBuffer( const Options& options )
+{
+   const char* const              paths[ 4 ] = { "Encrypt Per Object", "Encrypt Batch", "Decrypt Per Object", "Decrypt Batch" };
+   int                            status     = 0;
+   int                            objects    = options.multibuffer;
+   long long                      total      = 0;
+   std::mt19937                   random( 1 );
+   std::vector< int >             lengths( objects );
+   std::vector< long long >       offsets( objects + 1 );
+   std::vector< unsigned char >   keys( static_cast< size_t >( objects ) * 32 );
+   std::vector< unsigned char >   ivs( static_cast< size_t >( objects ) * 16 );
+   std::vector< AES::Job >        jobs( objects );
+   std::vector< unsigned char >   plaintext;
+   std::vector< unsigned char >   ciphertext[ 2 ];
+   std::vector< unsigned char >   decrypted;
+   std::vector< int >             statuses( objects );
+   Perf::Counters                 counters;
+   double                         rates[ 4 ];
+   bool                           native = ( AES::Selected( ) == AES::Suite::AES256 ) && AESNI::Available( );
+   bool                           hardware;
+
+   /// @par Process Design Language
+   /// -# Draw the object sizes, keys, IVs, and contents
+   for( int object = 0; object < objects; object++ )
+   {
+      lengths[ object ]     = std::uniform_int_distribution< int >( ObjectMinLen, ObjectMaxLen )( random );
+      offsets[ object + 1 ] = offsets[ object ] + lengths[ object ] + AES::BlockLen;
+      total                += lengths[ object ];
+   }
+   plaintext.resize( static_cast< size_t >( offsets[ objects ] ) );
+   ciphertext[ 0 ].resize( plaintext.size( ) );
+   ciphertext[ 1 ].resize( plaintext.size( ) );
+   decrypted.resize( plaintext.size( ) );
+   RAND_bytes( keys.data( ), static_cast< int >( keys.size( ) ) );
+   RAND_bytes( ivs.data( ), static_cast< int >( ivs.size( ) ) );
+   RAND_bytes( plaintext.data( ), static_cast< int >( plaintext.size( ) ) );
+   hardware = ( counters.Initialize( ) == 0 );
+
+   std::cout << "Secure Migration Multi-Buffer Cipher (" << AES::Name( AES::Selected( ) ) << ") BEGIN" << std::endl;
+   std::cout << "> Objects:               " << objects << " (" << ObjectMinLen << "-" << ObjectMaxLen << " Bytes, " << total
+             << " Bytes)" << std::endl;
+   std::cout << "> Batch:                 " << ( native ? "AES-NI multi-buffer kernel, " + std::to_string( AESNI::Lanes ) + " lanes" :
+                                                            std::string( "shared cipher context" ) ) << std::endl;
+   std::cout << "> Cycles:                " << ( hardware ? "Hardware counters" : "Time-stamp counter (reference cycles)" ) << std::endl;
+   std::cout << ">  Path                    Objects/s        MB/s   Cycles/Byte" << std::endl;
+
+   /// -# Time every path, the batch paths over jobs pointing at the same objects
+   for( int path = 0; path < 4; path++ )
+   {
+      bool            decrypt = ( path >= 2 );
+      bool            batch   = ( ( path % 2 ) == 1 );
+      unsigned char*  output  = decrypt ? decrypted.data( ) : ciphertext[ path ].data( );
+      double          best    = 0.0;
+      double          cycles  = 0.0;
+
+      for( int pass = 0; pass < 3; pass++ )
+      {
+         std::chrono::time_point< HighResClock > start;
+         Perf::Sample                            sample;
+         long long                               ticks;
+         double                                  elapsed;
+
+         for( int object = 0; object < objects; object++ )
+         {
+            jobs[ object ] = AES::Job{ &keys[ object * 32 ], &ivs[ object * 16 ],
+                                       ( decrypt ? ciphertext[ 0 ].data( ) : plaintext.data( ) ) + offsets[ object ],
+                                       decrypt ? statuses[ object ] : lengths[ object ], output + offsets[ object ], -1 };
+         }
+
+         start = HighResClock::now( );
+         ticks = Perf::Ticks( );
+         counters.Start( );
+         if( batch )
+         {
+            status |= ( decrypt ? AES::DecryptBatch( jobs.data( ), objects ) : AES::EncryptBatch( jobs.data( ), objects ) );
+         }
+         else
+         {
+            for( AES::Job& job : jobs )
+            {
+               job.status = decrypt ? AES::Decrypt( job.input, job.length, job.key, job.iv, job.output ) :
+                                      AES::Encrypt( job.input, job.length, job.key, job.iv, job.output );
+            }
+         }
+         sample  = counters.Stop( );
+         ticks   = Perf::Ticks( ) - ticks;
+         elapsed = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+
+         if( ( best == 0.0 ) || ( elapsed < best ) )
+         {
+            best   = elapsed;
+            cycles = static_cast< double >( sample.valid ? sample.values[ Perf::Cycles ] : ticks ) / total;
+         }
+      }
+
+      /// -# Keep the ciphertext lengths of one call per object, the batch must match them
+      for( int object = 0; object < objects; object++ )
+      {
+         if( path == 0 )
+         {
+            statuses[ object ] = jobs[ object ].status;
+         }
+         else if( !decrypt && ( jobs[ object ].status != statuses[ object ] ) )
+         {
+            status = -1;
+         }
+         else if( decrypt && ( jobs[ object ].status != lengths[ object ] ) )
+         {
+            status = -2;
+         }
+      }
+
+      rates[ path ] = objects * 1000.0 / std::max( best, 1e-3 );
+      std::cout << ">  " << std::left << std::setw( 20 ) << paths[ path ] << std::right << std::fixed << std::setprecision( 1 )
+                << std::setw( 13 ) << rates[ path ] << std::setw( 12 ) << ( total / ( std::max( best, 1e-3 ) * 1000.0 ) )
+                << std::setw( 14 ) << std::setprecision( 2 ) << cycles << std::defaultfloat << std::endl;
+   }
+
+   /// -# The batch produced the ciphertext of one call per object, and every object decrypted to its plaintext
+   if( ( status == 0 ) && ( ciphertext[ 0 ] != ciphertext[ 1 ] ) )
+   {
+      status = -3;
+   }
+   for( int object = 0; ( status == 0 ) && ( object < objects ); object++ )
+   {
+      if( std::memcmp( &decrypted[ offsets[ object ] ], &plaintext[ offsets[ object ] ], lengths[ object ] ) != 0 )
+      {
+         status = -4;
+      }
+   }
+
+   std::cout << "> Speedup:               " << std::fixed << std::setprecision( 2 ) << ( rates[ 1 ] / rates[ 0 ] ) << "x Encrypt, "
+             << ( rates[ 3 ] / rates[ 2 ] ) << "x Decrypt" << std::defaultfloat << std::endl;
+   if( status == 0 )
+   {
+      std::cout << "> SUCCESS: The batch matches one call per object" << std::endl;
+   }
+   else
+   {
+      std::cout << "> FAILURE: The batch does not match one call per object" << std::endl;
+   }
+
+   std::cout << "Secure Migration Multi-Buffer Cipher (" << AES::Name( AES::Selected( ) ) << ") END" << std::endl << std::endl;
+
+   return( status );
+}
+
+/**
+ * Benchmarks the backends of AES-256 side by side: EVP, and the native kernels with AES-NI and, where the
+ * CPU has it, VAES. Every backend runs ECB encryption, CBC encryption and decryption, and CTR over
+ * messages of 256 Bytes up to the given size, BackendVolume bytes per pass, on one thread. Reports MB/s and
+ * cycles/byte, counted by the hardware counters or else by the time-stamp counter, of the best of three
+ * passes.
+ *
+ * @return 0 when every backend produces the output of EVP, otherwise a negative value.
+ */
+int Simulation::RunBackends( const Options& options )
+{
+   struct Variant
+   {
+      AES::Backend backend;   ///< Implementation of the cipher
+      AESNI::Level level;     ///< Kernels of the native backend
+      const char*  name;      ///< Column of the report
+   };
+
+   const char* const               operations[ 4 ] = { "ECB Encrypt", "CBC Encrypt", "CBC Decrypt", "CTR" };
+   const int                       sizes[ 4 ]      = { 256, 4096, 64 * 1024, std::max( options.backends, 16 ) };
+   const AES::Backend              backend         = AES::Used( );
+   const AESNI::Level              level           = AESNI::Selected( );
+   int                             status          = 0;
+   std::vector< Variant >          variants        = { { AES::Backend::EVP, AESNI::Level::None, "EVP" } };
+   std::array< unsigned char, 32 > key;
+   std::array< unsigned char, 16 > iv;
+   std::vector< unsigned char >    plaintext( static_cast< size_t >( *std::max_element( sizes, sizes + 4 ) ) );
+   std::vector< unsigned char >    ciphertext( plaintext.size( ) + AES::BlockLen );
+   std::vector< unsigned char >    expected( ciphertext.size( ) );
+   std::vector< unsigned char >    output( ciphertext.size( ) );
+   Perf::Counters                  counters;
+   double                          speedups[ 4 ]   = { };
+   bool                            hardware;
+
+   /// @par Process Design Language
+   /// -# List the native kernels of this CPU
+   for( AESNI::Level native : { AESNI::Level::AESNI, AESNI::Level::VAES } )
+   {
+      if( native <= AESNI::Detect( ) )
+      {
+         variants.push_back( { AES::Backend::Native, native, AESNI::Name( native ) } );
+      }
+   }
+   RAND_bytes( key.data( ), static_cast< int >( key.size( ) ) );
+   RAND_bytes( iv.data( ), static_cast< int >( iv.size( ) ) );
+   RAND_bytes( plaintext.data( ), static_cast< int >( plaintext.size( ) ) );
+   hardware = ( counters.Initialize( ) == 0 );
+
+   std::cout << "Secure Migration Cipher Backends (AES-256) BEGIN" << std::endl;
+   std::cout << "> Backends:              " << variants.size( ) << " (AES instructions: " << AESNI::Name( AESNI::Detect( ) ) << ")"
+             << std::endl;
+   std::cout << "> Volume:                " << BackendVolume << " Bytes per Message Size" << std::endl;
+   std::cout << "> Cycles:                " << ( hardware ? "Hardware counters" : "Time-stamp counter (reference cycles)" ) << std::endl;
+   std::cout << ">  Operation         Bytes   Backend        MB/s   Cycles/Byte" << std::endl;
+
+   for( int operation = 0; operation < 4; operation++ )
+   {
+      for( int size : sizes )
+      {
+         const unsigned char* input  = ( operation == 2 ) ? ciphertext.data( ) : plaintext.data( );
+         int                  length = size;
+         int                  repeat = std::max( 1, BackendVolume / size );
+         int                  expectedLen;
+         double               rates[ 3 ] = { };
+
+         /// -# Encrypt the ciphertext of a decryption with EVP
+         AES::Use( AES::Backend::EVP );
+         if( operation == 2 )
+         {
+            length = runBackend( 1, plaintext.data( ), size, key, iv, ciphertext.data( ) );
+         }
+         expectedLen = runBackend( operation, input, length, key, iv, expected.data( ) );
+
+         /// -# Time every backend, checking its output against EVP
+         for( size_t variant = 0; variant < variants.size( ); variant++ )
+         {
+            double best   = 0.0;
+            double cycles = 0.0;
+
+            AES::Use( variants[ variant ].backend );
+            AESNI::Select( ( variants[ variant ].backend == AES::Backend::Native ) ? variants[ variant ].level : level );
+            if( ( runBackend( operation, input, length, key, iv, output.data( ) ) != expectedLen ) || ( expectedLen < 0 ) ||
+                ( std::memcmp( output.data( ), expected.data( ), static_cast< size_t >( expectedLen ) ) != 0 ) )
+            {
+               status = -1;
+            }
+
+            for( int pass = 0; pass < 3; pass++ )
+            {
+               std::chrono::time_point< HighResClock > start = HighResClock::now( );
+               long long                               ticks = Perf::Ticks( );
+               Perf::Sample                            sample;
+               double                                  elapsed;
+
+               counters.Start( );
+               for( int call = 0; call < repeat; call++ )
+               {
+                  runBackend( operation, input, length, key, iv, output.data( ) );
+               }
+               sample  = counters.Stop( );
+               ticks   = Perf::Ticks( ) - ticks;
+               elapsed = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+
+               if( ( best == 0.0 ) || ( elapsed < best ) )
+               {
+                  best   = elapsed;
+                  cycles = static_cast< double >( sample.valid ? sample.values[ Perf::Cycles ] : ticks ) / ( static_cast< double >( size ) * repeat );
+               }
+            }
+
+            rates[ variant ] = static_cast< double >( size ) * repeat / ( std::max( best, 1e-3 ) * 1000.0 );
+            std::cout << ">  " << std::left << std::setw( 14 ) << operations[ operation ] << std::right << std::setw( 9 ) << size << "   "
+                      << std::left << std::setw( 10 ) << variants[ variant ].name << std::right << std::fixed << std::setprecision( 1 )
+                      << std::setw( 9 ) << rates[ variant ] << std::setw( 14 ) << std::setprecision( 2 ) << cycles << std::defaultfloat
+                      << std::endl;
+         }
+         speedups[ operation ] = *std::max_element( rates + 1, rates + 3 ) / std::max( rates[ 0 ], 1e-9 );
+      }
+   }
+   AES::Use( backend );
+   AESNI::Select( level );
+
+   /// -# Every backend produced the output of EVP
+   std::cout << "> Speedup:               " << std::fixed << std::setprecision( 2 );
+   for( int operation = 0; operation < 4; operation++ )
+   {
+      std::cout << ( ( operation > 0 ) ? ", " : "" ) << speedups[ operation ] << "x " << operations[ operation ];
+   }
+   std::cout << std::defaultfloat << " (" << sizes[ 3 ] << " Bytes, fastest native)" << std::endl;
+   if( status == 0 )
+   {
+      std::cout << "> SUCCESS: Every backend matches EVP" << std::endl;
+   }
+   else
+   {
+      std::cout << "> FAILURE: A backend does not match EVP" << std::endl;
+   }
+
+   std::cout << "Secure Migration Cipher Backends (AES-256) END" << std::endl << std::endl;
+
+   return( status );
+}
+
+/**
+ * Benchmarks the latency of a two-party Diffie-Hellman handshake whose public values are unsigned, signed
+ * with Ed25519, or signed with RSA-2048 and RSA-3072, and the rate at which a receiver verifies the signed
+ * public values of many handshakes one at a time and in an Ed25519 batch.
+ *
+ * @return 0 when every handshake was authenticated and agreed on the secret, otherwise a negative value.
+ */
+int Simulation::RunSigned( const int keyLen, const Options& options )
+{
+   int                                     status   = 0;
+   Key*                                    dhParams = nullptr;
+   const std::string                       schemes[ 4 ] = { "", "ed25519", "rsa2048", "rsa3072" };
+   std::chrono::time_point< HighResClock > start;
+
+   std::cout << "Secure Migration Signed Handshakes (Diffie-Hellman) BEGIN" << std::endl;
+
+   /// @par Process Design Language
+   /// -# Set up the group shared by every handshake
+   if( ( options.subgroup || ( DiffieHellman::Session::NamedParams( keyLen, &dhParams ) != 0 ) ) &&
+       ( generateParams( keyLen, options, &dhParams ) != 0 ) )
+   {
+      std::cout << "> FAILURE: Diffie-Hellman parameters could not be generated" << std::endl;
+      status = -1;
+   }
+   if( status == 0 )
+   {
+      DiffieHellman::Group group( *dhParams );
+
+      std::cout << "> Key Length:            " << keyLen << " Bits" << std::endl;
+      std::cout << "> Handshakes:            " << options.signedHandshakes << std::endl;
+      std::cout << ">   Signature        p50 (ms)       p99 (ms)      mean (ms)   Verify (ops/s)" << std::endl;
+
+      for( const std::string& scheme : schemes )
+      {
+         Identity                                    identities[ 2 ];
+         std::vector< double >                       elapsed;
+         std::vector< Key >                          values;
+         std::vector< std::vector< unsigned char > > signatures;
+         double                                      mean = 0.0;
+         double                                      elapsedVerify;
+
+         /// -# Alice and Bob hold long-term signing keys of the scheme
+         for( Identity& identity : identities )
+         {
+            status |= scheme.empty( ) ? 0 : initIdentity( scheme, identity );
+         }
+
+         /// -# Time every handshake: fresh key pairs, signed public values, verification by the peer, and derive
+         for( int handshake = 0; ( status == 0 ) && ( handshake < options.signedHandshakes ); handshake++ )
+         {
+            DiffieHellman::Session       Alice;
+            DiffieHellman::Session       Bob;
+            std::vector< unsigned char > sigAlice;
+            std::vector< unsigned char > sigBob;
+
+            start = HighResClock::now( );
+            status |= Alice.Initialize( group ) | Bob.Initialize( group );
+            if( !scheme.empty( ) )
+            {
+               status |= ( signValue( scheme, identities[ 0 ], *Alice.PublicKey( ), sigAlice ) > 0 ) ? 0 : -1;
+               status |= ( signValue( scheme, identities[ 1 ], *Bob.PublicKey( ), sigBob ) > 0 ) ? 0 : -1;
+               status |= verifyValue( scheme, identities[ 0 ], *Alice.PublicKey( ), sigAlice );
+               status |= verifyValue( scheme, identities[ 1 ], *Bob.PublicKey( ), sigBob );
+            }
+            status |= Alice.Derive( *Bob.PublicKey( ) ) | Bob.Derive( *Alice.PublicKey( ) );
+            elapsed.push_back( std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( ) );
+            status |= ( *Alice.Secret( ) == *Bob.Secret( ) ) ? 0 : -2;
+
+            values.push_back( *Alice.PublicKey( ) );
+            signatures.push_back( sigAlice );
+         }
+         if( elapsed.empty( ) )
+         {
+            break;
+         }
+
+         /// -# Time the receiver verifying the signed public values of all handshakes
+         start = HighResClock::now( );
+         if( scheme == "ed25519" )
+         {
+            std::vector< Ed25519::Item > batch;
+
+            for( size_t i = 0; i < values.size( ); i++ )
+            {
+               batch.push_back( Ed25519::Item{ values[ i ].Buffer( ), values[ i ].Length( ), signatures[ i ].data( ),
+                                               identities[ 0 ].ed25519.PublicKey( ), 0 } );
+            }
+            status |= Ed25519::VerifyBatch( batch, options.threads );
+         }
+         else if( !scheme.empty( ) )
+         {
+            for( size_t i = 0; i < values.size( ); i++ )
+            {
+               status |= verifyValue( scheme, identities[ 0 ], values[ i ], signatures[ i ] );
+            }
+         }
+         elapsedVerify = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+
+         /// -# Report the latency distribution and the verification rate
+         std::sort( elapsed.begin( ), elapsed.end( ) );
+         for( double value : elapsed )
+         {
+            mean += value / elapsed.size( );
+         }
+         std::cout << "> " << std::setw( 11 ) << ( scheme.empty( ) ? "none" : scheme ) << std::fixed << std::setprecision( 3 )
+                   << std::setw( 16 ) << elapsed[ elapsed.size( ) / 2 ]
+                   << std::setw( 15 ) << elapsed[ std::min( elapsed.size( ) - 1, elapsed.size( ) * 99 / 100 ) ]
+                   << std::setw( 15 ) << mean << std::setprecision( 1 ) << std::setw( 17 );
+         if( scheme.empty( ) )
+         {
+            std::cout << "-";
+         }
+         else
+         {
+            std::cout << ( values.size( ) * 1000.0 / std::max( elapsedVerify, 1e-3 ) );
+         }
+         std::cout << std::defaultfloat << std::endl;
+      }
+   }
+
+   if( status == 0 )
+   {
+      std::cout << "> SUCCESS: All handshakes authenticated" << std::endl;
+   }
+   else
+   {
+      std::cout << "> FAILURE: Handshake authentication failed" << std::endl;
+   }
+
+   delete dhParams;
+
+   std::cout << "Secure Migration Signed Handshakes (Diffie-Hellman) END" << std::endl << std::endl;
+
+   return( status );
+}
+
+/**
+ * Lists the regular files below a directory, or the non-empty lines of a list file.
+ */
+static void listObjects( const std::string& path, std::vector< std::string >& objects )
+{
+   std::error_code error;
+
+   if( std::filesystem::is_directory( path, error ) )
+   {
+      for( const auto& entry : std::filesystem::recursive_directory_iterator( path, error ) )
+      {
+         if( entry.is_regular_file( error ) )
+         {
+            objects.push_back( entry.path( ).string( ) );
+         }
+      }
+   }
+   else
+   {
+      std::ifstream list( path );
+      std::string   line;
+
+      while( std::getline( list, line ) )
+      {
+         if( !line.empty( ) && ( line.back( ) == '\r' ) )
+         {
+            line.pop_back( );
+         }
+         if( !line.empty( ) )
+         {
+            objects.push_back( line );
+         }
+      }
+   }
+}
+
+/**
+ * Reads an object at Bob and migrates its first chunk, queuing a chunk task for every further chunk on
+ * the calling worker's deque where idle workers can steal them.
+ */
+static void migrateObject( Scheduler::Pool& pool, const std::string& path, unsigned int index,
+                           const unsigned char* keyBob, const unsigned char* keyCarol, int split, ObjectStats& stats )
+{
+   std::ifstream                                   in( path, std::ios::in | std::ios::binary | std::ios::ate );
+   std::shared_ptr< std::vector< unsigned char > > object = std::make_shared< std::vector< unsigned char > >( );
+   std::shared_ptr< std::atomic< int > >           remaining;
+   int                                             chunks;
+
+   /// @par Process Design Language
+   /// -# Read the object
+   if( !in.is_open( ) )
+   {
+      stats.failures++;
+      return;
+   }
+   object->resize( static_cast< size_t >( in.tellg( ) ) );
+   in.seekg( 0 );
+   if( !in.read( reinterpret_cast< char* >( object->data( ) ), static_cast< std::streamsize >( object->size( ) ) ) )
+   {
+      stats.failures++;
+      return;
+   }
+   in.close( );
+   stats.bytes += static_cast< long long >( object->size( ) );
+
+   /// -# Split the object, the last chunk to complete counts the object
+   chunks    = std::max( 1, static_cast< int >( ( object->size( ) + split - 1 ) / split ) );
+   remaining = std::make_shared< std::atomic< int > >( chunks );
+   auto task = [ object, remaining, index, split, keyBob, keyCarol, &stats ]( int chunk )
+   {
+      if( !migrateChunk( *object, index, chunk, split, keyBob, keyCarol ) )
+      {
+         stats.failures++;
+      }
+      stats.chunks++;
+      if( --*remaining == 0 )
+      {
+         stats.objects++;
+      }
+   };
+
+   /// -# Queue the further chunks and migrate the first one
+   for( int chunk = chunks - 1; chunk > 0; chunk-- )
+   {
+      pool.Submit( [ task, chunk ]( void ) { task( chunk ); } );
+   }
+   task( 0 );
+}
+
+/**
+ * Encrypts a chunk at Bob, decrypts it at Carol, and verifies it matches the plaintext.
+ */
+static bool migrateChunk( const std::vector< unsigned char >& object, unsigned int index, int chunk, int split,
+                          const unsigned char* keyBob, const unsigned char* keyCarol )
+{
+   thread_local std::vector< unsigned char > ciphertext;
+   thread_local std::vector< unsigned char > recovered;
+   unsigned char                             counter[ Journal::CounterLen ] = { };
+   size_t                                    offset = static_cast< size_t >( chunk ) * split;
+   int                                       len    = static_cast< int >( std::min< size_t >( split, object.size( ) - offset ) );
+
+   if( len == 0 )
+   {
+      return( true );
+   }
+
+   ciphertext.resize( len );
+   recovered.resize( len );
+   Utility::WriteU32( counter, index );
+   Utility::WriteU32( counter + 4, static_cast< unsigned int >( chunk ) );
+
+   return( ( AES::CTR( object.data( ) + offset, len, keyBob, counter, ciphertext.data( ) ) == len ) &&
+           ( AES::CTR( ciphertext.data( ), len, keyCarol, counter, recovered.data( ) ) == len ) &&
+           ( std::memcmp( recovered.data( ), object.data( ) + offset, len ) == 0 ) );
+}
+
+/**
+ * Returns the IV of one message under a session key. ChaCha20-Poly1305 must never repeat a nonce under a
+ * key, so Bob draws a fresh random nonce for every message and sends it ahead of the ciphertext, AES keeps
+ * the IV of the session.
+ *
+ * @return The IV, or null when no nonce could be drawn.
+ */
+static const unsigned char* messageIV( const unsigned char* iv, unsigned char* nonce )
+{
+   if( AES::Selected( ) != AES::Suite::ChaCha20Poly1305 )
+   {
+      return( iv );
+   }
+
+   return( ( RAND_bytes( nonce, AES::NonceLen ) == 1 ) ? nonce : NULL );
+}
+
+/**
+ * Restores the session key of an interrupted resumable migration. The key store is only trusted when
+ * the journal of the migration was written for the same key.
+ */
+static bool resume( const Simulation::Options& options, unsigned char* key )
+{
+   return( !options.journal.empty( ) && ( Journal::LoadKey( options.journal + ".key", key ) == 0 ) &&
+           Journal::Matches( options.journal + ".journal", key ) );
+}
+
+/**
+ * Derives the keys of a migration from the master secret Bob and Carol cached after a previous full key
+ * exchange between the same parties. Alice sends a fresh nonce, and Bob and Carol each expand their
+ * master secret with it, so every migration is keyed differently without a new exponentiation.
+ */
+static bool resumeSession( const Simulation::Options& options, const std::string& peers,
+                           unsigned char* keyBob, unsigned char* keyCarol, double& elapsed )
+{
+   bool          status = false;
+   unsigned char nonce[ Resumption::NonceLen ];
+   std::chrono::time_point< HighResClock > start = HighResClock::now( );
+
+   if( ( options.cache != nullptr ) && ( RAND_bytes( nonce, Resumption::NonceLen ) == 1 ) )
+   {
+      status  = ( options.cache->Derive( peers, nonce, keyBob, SessionKeyLen ) == SessionKeyLen ) &&
+                ( options.cache->Derive( peers, nonce, keyCarol, SessionKeyLen ) == SessionKeyLen );
+      elapsed = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+      if( status )
+      {
+         options.cache->Account( peers, elapsed );
+      }
+   }
+
+   return( status );
+}
+
+static void printSetup( const Simulation::Options& options, const std::string& peers, bool resumed )
+{
+   int    migrations;
+   double amortized;
+
+   if( options.cache != nullptr )
+   {
+      amortized = options.cache->Amortized( peers, migrations );
+      std::cout << "> Session Resumption:    " << ( resumed ? "Resumed from cached master secret (HKDF-SHA256)" : "Full key exchange" )
+                << std::endl;
+      std::cout << "> Amortized Key Setup:   " << std::setprecision( 6 ) << amortized << " Milliseconds per Migration ("
+                << migrations << " Migrations, " << options.cache->Count( ) << " Cached, " << options.cache->Evictions( )
+                << " Evicted)" << std::endl;
+   }
+}
+
+/**
+ * Generates Diffie-Hellman parameters, safe-prime (p,g) or (p,q,g) with a prime order subgroup.
+ */
+static int generateParams( int keyLen, const Simulation::Options& options, Key** params )
+{
+   return( options.subgroup ? DiffieHellman::Session::SubgroupParams( keyLen, params ) :
+                              DiffieHellman::Session::GenerateParams( keyLen, params, options.keygen ) );
+}
+
+/**
+ * Generates the long-term signing key of a party for the scheme, "ed25519" or "rsa<Bits>" (2048 bits when
+ * the length is omitted).
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+static int initIdentity( const std::string& scheme, Identity& identity )
+{
+   int status = -1;
+
+   if( scheme == "ed25519" )
+   {
+      status = identity.ed25519.Initialize( );
+   }
+   else if( scheme.rfind( "rsa", 0 ) == 0 )
+   {
+      status = identity.rsa.Initialize( ( scheme.size( ) > 3 ) ? std::stoi( scheme.substr( 3 ) ) : 2048 );
+   }
+
+   return( status );
+}
+
+/**
+ * Signs a Diffie-Hellman public value with the long-term key of its party.
+ *
+ * @return Length of the signature, or a negative value on error.
+ */
+static int signValue( const std::string& scheme, Identity& identity, const Key& value, std::vector< unsigned char >& signature )
+{
+   int status;
+
+   if( scheme == "ed25519" )
+   {
+      signature.resize( Ed25519::SignatureLen );
+      status = identity.ed25519.Sign( value.Buffer( ), value.Length( ), signature.data( ) );
+   }
+   else
+   {
+      signature.resize( static_cast< size_t >( identity.rsa.Size( ) ) );
+      status = identity.rsa.Sign( value.Buffer( ), static_cast< int >( value.Length( ) ), signature.data( ) );
+   }
+
+   return( status );
+}
+
+/**
+ * Verifies the signature of a peer's Diffie-Hellman public value with the peer's long-term public key.
+ *
+ * @return 0 when the signature is valid, otherwise a negative value.
+ */
+static int verifyValue( const std::string& scheme, const Identity& signer, const Key& value,
+                        const std::vector< unsigned char >& signature )
+{
+   int status;
+
+   if( scheme == "ed25519" )
+   {
+      status = ( signature.size( ) != Ed25519::SignatureLen ) ? -1 :
+               Ed25519::Verify( value.Buffer( ), value.Length( ), signature.data( ), signer.ed25519.PublicKey( ) );
+   }
+   else
+   {
+      status = RSACryptosystem::Cipher::Verify( value.Buffer( ), static_cast< int >( value.Length( ) ), signature.data( ),
+                                                static_cast< int >( signature.size( ) ), *signer.rsa.PublicKey( ) );
+   }
+
+   return( status );
+}
+
+/**
+ * Alice generates the Diffie-Hellman parameters and Alice, Bob, and Carol exchange first and second stage
+ * public keys until each of them holds the shared secret g^abc mod p.
+ */
+static int exchangeDiffieHellman( int keyLen, const Simulation::Options& options, DiffieHellman::Session& Alice,
+                                  DiffieHellman::Session& Bob, DiffieHellman::Session& Carol,
+                                  double& elapsedGen, double& elapsedExc, double& elapsedAuth, Perf::Sample& perfExc,
+                                  Memory::Usage& memoryGen, Memory::Usage& memoryExc )
+{
+   int status = 0;
+
+   Key* keyGab  = nullptr;
+   Key* keyGac  = nullptr;
+   Key* keyGba  = nullptr;
+   Key* keyGbc  = nullptr;
+   Key* keyGca  = nullptr;
+   Key* keyGcb  = nullptr;
+   Key* keyGabc = nullptr;
+   Key* keyGacb = nullptr;
+   Key* keyGbca = nullptr;
+   Key* keyGbac = nullptr;
+   Key* keyGcab = nullptr;
+   Key* keyGcba = nullptr;
+   Key* dhParams = nullptr;
+
+   Identity                     identities[ 3 ];
+   std::vector< unsigned char > signatures[ 3 ];
+   Trace::Span                  exchange( "Diffie-Hellman Exchange" );
+   Perf::Counters               counters;
+   Memory::Phase                phase;
+   Network::Emulator*           wan = options.network;
+
+   std::chrono::time_point< HighResClock > start;
+   std::chrono::time_point< HighResClock > startAuth;
+
+   /// @par Process Design Language
+   /// -# Alice, Bob, and Carol hold long-term signing keys known to each other when the public values are signed
+   elapsedAuth = 0.0;
+   for( Identity& identity : identities )
+   {
+      status |= options.auth.empty( ) ? 0 : initIdentity( options.auth, identity );
+   }
+
+   /// -# Alice generates Diffie-Hellman Parameters (p,g), or (p,q,g) with a 256-bit subgroup
+   start = std::chrono::high_resolution_clock::now( );
+   phase.Start( );
+   {
+      Trace::Span span( "Generate Parameters", "Alice" );
+      Progress::Begin( Progress::Phase::Parameters );
+      status |= generateParams( keyLen, options, &dhParams );
+   }
+   if( status != 0 )
+   {
+      memoryGen = phase.Stop( );
+      delete dhParams;
+      return( -1 );
+   }
+   #ifdef _DEBUG
+   std::cout << "> Alice Generated (p,g)" << std::endl;
+   #endif
+
+   /// -# Precompute the Montgomery context and fixed-base table of (p,g) once for all three parties
+   DiffieHellman::Group group( *dhParams );
+   elapsedGen = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+   memoryGen  = phase.Stop( );
+   compute( wan, Network::Alice, elapsedGen );
+   start = std::chrono::high_resolution_clock::now( );
+   phase.Start( );
+   Progress::Begin( Progress::Phase::Exchange );
+
+   /// -# Count the hardware events of the exponentiations, leaving out parameter generation and signatures
+   if( options.perf )
+   {
+      ( void )counters.Initialize( );
+   }
+   counters.Start( );
+
+   /// -# Alice Initializes Private Key a
+   {
+      Trace::Span   span( "Initialize", "Alice" );
+      Network::Step step( wan, Network::Alice );
+      status |= Alice.Initialize( group );
+   }
+   #ifdef _DEBUG
+   std::cout << "> Alice Initialized a" << std::endl;
+   #endif
+
+   /// -# Alice sends parameters (p,g) to Bob
+   send( wan, Network::Alice, Network::Bob, dhParams->Length( ) );
+   {
+      Trace::Span   span( "Initialize", "Bob" );
+      Network::Step step( wan, Network::Bob );
+      status |= Bob.Initialize( group );
+   }
+   #ifdef _DEBUG
+   std::cout << "> Alice->Bob [p,g]" << std::endl;
+   #endif
+
+   /// -# Alice sends parameters (p,g) to Carol
+   send( wan, Network::Alice, Network::Carol, dhParams->Length( ) );
+   {
+      Trace::Span   span( "Initialize", "Carol" );
+      Network::Step step( wan, Network::Carol );
+      status |= Carol.Initialize( group );
+   }
+   #ifdef _DEBUG
+   std::cout << "> Alice->Carol [p,g]" << std::endl;
+   #endif
+   perfExc = counters.Stop( );
+
+   const DiffieHellman::Session* parties[ 3 ] = { &Alice, &Bob, &Carol };
+   const char*                   names[ 3 ]   = { "Alice", "Bob", "Carol" };
+
+   /// -# Alice, Bob, and Carol sign their public values
+   if( !options.auth.empty( ) && ( status == 0 ) )
+   {
+      startAuth = HighResClock::now( );
+      for( int party = 0; party < 3; party++ )
+      {
+         Trace::Span   span( "Sign Public Value", names[ party ] );
+         Network::Step step( wan, static_cast< Network::Party >( party ) );
+
+         status |= ( signValue( options.auth, identities[ party ], *parties[ party ]->PublicKey( ), signatures[ party ] ) > 0 ) ? 0 : -1;
+      }
+      elapsedAuth = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - startAuth ).count( );
+   }
+
+   /// -# Every party sends its public value with its signature to its peers, and receives theirs
+   for( int party = 0; ( status == 0 ) && ( party < 3 ); party++ )
+   {
+      for( int peer = 0; peer < 3; peer++ )
+      {
+         if( peer != party )
+         {
+            send( wan, static_cast< Network::Party >( party ), static_cast< Network::Party >( peer ),
+                  static_cast< long long >( parties[ party ]->PublicKey( )->Length( ) + signatures[ party ].size( ) ) );
+         }
+      }
+   }
+   for( int party = 0; party < 3; party++ )
+   {
+      for( int peer = 0; peer < 3; peer++ )
+      {
+         if( peer != party )
+         {
+            receive( wan, static_cast< Network::Party >( peer ), static_cast< Network::Party >( party ) );
+         }
+      }
+   }
+
+   /// -# Every party verifies the signed values of its peers
+   if( !options.auth.empty( ) && ( status == 0 ) )
+   {
+      startAuth = HighResClock::now( );
+      for( int party = 0; party < 3; party++ )
+      {
+         for( int peer = 0; peer < 3; peer++ )
+         {
+            if( peer != party )
+            {
+               Trace::Span   span( "Verify Public Value", names[ party ] );
+               Network::Step step( wan, static_cast< Network::Party >( party ) );
+
+               status |= verifyValue( options.auth, identities[ peer ], *parties[ peer ]->PublicKey( ), signatures[ peer ] );
+            }
+         }
+      }
+      elapsedAuth += std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - startAuth ).count( );
+      #ifdef _DEBUG
+      std::cout << "> Alice, Bob, and Carol verified the signed public values" << std::endl;
+      #endif
+   }
+   if( status != 0 )
+   {
+      memoryExc = phase.Stop( );
+      delete dhParams;
+      return( -1 );
+   }
+
+   /// -# Alice sends g^a mod p to Bob
+   counters.Start( );
+   if( status == 0 )
+   {
+      Trace::Span   span( "Derive g^ab", "Bob" );
+      Network::Step step( wan, Network::Bob );
+      status = Bob.Derive( *Alice.PublicKey( ) );
+   }
+   if( status == 0 )
+   {
+      keyGab = new Key( *Bob.Secret( ) );
+      send( wan, Network::Bob, Network::Carol, keyGab->Length( ) );
+   }
+   #ifdef _DEBUG
+   std::cout << "> Alice->Bob [g^a mod p]" << std::endl;
+   #endif
+
+   /// -# Alice sends g^a mod p to Carol
+   if( status == 0 )
+   {
+      Trace::Span   span( "Derive g^ac", "Carol" );
+      Network::Step step( wan, Network::Carol );
+      status = Carol.Derive( *Alice.PublicKey( ) );
+   }
+   if( status == 0 )
+   {
+      keyGac = new Key( *Carol.Secret( ) );
+      send( wan, Network::Carol, Network::Bob, keyGac->Length( ) );
+   }
+   #ifdef _DEBUG
+   std::cout << "> Alice->Carol [g^a mod p]" << std::endl;
+   #endif
+
+   /// -# Bob sends g^b mod p to Alice
+   if( status == 0 )
+   {
+      Trace::Span   span( "Derive g^ba", "Alice" );
+      Network::Step step( wan, Network::Alice );
+      status = Alice.Derive( *Bob.PublicKey( ) );
+   }
+   if( status == 0 )
+   {
+      keyGba = new Key( *Alice.Secret( ) );
+      send( wan, Network::Alice, Network::Carol, keyGba->Length( ) );
+   }
+   #ifdef _DEBUG
+   std::cout << "> Bob->Alice [g^b mod p]" << std::endl;
+   #endif
+
+   /// -# Bob sends g^b mod p to Carol
+   if( status == 0 )
+   {
+      Trace::Span   span( "Derive g^bc", "Carol" );
+      Network::Step step( wan, Network::Carol );
+      status = Carol.Derive( *Bob.PublicKey( ) );
+   }
+   if( status == 0 )
+   {
+      keyGbc = new Key( *Carol.Secret( ) );
+      send( wan, Network::Carol, Network::Alice, keyGbc->Length( ) );
+   }
+   #ifdef _DEBUG
+   std::cout << "> Bob->Carol [g^b mod p]" << std::endl;
+   #endif
+
+   /// -# Carol sends g^c mod p to Alice
+   if( status == 0 )
+   {
+      Trace::Span   span( "Derive g^ca", "Alice" );
+      Network::Step step( wan, Network::Alice );
+      status = Alice.Derive( *Carol.PublicKey( ) );
+   }
+   if( status == 0 )
+   {
+      keyGca = new Key( *Alice.Secret( ) );
+      send( wan, Network::Alice, Network::Bob, keyGca->Length( ) );
+   }
+   #ifdef _DEBUG
+   std::cout << "> Carol->Alice [g^c mod p]" << std::endl;
+   #endif
+
+   /// -# Carol sends g^c mod p to Bob
+   if( status == 0 )
+   {
+      Trace::Span   span( "Derive g^cb", "Bob" );
+      Network::Step step( wan, Network::Bob );
+      status = Bob.Derive( *Carol.PublicKey( ) );
+   }
+   if( status == 0 )
+   {
+      keyGcb = new Key( *Bob.Secret( ) );
+      send( wan, Network::Bob, Network::Alice, keyGcb->Length( ) );
+   }
+   #ifdef _DEBUG
+   std::cout << "> Carol->Bob [g^c mod p]" << std::endl;
+   #endif
+
+   /// -# Alice sends Bob   [g^ca mod p]
+   /// -# Alice sends Carol [g^ba mod p]
+   /// -# Bob   sends Alice [g^cb mod p]
+   /// -# Bob   sends Carol [g^ab mod p]
+   /// -# Carol sends Alice [g^bc mod p]
+   /// -# Carol sends Bob   [g^ac mod p]
+
+   /// -# Alice Derives Shared Secrets g^bca and g^cba
+   /// -# Alice verifies g^bca == g^cba
+   receive( wan, Network::Carol, Network::Alice );
+   if( status == 0 )
+   {
+      Trace::Span   span( "Derive g^bca", "Alice" );
+      Network::Step step( wan, Network::Alice );
+      status = Alice.Derive( *keyGbc );
+   }
+   if( status == 0 )
+   {
+      keyGbca = new Key( *Alice.Secret( ) );
+   }
+   #ifdef _DEBUG
+   std::cout << "> Alice derived [g^bca mod p]" << std::endl;
+   #endif
+   
+   receive( wan, Network::Bob, Network::Alice );
+   if( status == 0 )
+   {
+      Trace::Span   span( "Derive g^cba", "Alice" );
+      Network::Step step( wan, Network::Alice );
+      status = Alice.Derive( *keyGcb );
+   }
+   if( status == 0 )
+   {
+      keyGcba = new Key( *Alice.Secret( ) );
+   }
+   #ifdef _DEBUG
+   std::cout << "> Alice derived [g^cba mod p]" << std::endl;
+   #endif
+
+   /// -# Bob Derives Shared Secrets g^acb and g^cab
+   /// -# Bob verifies g^acb == g^cab
+   receive( wan, Network::Carol, Network::Bob );
+   if( status == 0 )
+   {
+      Trace::Span   span( "Derive g^acb", "Bob" );
+      Network::Step step( wan, Network::Bob );
+      status = Bob.Derive( *keyGac );
+   }
+   if( status == 0 )
+   {
+      keyGacb = new Key( *Bob.Secret( ) );
+   }
+   #ifdef _DEBUG
+   std::cout << "> Bob derived [g^acb mod p]" << std::endl;
+   #endif
+   
+   receive( wan, Network::Alice, Network::Bob );
+   if( status == 0 )
+   {
+      Trace::Span   span( "Derive g^cab", "Bob" );
+      Network::Step step( wan, Network::Bob );
+      status = Bob.Derive( *keyGca );
+   }
+   if( status == 0 )
+   {
+      keyGcab = new Key( *Bob.Secret( ) );
+   }
+   #ifdef _DEBUG
+   std::cout << "> Bob derived [g^cab mod p]" << std::endl;
+   #endif
+
+   /// -# Carol Derives Shared Secrets g^abc and g^bac
+   /// -# Carol verifies g^abc == g^bac
+   receive( wan, Network::Bob, Network::Carol );
+   if( status == 0 )
+   {
+      Trace::Span   span( "Derive g^abc", "Carol" );
+      Network::Step step( wan, Network::Carol );
+      status = Carol.Derive( *keyGab );
+   }
+   if( status == 0 )
+   {
+      keyGabc = new Key( *Carol.Secret( ) );
+   }
+   #ifdef _DEBUG
+   std::cout << "> Carol derived [g^abc mod p]" << std::endl;
+   #endif
+
+   receive( wan, Network::Alice, Network::Carol );
+   if( status == 0 )
+   {
+      Trace::Span   span( "Derive g^bac", "Carol" );
+      Network::Step step( wan, Network::Carol );
+      status = Carol.Derive( *keyGba );
+   }
+   if( status == 0 )
+   {
+      keyGbac = new Key( *Carol.Secret( ) );
+   }
+   #ifdef _DEBUG  
+   std::cout << "> Carol derived [g^bac mod p]" << std::endl;
+   #endif
+
+   /// -# Every party verifies that its two derivations of the shared secret agree
+   if( ( status == 0 ) && !( ( *keyGbca == *keyGcba ) && ( *keyGacb == *keyGcab ) && ( *keyGabc == *keyGbac ) ) )
+   {
+      status = -2;
+   }
+   #ifdef _DEBUG
+   std::cout << "> Alice, Bob, and Carol verified [g^abc mod p]" << ( ( status == 0 ) ? "" : " ERROR" ) << std::endl;
+   #endif
+
+   perfExc.Add( counters.Stop( ) );
+   elapsedExc = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+
+   delete keyGab;
+   delete keyGac;
+   delete keyGba;
+   delete keyGbc;
+   delete keyGca;
+   delete keyGcb;
+   delete keyGabc;
+   delete keyGacb;
+   delete keyGbca;
+   delete keyGbac;
+   delete keyGcab;
+   delete keyGcba;
+   memoryExc = phase.Stop( );
+   delete dhParams;
+
+   return( status );
+}
+
+/**
+ * Returns the number of primes of the RSA keys, the most the key length allows when the option is 0.
+ */
+static unsigned int rsaPrimes( int keyLen, const Simulation::Options& options )
+{
+   return( ( options.rsaPrimes == 0 ) ? RSACryptosystem::Cipher::MaxPrimes( keyLen ) : options.rsaPrimes );
+}
+
+/**
+ * Alice generates the secret key, Alice, Bob, and Carol generate public/private key pairs, and Alice
+ * distributes the secret key to Bob and Carol encrypted with their public keys.
+ *
+ * @return 0 when Bob and Carol both hold the secret key, otherwise a negative value.
+ */
+static int exchangeRSA( int keyLen, const Simulation::Options& options, unsigned char* keyBobP, unsigned char* keyCarolP,
+                        double& elapsedGen, double& elapsedExc, Perf::Sample& perfExc, Memory::Usage& memoryGen,
+                        Memory::Usage& memoryExc )
+{
+   int                     status = 0;
+   BIGNUM*                 prime;
+   Key*                    rsaKey;
+   int                     bytes = ( ( keyLen + 7 ) / 8 ) - 11;
+   int                     length;
+   unsigned char*          buffer;
+   unsigned char*          keyBobC    = new unsigned char[ ( keyLen + 7 ) / 8 ];
+   unsigned char*          keyCarolC  = new unsigned char[ ( keyLen + 7 ) / 8 ];
+   RSACryptosystem::Cipher Alice;
+   RSACryptosystem::Cipher Bob;
+   RSACryptosystem::Cipher Carol;
+   Trace::Span             exchange( "RSA Exchange" );
+   Perf::Counters          counters;
+   Memory::Phase           phase;
+   Network::Emulator*      wan = options.network;
+
+   std::chrono::time_point< HighResClock > start;
+
+   /// @par Process Design Language
+   /// -# Alice generates a secret key
+   start = std::chrono::high_resolution_clock::now( );
+   phase.Start( );
+   {
+      Trace::Span span( "Generate Secret Key", "Alice" );
+      Progress::Begin( Progress::Phase::Parameters );
+
+      prime  = BN_new( );
+      buffer = new unsigned char[ ( keyLen + 7 ) / 8 ];
+      if( ( prime == NULL ) || ( BN_generate_prime_ex( prime, keyLen, 1, NULL, NULL, NULL ) != 1 ) ||
+          ( BN_bn2binpad( prime, buffer, ( keyLen + 7 ) / 8 ) < 0 ) )
+      {
+         status = -1;
+      }
+      rsaKey = new Key( buffer, ( keyLen + 7 ) / 8 );
+      BN_free( prime );
+      delete[ ] buffer;
+   }
+   #ifdef _DEBUG
+   std::cout << "> Alice generated Secret Key" << std::endl;
+   #endif
+   elapsedGen = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+   memoryGen  = phase.Stop( );
+   compute( wan, Network::Alice, elapsedGen );
+   start = std::chrono::high_resolution_clock::now( );
+   phase.Start( );
+   Progress::Begin( Progress::Phase::Exchange );
+
+   /// -# Alice, Bob, and Carol generate Public/Private Key Pair
+   {
+      Trace::Span   span( "Generate Key Pair", "Alice" );
+      Network::Step step( wan, Network::Alice );
+      status |= ( Alice.Initialize( keyLen, options.keygen, rsaPrimes( keyLen, options ) ) == 0 ) ? 0 : -2;
+   }
+   #ifdef _DEBUG
+   std::cout << "> Alice generate Public/Private Key Pair" << std::endl;
+   #endif
+   {
+      Trace::Span   span( "Generate Key Pair", "Bob" );
+      Network::Step step( wan, Network::Bob );
+      status |= ( Bob.Initialize( keyLen, options.keygen, rsaPrimes( keyLen, options ) ) == 0 ) ? 0 : -2;
+   }
+   #ifdef _DEBUG
+   std::cout << "> Bob generate Public/Private Key Pair" << std::endl;
+   #endif
+   {
+      Trace::Span   span( "Generate Key Pair", "Carol" );
+      Network::Step step( wan, Network::Carol );
+      status |= ( Carol.Initialize( keyLen, options.keygen, rsaPrimes( keyLen, options ) ) == 0 ) ? 0 : -2;
+   }
+   #ifdef _DEBUG
+   std::cout << "> Carol generate Public/Private Key Pair" << std::endl; 
+   #endif   
+   
+   /// -# Count the hardware events of the public and private key operations, leaving out key generation
+   if( options.perf )
+   {
+      ( void )counters.Initialize( );
+   }
+   counters.Start( );
+
+   /// -# Alice requests Bob's Public Key B and Carol's Public Key C
+   /// -# Bob sends his Public Key B to Alice, Carol sends her Public Key C to Alice
+   send( wan, Network::Alice, Network::Bob, 0 );
+   send( wan, Network::Alice, Network::Carol, 0 );
+   receive( wan, Network::Alice, Network::Bob );
+   send( wan, Network::Bob, Network::Alice, ( status == 0 ) ? Bob.PublicKey( )->Length( ) : 0 );
+   receive( wan, Network::Alice, Network::Carol );
+   send( wan, Network::Carol, Network::Alice, ( status == 0 ) ? Carol.PublicKey( )->Length( ) : 0 );
+
+   /// -# Alice encrypts the Secret Key using B
+   receive( wan, Network::Bob, Network::Alice );
+   {
+      Trace::Span   span( "Encrypt Secret Key for Bob", "Alice" );
+      Network::Step step( wan, Network::Alice );
+      length = ( status == 0 ) ? Alice.Encrypt( rsaKey->Buffer( ), keyBobC, bytes, *Bob.PublicKey( ) ) : -1;
+   }
+   #ifdef _DEBUG
+   std::cout << "> Alice encrypted " << ( bytes * 8 ) << " bits of " << keyLen << " bit Secret Key using Bob's Public Key" << std::endl;
+   #endif   
+
+   /// -# Alice Sends Encrypted Secret Key to Bob
+   /// -# Bob Decrypts Secret Key
+   send( wan, Network::Alice, Network::Bob, std::max( length, 0 ) );
+   receive( wan, Network::Alice, Network::Bob );
+   {
+      Trace::Span   span( "Decrypt Secret Key", "Bob" );
+      Network::Step step( wan, Network::Bob );
+      if( ( length < 0 ) || ( Bob.Decrypt( keyBobC, keyBobP, length ) != bytes ) )
+      {
+         status = -3;
+      }
+   }
+   #ifdef _DEBUG  
+   std::cout << "> Alice sent the Encrypted Secret Key to Bob" << std::endl;
+   std::cout << "> Bob Decypts the Secret Key" << std::endl;
+   #endif
+   
+   /// -# Alice encrypts the Secret Key using C
+   receive( wan, Network::Carol, Network::Alice );
+   {
+      Trace::Span   span( "Encrypt Secret Key for Carol", "Alice" );
+      Network::Step step( wan, Network::Alice );
+      length = ( status == 0 ) ? Alice.Encrypt( rsaKey->Buffer( ), keyCarolC, bytes, *Carol.PublicKey( ) ) : -1;
+   }
+   #ifdef _DEBUG
+   std::cout << "> Alice encrypted " << ( bytes * 8 ) << " bits of " << keyLen << " bit Secret Key using Carol's Public Key" << std::endl;
+   #endif
+   
+   /// -# Alice Sends Encrypted Secret Key to Carol
+   /// -# Carol Decrypts Secret Key
+   send( wan, Network::Alice, Network::Carol, std::max( length, 0 ) );
+   receive( wan, Network::Alice, Network::Carol );
+   {
+      Trace::Span   span( "Decrypt Secret Key", "Carol" );
+      Network::Step step( wan, Network::Carol );
+      if( ( length < 0 ) || ( Carol.Decrypt( keyCarolC, keyCarolP, length ) != bytes ) )
+      {
+         status = -4;
+      }
+   }
+   #ifdef _DEBUG
+   std::cout << "> Alice sent the Encrypted Secret Key to Carol" << std::endl;
+   std::cout << "> Carol Decypts the Secret Key" << std::endl;
+   #endif
+
+   perfExc    = counters.Stop( );
+   elapsedExc = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+
+   delete rsaKey;
+   delete[ ] keyBobC;
+   delete[ ] keyCarolC;
+   memoryExc = phase.Stop( );
+
+   return( status );
+}
+
+/**
+ * Encrypts the plaintext at Bob, sends the ciphertext to Carol, and decrypts it at Carol. When
+ * deduplication is enabled Bob first replaces the chunks Carol already holds with references, and when
+ * compression is enabled the remaining bytes are compressed in parallel chunks before encryption and
+ * decompressed after decryption, with the uncompressed pipeline timed as a baseline.
+ */
+static int transfer( const unsigned char* plaintext, int size,
+                     const unsigned char* keyBob, const unsigned char* ivBob,
+                     const unsigned char* keyCarol, const unsigned char* ivCarol,
+                     unsigned char* decrypted, const Simulation::Options& options, TransferStats& stats )
+{
+   int                    status;
+   int                    length     = size;
+   int                    packedLen  = size;
+   int                    capacity;
+   const unsigned char*   input      = plaintext;
+   unsigned char*         packed     = nullptr;
+   unsigned char*         compressed = nullptr;
+   unsigned char*         ciphertext;
+   unsigned char*         recovered;
+   unsigned char*         unpacked;
+   unsigned char          nonce[ AES::NonceLen ];
+   unsigned char          baseline[ Journal::KeyLen + AES::BlockLen ];
+   const unsigned char*   ivSent;
+   Deduplication::Chunker chunker( options.average );
+   Trace::Span            migration( "Transfer", nullptr, size );
+   Perf::Counters         counters;
+   Memory::Phase          phase;
+   Network::Emulator*     wan = options.network;
+   std::chrono::time_point< HighResClock > begin = HighResClock::now( );
+   std::chrono::time_point< HighResClock > start;
+
+   /// @par Process Design Language
+   /// -# Measure the allocations of the whole transfer, until its buffers are freed
+   phase.Start( );
+   stats.network = measure( wan );
+
+   /// -# Migrate chunk by chunk with a checkpoint journal in resumable mode, emulated as one message after both parties computed
+   if( !options.journal.empty( ) )
+   {
+      {
+         Network::Step step( wan, Network::Bob );
+         Progress::Begin( Progress::Phase::Transfer );
+         status = resumableTransfer( plaintext, size, keyBob, keyCarol, decrypted, options, stats );
+         Progress::End( );
+      }
+      send( wan, Network::Bob, Network::Carol, stats.migrated );
+      receive( wan, Network::Bob, Network::Carol );
+      stats.memory = phase.Stop( );
+      return( status );
+   }
+
+   /// -# Migrate only the changed blocks in incremental mode, emulated as one message after both parties computed
+   if( !options.state.empty( ) )
+   {
+      {
+         Network::Step step( wan, Network::Bob );
+         Progress::Begin( Progress::Phase::Transfer );
+         status = incrementalTransfer( plaintext, size, keyBob, ivBob, keyCarol, ivCarol, decrypted, options, stats );
+         Progress::End( );
+      }
+      send( wan, Network::Bob, Network::Carol, stats.migrated );
+      receive( wan, Network::Bob, Network::Carol );
+      stats.memory = phase.Stop( );
+      return( status );
+   }
+
+   stats.compressed     = size;
+   stats.migratedRaw    = 0;
+   stats.elapsedZip     = 0.0;
+   stats.elapsedUnzip   = 0.0;
+   stats.elapsedRaw     = 0.0;
+   stats.elapsedDedup   = 0.0;
+   stats.elapsedUndedup = 0.0;
+
+   /// -# Count the hardware events of the ciphers
+   if( options.perf )
+   {
+      ( void )counters.Initialize( );
+   }
+
+   /// -# Replace the chunks Carol already holds with references at Bob
+   if( options.index != nullptr )
+   {
+      capacity = Deduplication::PackBound( size, chunker );
+      packed   = new unsigned char[ capacity ];
+      start    = HighResClock::now( );
+      {
+         Trace::Span   span( "Deduplicate", "Bob", size );
+         Network::Step step( wan, Network::Bob );
+         Progress::Begin( Progress::Phase::Deduplicate, size );
+         length   = Deduplication::Pack( plaintext, size, chunker, *options.index, packed, capacity, stats.dedup );
+      }
+      stats.elapsedDedup = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+      packedLen = length;
+      input     = packed;
+      #ifdef _DEBUG
+      std::cout << "> Bob looked up chunks in Carol's index and packed the new chunks" << std::endl;
+      #endif
+   }
+
+   /// -# Compress data at Bob
+   if( options.compress && ( length >= 0 ) )
+   {
+      capacity   = std::max( length, Compression::Bound( length, options.chunkSize ) );
+      compressed = new unsigned char[ capacity ];
+      start      = HighResClock::now( );
+      {
+         Trace::Span   span( "Compress", "Bob", length );
+         Network::Step step( wan, Network::Bob );
+         Progress::Begin( Progress::Phase::Compress, length );
+         length     = Compression::Compress( input, length, compressed, capacity, options.chunkSize, options.level );
+      }
+      stats.elapsedZip = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+      stats.compressed = length;
+      input            = compressed;
+      #ifdef _DEBUG
+      std::cout << "> Bob compressed plaintext" << std::endl;
+      #endif
+   }
+
+   capacity   = std::max( { length, packedLen, size } ) + 32;
+   ciphertext = new unsigned char[ capacity ];
+   recovered  = ( options.compress || ( options.index != nullptr ) ) ? new unsigned char[ capacity ] : decrypted;
+   unpacked   = ( options.compress && ( options.index != nullptr ) ) ? new unsigned char[ capacity ] : recovered;
+
+   /// -# Encrypt data at Bob and send to Carol, ahead of it a fresh nonce with ChaCha20-Poly1305
+   ivSent = messageIV( ivBob, nonce );
+   {
+      Trace::Span   span( "Encrypt", "Bob", length );
+      Network::Step step( wan, Network::Bob );
+      Progress::Begin( Progress::Phase::Encrypt, length );
+      counters.Start( );
+      status = ( length < 0 ) ? length : AES::Encrypt( input, length, keyBob, ivSent, ciphertext );
+      stats.perfEncrypt = counters.Stop( );
+   }
+   stats.migrated = status;
+   #ifdef _DEBUG
+   std::cout << "> Bob encrypted plaintext and sent ciphertext to Carol" << std::endl;
+   #endif
+
+   /// -# Bob signs the manifest of the ciphertext messages once, Carol checks it and every message
+   if( ( options.signer != nullptr ) && ( status >= 0 ) )
+   {
+      status = authenticate( ciphertext, status, options, stats );
+      compute( wan, Network::Bob, stats.elapsedSigning );
+   }
+
+   /// -# Decrypt data at Carol received from Bob
+   if( status >= 0 )
+   {
+      send( wan, Network::Bob, Network::Carol, stats.migrated );
+      receive( wan, Network::Bob, Network::Carol );
+      compute( wan, Network::Carol, ( options.signer != nullptr ) ? stats.elapsedVerify : 0.0 );
+      {
+         Trace::Span   span( "Decrypt", "Carol", status );
+         Network::Step step( wan, Network::Carol );
+         Progress::Begin( Progress::Phase::Decrypt, status );
+         counters.Start( );
+         status = AES::Decrypt( ciphertext, status, keyCarol, ( ivSent == nonce ) ? nonce : ivCarol, recovered );
+         stats.perfDecrypt = counters.Stop( );
+      }
+      #ifdef _DEBUG
+      std::cout << "> Carol received ciphertext from Bob and decrypted plaintext" << std::endl;
+      #endif
+   }
+
+   /// -# Decompress data at Carol
+   if( options.compress && ( status >= 0 ) )
+   {
+      start  = HighResClock::now( );
+      {
+         Trace::Span   span( "Decompress", "Carol", status );
+         Network::Step step( wan, Network::Carol );
+         Progress::Begin( Progress::Phase::Decompress, status );
+         status = Compression::Decompress( recovered, status, ( options.index != nullptr ) ? unpacked : decrypted, packedLen,
+                                          options.chunkSize );
+      }
+      stats.elapsedUnzip = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+      #ifdef _DEBUG
+      std::cout << "> Carol decompressed plaintext" << std::endl;
+      #endif
+   }
+
+   /// -# Reassemble the object at Carol from the new chunks and her chunk index
+   if( ( options.index != nullptr ) && ( status >= 0 ) )
+   {
+      start  = HighResClock::now( );
+      {
+         Trace::Span   span( "Reassemble", "Carol", status );
+         Network::Step step( wan, Network::Carol );
+         Progress::Begin( Progress::Phase::Reassemble, status );
+         status = Deduplication::Unpack( unpacked, status, *options.index, decrypted, size );
+      }
+      stats.elapsedUndedup = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+      #ifdef _DEBUG
+      std::cout << "> Carol reassembled plaintext from her chunk index" << std::endl;
+      #endif
+   }
+
+   Progress::End( );
+   stats.elapsed = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - begin ).count( );
+
+   /// -# Time the uncompressed pipeline as the baseline for the net effect of compression, under a throwaway key
+   ///    so the session key never encrypts a second message
+   if( options.compress && ( packedLen >= 0 ) && ( RAND_bytes( baseline, sizeof( baseline ) ) == 1 ) )
+   {
+      ivSent = messageIV( ( ivBob != NULL ) ? baseline + Journal::KeyLen : NULL, nonce );
+      start  = HighResClock::now( );
+      length = AES::Encrypt( ( packed != nullptr ) ? packed : plaintext, packedLen, baseline, ivSent, ciphertext );
+      stats.migratedRaw = length;
+      ( void )AES::Decrypt( ciphertext, length, baseline, ivSent, recovered );
+      stats.elapsedRaw = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+   }
+
+   if( unpacked != recovered )
+   {
+      delete[ ] unpacked;
+   }
+   if( recovered != decrypted )
+   {
+      delete[ ] recovered;
+   }
+   delete[ ] compressed;
+   delete[ ] packed;
+   delete[ ] ciphertext;
+   OPENSSL_cleanse( baseline, sizeof( baseline ) );
+   stats.memory = phase.Stop( );
+
+   return( status );
+}
+
+/**
+ * Migrates only the blocks which changed since the previous migration of the object. Bob keeps a block
+ * signature manifest, wraps the object key with the session key, and sends the changed blocks encrypted
+ * with AES-256-CTR together with the block version table. Carol writes the changed ciphertext blocks
+ * into her replica in place, the unchanged ciphertext blocks stay valid.
+ */
+static int incrementalTransfer( const unsigned char* plaintext, int size,
+                                const unsigned char* keyBob, const unsigned char* ivBob,
+                                const unsigned char* keyCarol, const unsigned char* ivCarol,
+                                unsigned char* decrypted, const Simulation::Options& options, TransferStats& stats )
+{
+   const std::string            manifestPath = options.state + ".manifest";
+   const std::string            replicaPath  = options.state + ".replica";
+   int                          status       = 0;
+   int                          length;
+   long long                    replicaSize  = -1;
+   Delta::Manifest              manifest( options.blockSize );
+   std::vector< int >           changed;
+   std::vector< unsigned int >  versions;
+   std::vector< unsigned char > ciphertext( static_cast< size_t >( size ) + 1 );
+   unsigned char                wrapped[ Delta::DataKeyLen + 32 ];
+   unsigned char                dataKey[ Delta::DataKeyLen + 32 ];
+   unsigned char                nonce[ AES::NonceLen ];
+   const unsigned char*         ivSent;
+   std::error_code              error;
+   std::chrono::time_point< HighResClock > begin = HighResClock::now( );
+   std::chrono::time_point< HighResClock > start;
+
+   stats.compressed = size;
+   stats.changedLen = 0;
+
+   /// @par Process Design Language
+   /// -# Carol reports the size of her replica, Bob starts over when it does not match his manifest
+   if( std::filesystem::exists( replicaPath, error ) )
+   {
+      replicaSize = static_cast< long long >( std::filesystem::file_size( replicaPath, error ) );
+   }
+   if( ( manifest.Load( manifestPath ) != 0 ) || ( manifest.BlockSize( ) != options.blockSize ) ||
+       ( manifest.Size( ) != replicaSize ) )
+   {
+      manifest = Delta::Manifest( options.blockSize );
+   }
+
+   /// -# Bob signs every block and selects the blocks which changed
+   start = HighResClock::now( );
+   status = manifest.Update( plaintext, size, changed );
+   stats.elapsedSign = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+   stats.blocks      = manifest.Blocks( );
+   stats.changed     = static_cast< int >( changed.size( ) );
+   #ifdef _DEBUG
+   std::cout << "> Bob signed " << stats.blocks << " blocks, " << stats.changed << " changed" << std::endl;
+   #endif
+
+   /// -# Bob wraps the object key with the session key and sends it to Carol, who unwraps it
+   ivSent = messageIV( ivBob, nonce );
+   length = AES::Encrypt( manifest.DataKey( ), Delta::DataKeyLen, keyBob, ivSent, wrapped );
+   stats.migrated = length;
+   length = AES::Decrypt( wrapped, length, keyCarol, ( ivSent == nonce ) ? nonce : ivCarol, dataKey );
+   if( ( status >= 0 ) && ( length != Delta::DataKeyLen ) )
+   {
+      status = -1;
+   }
+
+   /// -# Bob encrypts the changed blocks in parallel and sends them with the block version table
+   for( int block = 0; block < stats.blocks; block++ )
+   {
+      versions.push_back( manifest.Version( block ) );
+   }
+   Utility::ParallelFor( stats.changed, [ & ]( int index )
+   {
+      unsigned char counter[ Delta::CounterLen ];
+      long long     offset = static_cast< long long >( changed[ index ] ) * options.blockSize;
+      int           len    = static_cast< int >( std::min< long long >( options.blockSize, size - offset ) );
+
+      manifest.Counter( changed[ index ], counter );
+      ( void )AES::CTR( plaintext + offset, len, manifest.DataKey( ), counter, &ciphertext[ offset ] );
+   } );
+   for( int block : changed )
+   {
+      stats.changedLen += std::min< long long >( options.blockSize, size - static_cast< long long >( block ) * options.blockSize );
+   }
+   stats.migrated += static_cast< int >( stats.changedLen ) + ( stats.blocks + stats.changed ) * 4;
+   #ifdef _DEBUG
+   std::cout << "> Bob encrypted changed blocks and sent ciphertext to Carol" << std::endl;
+   #endif
+
+   /// -# Carol writes the changed ciphertext blocks into her replica in place
+   if( status >= 0 )
+   {
+      if( replicaSize < 0 )
+      {
+         std::ofstream( replicaPath, std::ios::out | std::ios::binary );
+      }
+
+      std::fstream replica( replicaPath, std::ios::in | std::ios::out | std::ios::binary );
+      for( int block : changed )
+      {
+         long long offset = static_cast< long long >( block ) * options.blockSize;
+
+         replica.seekp( offset );
+         replica.write( reinterpret_cast< const char* >( &ciphertext[ offset ] ),
+                        std::min< long long >( options.blockSize, size - offset ) );
+      }
+      status = replica.good( ) ? status : -2;
+      replica.close( );
+      std::filesystem::resize_file( replicaPath, size, error );
+      #ifdef _DEBUG
+      std::cout << "> Carol wrote changed blocks into her replica" << std::endl;
+      #endif
+   }
+
+   /// -# Bob records the manifest for the next migration
+   if( ( status >= 0 ) && ( manifest.Save( manifestPath ) != 0 ) )
+   {
+      status = -3;
+   }
+
+   stats.elapsed = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - begin ).count( );
+
+   /// -# Carol decrypts her complete replica to verify it matches the object
+   if( status >= 0 )
+   {
+      std::ifstream replica( replicaPath, std::ios::in | std::ios::binary );
+
+      if( !replica.read( reinterpret_cast< char* >( ciphertext.data( ) ), size ) )
+      {
+         status = -4;
+      }
+      else
+      {
+         Utility::ParallelFor( stats.blocks, [ & ]( int block )
+         {
+            unsigned char counter[ Delta::CounterLen ];
+            long long     offset = static_cast< long long >( block ) * options.blockSize;
+            int           len    = static_cast< int >( std::min< long long >( options.blockSize, size - offset ) );
+
+            Delta::Manifest::Counter( block, versions[ block ], counter );
+            ( void )AES::CTR( &ciphertext[ offset ], len, dataKey, counter, decrypted + offset );
+         } );
+         status = size;
+      }
+   }
+
+   OPENSSL_cleanse( dataKey, sizeof( dataKey ) );
+
+   return( status );
+}
+
+/**
+ * Migrates the object in chunks encrypted with AES-256-CTR, recording every chunk Carol has written in a
+ * checkpoint journal. The counter block of a chunk depends only on the journal nonce and the chunk
+ * index, so a restarted migration skips the completed chunks and continues at the first missing one
+ * without any other cipher state.
+ */
+static int resumableTransfer( const unsigned char* plaintext, int size,
+                              const unsigned char* keyBob, const unsigned char* keyCarol,
+                              unsigned char* decrypted, const Simulation::Options& options, TransferStats& stats )
+{
+   const std::string            journalPath = options.journal + ".journal";
+   const std::string            keyPath     = options.journal + ".key";
+   const std::string            outputPath  = options.journal + ".migrated";
+   int                          status;
+   std::FILE*                   output      = NULL;
+   Journal::Checkpoint          checkpoint( options.batch );
+   std::vector< unsigned char > ciphertext( static_cast< size_t >( options.blockSize ) );
+   unsigned char                counter[ Journal::CounterLen ];
+   std::chrono::time_point< HighResClock > begin = HighResClock::now( );
+
+   stats.compressed = size;
+   stats.migrated   = 0;
+   stats.changed    = 0;
+   stats.changedLen = 0;
+
+   /// @par Process Design Language
+   /// -# Carol replays the journal, starting over when her output was lost
+   status = checkpoint.Open( journalPath, keyBob, size, options.blockSize );
+   if( status > 0 )
+   {
+      output = std::fopen( outputPath.c_str( ), "r+b" );
+      if( output == NULL )
+      {
+         std::remove( journalPath.c_str( ) );
+         status = checkpoint.Open( journalPath, keyBob, size, options.blockSize );
+      }
+   }
+
+   /// -# A new migration creates Carol's output and stores the session key for a restart
+   if( status == 0 )
+   {
+      output = std::fopen( outputPath.c_str( ), "w+b" );
+      status = ( ( output == NULL ) || ( Journal::StoreKey( keyPath, keyBob ) != 0 ) ) ? -1 : 0;
+   }
+   stats.resumed = ( status > 0 ) ? status : 0;
+   stats.blocks  = checkpoint.Chunks( );
+   #ifdef _DEBUG
+   std::cout << "> Carol resumes at chunk " << checkpoint.Next( ) << " of " << stats.blocks << std::endl;
+   #endif
+
+   /// -# Bob encrypts every missing chunk, Carol decrypts it, writes it, and commits it to the journal
+   for( int chunk = 0; ( status >= 0 ) && ( chunk < stats.blocks ); chunk++ )
+   {
+      long long offset = static_cast< long long >( chunk ) * options.blockSize;
+      int       len    = static_cast< int >( std::min< long long >( options.blockSize, size - offset ) );
+
+      if( checkpoint.Completed( chunk ) )
+      {
+         continue;
+      }
+
+      /// -# Simulate a crash after the requested number of chunks, losing the uncommitted batch
+      if( ( options.interrupt > 0 ) && ( stats.changed >= options.interrupt ) )
+      {
+         std::cout << "> Migration interrupted after " << stats.changed << " chunks" << std::endl;
+         checkpoint.Abandon( );
+         status = -2;
+         break;
+      }
+
+      checkpoint.Counter( chunk, counter );
+      ( void )AES::CTR( plaintext + offset, len, keyBob, counter, ciphertext.data( ) );
+      ( void )AES::CTR( ciphertext.data( ), len, keyCarol, counter, decrypted + offset );
+
+      if( ( std::fseek( output, static_cast< long >( offset ), SEEK_SET ) != 0 ) ||
+          ( std::fwrite( decrypted + offset, 1, len, output ) != static_cast< size_t >( len ) ) )
+      {
+         status = -3;
+      }
+      else
+      {
+         status = checkpoint.Commit( chunk, output );
+      }
+      stats.changed++;
+      stats.changedLen += len;
+   }
+
+   /// -# Commit the final batch
+   if( status >= 0 )
+   {
+      status = checkpoint.Flush( output );
+   }
+   stats.migrated = static_cast< int >( stats.changedLen );
+   stats.syncs    = checkpoint.Syncs( );
+   stats.elapsed  = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - begin ).count( );
+
+   /// -# Carol reads back the complete object and discards the journal and the key store
+   if( status >= 0 )
+   {
+      checkpoint.Close( );
+      std::rewind( output );
+      status = ( std::fread( decrypted, 1, size, output ) == static_cast< size_t >( size ) ) ? size : -4;
+      std::remove( journalPath.c_str( ) );
+      ( void )Journal::EraseKey( keyPath );
+   }
+   if( output != NULL )
+   {
+      std::fclose( output );
+   }
+
+   return( status );
+}
+
+/**
+ * Authenticates the ciphertext Bob sends to Carol as messages of the block size. Bob hashes every message
+ * into the manifest and signs it once, Carol checks the signature once and the digests of the received
+ * messages against the manifest in parallel.
+ *
+ * @return The length of the ciphertext when it is authentic, otherwise a negative value.
+ */
+static int authenticate( const unsigned char* ciphertext, int length, const Simulation::Options& options,
+                         TransferStats& stats )
+{
+   int                                     status = length;
+   Manifest::Builder                       manifest;
+   std::vector< unsigned char >            signature;
+   std::chrono::time_point< HighResClock > start;
+
+   /// @par Process Design Language
+   /// -# Bob records every message and signs the manifest
+   start = HighResClock::now( );
+   {
+      Trace::Span span( "Sign Manifest", "Bob", length );
+
+      stats.messages = static_cast< int >( manifest.AddAll( ciphertext, length, options.blockSize, options.threads ) );
+      if( manifest.Sign( *options.signer, signature ) < 0 )
+      {
+         status = -5;
+      }
+   }
+   stats.elapsedSigning = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+   #ifdef _DEBUG
+   std::cout << "> Bob signed the manifest of " << stats.messages << " messages" << std::endl;
+   #endif
+
+   /// -# Carol verifies the manifest and every received message with Bob's public key
+   start = HighResClock::now( );
+   if( status >= 0 )
+   {
+      Trace::Span span( "Verify Manifest", "Carol", length );
+
+      if( Manifest::VerifyBatch( manifest, signature.data( ), static_cast< int >( signature.size( ) ), *options.signer->PublicKey( ),
+                                 ciphertext, length, options.blockSize, options.threads ) != 0 )
+      {
+         status = -6;
+      }
+   }
+   stats.elapsedVerify = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+   #ifdef _DEBUG
+   std::cout << "> Carol verified the manifest and the messages" << std::endl;
+   #endif
+
+   return( status );
+}
+
+/**
+ * Returns the name of the selected bulk cipher, with the AES mode of the migration.
+ */
+static std::string cipherName( const char* mode )
+{
+   if( AES::Selected( ) == AES::Suite::ChaCha20Poly1305 )
+   {
+      return( ( std::strcmp( mode, "CTR" ) == 0 ) ? "ChaCha20" : "ChaCha20-Poly1305" );
+   }
+
+   return( std::string( "AES-256-" ) + mode );
+}
+
+static void printTransfer( int size, const TransferStats& stats, const Simulation::Options& options )
+{
+   if( !options.journal.empty( ) )
+   {
+      std::cout << "> Resumed Chunks:        " << stats.resumed << " of " << stats.blocks << " already migrated ("
+                << options.blockSize << " Byte Chunks)" << std::endl;
+      std::cout << "> Journal Syncs:         " << stats.syncs << " (" << options.batch << " Chunks per Sync)" << std::endl;
+      std::cout << "> Key Exchange Skipped:  " << ( stats.resumedKey ? "Yes" : "No" ) << std::endl;
+   }
+   else if( !options.state.empty( ) )
+   {
+      std::cout << "> Incremental Blocks:    " << stats.changed << " of " << stats.blocks << " changed ("
+                << options.blockSize << " Byte Blocks)" << std::endl;
+      std::cout << "> Block Signatures:      " << std::setprecision( 6 ) << stats.elapsedSign << " Milliseconds" << std::endl;
+      std::cout << "> Bytes Saved:           " << ( size - stats.changedLen ) << " Bytes" << std::endl;
+   }
+   if( options.index != nullptr )
+   {
+      std::cout << "> Deduplication:         " << stats.dedup.chunks << " Chunks, " << stats.dedup.duplicates
+                << " sent as References" << std::endl;
+      std::cout << "> Deduplication Ratio:   " << std::setprecision( 4 )
+                << ( static_cast< double >( stats.dedup.logical ) / std::max( stats.dedup.unique, 1ll ) ) << ":1 ("
+                << ( stats.dedup.logical - stats.dedup.unique ) << " Bytes saved)" << std::endl;
+      std::cout << "> Chunking/Lookup:       " << std::setprecision( 6 ) << stats.elapsedDedup << " Milliseconds" << std::endl;
+      std::cout << "> Reassembly:            " << std::setprecision( 6 ) << stats.elapsedUndedup << " Milliseconds" << std::endl;
+      std::cout << "> Carol Chunk Index:     " << options.index->Count( ) << " Chunks, " << options.index->Bytes( )
+                << " Bytes" << std::endl;
+   }
+   if( options.compress && ( stats.compressed > 0 ) )
+   {
+      int input = ( options.index != nullptr ) ? stats.dedup.packed : size;
+
+      std::cout << "> Compression Ratio:     " << std::setprecision( 4 )
+                << ( static_cast< double >( input ) / stats.compressed ) << ":1 (" << input << " -> "
+                << stats.compressed << " Bytes)" << std::endl;
+      std::cout << "> Compression:           " << std::setprecision( 6 ) << stats.elapsedZip << " Milliseconds ("
+                << std::setprecision( 4 ) << ( input / ( stats.elapsedZip * 1000.0 ) ) << " MB/s)" << std::endl;
+      std::cout << "> Decompression:         " << std::setprecision( 6 ) << stats.elapsedUnzip << " Milliseconds ("
+                << std::setprecision( 4 ) << ( input / ( stats.elapsedUnzip * 1000.0 ) ) << " MB/s)" << std::endl;
+      std::cout << "> Uncompressed Baseline: " << std::setprecision( 6 ) << stats.elapsedRaw << " Milliseconds" << std::endl;
+      std::cout << "> Net Effect:            " << std::showpos << std::setprecision( 6 )
+                << ( stats.elapsed - stats.elapsedRaw ) << " Milliseconds, "
+                << ( stats.migrated - stats.migratedRaw ) << std::noshowpos << " Bytes migrated" << std::endl;
+   }
+   if( ( options.signer != nullptr ) && options.journal.empty( ) && options.state.empty( ) )
+   {
+      std::cout << "> Signed Manifest:       " << stats.messages << " Messages of " << options.blockSize
+                << " Bytes, 1 RSA-PSS Signature" << std::endl;
+      std::cout << "> Manifest Signing:      " << std::setprecision( 6 ) << stats.elapsedSigning << " Milliseconds" << std::endl;
+      std::cout << "> Batch Verification:    " << std::setprecision( 6 ) << stats.elapsedVerify << " Milliseconds" << std::endl;
+   }
+   if( options.capabilities != nullptr )
+   {
+      std::cout << "> Bulk Cipher:           " << AES::Name( AES::Selected( ) ) << " (" << options.cipher << ", AES-NI "
+                << ( options.capabilities->aesni ? "reported" : "not reported" ) << ")" << std::endl;
+      if( AES::Selected( ) == AES::Suite::AES256 )
+      {
+         std::cout << "> AES Backend:           " << AES::Name( AES::Used( ) );
+         if( AES::Used( ) == AES::Backend::Native )
+         {
+            std::cout << " (" << AESNI::Name( AESNI::Selected( ) ) << ")";
+         }
+         std::cout << std::endl;
+      }
+      std::cout << "> Probed Throughput:     " << std::fixed << std::setprecision( 1 ) << options.capabilities->aesRate
+                << " MB/s AES-256-CBC, " << options.capabilities->chachaRate << " MB/s ChaCha20-Poly1305"
+                << std::defaultfloat << std::endl;
+      std::cout << "> Migration Throughput:  " << std::fixed << std::setprecision( 1 )
+                << ( size / ( std::max( stats.elapsed, 1e-3 ) * 1000.0 ) ) << " MB/s" << std::defaultfloat << std::endl;
+   }
+   printCounters( "> Encrypt Counters:      ", stats.perfEncrypt, stats.migrated, "Byte", options );
+   printCounters( "> Decrypt Counters:      ", stats.perfDecrypt, stats.migrated, "Byte", options );
+   printMemory( "> Transfer Memory:       ", stats.memory, options );
+   std::cout << "> Bytes Migrated:        " << stats.migrated << " Bytes" << std::endl;
+}
+
+/**
+ * Prints the hardware events of a phase per unit, when counted.
+ */
+static void printCounters( const char* label, const Perf::Sample& sample, double units, const std::string& unit,
+                           const Simulation::Options& options )
+{
+   if( options.perf && ( sample.valid || ( sample.error != 0 ) ) )
+   {
+      std::cout << label << sample.Describe( std::max( units, 1.0 ), unit ) << std::endl;
+   }
+}
+
+/**
+ * Records a migration in the metrics registry: its key exchange latency, the bytes and chunks migrated, the
+ * throughput of the transfer, and a failure.
+ */
+static void recordMigration( const char* protocol, int status, double elapsedExc, long long bytes, long long chunks,
+                             double elapsedCmp )
+{
+   const std::string labels = std::string( "{protocol=\"" ) + protocol + "\"}";
+
+   Metrics::GetCounter( "securemigration_migrations_total" + labels, "Migrations started" ).Add( );
+   if( elapsedExc > 0.0 )
+   {
+      Metrics::GetHistogram( "securemigration_key_exchange_seconds" + labels, "Latency of the key exchange of a migration" )
+         .Record( static_cast< long long >( elapsedExc * 1e6 ) );
+   }
+   if( status != 0 )
+   {
+      Metrics::GetCounter( "securemigration_failures_total{component=\"migration\"}", "Failed operations by component" ).Add( );
+      return;
+   }
+   Metrics::GetCounter( "securemigration_migrated_bytes_total" + labels, "Plaintext bytes migrated" ).Add( bytes );
+   Metrics::GetCounter( "securemigration_chunks_total" + labels, "Chunks migrated" ).Add( chunks );
+   if( elapsedCmp > 0.0 )
+   {
+      Metrics::GetGauge( "securemigration_throughput_bytes_per_second" + labels, "Transfer throughput of the last migration" )
+         .Set( static_cast< double >( bytes ) / ( elapsedCmp / 1000.0 ) );
+   }
+}
+
+/**
+ * Prints the allocations and peak memory of a phase, when measured.
+ */
+static void printMemory( const char* label, const Memory::Usage& usage, const Simulation::Options& options )
+{
+   if( options.memory && usage.valid )
+   {
+      std::cout << label << usage.Describe( ) << std::endl;
+   }
+}
+
+/**
+ * Records the allocations and peak memory of a migration phase in the metrics registry, when measured.
+ */
+static void recordMemory( const char* protocol, const char* phase, const Memory::Usage& usage )
+{
+   const std::string labels = std::string( "{protocol=\"" ) + protocol + "\",phase=\"" + phase + "\"}";
+
+   if( usage.valid )
+   {
+      Metrics::GetCounter( "securemigration_allocations_total" + labels, "Blocks allocated by migration phase" ).Add( usage.allocations );
+      Metrics::GetCounter( "securemigration_allocated_bytes_total" + labels, "Bytes allocated by migration phase" ).Add( usage.bytes );
+      Metrics::GetGauge( "securemigration_live_bytes" + labels, "Bytes still allocated at the end of the phase of the last migration" )
+         .Set( static_cast< double >( usage.live ) );
+      Metrics::GetGauge( "securemigration_peak_live_bytes" + labels, "Peak bytes allocated during the phase of the last migration" )
+         .Set( static_cast< double >( usage.peakLive ) );
+      Metrics::GetGauge( "securemigration_peak_rss_bytes" + labels, "Peak resident set size during the phase of the last migration" )
+         .Set( static_cast< double >( usage.peakRss ) );
+   }
+}
+
+/**
+ * Advances the emulated clock of a party by the milliseconds it computed outside of a step.
+ */
+static void compute( Network::Emulator* wan, Network::Party party, double elapsed )
+{
+   if( wan != nullptr )
+   {
+      wan->Compute( party, elapsed );
+   }
+}
+
+/**
+ * Sends a message on the emulated link between two parties, when emulated.
+ */
+static void send( Network::Emulator* wan, Network::Party from, Network::Party to, long long length )
+{
+   if( wan != nullptr )
+   {
+      wan->Send( from, to, length );
+   }
+}
+
+/**
+ * Receives the next message on the emulated link between two parties, when emulated.
+ */
+static void receive( Network::Emulator* wan, Network::Party from, Network::Party to )
+{
+   if( wan != nullptr )
+   {
+      ( void )wan->Receive( from, to );
+   }
+}
+
+/**
+ * Returns the messages, bytes, and virtual time of the migration so far, none when not emulated.
+ */
+static Network::Usage measure( const Network::Emulator* wan )
+{
+   return( ( wan != nullptr ) ? wan->Measure( ) : Network::Usage{ } );
+}
+
+/**
+ * Prints the messages, bytes, and virtual time of the key setup and the transfer over the emulated links,
+ * and the time the migration finished.
+ */
+static void printNetwork( const Network::Usage& exchange, const Network::Usage& migration, const Simulation::Options& options )
+{
+   Network::Usage transfer = migration.Since( exchange );
+
+   if( options.network != nullptr )
+   {
+      std::cout << "> WAN Links:             " << options.network->Describe( ) << std::endl;
+      std::cout << "> WAN Key Setup:         " << std::setprecision( 6 ) << exchange.finish << " Milliseconds, "
+                << exchange.messages << " Messages, " << exchange.bytes << " Bytes" << std::endl;
+      std::cout << "> WAN Transfer:          " << std::setprecision( 6 ) << transfer.finish << " Milliseconds, "
+                << transfer.messages << " Messages, " << transfer.bytes << " Bytes" << std::endl;
+      std::cout << "> WAN Completion:        " << std::setprecision( 6 ) << migration.finish << " Milliseconds" << std::endl;
+   }
+}
+
+/**
+ * Records the messages, bytes, and virtual time of a migration phase over the emulated links in the metrics
+ * registry, when emulated.
+ */
+static void recordNetwork( const char* protocol, const char* phase, const Network::Usage& usage, const Simulation::Options& options )
+{
+   const std::string labels = std::string( "{protocol=\"" ) + protocol + "\",phase=\"" + phase + "\"}";
+
+   if( options.network != nullptr )
+   {
+      Metrics::GetCounter( "securemigration_wan_messages_total" + labels, "Messages sent over the emulated links by migration phase" )
+         .Add( usage.messages );
+      Metrics::GetCounter( "securemigration_wan_bytes_total" + labels, "Payload bytes sent over the emulated links by migration phase" )
+         .Add( usage.bytes );
+      Metrics::GetGauge( "securemigration_wan_seconds" + labels, "Emulated duration of the phase of the last migration" )
+         .Set( usage.finish / 1000.0 );
+   }
+}
+
+/**
+ * Runs one operation of the cipher backend benchmark on the selected backend: ECB encryption, CBC
+ * encryption, CBC decryption, or CTR.
+ *
+ * @return The status of the operation.
+ */
+static int runBackend( int operation, const unsigned char* input, int length, const std::array< unsigned char, 32 >& key,
+                       const std::array< unsigned char, 16 >& iv, unsigned char* output )
+{
+   switch( operation )
+   {
+      case 0:  return( AES::Cipher< AES::Mode::ECB, 256 >::Encrypt( input, length, key, { }, output ) );
+      case 1:  return( AES::Cipher< AES::Mode::CBC, 256 >::Encrypt( input, length, key, iv, output ) );
+      case 2:  return( AES::Cipher< AES::Mode::CBC, 256 >::Decrypt( input, length, key, iv, output ) );
+      default: return( AES::Cipher< AES::Mode::CTR, 256 >::Encrypt( input, length, key, iv, output ) );
+   }
+}
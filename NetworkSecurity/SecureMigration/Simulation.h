@@ -1,11 +1,121 @@
 #pragma once
 
+// StdLib Includes
+#include <string>
+
 namespace SecureMigration
 {
+   namespace AES
+   {
+      struct Capabilities;
+   }
+
+   namespace Deduplication
+   {
+      class ChunkIndex;
+   }
+
+   namespace Network
+   {
+      class Emulator;
+   }
+
+   namespace Resumption
+   {
+      class Cache;
+   }
+
+   namespace RSACryptosystem
+   {
+      class Cipher;
+   }
+
    namespace Simulation
    {
-      int RunDiffieHellman( const unsigned char* plaintext, const int size, const int keyLen );
-      int RunRSA( const unsigned char* plaintext, const int size, const int keyLen );
+      const int SplitDef        = 1024 * 1024;        ///< Default bytes per chunk task of a multi-object migration
+      const int FetchMessageLen = 64;                 ///< Bytes per message of the cipher fetch benchmark
+      const int ObjectMinLen    = 1024;               ///< Smallest object of the multi-buffer cipher benchmark
+      const int ObjectMaxLen    = 16 * 1024;          ///< Largest object of the multi-buffer cipher benchmark
+      const int BackendVolume   = 16 * 1024 * 1024;   ///< Bytes per pass of every message size of the cipher backend benchmark
+
+      struct Options
+      {
+         bool compress;    ///< Compress the plaintext at Bob before encryption
+         int  level;       ///< zlib compression level (1-9)
+         int  chunkSize;   ///< Uncompressed bytes per compression chunk
+
+         Deduplication::ChunkIndex* index;     ///< Carol's chunk index, deduplication is disabled when null
+         int                        average;   ///< Average content-defined chunk size
+
+         std::string state;       ///< Path prefix of the incremental migration state, disabled when empty
+         int         blockSize;   ///< Bytes per incremental migration block
+
+         std::string journal;     ///< Path prefix of the checkpoint journal of a resumable migration, disabled when empty
+         int         batch;       ///< Chunk commits per checkpoint journal sync
+         int         interrupt;   ///< Chunks after which a resumable migration is interrupted, never when 0
+
+         bool         objects;    ///< The path names a directory or a list of objects to migrate
+         int          split;      ///< Bytes per chunk task of a multi-object migration
+         unsigned int threads;    ///< Workers of a multi-object migration or handshake engine, one per hardware thread when 0
+
+         int sessions;   ///< Maximum concurrent sessions of the handshake benchmark, disabled when 0
+         int derives;    ///< Derives of the batch derive benchmark, disabled when 0
+
+         bool subgroup;   ///< Diffie-Hellman parameters with a 256-bit prime order subgroup and short exponents
+
+         unsigned int keygen;   ///< Threads of the prime searches of key generation, OpenSSL's search when 1, one per hardware thread when 0
+         int          primes;   ///< Generations per configuration of the key generation benchmark, disabled when 0
+
+         unsigned int rsaPrimes;   ///< Primes of the RSA keys, the most the key length allows when 0
+         int          unwraps;     ///< Private operations per key of the RSA unwrap benchmark, disabled when 0
+
+         int fetches;   ///< Messages per thread of the cipher fetch benchmark, disabled when 0
+
+         int multibuffer;   ///< Objects of the multi-buffer cipher benchmark, disabled when 0
+
+         std::string backend;    ///< Implementation of AES-256 ECB, CBC, and CTR, "evp" or "native"
+         int         backends;   ///< Largest message of the cipher backend benchmark, disabled when 0
+
+         std::string auth;               ///< Scheme signing the Diffie-Hellman public values, "ed25519" or "rsa<Bits>", unsigned when empty
+         int         signedHandshakes;   ///< Handshakes per scheme of the signed handshake benchmark, disabled when 0
+
+         std::string              cipher;         ///< Bulk cipher, "aes", "chacha20", or "auto" for the fastest probed on this host
+         const AES::Capabilities* capabilities;   ///< Probed bulk cipher throughput, not reported when null
+
+         RSACryptosystem::Cipher* signer;   ///< Bob's key signing the message manifest of a migration, unsigned when null
+
+         Resumption::Cache* cache;        ///< Master secrets of previous key exchanges, resumption is disabled when null
+         int                migrations;   ///< Back to back migrations of the file
+
+         std::string trace;   ///< Path of the Chrome trace of the protocol phases written after the runs, disabled when empty
+
+         bool perf;   ///< Count cycles, instructions, cache misses, and branch misses of the exchange and the ciphers
+
+         bool memory;   ///< Count allocations, allocated bytes, live bytes, and peak memory of every migration phase
+
+         int progress;   ///< Milliseconds between live progress reports on the console, disabled when 0
+
+         Network::Emulator* network;   ///< Emulated links between the parties on a virtual clock, local calls when null
+
+         std::string metrics;           ///< Path of the Prometheus text file of the metrics registry, disabled when empty
+         int         metricsInterval;   ///< Seconds between writes of the metrics file, only at exit when 0
+
+         Options( void );
+      };
+
+      int RunDiffieHellman( const unsigned char* plaintext, const int size, const int keyLen,
+                            const Options& options = Options( ) );
+      int RunRSA( const unsigned char* plaintext, const int size, const int keyLen,
+                  const Options& options = Options( ) );
+      int RunObjects( const std::string& path, const int keyLen, const bool rsa,
+                      const Options& options = Options( ) );
+      int RunHandshakes( const int keyLen, const bool rsa, const Options& options = Options( ) );
+      int RunDerives( const int keyLen, const Options& options = Options( ) );
+      int RunPrimes( const int keyLen, const bool rsa, const Options& options = Options( ) );
+      int RunUnwrap( const int keyLen, const Options& options = Options( ) );
+      int RunSigned( const int keyLen, const Options& options = Options( ) );
+      int RunFetch( const Options& options = Options( ) );
+      int RunMultiBuffer( const Options& options = Options( ) );
+      int RunBackends( const Options& options = Options( ) );
    }
 }
-
@@ -0,0 +1,214 @@
+/**
+ * @file
+ * @brief Scoped spans of protocol phases recorded into per-thread buffers and written as a Chrome trace.
+ */
+// Application Includes
+#include <Trace.h>
+
+// StdLib Includes
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace SecureMigration;
+
+/// Completed span
+struct Event
+{
+   const char* name;       ///< Phase of the span
+   const char* party;      ///< Party executing the phase, none when null
+   long long   start;      ///< Start in nanoseconds since the trace epoch
+   long long   duration;   ///< Duration in nanoseconds
+   long long   bytes;      ///< Bytes processed by the phase
+};
+
+/// Trace buffer written only by its own thread
+struct Buffer
+{
+   int                      tid;                        ///< Trace thread identifier, in order of the first span
+   std::atomic< long long > count;                      ///< Events published to readers
+   std::atomic< long long > dropped;                    ///< Events dropped because the buffer was full
+   std::unique_ptr< Event[ ] > blocks[ Trace::BlocksMax ];   ///< Event blocks, allocated when first written
+};
+
+std::atomic< bool > Trace::enabled( false );
+
+static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now( );   ///< Trace epoch
+
+static std::mutex                               registryMutex;   ///< Protects the registry
+static std::vector< std::unique_ptr< Buffer > > registry;        ///< Buffers of every thread which recorded a span
+
+static Buffer* local( void );
+static void    escape( std::ostream& stream, const char* text );
+
+void Trace::Enable( bool enable )
+{
+   enabled.store( enable );
+}
+
+/**
+ * Writes every recorded span in the Chrome trace event format, readable by chrome://tracing and Perfetto.
+ * Spans still being recorded concurrently may or may not be included.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+int Trace::Write( const std::string& path )
+{
+   std::lock_guard< std::mutex > lock( registryMutex );
+   std::ofstream                 file( path, std::ios::out | std::ios::trunc );
+   bool                          first = true;
+
+   if( !file )
+   {
+      return( -1 );
+   }
+
+   /// @par Process Design Language
+   /// -# Name every thread, then write its published events as complete events
+   file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+   for( const std::unique_ptr< Buffer >& buffer : registry )
+   {
+      long long count = buffer->count.load( std::memory_order_acquire );
+
+      file << ( first ? "" : "," ) << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+           << ",\"args\":{\"name\":\"" << ( ( buffer->tid == 0 ) ? "Main" : "Worker " + std::to_string( buffer->tid ) ) << "\"}}";
+      first = false;
+
+      for( long long i = 0; i < count; i++ )
+      {
+         const Event& event = buffer->blocks[ i / BlockEvents ][ i % BlockEvents ];
+
+         file << ",\n{\"name\":\"";
+         escape( file, event.name );
+         file << "\",\"cat\":\"" << ( ( event.party != nullptr ) ? "protocol" : "crypto" ) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+              << buffer->tid << std::fixed << std::setprecision( 3 ) << ",\"ts\":" << event.start / 1000.0
+              << ",\"dur\":" << event.duration / 1000.0 << std::defaultfloat << ",\"args\":{";
+         if( event.party != nullptr )
+         {
+            file << "\"party\":\"";
+            escape( file, event.party );
+            file << "\",";
+         }
+         file << "\"bytes\":" << event.bytes << "}}";
+      }
+   }
+   file << "\n]}\n";
+
+   return( file.good( ) ? 0 : -2 );
+}
+
+/**
+ * Discards the recorded spans. No thread may record spans concurrently.
+ */
+void Trace::Clear( void )
+{
+   std::lock_guard< std::mutex > lock( registryMutex );
+
+   for( std::unique_ptr< Buffer >& buffer : registry )
+   {
+      buffer->count.store( 0 );
+      buffer->dropped.store( 0 );
+   }
+}
+
+long long Trace::Events( void )
+{
+   std::lock_guard< std::mutex > lock( registryMutex );
+   long long                     events = 0;
+
+   for( const std::unique_ptr< Buffer >& buffer : registry )
+   {
+      events += buffer->count.load( std::memory_order_acquire );
+   }
+
+   return( events );
+}
+
+long long Trace::Dropped( void )
+{
+   std::lock_guard< std::mutex > lock( registryMutex );
+   long long                     dropped = 0;
+
+   for( const std::unique_ptr< Buffer >& buffer : registry )
+   {
+      dropped += buffer->dropped.load( );
+   }
+
+   return( dropped );
+}
+
+/**
+ * Returns nanoseconds since the trace epoch.
+ */
+long long Trace::Now( void )
+{
+   return( std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now( ) - epoch ).count( ) );
+}
+
+/**
+ * Records a span ending now into the calling thread's buffer without any lock: only the owning thread
+ * writes the buffer, and the event count is published after the event.
+ */
+void Trace::Record( const char* name, const char* party, long long start, long long bytes )
+{
+   long long end    = Now( );
+   Buffer*   buffer = local( );
+   long long index  = buffer->count.load( std::memory_order_relaxed );
+   long long block  = index / BlockEvents;
+
+   /// @par Process Design Language
+   /// -# Drop the event when the buffer is full
+   if( block >= BlocksMax )
+   {
+      buffer->dropped.fetch_add( 1, std::memory_order_relaxed );
+      return;
+   }
+
+   /// -# Allocate the next block before its first event, then publish the event
+   if( buffer->blocks[ block ] == nullptr )
+   {
+      buffer->blocks[ block ].reset( new Event[ BlockEvents ] );
+   }
+   buffer->blocks[ block ][ index % BlockEvents ] = Event{ name, party, start, end - start, bytes };
+   buffer->count.store( index + 1, std::memory_order_release );
+}
+
+/**
+ * Returns the trace buffer of the calling thread, registering it on the first span of the thread. The
+ * buffer outlives the thread so its spans can be written after the thread ended.
+ */
+static Buffer* local( void )
+{
+   thread_local Buffer* buffer = nullptr;
+
+   if( buffer == nullptr )
+   {
+      std::lock_guard< std::mutex > lock( registryMutex );
+
+      registry.emplace_back( new Buffer( ) );
+      buffer      = registry.back( ).get( );
+      buffer->tid = static_cast< int >( registry.size( ) ) - 1;
+      buffer->count.store( 0 );
+      buffer->dropped.store( 0 );
+   }
+
+   return( buffer );
+}
+
+/**
+ * Writes text as the content of a JSON string.
+ */
+static void escape( std::ostream& stream, const char* text )
+{
+   for( ; *text != '\0'; text++ )
+   {
+      if( ( *text == '"' ) || ( *text == '\\' ) )
+      {
+         stream << '\\';
+      }
+      stream << *text;
+   }
+}
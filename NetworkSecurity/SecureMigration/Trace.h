@@ -0,0 +1,66 @@
+#pragma once
+
+// StdLib Includes
+#include <atomic>
+#include <string>
+
+namespace SecureMigration
+{
+   namespace Trace
+   {
+      const int BlockEvents = 4096;   ///< Events per block of a thread's trace buffer
+      const int BlocksMax   = 1024;   ///< Blocks per thread, later events are dropped
+
+      extern std::atomic< bool > enabled;   ///< Spans are recorded, checked by every span before anything else
+
+      void      Enable( bool enable );
+      int       Write( const std::string& path );
+      void      Clear( void );
+      long long Events( void );
+      long long Dropped( void );
+      long long Now( void );
+      void      Record( const char* name, const char* party, long long start, long long bytes );
+
+      /**
+       * Scoped span of a protocol phase, recorded into the calling thread's trace buffer when it ends.
+       *
+       * @details
+       * Names and parties must be string literals or otherwise outlive the trace. When tracing is disabled
+       * a span costs one relaxed atomic load.
+       */
+      class Span
+      {
+      private:    // Private Attributes
+         const char* name;    ///< Phase of the span
+         const char* party;   ///< Party executing the phase, none when null
+         long long   bytes;   ///< Bytes processed by the phase
+         long long   start;   ///< Start in nanoseconds since the trace epoch, negative when not recorded
+
+      public:     // Public Methods
+         Span( const char* name, const char* party = nullptr, long long bytes = 0 )
+         {
+            this->name  = name;
+            this->party = party;
+            this->bytes = bytes;
+            this->start = enabled.load( std::memory_order_relaxed ) ? Now( ) : -1;
+         }
+
+         ~Span( void )
+         {
+            if( this->start >= 0 )
+            {
+               Record( this->name, this->party, this->start, this->bytes );
+            }
+         }
+
+         void Bytes( long long bytes )
+         {
+            this->bytes = bytes;
+         }
+
+      private:    // Private Methods
+         Span( const Span& );              // Disabled
+         Span& operator=( const Span& );   // Disabled
+      };
+   }
+}
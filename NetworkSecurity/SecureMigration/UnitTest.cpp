@@ -4,18 +4,78 @@
 #include <DiffieHellman.h>
 #include <RSACryptosystem.h>
 #include <AES.h>
+#include <AESNI.h>
+#include <Compression.h>
+#include <Deduplication.h>
+#include <Delta.h>
+#include <Journal.h>
+#include <Scheduler.h>
+#include <Handshake.h>
+#include <Resumption.h>
+#include <Primes.h>
+#include <Manifest.h>
+#include <Ed25519.h>
+#include <Trace.h>
+#include <Metrics.h>
+#include <Perf.h>
+#include <Memory.h>
+#include <Progress.h>
+#include <Network.h>
+#include <Provider.h>
 
 // OpenSSL Includes
 #include <openssl/bn.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
 
 // StdLib Includes
 #include <string>
 #include <iostream>
 #include <iomanip>
 #include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
 
 using namespace SecureMigration;
 
+/// Observer recording the progress reports of the progress test
+class Recorder : public Progress::Observer
+{
+public:     // Public Attributes
+   std::atomic< int > began;      ///< Phases begun
+   std::atomic< int > advanced;   ///< Progress reports
+   std::atomic< int > ended;      ///< Phases ended
+   Progress::Report   last;       ///< Last report of an ended phase
+
+public:     // Public Methods
+   Recorder( void ) : began( 0 ), advanced( 0 ), ended( 0 ), last( )
+   {
+   }
+
+   void Began( const Progress::Report& report ) override
+   {
+      this->began += ( report.bytes == 0 ) ? 1 : 1000;
+   }
+
+   void Advanced( const Progress::Report& report ) override
+   {
+      this->advanced += ( report.bytes <= report.total ) ? 1 : 1000;
+   }
+
+   void Ended( const Progress::Report& report ) override
+   {
+      this->ended++;
+      this->last = report;
+   }
+};
+
 UnitTest::UnitTest( int keySize )
 {
    /// -# Record Key Size
@@ -26,7 +86,8 @@ UnitTest::UnitTest( int keySize )
 
    /// -# Generate shared secret for RSA exchange
    buffer = new unsigned char[ ( keySize + 7 ) / 8 ];
-   prime = BN_generate_prime( NULL, keySize, 1, NULL, NULL, NULL, NULL );
+   prime = BN_new( );
+   BN_generate_prime_ex( prime, keySize, 1, NULL, NULL, NULL );
    BN_bn2bin( prime, buffer );
    rsaKey = new Key( buffer, ( keySize + 7 ) / 8 );
 }
@@ -35,6 +96,7 @@ UnitTest::~UnitTest( void )
 {
    delete this->dhParams;
    delete this->rsaKey;
+   delete[ ] this->buffer;
    BN_free( this->prime );
 }
 
@@ -83,6 +145,160 @@ int UnitTest::Run( void )
    elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
    std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
 
+   /// -# Test ChaCha20-Poly1305
+   std::cout << "Executing ChaCha20-Poly1305" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestChaCha( this->keySize );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Compile-Time Cipher Templates
+   std::cout << "Executing Compile-Time Cipher Templates" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestCipher( this->keySize );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Multi-Buffer Batch Encryption
+   std::cout << "Executing Multi-Buffer Batch Encryption" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestBatch( this->keySize );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Chunked Compression
+   std::cout << "Executing Chunked Compression" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestCompression( this->keySize * 1024 );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Content-Defined Chunking and Deduplication
+   std::cout << "Executing Content-Defined Chunking and Deduplication" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestDeduplication( this->keySize * 1024 );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Incremental Block Migration
+   std::cout << "Executing Incremental Block Migration" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestIncremental( this->keySize * 1024 );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Checkpoint Journal
+   std::cout << "Executing Checkpoint Journal" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestJournal( this->keySize * 1024 );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Work-Stealing Scheduler
+   std::cout << "Executing Work-Stealing Scheduler" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestScheduler( this->keySize * 1024 );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Coroutine Handshake Engine
+   std::cout << "Executing Coroutine Handshake Engine" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestHandshake( this->keySize );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Session Resumption Cache
+   std::cout << "Executing Session Resumption Cache" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestResumption( );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Diffie-Hellman Fixed-Base Precomputation
+   std::cout << "Executing Diffie-Hellman Fixed-Base Precomputation" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestGroup( this->keySize );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Parallel Prime Search
+   std::cout << "Executing Parallel Prime Search" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestPrimes( this->keySize );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Multi-Prime RSA
+   std::cout << "Executing Multi-Prime RSA" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestMultiPrime( this->keySize );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Signed Manifest
+   std::cout << "Executing Signed Manifest" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestManifest( this->keySize );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Ed25519 Signatures
+   std::cout << "Executing Ed25519 Signatures" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestEd25519( );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Protocol Tracing
+   std::cout << "Executing Protocol Tracing" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestTrace( 64 * 1024 );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Metrics Registry
+   std::cout << "Executing Metrics Registry" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestMetrics( this->keySize );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Hardware Performance Counters
+   std::cout << "Executing Hardware Performance Counters" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestPerf( 1024 * 1024 );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Memory Accounting
+   std::cout << "Executing Memory Accounting" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestMemory( );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Progress Reporting
+   std::cout << "Executing Progress Reporting" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestProgress( 4 * Progress::SliceLen + 1000 );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test WAN Emulation
+   std::cout << "Executing WAN Emulation" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestNetwork( );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
+   /// -# Test Explicit Algorithm Fetch
+   std::cout << "Executing Explicit Algorithm Fetch" << std::endl;
+   start = std::chrono::high_resolution_clock::now( );
+   status |= TestProvider( );
+   elapsed = std::chrono::duration_cast< Seconds >( HighResClock::now( ) - start ).count( );
+   std::cout << std::endl << "Elapsed: " << std::setprecision( 6 ) << elapsed << " Seconds" << std::endl << std::endl;
+
    return( status );
 }
 
@@ -244,11 +460,38 @@ int UnitTest::TestRSA3( int keySize )
 
 int UnitTest::TestECB( int size )
 {
+   typedef AES::Cipher< AES::Mode::ECB, 256 > ECB256;
+
    unsigned char  key[ ] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF,
                              0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF };
+   const unsigned char vector[ 64 ] =
+   {
+      0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96, 0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A,
+      0xAE, 0x2D, 0x8A, 0x57, 0x1E, 0x03, 0xAC, 0x9C, 0x9E, 0xB7, 0x6F, 0xAC, 0x45, 0xAF, 0x8E, 0x51,
+      0x30, 0xC8, 0x1C, 0x46, 0xA3, 0x5C, 0xE4, 0x11, 0xE5, 0xFB, 0xC1, 0x19, 0x1A, 0x0A, 0x52, 0xEF,
+      0xF6, 0x9F, 0x24, 0x45, 0xDF, 0x4F, 0x9B, 0x17, 0xAD, 0x2B, 0x41, 0x7B, 0xE6, 0x6C, 0x37, 0x10
+   };
+   const ECB256::Key nistKey =
+   {
+      0x60, 0x3D, 0xEB, 0x10, 0x15, 0xCA, 0x71, 0xBE, 0x2B, 0x73, 0xAE, 0xF0, 0x85, 0x7D, 0x77, 0x81,
+      0x1F, 0x35, 0x2C, 0x07, 0x3B, 0x61, 0x08, 0xD7, 0x2D, 0x98, 0x10, 0xA3, 0x09, 0x14, 0xDF, 0xF4
+   };
+   const unsigned char expected[ 64 ] =
+   {
+      0xF3, 0xEE, 0xD1, 0xBD, 0xB5, 0xD2, 0xA0, 0x3C, 0x06, 0x4B, 0x5A, 0x7E, 0x3D, 0xB1, 0x81, 0xF8,
+      0x59, 0x1C, 0xCB, 0x10, 0xD4, 0x10, 0xED, 0x26, 0xDC, 0x5B, 0xA7, 0x4A, 0x31, 0x36, 0x28, 0x70,
+      0xB6, 0xED, 0x21, 0xB9, 0x9C, 0xA6, 0xF4, 0xF9, 0xF1, 0x53, 0xE7, 0xB1, 0xBE, 0xAF, 0xED, 0x1D,
+      0x23, 0x30, 0x4B, 0x7A, 0x39, 0xF9, 0xF3, 0xFF, 0x06, 0x7D, 0x8D, 0x8F, 0x9E, 0x24, 0xEC, 0xC7
+   };
    unsigned char* plaintext = new unsigned char[ size * 2 ];
    unsigned char* ciphertext = new unsigned char[ size * 2 ];
    unsigned char* decrypted = new unsigned char[ size * 2 ];
+   unsigned char* reference = new unsigned char[ size * 4 ];
+   unsigned char  output[ 80 ];
+   unsigned char  recovered[ 80 ];
+   ECB256::Key    typedKey;
+   AES::Backend   backend = AES::Used( );
+   AESNI::Level   level   = AESNI::Selected( );
 
    int status = 0;
    int len;
@@ -265,22 +508,87 @@ int UnitTest::TestECB( int size )
 
    status = std::memcmp( reinterpret_cast< const void* >( plaintext ), reinterpret_cast< const void* >( decrypted ), len );
 
+   /// -# EVP and every native kernel of this CPU match the NIST SP 800-38A AES-256 example, and the native
+   ///    kernels match EVP on a whole and a padded last block
+   std::memcpy( typedKey.data( ), key, typedKey.size( ) );
+   for( int variant = 0; variant <= static_cast< int >( AESNI::Detect( ) ); variant++ )
+   {
+      AES::Use( ( variant == 0 ) ? AES::Backend::EVP : AES::Backend::Native );
+      AESNI::Select( ( variant == 0 ) ? level : static_cast< AESNI::Level >( variant ) );
+
+      status |= ( ECB256::Encrypt( vector, sizeof( vector ), nistKey, { }, output ) == sizeof( output ) ) &&
+                ( std::memcmp( output, expected, sizeof( expected ) ) == 0 ) ? 0 : -1;
+      status |= ( ECB256::Decrypt( output, sizeof( output ), nistKey, { }, recovered ) == sizeof( vector ) ) &&
+                ( std::memcmp( recovered, vector, sizeof( vector ) ) == 0 ) &&
+                ( ECB256::Decrypt( output, sizeof( output ) - 1, nistKey, { }, recovered ) < 0 ) ? 0 : -2;
+      for( int length = size - 1; length <= size; length++ )
+      {
+         unsigned char* expectedText = reference + ( length - size + 1 ) * size * 2;
+
+         if( variant == 0 )
+         {
+            ECB256::Encrypt( plaintext, length, typedKey, { }, expectedText );
+         }
+         len = ECB256::Encrypt( plaintext, length, typedKey, { }, ciphertext );
+         status |= ( len > length ) && ( std::memcmp( ciphertext, expectedText, len ) == 0 ) ? 0 : -3;
+         status |= ( ECB256::Decrypt( ciphertext, len, typedKey, { }, decrypted ) == length ) &&
+                   ( std::memcmp( plaintext, decrypted, length ) == 0 ) ? 0 : -4;
+      }
+      std::cout << "AES-256-ECB on " << ( ( variant == 0 ) ? "EVP" : AESNI::Name( static_cast< AESNI::Level >( variant ) ) )
+                << ( ( status == 0 ) ? " matches" : " does not match" ) << " NIST SP 800-38A" << std::endl;
+   }
+   AES::Use( backend );
+   AESNI::Select( level );
+
    delete[ ] plaintext;
    delete[ ] ciphertext;
    delete[ ] decrypted;
+   delete[ ] reference;
 
    return( status );
 }
 
 int UnitTest::TestCBC( int size )
 {
+   typedef AES::Cipher< AES::Mode::CBC, 256 > CBC256;
+
    unsigned char  key[ ] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF,
                              0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF };
    unsigned char  iv[ ] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
                             0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F };
+   const unsigned char vector[ 64 ] =
+   {
+      0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96, 0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A,
+      0xAE, 0x2D, 0x8A, 0x57, 0x1E, 0x03, 0xAC, 0x9C, 0x9E, 0xB7, 0x6F, 0xAC, 0x45, 0xAF, 0x8E, 0x51,
+      0x30, 0xC8, 0x1C, 0x46, 0xA3, 0x5C, 0xE4, 0x11, 0xE5, 0xFB, 0xC1, 0x19, 0x1A, 0x0A, 0x52, 0xEF,
+      0xF6, 0x9F, 0x24, 0x45, 0xDF, 0x4F, 0x9B, 0x17, 0xAD, 0x2B, 0x41, 0x7B, 0xE6, 0x6C, 0x37, 0x10
+   };
+   const CBC256::Key nistKey =
+   {
+      0x60, 0x3D, 0xEB, 0x10, 0x15, 0xCA, 0x71, 0xBE, 0x2B, 0x73, 0xAE, 0xF0, 0x85, 0x7D, 0x77, 0x81,
+      0x1F, 0x35, 0x2C, 0x07, 0x3B, 0x61, 0x08, 0xD7, 0x2D, 0x98, 0x10, 0xA3, 0x09, 0x14, 0xDF, 0xF4
+   };
+   const CBC256::IV nistIV =
+   {
+      0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+   };
+   const unsigned char expected[ 64 ] =
+   {
+      0xF5, 0x8C, 0x4C, 0x04, 0xD6, 0xE5, 0xF1, 0xBA, 0x77, 0x9E, 0xAB, 0xFB, 0x5F, 0x7B, 0xFB, 0xD6,
+      0x9C, 0xFC, 0x4E, 0x96, 0x7E, 0xDB, 0x80, 0x8D, 0x67, 0x9F, 0x77, 0x7B, 0xC6, 0x70, 0x2C, 0x7D,
+      0x39, 0xF2, 0x33, 0x69, 0xA9, 0xD9, 0xBA, 0xCF, 0xA5, 0x30, 0xE2, 0x63, 0x04, 0x23, 0x14, 0x61,
+      0xB2, 0xEB, 0x05, 0xE2, 0xC3, 0x9B, 0xE9, 0xFC, 0xDA, 0x6C, 0x19, 0x07, 0x8C, 0x6A, 0x9D, 0x1B
+   };
    unsigned char* plaintext = new unsigned char[ size * 2 ];
    unsigned char* ciphertext = new unsigned char[ size * 2 ];
    unsigned char* decrypted = new unsigned char[ size * 2 ];
+   unsigned char* reference = new unsigned char[ size * 4 ];
+   unsigned char  output[ 80 ];
+   unsigned char  recovered[ 80 ];
+   CBC256::Key    typedKey;
+   CBC256::IV     typedIV;
+   AES::Backend   backend = AES::Used( );
+   AESNI::Level   level   = AESNI::Selected( );
 
    int status = 0;
    int len;
@@ -297,9 +605,1477 @@ int UnitTest::TestCBC( int size )
 
    status = std::memcmp( reinterpret_cast< const void* >( plaintext ), reinterpret_cast< const void* >( decrypted ), len );
 
+   /// -# EVP and every native kernel of this CPU match the NIST SP 800-38A AES-256 example, and the native
+   ///    kernels match EVP on a whole and a padded last block
+   std::memcpy( typedKey.data( ), key, typedKey.size( ) );
+   std::memcpy( typedIV.data( ), iv, typedIV.size( ) );
+   for( int variant = 0; variant <= static_cast< int >( AESNI::Detect( ) ); variant++ )
+   {
+      AES::Use( ( variant == 0 ) ? AES::Backend::EVP : AES::Backend::Native );
+      AESNI::Select( ( variant == 0 ) ? level : static_cast< AESNI::Level >( variant ) );
+
+      status |= ( CBC256::Encrypt( vector, sizeof( vector ), nistKey, nistIV, output ) == sizeof( output ) ) &&
+                ( std::memcmp( output, expected, sizeof( expected ) ) == 0 ) ? 0 : -1;
+      status |= ( CBC256::Decrypt( output, sizeof( output ), nistKey, nistIV, recovered ) == sizeof( vector ) ) &&
+                ( std::memcmp( recovered, vector, sizeof( vector ) ) == 0 ) &&
+                ( CBC256::Decrypt( output, sizeof( output ) - 1, nistKey, nistIV, recovered ) < 0 ) ? 0 : -2;
+      for( int length = size - 1; length <= size; length++ )
+      {
+         unsigned char* expectedText = reference + ( length - size + 1 ) * size * 2;
+
+         if( variant == 0 )
+         {
+            CBC256::Encrypt( plaintext, length, typedKey, typedIV, expectedText );
+         }
+         len = CBC256::Encrypt( plaintext, length, typedKey, typedIV, ciphertext );
+         status |= ( len > length ) && ( std::memcmp( ciphertext, expectedText, len ) == 0 ) ? 0 : -3;
+         status |= ( CBC256::Decrypt( ciphertext, len, typedKey, typedIV, decrypted ) == length ) &&
+                   ( std::memcmp( plaintext, decrypted, length ) == 0 ) ? 0 : -4;
+      }
+      std::cout << "AES-256-CBC on " << ( ( variant == 0 ) ? "EVP" : AESNI::Name( static_cast< AESNI::Level >( variant ) ) )
+                << ( ( status == 0 ) ? " matches" : " does not match" ) << " NIST SP 800-38A" << std::endl;
+   }
+   AES::Use( backend );
+   AESNI::Select( level );
+
+   delete[ ] plaintext;
+   delete[ ] ciphertext;
+   delete[ ] decrypted;
+   delete[ ] reference;
+
+   return( status );
+}
+
+int UnitTest::TestChaCha( int size )
+{
+   const unsigned char text[ ] = "Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, sunscreen would be it.";
+   const unsigned char expected[ 16 ] = { 0x6E, 0x2E, 0x35, 0x9A, 0x25, 0x68, 0xF9, 0x80, 0x41, 0xBA, 0x07, 0x28, 0xDD, 0x0D, 0x69, 0x81 };
+   unsigned char       key[ 32 ];
+   const unsigned char counter[ 16 ]  = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 };
+   const unsigned char iv[ 16 ]       = { 0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47 };
+   unsigned char*      plaintext  = new unsigned char[ size ];
+   unsigned char*      ciphertext = new unsigned char[ size + AES::TagLen ];
+   unsigned char*      decrypted  = new unsigned char[ size + AES::TagLen ];
+   AES::Suite          previous   = AES::Selected( );
+   AES::Capabilities   capabilities;
+   int                 len;
+
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# Initialize key and plaintext
+   for( int i = 0; i < 32; i++ )
+   {
+      key[ i ] = static_cast< unsigned char >( i );
+   }
+   for( int i = 0; i < size; i++ )
+   {
+      plaintext[ i ] = static_cast< unsigned char >( i );
+   }
+   AES::Select( AES::Suite::ChaCha20Poly1305 );
+
+   /// -# The sealed message opens to the plaintext and carries the tag
+   len = AES::Encrypt( plaintext, size, key, iv, ciphertext );
+   status |= ( len == size + AES::TagLen ) ? 0 : -1;
+   status |= ( AES::Decrypt( ciphertext, len, key, iv, decrypted ) == size ) &&
+             ( std::memcmp( plaintext, decrypted, size ) == 0 ) ? 0 : -2;
+
+   /// -# A modified ciphertext or tag is rejected
+   ciphertext[ size / 2 ] ^= 0x01;
+   status |= ( AES::Decrypt( ciphertext, len, key, iv, decrypted ) < 0 ) ? 0 : -3;
+   ciphertext[ size / 2 ] ^= 0x01;
+   ciphertext[ len - 1 ] ^= 0x80;
+   status |= ( AES::Decrypt( ciphertext, len, key, iv, decrypted ) < 0 ) ? 0 : -4;
+
+   /// -# A message without a nonce is refused
+   status |= ( AES::Encrypt( plaintext, size, key, NULL, ciphertext ) < 0 ) ? 0 : -7;
+
+   /// -# The seekable stream matches the RFC 8439 ChaCha20 test vector with block counter 1
+   status |= ( AES::CTR( text, sizeof( text ) - 1, key, counter, ciphertext ) == sizeof( text ) - 1 ) &&
+             ( std::memcmp( ciphertext, expected, sizeof( expected ) ) == 0 ) ? 0 : -5;
+
+   /// -# The probe measures both suites and keeps AES-256 when the CPU has the AES instructions
+   AES::Select( AES::Probe( capabilities, 1024 * 1024 ) );
+   status |= ( capabilities.aesRate > 0.0 ) && ( capabilities.chachaRate > 0.0 ) &&
+             ( !capabilities.aesni || ( AES::Selected( ) == AES::Suite::AES256 ) ) ? 0 : -6;
+   std::cout << "Probed " << capabilities.aesRate << " MB/s AES-256-CBC, " << capabilities.chachaRate
+             << " MB/s ChaCha20-Poly1305, AES-NI " << ( capabilities.aesni ? "reported" : "not reported" ) << std::endl;
+
+   AES::Select( previous );
+   delete[ ] plaintext;
+   delete[ ] ciphertext;
+   delete[ ] decrypted;
+
+   return( status );
+}
+
+int UnitTest::TestCipher( int size )
+{
+   typedef AES::Cipher< AES::Mode::CBC, 256 >              CBC256;
+   typedef AES::Cipher< AES::Mode::CTR, 256 >              CTR256;
+   typedef AES::Cipher< AES::Mode::ChaCha20Poly1305, 256 > Sealed;
+
+   const unsigned char block[ 16 ] =
+   {
+      0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96, 0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A
+   };
+   const AES::Cipher< AES::Mode::ECB, 128 >::Key key128 =
+   {
+      0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C
+   };
+   const AES::Cipher< AES::Mode::ECB, 192 >::Key key192 =
+   {
+      0x8E, 0x73, 0xB0, 0xF7, 0xDA, 0x0E, 0x64, 0x52, 0xC8, 0x10, 0xF3, 0x2B, 0x80, 0x90, 0x79, 0xE5,
+      0x62, 0xF8, 0xEA, 0xD2, 0x52, 0x2C, 0x6B, 0x7B
+   };
+   const AES::Cipher< AES::Mode::ECB, 256 >::Key key256 =
+   {
+      0x60, 0x3D, 0xEB, 0x10, 0x15, 0xCA, 0x71, 0xBE, 0x2B, 0x73, 0xAE, 0xF0, 0x85, 0x7D, 0x77, 0x81,
+      0x1F, 0x35, 0x2C, 0x07, 0x3B, 0x61, 0x08, 0xD7, 0x2D, 0x98, 0x10, 0xA3, 0x09, 0x14, 0xDF, 0xF4
+   };
+   const CBC256::IV iv =
+   {
+      0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+   };
+   const CTR256::IV counter =
+   {
+      0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF
+   };
+   const unsigned char expected[ 3 ][ 3 ][ 16 ] =
+   {
+      {
+         { 0x3A, 0xD7, 0x7B, 0xB4, 0x0D, 0x7A, 0x36, 0x60, 0xA8, 0x9E, 0xCA, 0xF3, 0x24, 0x66, 0xEF, 0x97 },
+         { 0xBD, 0x33, 0x4F, 0x1D, 0x6E, 0x45, 0xF2, 0x5F, 0xF7, 0x12, 0xA2, 0x14, 0x57, 0x1F, 0xA5, 0xCC },
+         { 0xF3, 0xEE, 0xD1, 0xBD, 0xB5, 0xD2, 0xA0, 0x3C, 0x06, 0x4B, 0x5A, 0x7E, 0x3D, 0xB1, 0x81, 0xF8 }
+      },
+      {
+         { 0x76, 0x49, 0xAB, 0xAC, 0x81, 0x19, 0xB2, 0x46, 0xCE, 0xE9, 0x8E, 0x9B, 0x12, 0xE9, 0x19, 0x7D },
+         { 0x4F, 0x02, 0x1D, 0xB2, 0x43, 0xBC, 0x63, 0x3D, 0x71, 0x78, 0x18, 0x3A, 0x9F, 0xA0, 0x71, 0xE8 },
+         { 0xF5, 0x8C, 0x4C, 0x04, 0xD6, 0xE5, 0xF1, 0xBA, 0x77, 0x9E, 0xAB, 0xFB, 0x5F, 0x7B, 0xFB, 0xD6 }
+      },
+      {
+         { 0x87, 0x4D, 0x61, 0x91, 0xB6, 0x20, 0xE3, 0x26, 0x1B, 0xEF, 0x68, 0x64, 0x99, 0x0D, 0xB6, 0xCE },
+         { 0x1A, 0xBC, 0x93, 0x24, 0x17, 0x52, 0x1C, 0xA2, 0x4F, 0x2B, 0x04, 0x59, 0xFE, 0x7E, 0x6E, 0x0B },
+         { 0x60, 0x1E, 0xC3, 0x13, 0x77, 0x57, 0x89, 0xA5, 0xB7, 0xA7, 0xF5, 0x04, 0xBB, 0xF3, 0xD2, 0x28 }
+      }
+   };
+   const CTR256::IV carried =
+   {
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0
+   };
+   const Sealed::IV nonce = { 0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47 };
+   unsigned char    output[ 32 ];
+   unsigned char*   plaintext  = new unsigned char[ size ];
+   unsigned char*   ciphertext = new unsigned char[ size + AES::BlockLen ];
+   unsigned char*   wrapped    = new unsigned char[ size + AES::BlockLen ];
+   unsigned char*   decrypted  = new unsigned char[ size + AES::BlockLen ];
+   AES::Suite       previous   = AES::Selected( );
+   AES::Backend     backend    = AES::Used( );
+   AESNI::Level     level      = AESNI::Selected( );
+   int              len;
+
+   int status = 0;
+
+   auto matches = [ & ]( int length, int mode, int keySize )
+   {
+      return( ( length >= AES::BlockLen ) && ( std::memcmp( output, expected[ mode ][ keySize ], AES::BlockLen ) == 0 ) ? 0 : -1 );
+   };
+
+   /// @par Process Design Language
+   /// -# Every mode and key size reproduces the first block of its NIST SP 800-38A example
+   status |= matches( AES::Cipher< AES::Mode::ECB, 128 >::Encrypt( block, sizeof( block ), key128, { }, output ), 0, 0 );
+   status |= matches( AES::Cipher< AES::Mode::ECB, 192 >::Encrypt( block, sizeof( block ), key192, { }, output ), 0, 1 );
+   status |= matches( AES::Cipher< AES::Mode::ECB, 256 >::Encrypt( block, sizeof( block ), key256, { }, output ), 0, 2 );
+   status |= matches( AES::Cipher< AES::Mode::CBC, 128 >::Encrypt( block, sizeof( block ), key128, iv, output ), 1, 0 );
+   status |= matches( AES::Cipher< AES::Mode::CBC, 192 >::Encrypt( block, sizeof( block ), key192, iv, output ), 1, 1 );
+   status |= matches( AES::Cipher< AES::Mode::CBC, 256 >::Encrypt( block, sizeof( block ), key256, iv, output ), 1, 2 );
+   status |= matches( AES::Cipher< AES::Mode::CTR, 128 >::Encrypt( block, sizeof( block ), key128, counter, output ), 2, 0 );
+   status |= matches( AES::Cipher< AES::Mode::CTR, 192 >::Encrypt( block, sizeof( block ), key192, counter, output ), 2, 1 );
+   status |= matches( AES::Cipher< AES::Mode::CTR, 256 >::Encrypt( block, sizeof( block ), key256, counter, output ), 2, 2 );
+
+   /// -# The wrappers of the AES-256 suite produce exactly the output of the templates
+   for( int i = 0; i < size; i++ )
+   {
+      plaintext[ i ] = static_cast< unsigned char >( i * 7 );
+   }
+   AES::Select( AES::Suite::AES256 );
+   len = CBC256::Encrypt( plaintext, size, key256, iv, ciphertext );
+   status |= ( len == AES::Encrypt( plaintext, size, key256.data( ), iv.data( ), wrapped ) ) &&
+             ( std::memcmp( ciphertext, wrapped, len ) == 0 ) ? 0 : -2;
+   status |= ( CBC256::Decrypt( ciphertext, len, key256, iv, decrypted ) == size ) &&
+             ( std::memcmp( plaintext, decrypted, size ) == 0 ) ? 0 : -3;
+   len = CTR256::Encrypt( plaintext, size, key256, counter, ciphertext );
+   status |= ( len == size ) && ( AES::CTR( plaintext, size, key256.data( ), counter.data( ), wrapped ) == size ) &&
+             ( std::memcmp( ciphertext, wrapped, size ) == 0 ) ? 0 : -4;
+
+   /// -# Every native kernel of this CPU matches NIST and EVP in CTR, across a carry through all 128 bits
+   AES::Use( AES::Backend::EVP );
+   len = CTR256::Encrypt( plaintext, size - 3, key256, carried, ciphertext );
+   for( int variant = 1; variant <= static_cast< int >( AESNI::Detect( ) ); variant++ )
+   {
+      AES::Use( AES::Backend::Native );
+      AESNI::Select( static_cast< AESNI::Level >( variant ) );
+      status |= matches( CTR256::Encrypt( block, sizeof( block ), key256, counter, output ), 2, 2 );
+      status |= ( CTR256::Encrypt( plaintext, size - 3, key256, carried, wrapped ) == len ) &&
+                ( std::memcmp( ciphertext, wrapped, len ) == 0 ) ? 0 : -7;
+   }
+   AES::Use( backend );
+   AESNI::Select( level );
+
+   /// -# The sealed template opens to the plaintext and rejects a modified tag
+   delete[ ] ciphertext;
+   ciphertext = new unsigned char[ size + Sealed::Growth ];
+   len = Sealed::Encrypt( plaintext, size, key256, nonce, ciphertext );
+   status |= ( len == size + Sealed::TagLen ) && ( Sealed::Decrypt( ciphertext, len, key256, nonce, decrypted ) == size ) &&
+             ( std::memcmp( plaintext, decrypted, size ) == 0 ) ? 0 : -5;
+   ciphertext[ len - 1 ] ^= 0x01;
+   status |= ( Sealed::Decrypt( ciphertext, len, key256, nonce, decrypted ) < 0 ) ? 0 : -6;
+
+   std::cout << "AES-128, AES-192, and AES-256 in ECB, CBC, and CTR match NIST SP 800-38A, the wrappers match the templates"
+             << std::endl;
+
+   AES::Select( previous );
    delete[ ] plaintext;
    delete[ ] ciphertext;
+   delete[ ] wrapped;
    delete[ ] decrypted;
 
    return( status );
 }
+
+int UnitTest::TestBatch( int size )
+{
+   const int                    jobs   = 37;
+   const AES::Suite             suites[ 2 ] = { AES::Suite::AES256, AES::Suite::ChaCha20Poly1305 };
+   AES::Suite                   previous    = AES::Selected( );
+   std::vector< unsigned char > keys( jobs * 32 );
+   std::vector< unsigned char > ivs( jobs * 16 );
+   std::vector< unsigned char > plaintext( static_cast< size_t >( jobs ) * ( size + 32 ) );
+   std::vector< unsigned char > expected( plaintext.size( ) );
+   std::vector< unsigned char > batched( plaintext.size( ) );
+   std::vector< unsigned char > decrypted( plaintext.size( ) );
+   std::vector< AES::Job >      batch( jobs );
+   std::vector< int >           lengths( jobs );
+
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# Vary the lengths across and within blocks, with every fifth job in ECB and every key distinct
+   for( int job = 0; job < jobs; job++ )
+   {
+      lengths[ job ] = ( job * 997 + job / 3 ) % ( size + 1 );
+   }
+   lengths[ 0 ] = 0;
+   lengths[ 1 ] = AES::BlockLen;
+   for( size_t i = 0; i < keys.size( ); i++ )
+   {
+      keys[ i ] = static_cast< unsigned char >( i * 13 + 7 );
+   }
+   for( size_t i = 0; i < ivs.size( ); i++ )
+   {
+      ivs[ i ] = static_cast< unsigned char >( i * 29 + 3 );
+   }
+   for( size_t i = 0; i < plaintext.size( ); i++ )
+   {
+      plaintext[ i ] = static_cast< unsigned char >( i ^ ( i >> 9 ) );
+   }
+
+   for( AES::Suite suite : suites )
+   {
+      AES::Select( suite );
+
+      /// -# The batch encrypts every job exactly as one call of Encrypt per job
+      for( int job = 0; job < jobs; job++ )
+      {
+         size_t               offset = static_cast< size_t >( job ) * ( size + 32 );
+         const unsigned char* iv     = ( ( ( job % 5 ) == 4 ) && ( suite == AES::Suite::AES256 ) ) ? NULL : &ivs[ job * 16 ];
+         int                  length = AES::Encrypt( &plaintext[ offset ], lengths[ job ], &keys[ job * 32 ], iv, &expected[ offset ] );
+
+         batch[ job ] = AES::Job{ &keys[ job * 32 ], iv, &plaintext[ offset ], lengths[ job ], &batched[ offset ], -1 };
+         status |= ( length > 0 ) ? 0 : -1;
+      }
+      status |= ( AES::EncryptBatch( batch.data( ), jobs ) == 0 ) && ( batched == expected ) ? 0 : -2;
+
+      /// -# The batch decrypts every job back to its plaintext
+      for( int job = 0; job < jobs; job++ )
+      {
+         size_t offset = static_cast< size_t >( job ) * ( size + 32 );
+
+         batch[ job ].input  = &batched[ offset ];
+         batch[ job ].length = batch[ job ].status;
+         batch[ job ].output = &decrypted[ offset ];
+      }
+      status |= ( AES::DecryptBatch( batch.data( ), jobs ) == 0 ) ? 0 : -3;
+      for( int job = 0; job < jobs; job++ )
+      {
+         size_t offset = static_cast< size_t >( job ) * ( size + 32 );
+
+         status |= ( batch[ job ].status == lengths[ job ] ) &&
+                   ( std::memcmp( &decrypted[ offset ], &plaintext[ offset ], lengths[ job ] ) == 0 ) ? 0 : -4;
+      }
+
+      /// -# A job of negative length fails alone
+      batch[ 2 ]        = AES::Job{ &keys[ 0 ], &ivs[ 0 ], &plaintext[ 0 ], -1, &batched[ 0 ], 0 };
+      batch[ 3 ].input  = &plaintext[ 3 * static_cast< size_t >( size + 32 ) ];
+      batch[ 3 ].length = lengths[ 3 ];
+      batch[ 3 ].output = &batched[ 3 * static_cast< size_t >( size + 32 ) ];
+      status |= ( AES::EncryptBatch( &batch[ 2 ], 2 ) < 0 ) && ( batch[ 2 ].status < 0 ) && ( batch[ 3 ].status >= lengths[ 3 ] ) ? 0 : -5;
+   }
+
+   std::cout << jobs << " jobs of up to " << size << " bytes encrypted and decrypted in a batch as by one call per job with "
+             << ( AESNI::Available( ) ? "the AES-NI multi-buffer kernel" : "a shared cipher context" ) << std::endl;
+
+   AES::Select( previous );
+
+   return( status );
+}
+
+int UnitTest::TestCompression( int size )
+{
+   const int      chunkSize  = 64 * 1024;
+   int            capacity   = Compression::Bound( size, chunkSize );
+   unsigned char* plaintext  = new unsigned char[ size ];
+   unsigned char* compressed = new unsigned char[ capacity ];
+   unsigned char* restored   = new unsigned char[ size ];
+
+   int          status = 0;
+   int          len;
+   unsigned int seed = 0x2545F491u;
+
+   /// @par Process Design Language
+   /// -# Initialize plaintext with a compressible first half and a pseudo random second half
+   for( int i = 0; i < size; i++ )
+   {
+      seed ^= seed << 13;
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      plaintext[ i ] = ( i < ( size / 2 ) ) ? static_cast< unsigned char >( i % 7 ) : static_cast< unsigned char >( seed );
+   }
+
+   /// -# Compress and decompress the plaintext
+   len = Compression::Compress( plaintext, size, compressed, capacity, chunkSize, Compression::LevelDef );
+   std::cout << "Compressed " << size << " Bytes to " << len << " Bytes" << std::endl;
+   len = Compression::Decompress( compressed, len, restored, size, chunkSize );
+
+   /// -# Verify the restored data matches the plaintext
+   if( len != size )
+   {
+      status = -1;
+   }
+   else
+   {
+      status = std::memcmp( reinterpret_cast< const void* >( plaintext ), reinterpret_cast< const void* >( restored ), len );
+   }
+
+   /// -# A verbatim chunk claiming more bytes than it stores, or a chunk above the chunk size, is rejected
+   Utility::WriteU32( compressed, 64 );
+   Utility::WriteU32( compressed + 4, 16 | 0x80000000u );
+   status |= ( Compression::Decompress( compressed, 24, restored, size, chunkSize ) < 0 ) ? 0 : -2;
+   Utility::WriteU32( compressed + 4, 64 | 0x80000000u );
+   status |= ( Compression::Decompress( compressed, 72, restored, size, 32 ) < 0 ) ? 0 : -3;
+   status |= ( Compression::Bound( size, 0 ) < 0 ) ? 0 : -4;
+
+   delete[ ] plaintext;
+   delete[ ] compressed;
+   delete[ ] restored;
+
+   return( status );
+}
+
+int UnitTest::TestDeduplication( int size )
+{
+   Deduplication::Chunker    chunker;
+   Deduplication::ChunkIndex index;
+   Deduplication::Stats      first;
+   Deduplication::Stats      second;
+   int                       capacity  = Deduplication::PackBound( size, chunker );
+   unsigned char*            plaintext = new unsigned char[ size ];
+   unsigned char*            packed    = new unsigned char[ capacity ];
+   unsigned char*            restored  = new unsigned char[ size ];
+
+   int          status = 0;
+   int          len;
+   unsigned int seed = 0x2545F491u;
+
+   /// @par Process Design Language
+   /// -# Initialize plaintext whose second half repeats the first half shifted by a few bytes
+   for( int i = 0; i < size; i++ )
+   {
+      seed ^= seed << 13;
+      seed ^= seed >> 17;
+      seed ^= seed << 5;
+      plaintext[ i ] = ( i < ( size / 2 ) ) ? static_cast< unsigned char >( seed ) : plaintext[ i - ( size / 2 ) + 3 ];
+   }
+
+   /// -# Migrate the object to an empty index, the repeated half should be sent as references
+   len = Deduplication::Pack( plaintext, size, chunker, index, packed, capacity, first );
+   len = Deduplication::Unpack( packed, len, index, restored, size );
+   if( ( len != size ) || ( std::memcmp( plaintext, restored, size ) != 0 ) || ( first.unique >= ( size * 3 ) / 4 ) )
+   {
+      status = -1;
+   }
+
+   /// -# Migrate the object again, every chunk should be sent as a reference
+   len = Deduplication::Pack( plaintext, size, chunker, index, packed, capacity, second );
+   len = Deduplication::Unpack( packed, len, index, restored, size );
+   if( ( len != size ) || ( std::memcmp( plaintext, restored, size ) != 0 ) || ( second.unique != 0 ) )
+   {
+      status = -1;
+   }
+
+   std::cout << "Split " << size << " Bytes into " << first.chunks << " Chunks, sent " << first.unique
+             << " Bytes then " << second.unique << " Bytes" << std::endl;
+
+   delete[ ] plaintext;
+   delete[ ] packed;
+   delete[ ] restored;
+
+   return( status );
+}
+
+int UnitTest::TestIncremental( int size )
+{
+   const int          blockSize = 4096;
+   Delta::Manifest    manifest( blockSize );
+   std::vector< int > changed;
+   unsigned char      counter[ Delta::CounterLen ];
+   unsigned char*     plaintext  = new unsigned char[ size ];
+   unsigned char*     ciphertext = new unsigned char[ size ];
+   unsigned char*     block      = new unsigned char[ blockSize ];
+
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# Initialize plaintext
+   for( int i = 0; i < size; i++ )
+   {
+      plaintext[ i ] = static_cast< unsigned char >( i );
+   }
+
+   /// -# The first migration sends every block
+   if( manifest.Update( plaintext, size, changed ) != ( ( size + blockSize - 1 ) / blockSize ) )
+   {
+      status = -1;
+   }
+
+   /// -# Encrypt every block, then change one byte and verify only its block is selected with a new version
+   for( int i = 0; i < manifest.Blocks( ); i++ )
+   {
+      manifest.Counter( i, counter );
+      AES::CTR( plaintext + i * blockSize, std::min( blockSize, size - i * blockSize ), manifest.DataKey( ), counter,
+                ciphertext + i * blockSize );
+   }
+   plaintext[ blockSize * 3 + 7 ] ^= 0xFF;
+   if( ( manifest.Update( plaintext, size, changed ) != 1 ) || ( changed[ 0 ] != 3 ) || ( manifest.Version( 3 ) != 2 ) ||
+       ( manifest.Version( 2 ) != 1 ) )
+   {
+      status = -1;
+   }
+
+   /// -# Re-encrypt the changed block in place and verify every block still decrypts independently
+   manifest.Counter( 3, counter );
+   AES::CTR( plaintext + 3 * blockSize, blockSize, manifest.DataKey( ), counter, ciphertext + 3 * blockSize );
+   for( int i = 0; i < manifest.Blocks( ); i++ )
+   {
+      int len = std::min( blockSize, size - i * blockSize );
+
+      manifest.Counter( i, counter );
+      AES::CTR( ciphertext + i * blockSize, len, manifest.DataKey( ), counter, block );
+      status |= std::memcmp( block, plaintext + i * blockSize, len );
+   }
+
+   std::cout << "Re-sent " << changed.size( ) << " of " << manifest.Blocks( ) << " Blocks" << std::endl;
+
+   delete[ ] plaintext;
+   delete[ ] ciphertext;
+   delete[ ] block;
+
+   return( status );
+}
+
+int UnitTest::TestJournal( int size )
+{
+   const int           chunkSize = 4096;
+   const std::string   path      = ( std::filesystem::temp_directory_path( ) / "SecureMigration.journal" ).string( );
+   unsigned char       key[ Journal::KeyLen ];
+   unsigned char       counter[ Journal::CounterLen ];
+   unsigned char       resumed[ Journal::CounterLen ];
+   int                 chunks    = ( size + chunkSize - 1 ) / chunkSize;
+   int                 recovered;
+   std::FILE*          file;
+
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# Start a new journal and commit ten chunks in batches of four, then crash losing the last two
+   for( int i = 0; i < Journal::KeyLen; i++ )
+   {
+      key[ i ] = static_cast< unsigned char >( i * 7 );
+   }
+   std::remove( path.c_str( ) );
+   {
+      Journal::Checkpoint checkpoint( 4 );
+
+      status |= checkpoint.Open( path, key, size, chunkSize );
+      for( int chunk = 0; chunk < 10; chunk++ )
+      {
+         status |= checkpoint.Commit( chunk, NULL );
+      }
+      checkpoint.Counter( 5, counter );
+      checkpoint.Abandon( );
+   }
+
+   /// -# Append a torn record and verify the restart resumes at the first uncommitted chunk with the same nonce
+   file = std::fopen( path.c_str( ), "ab" );
+   std::fwrite( key, 1, 3, file );
+   std::fclose( file );
+   {
+      Journal::Checkpoint checkpoint( 4 );
+
+      recovered = checkpoint.Open( path, key, size, chunkSize );
+      checkpoint.Counter( 5, resumed );
+      if( ( recovered != 8 ) || ( checkpoint.Next( ) != 8 ) || ( checkpoint.Chunks( ) != chunks ) ||
+          ( std::memcmp( counter, resumed, Journal::CounterLen ) != 0 ) || !Journal::Matches( path, key ) )
+      {
+         status = -1;
+      }
+
+      /// -# Complete the migration with a single sync for the remaining chunks
+      for( int chunk = checkpoint.Next( ); chunk < chunks; chunk++ )
+      {
+         status |= checkpoint.Commit( chunk, NULL );
+      }
+      status |= checkpoint.Flush( NULL );
+      std::cout << "Resumed at chunk " << recovered << " of " << chunks << ", " << checkpoint.Syncs( ) << " Syncs" << std::endl;
+   }
+
+   /// -# A journal written for another session key is never resumed
+   key[ 0 ] ^= 0xFF;
+   {
+      Journal::Checkpoint checkpoint;
+
+      if( Journal::Matches( path, key ) || ( checkpoint.Open( path, key, size, chunkSize ) != 0 ) )
+      {
+         status = -1;
+      }
+   }
+   std::remove( path.c_str( ) );
+
+   return( status );
+}
+
+int UnitTest::TestScheduler( int size )
+{
+   const int                tasks = 64;
+   std::atomic< long long > sum( 0 );
+   std::atomic< int >       chunks( 0 );
+   Scheduler::Pool          pool( 4 );
+
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# Submit objects of very different sizes, every object splits into one chunk task per 1024 values
+   for( int task = 0; task < tasks; task++ )
+   {
+      pool.Submit( [ &, task ]( void )
+      {
+         int values = ( task % 8 == 0 ) ? size : ( task + 1 );
+
+         for( int first = 1024; first < values; first += 1024 )
+         {
+            pool.Submit( [ &, first, values ]( void )
+            {
+               for( int value = first; value < std::min( first + 1024, values ); value++ )
+               {
+                  sum += value;
+               }
+               chunks++;
+            } );
+         }
+         for( int value = 0; value < std::min( 1024, values ); value++ )
+         {
+            sum += value;
+         }
+         chunks++;
+      } );
+   }
+
+   /// -# Wait for the objects and all spawned chunk tasks and verify every value was summed exactly once
+   pool.Wait( );
+   {
+      long long expected = 0;
+
+      for( int task = 0; task < tasks; task++ )
+      {
+         long long values = ( task % 8 == 0 ) ? size : ( task + 1 );
+
+         expected += values * ( values - 1 ) / 2;
+      }
+      status = ( sum == expected ) ? 0 : -1;
+   }
+
+   std::cout << chunks << " Tasks on " << pool.Threads( ) << " Workers, " << pool.Steals( ) << " Steals" << std::endl;
+
+   return( status );
+}
+
+int UnitTest::TestHandshake( int keySize )
+{
+   Handshake::Stats  stats;
+   Handshake::Engine dh( Handshake::Protocol::DiffieHellman, keySize, dhParams, 2 );
+   Handshake::Engine rsa( Handshake::Protocol::RSA, keySize, nullptr, 2 );
+   unsigned char     junk[ 1 ] = { 0 };
+   Key               invalid( junk, 1 );
+   Handshake::Engine broken( Handshake::Protocol::DiffieHellman, keySize, &invalid, 2 );
+
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# Interleave concurrent Diffie-Hellman sessions and verify every participant derived the same secret
+   status |= dh.Run( 32, stats );
+   std::cout << "Diffie-Hellman: " << stats.sessions << " Sessions, " << std::setprecision( 6 ) << stats.perSecond
+             << " Handshakes/s, p99 " << stats.p99 << " Milliseconds" << std::endl;
+
+   /// -# Interleave concurrent RSA key distributions and verify Bob and Carol decrypted Alice's secret
+   status |= rsa.Run( 4, stats );
+   std::cout << "RSA: " << stats.sessions << " Sessions, " << std::setprecision( 6 ) << stats.perSecond
+             << " Handshakes/s, p99 " << stats.p99 << " Milliseconds" << std::endl;
+
+   /// -# Sessions of invalid parameters complete as failures instead of dereferencing a missing key
+   status |= ( broken.Run( 4, stats ) != 0 ) && ( stats.failures == 4 ) ? 0 : -2;
+
+   return( status );
+}
+
+int UnitTest::TestResumption( void )
+{
+   const unsigned char master[ 32 ] = { 0x4D, 0x61, 0x73, 0x74, 0x65, 0x72 };
+   const unsigned char nonceA[ Resumption::NonceLen ] = { 1 };
+   const unsigned char nonceB[ Resumption::NonceLen ] = { 2 };
+   unsigned char       keyA[ 48 ];
+   unsigned char       keyB[ 48 ];
+   unsigned char       keyC[ 48 ];
+   int                 migrations = 0;
+   Resumption::Cache   cache( 2 );
+   Resumption::Cache   expired( 2, std::chrono::seconds( 0 ) );
+
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# A migration between parties without a cached master secret misses
+   status |= ( cache.Derive( "A,B", nonceA, keyA, sizeof( keyA ) ) < 0 ) ? 0 : -1;
+
+   /// -# Both sides derive the same key from the same nonce, and a different key from another nonce
+   cache.Store( "A,B", master, sizeof( master ), 100.0 );
+   status |= ( cache.Derive( "A,B", nonceA, keyA, sizeof( keyA ) ) == sizeof( keyA ) ) ? 0 : -2;
+   status |= ( cache.Derive( "A,B", nonceA, keyB, sizeof( keyB ) ) == sizeof( keyB ) ) ? 0 : -3;
+   status |= ( cache.Derive( "A,B", nonceB, keyC, sizeof( keyC ) ) == sizeof( keyC ) ) ? 0 : -4;
+   status |= ( std::memcmp( keyA, keyB, sizeof( keyA ) ) == 0 ) ? 0 : -5;
+   status |= ( std::memcmp( keyA, keyC, sizeof( keyA ) ) != 0 ) ? 0 : -6;
+
+   /// -# The same master secret of other parties yields a different key
+   cache.Store( "A,C", master, sizeof( master ), 100.0 );
+   status |= ( cache.Derive( "A,C", nonceA, keyB, sizeof( keyB ) ) == sizeof( keyB ) ) ? 0 : -7;
+   status |= ( std::memcmp( keyA, keyB, sizeof( keyA ) ) != 0 ) ? 0 : -8;
+
+   /// -# The full key exchange is amortized over every migration keyed from its master secret
+   cache.Account( "A,B", 0.0 );
+   cache.Account( "A,B", 0.0 );
+   cache.Account( "A,B", 0.0 );
+   status |= ( cache.Amortized( "A,B", migrations ) == 25.0 ) && ( migrations == 4 ) ? 0 : -9;
+
+   /// -# A full cache evicts the least recently used parties
+   cache.Derive( "A,B", nonceA, keyA, sizeof( keyA ) );
+   cache.Store( "B,C", master, sizeof( master ), 100.0 );
+   status |= ( cache.Derive( "A,C", nonceA, keyA, sizeof( keyA ) ) < 0 ) ? 0 : -10;
+   status |= ( cache.Derive( "A,B", nonceA, keyA, sizeof( keyA ) ) > 0 ) ? 0 : -11;
+   status |= ( cache.Count( ) == 2 ) && ( cache.Evictions( ) == 1 ) ? 0 : -12;
+
+   /// -# An expired master secret is never used
+   expired.Store( "A,B", master, sizeof( master ), 100.0 );
+   status |= ( expired.Derive( "A,B", nonceA, keyA, sizeof( keyA ) ) < 0 ) ? 0 : -13;
+   status |= ( expired.Count( ) == 0 ) ? 0 : -14;
+
+   std::cout << cache.Hits( ) << " Hits, " << cache.Misses( ) << " Misses, " << cache.Evictions( ) << " Evictions" << std::endl;
+
+   return( status );
+}
+
+int UnitTest::TestGroup( int keySize )
+{
+   using HighResClock = std::chrono::high_resolution_clock;
+   using Milliseconds = std::chrono::duration< double, std::milli >;
+
+   const int                     sessions = 32;
+   DiffieHellman::Group          group( *dhParams );
+   DiffieHellman::Session        Alice;
+   DiffieHellman::Session        Bob;
+   BN_CTX*                       ctx      = BN_CTX_new( );
+   BIGNUM*                       g        = BN_new( );
+   BIGNUM*                       x        = BN_new( );
+   BIGNUM*                       expected = BN_new( );
+   BIGNUM*                       actual   = BN_new( );
+   double                        elapsedKey;
+   double                        elapsedGroup;
+   std::chrono::time_point< HighResClock > start;
+
+   int status = group.Valid( ) ? 0 : -1;
+
+   /// @par Process Design Language
+   /// -# The fixed-base table agrees with a plain exponentiation, also for exponents longer than the table
+   BN_set_word( g, 2 );
+   for( int i = 0; ( i < 8 ) && ( status == 0 ); i++ )
+   {
+      BN_rand( x, ( i == 7 ) ? group.Bits( ) + 8 : group.Bits( ) - i * 64, BN_RAND_TOP_ANY, BN_RAND_BOTTOM_ANY );
+      BN_mod_exp( expected, g, x, group.Prime( ), ctx );
+      status |= ( group.Power( x, actual, ctx ) == 0 ) && ( BN_cmp( expected, actual ) == 0 ) ? 0 : -2;
+   }
+
+   /// -# A session of the group agrees with a session initialized from the raw parameters
+   Alice.Initialize( *dhParams );
+   Bob.Initialize( group );
+   Alice.Derive( *Bob.PublicKey( ) );
+   Bob.Derive( *Alice.PublicKey( ) );
+   status |= ( ( Alice.Secret( ) != nullptr ) && ( Bob.Secret( ) != nullptr ) && ( *Alice.Secret( ) == *Bob.Secret( ) ) ) ? 0 : -3;
+
+   /// -# A batch derive agrees with the scalar derive and rejects an invalid public key without failing the rest
+   {
+      unsigned char                           one     = 1;
+      Key                                     invalid( &one, 1 );
+      DiffieHellman::Session                  Carol;
+      std::vector< DiffieHellman::Derivation > batch;
+
+      Carol.Initialize( group );
+      batch.push_back( DiffieHellman::Derivation{ &Bob, Alice.PublicKey( ), 0 } );
+      batch.push_back( DiffieHellman::Derivation{ &Carol, Bob.PublicKey( ), 0 } );
+      batch.push_back( DiffieHellman::Derivation{ &Carol, &invalid, 0 } );
+      status |= ( group.Derive( batch, 2 ) == -1 ) ? 0 : -4;
+      status |= ( batch[ 0 ].status == 0 ) && ( batch[ 1 ].status == 0 ) && ( batch[ 2 ].status < 0 ) ? 0 : -5;
+      status |= ( *Bob.Secret( ) == *Alice.Secret( ) ) ? 0 : -6;
+   }
+
+   /// -# Subgroup parameters use exponents as long as q, agree with the raw parameters, and reject non-members
+   {
+      unsigned char          two = 2;
+      Key                    outside( &two, 1 );
+      Key*                   subParams = nullptr;
+      DiffieHellman::Session Carol;
+      DiffieHellman::Session Dave;
+
+      status |= ( DiffieHellman::Session::SubgroupParams( keySize, &subParams ) == 0 ) ? 0 : -7;
+      if( subParams != nullptr )
+      {
+         DiffieHellman::Group subgroup( *subParams );
+
+         Carol.Initialize( *subParams );
+         Dave.Initialize( subgroup );
+         Carol.Derive( *Dave.PublicKey( ) );
+         Dave.Derive( *Carol.PublicKey( ) );
+         status |= ( subgroup.Bits( ) == ( ( keySize >= 2048 ) ? DiffieHellman::SubgroupBits : 160 ) ) ? 0 : -8;
+         status |= ( ( Carol.Secret( ) != nullptr ) && ( Dave.Secret( ) != nullptr ) && ( *Carol.Secret( ) == *Dave.Secret( ) ) ) ? 0 : -9;
+         status |= ( Dave.Derive( outside ) < 0 ) ? 0 : -10;
+         std::cout << "Subgroup of " << BN_num_bits( subgroup.Prime( ) ) << "-bit p: " << BN_num_bits( subgroup.Order( ) )
+                   << "-bit q, " << subgroup.Entries( ) << " Table Entries" << std::endl;
+      }
+      delete subParams;
+   }
+
+   /// -# Compare key generation from the raw parameters with key generation from the group
+   start = HighResClock::now( );
+   for( int i = 0; i < sessions; i++ )
+   {
+      DiffieHellman::Session session;
+
+      session.Initialize( *dhParams );
+   }
+   elapsedKey = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+
+   start = HighResClock::now( );
+   for( int i = 0; i < sessions; i++ )
+   {
+      DiffieHellman::Session session;
+
+      session.Initialize( group );
+   }
+   elapsedGroup = std::chrono::duration_cast< Milliseconds >( HighResClock::now( ) - start ).count( );
+
+   std::cout << group.Entries( ) << " Table Entries, " << sessions << " Key Pairs: " << std::setprecision( 6 )
+             << elapsedKey << " Milliseconds from (p,g), " << elapsedGroup << " Milliseconds from the group ("
+             << elapsedKey / elapsedGroup << "x)" << std::endl;
+
+   BN_free( g );
+   BN_free( x );
+   BN_free( expected );
+   BN_free( actual );
+   BN_CTX_free( ctx );
+
+   return( status );
+}
+
+int UnitTest::TestPrimes( int keySize )
+{
+   BN_CTX*                 ctx   = BN_CTX_new( );
+   BIGNUM*                 p     = BN_new( );
+   BIGNUM*                 q     = BN_new( );
+   unsigned char           plaintext[ 32 ] = { 0x50, 0x72, 0x69, 0x6D, 0x65 };
+   unsigned char           ciphertext[ 1024 ];
+   unsigned char           decrypted[ 1024 ];
+   RSACryptosystem::Cipher Alice;
+   RSACryptosystem::Cipher Bob;
+
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# A prime raced on several threads is prime and has the requested size
+   status |= ( Primes::Search( p, keySize / 2, false, NULL, NULL, 3 ) == 0 ) ? 0 : -1;
+   status |= ( BN_num_bits( p ) == keySize / 2 ) && ( BN_check_prime( p, ctx, NULL ) == 1 ) ? 0 : -2;
+
+   /// -# A safe prime for generator 2 is 23 mod 24 and (p - 1) / 2 is prime
+   status |= ( Primes::SafePrime( p, keySize / 4, 2, 3 ) == 0 ) ? 0 : -3;
+   BN_rshift1( q, p );
+   status |= ( BN_mod_word( p, 24 ) == 23 ) && ( BN_check_prime( q, ctx, NULL ) == 1 ) ? 0 : -4;
+
+   /// -# An RSA key pair from raced primes decrypts what its public key encrypted
+   status |= ( Bob.Initialize( keySize, 2 ) == 0 ) ? 0 : -5;
+   if( status == 0 )
+   {
+      int length = Alice.Encrypt( plaintext, ciphertext, sizeof( plaintext ), *Bob.PublicKey( ) );
+
+      status |= ( Bob.Decrypt( ciphertext, decrypted, length ) == sizeof( plaintext ) ) &&
+                ( std::memcmp( plaintext, decrypted, sizeof( plaintext ) ) == 0 ) ? 0 : -6;
+   }
+
+   std::cout << "Safe prime of " << BN_num_bits( p ) << " Bits, RSA key pair of " << keySize << " Bits" << std::endl;
+
+   BN_free( p );
+   BN_free( q );
+   BN_CTX_free( ctx );
+
+   return( status );
+}
+
+int UnitTest::TestMultiPrime( int keySize )
+{
+   const unsigned int      primes = RSACryptosystem::Cipher::MaxPrimes( keySize );
+   unsigned char           plaintext[ 32 ] = { 0x4D, 0x75, 0x6C, 0x74, 0x69 };
+   unsigned char           digest[ RSACryptosystem::SignatureDigestLen ] = { 0x44, 0x69, 0x67, 0x65, 0x73, 0x74 };
+   unsigned char           ciphertext[ 1024 ];
+   unsigned char           decrypted[ 1024 ];
+   RSACryptosystem::Cipher Alice;
+   RSACryptosystem::Cipher Bob;
+   RSACryptosystem::Cipher Carol;
+   BIO*                    bio    = NULL;
+   EVP_PKEY*               rsa    = NULL;
+   EVP_PKEY_CTX*           verify = NULL;
+
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# A multi-prime key pair has the requested number of primes, and more than the key length allows are refused
+   status |= ( Bob.Initialize( keySize, 1, primes ) == 0 ) && ( Bob.PrimeCount( ) == static_cast< int >( primes ) ) ? 0 : -1;
+   status |= ( Carol.Initialize( keySize, 1, primes + 1 ) != 0 ) ? 0 : -2;
+
+   /// -# The CRT private key decrypts what the public key encrypted, also through a copy of the cipher
+   if( status == 0 )
+   {
+      RSACryptosystem::Cipher copy( Bob );
+      int                     length = Alice.Encrypt( plaintext, ciphertext, sizeof( plaintext ), *Bob.PublicKey( ) );
+
+      status |= ( copy.Decrypt( ciphertext, decrypted, length ) == sizeof( plaintext ) ) &&
+                ( std::memcmp( plaintext, decrypted, sizeof( plaintext ) ) == 0 ) ? 0 : -3;
+
+      /// -# The PSS signature of a digest verifies with the public key
+      length = Bob.SignDigest( digest, ciphertext );
+      if( ( ( bio = BIO_new_mem_buf( Bob.PublicKey( )->Buffer( ), static_cast< int >( Bob.PublicKey( )->Length( ) ) ) ) == NULL ) ||
+          ( ( rsa = PEM_read_bio_PUBKEY( bio, NULL, NULL, NULL ) ) == NULL ) ||
+          ( ( verify = EVP_PKEY_CTX_new( rsa, NULL ) ) == NULL ) || ( EVP_PKEY_verify_init( verify ) <= 0 ) ||
+          ( EVP_PKEY_CTX_set_rsa_padding( verify, RSA_PKCS1_PSS_PADDING ) <= 0 ) ||
+          ( EVP_PKEY_CTX_set_signature_md( verify, EVP_sha256( ) ) <= 0 ) ||
+          ( EVP_PKEY_CTX_set_rsa_pss_saltlen( verify, RSACryptosystem::SignatureDigestLen ) <= 0 ) ||
+          ( EVP_PKEY_verify( verify, ciphertext, length, digest, RSACryptosystem::SignatureDigestLen ) != 1 ) )
+      {
+         status |= -4;
+      }
+
+      /// -# A different digest does not verify
+      digest[ 0 ] ^= 1;
+      if( ( verify != NULL ) &&
+          ( EVP_PKEY_verify( verify, ciphertext, length, digest, RSACryptosystem::SignatureDigestLen ) == 1 ) )
+      {
+         status |= -5;
+      }
+   }
+
+   std::cout << "RSA key pair of " << keySize << " Bits with " << Bob.PrimeCount( ) << " primes" << std::endl;
+
+   EVP_PKEY_CTX_free( verify );
+   EVP_PKEY_free( rsa );
+   BIO_free( bio );
+
+   return( status );
+}
+
+int UnitTest::TestManifest( int keySize )
+{
+   const size_t                 messageLen = 1000;
+   std::vector< unsigned char > data( 10 * messageLen + 123 );
+   std::vector< unsigned char > signature;
+   std::vector< unsigned char > single( static_cast< size_t >( ( keySize + 7 ) / 8 ) );
+   RSACryptosystem::Cipher      Bob;
+   RSACryptosystem::Cipher      Mallory;
+   Manifest::Builder            manifest;
+   Manifest::Builder            serial;
+   int                          length;
+
+   int status = 0;
+
+   for( size_t i = 0; i < data.size( ); i++ )
+   {
+      data[ i ] = static_cast< unsigned char >( ( i * 131 ) ^ ( i >> 8 ) );
+   }
+
+   /// @par Process Design Language
+   /// -# A single message signature verifies only for its message and signer
+   status |= ( Bob.Initialize( keySize ) == 0 ) && ( Mallory.Initialize( keySize ) == 0 ) ? 0 : -1;
+   if( status == 0 )
+   {
+      length = Bob.Sign( data.data( ), 100, single.data( ) );
+      status |= ( RSACryptosystem::Cipher::Verify( data.data( ), 100, single.data( ), length, *Bob.PublicKey( ) ) == 0 ) ? 0 : -2;
+      status |= ( RSACryptosystem::Cipher::Verify( data.data( ), 101, single.data( ), length, *Bob.PublicKey( ) ) != 0 ) ? 0 : -3;
+      status |= ( RSACryptosystem::Cipher::Verify( data.data( ), 100, single.data( ), length, *Mallory.PublicKey( ) ) != 0 ) ? 0 : -4;
+   }
+
+   /// -# Parallel hashing records the same manifest as adding the messages one by one
+   status |= ( manifest.AddAll( data.data( ), data.size( ), messageLen, 3 ) == 11 ) ? 0 : -5;
+   for( size_t offset = 0; offset < data.size( ); offset += messageLen )
+   {
+      serial.Add( data.data( ) + offset, std::min( messageLen, data.size( ) - offset ) );
+   }
+   status |= ( serial.Count( ) == manifest.Count( ) ) &&
+             ( std::memcmp( serial.Entry( 0 ), manifest.Entry( 0 ), serial.Count( ) * Manifest::DigestLen ) == 0 ) ? 0 : -6;
+
+   /// -# The signed manifest verifies every message in one batch
+   if( status == 0 )
+   {
+      length = manifest.Sign( Bob, signature );
+      status |= ( length == Bob.Size( ) ) ? 0 : -7;
+      status |= ( Manifest::VerifyBatch( manifest, signature.data( ), length, *Bob.PublicKey( ),
+                                         data.data( ), data.size( ), messageLen, 3 ) == 0 ) ? 0 : -8;
+
+      /// -# A forged signer, an altered message, and a dropped message are all detected
+      status |= ( Manifest::VerifyBatch( manifest, signature.data( ), length, *Mallory.PublicKey( ),
+                                         data.data( ), data.size( ), messageLen, 3 ) == -1 ) ? 0 : -9;
+      data[ 5 * messageLen + 7 ] ^= 0x01;
+      status |= ( manifest.Check( data.data( ), data.size( ), messageLen, 3 ) == 5 ) ? 0 : -10;
+      status |= ( Manifest::VerifyBatch( manifest, signature.data( ), length, *Bob.PublicKey( ),
+                                         data.data( ), data.size( ), messageLen, 3 ) == -2 ) ? 0 : -11;
+      data[ 5 * messageLen + 7 ] ^= 0x01;
+      status |= ( manifest.Check( data.data( ), 10 * messageLen, messageLen, 3 ) == 10 ) ? 0 : -12;
+   }
+
+   std::cout << "Manifest of " << manifest.Count( ) << " messages signed with " << keySize << " Bit RSA-PSS" << std::endl;
+
+   return( status );
+}
+
+int UnitTest::TestEd25519( void )
+{
+   const int                    count = 16;
+   std::vector< unsigned char > messages( count * 40 );
+   std::vector< unsigned char > signatures( count * Ed25519::SignatureLen );
+   std::vector< Ed25519::Item > batch;
+   Ed25519::Signer              Alice;
+   Ed25519::Signer              Mallory;
+
+   int status = 0;
+
+   for( size_t i = 0; i < messages.size( ); i++ )
+   {
+      messages[ i ] = static_cast< unsigned char >( i * 7 + 3 );
+   }
+
+   /// @par Process Design Language
+   /// -# A signature verifies only for its message and its signer
+   status |= ( Alice.Initialize( ) == 0 ) && ( Mallory.Initialize( ) == 0 ) ? 0 : -1;
+   status |= ( Alice.Sign( messages.data( ), 40, signatures.data( ) ) == Ed25519::SignatureLen ) ? 0 : -2;
+   status |= ( Ed25519::Verify( messages.data( ), 40, signatures.data( ), Alice.PublicKey( ) ) == 0 ) ? 0 : -3;
+   status |= ( Ed25519::Verify( messages.data( ), 39, signatures.data( ), Alice.PublicKey( ) ) != 0 ) ? 0 : -4;
+   status |= ( Ed25519::Verify( messages.data( ), 40, signatures.data( ), Mallory.PublicKey( ) ) != 0 ) ? 0 : -5;
+
+   /// -# A batch of valid signatures verifies
+   for( int i = 0; i < count; i++ )
+   {
+      status |= ( Alice.Sign( &messages[ i * 40 ], 40, &signatures[ i * Ed25519::SignatureLen ] ) == Ed25519::SignatureLen ) ? 0 : -6;
+      batch.push_back( Ed25519::Item{ &messages[ i * 40 ], 40, &signatures[ i * Ed25519::SignatureLen ], Alice.PublicKey( ), -1 } );
+   }
+   status |= ( Ed25519::VerifyBatch( batch, 3 ) == 0 ) ? 0 : -7;
+
+   /// -# A single forged signature fails the batch and is identified
+   signatures[ 5 * Ed25519::SignatureLen + 9 ] ^= 0x20;
+   status |= ( Ed25519::VerifyBatch( batch, 3 ) != 0 ) ? 0 : -8;
+   for( int i = 0; i < count; i++ )
+   {
+      status |= ( ( batch[ i ].status != 0 ) == ( i == 5 ) ) ? 0 : -9;
+   }
+
+   std::cout << "Batch of " << count << " Ed25519 signatures, forged signature " << ( ( batch[ 5 ].status != 0 ) ? "detected" : "missed" )
+             << std::endl;
+
+   return( status );
+}
+
+int UnitTest::TestTrace( int size )
+{
+   const std::string            path = ( std::filesystem::temp_directory_path( ) / "SecureMigration.trace.json" ).string( );
+   const int                    tasks = 8;
+   std::vector< unsigned char > key( 32, 0x5A );
+   std::vector< unsigned char > plaintext( static_cast< size_t >( size ), 0x3C );
+   std::vector< unsigned char > ciphertext( static_cast< size_t >( tasks ) * ( static_cast< size_t >( size ) + 32 ) );
+   std::string                  json;
+   char*                        buffer = nullptr;
+   int                          length;
+
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# Spans record nothing while tracing is disabled
+   Trace::Clear( );
+   {
+      Trace::Span span( "Disabled", "Alice" );
+   }
+   status |= ( Trace::Events( ) == 0 ) ? 0 : -1;
+
+   /// -# Nested spans on this thread and spans on every worker are recorded once enabled
+   Trace::Enable( true );
+   {
+      Trace::Span span( "Encrypt", "Bob", size );
+
+      Utility::ParallelFor( tasks, [ & ]( int task )
+      {
+         ( void )AES::Encrypt( plaintext.data( ), size, key.data( ), key.data( ),
+                               &ciphertext[ static_cast< size_t >( task ) * ( static_cast< size_t >( size ) + 32 ) ] );
+      }, 3 );
+   }
+   Trace::Enable( false );
+   status |= ( Trace::Events( ) == tasks + 1 ) ? 0 : -2;
+   status |= ( Trace::Dropped( ) == 0 ) ? 0 : -3;
+
+   /// -# The written trace holds a named thread and a complete event per span
+   status |= ( Trace::Write( path ) == 0 ) ? 0 : -4;
+   if( ( length = Utility::ReadFile( path.c_str( ), &buffer ) ) > 0 )
+   {
+      json.assign( buffer, static_cast< size_t >( length ) );
+   }
+   status |= ( json.rfind( "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0 ) == 0 ) ? 0 : -5;
+   status |= ( json.find( "\"ph\":\"M\"" ) != std::string::npos ) ? 0 : -6;
+   status |= ( json.find( "\"name\":\"Encrypt\",\"cat\":\"protocol\",\"ph\":\"X\"" ) != std::string::npos ) ? 0 : -7;
+   status |= ( json.find( "\"party\":\"Bob\",\"bytes\":" + std::to_string( size ) ) != std::string::npos ) ? 0 : -8;
+   status |= ( json.find( "Disabled" ) == std::string::npos ) ? 0 : -9;
+
+   std::cout << "Traced " << Trace::Events( ) << " spans into " << json.size( ) << " bytes of Chrome trace" << std::endl;
+
+   Trace::Clear( );
+   delete[ ] buffer;
+   std::remove( path.c_str( ) );
+
+   return( status );
+}
+
+int UnitTest::TestMetrics( int keySize )
+{
+   const std::string       path      = ( std::filesystem::temp_directory_path( ) / "SecureMigration.prom" ).string( );
+   Metrics::Histogram&     latency   = Metrics::GetHistogram( "securemigration_test_latency_seconds{case=\"uniform\"}", "Test latency" );
+   Metrics::Counter&       counter   = Metrics::GetCounter( "securemigration_test_total", "Test counter" );
+   Metrics::Gauge&         gauge     = Metrics::GetGauge( "securemigration_test_level", "Test gauge" );
+   Metrics::Histogram&     derive    = Metrics::GetHistogram( "securemigration_dh_latency_seconds{operation=\"derive\"}", "" );
+   Metrics::Exporter       exporter;
+   DiffieHellman::Session  Alice;
+   DiffieHellman::Session  Bob;
+   Key*                    dhParams  = nullptr;
+   long long               derives   = derive.Count( );
+   std::string             text;
+   char*                   buffer    = nullptr;
+   int                     length;
+
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# Every value lies in a bucket whose highest value is within 1/SubBuckets above it
+   for( long long value = 0; value < ( 1LL << 40 ); value = value * 3 / 2 + 1 )
+   {
+      long long highest = Metrics::Histogram::Highest( Metrics::Histogram::Bucket( value ) );
+
+      status |= ( ( highest >= value ) && ( highest - value <= value / Metrics::SubBuckets ) ) ? 0 : -1;
+      status |= ( Metrics::Histogram::Bucket( value + 1 ) >= Metrics::Histogram::Bucket( value ) ) ? 0 : -2;
+   }
+
+   /// -# Quantiles of a uniform distribution of 1 to 100 ms are within the bucket error
+   for( long long value = 1; value <= 100000; value++ )
+   {
+      latency.Record( value * 1000 );
+   }
+   status |= ( std::abs( latency.Quantile( 0.5 ) - 50000000 ) <= 50000000 / Metrics::SubBuckets ) ? 0 : -3;
+   status |= ( std::abs( latency.Quantile( 0.99 ) - 99000000 ) <= 99000000 / Metrics::SubBuckets ) ? 0 : -4;
+   status |= ( latency.Quantile( 1.0 ) == 100000000 ) && ( latency.Count( ) == 100000 ) ? 0 : -5;
+
+   /// -# Counters and gauges accumulate
+   counter.Add( 3 );
+   counter.Add( );
+   gauge.Set( 2.5 );
+   gauge.Add( -1.0 );
+   status |= ( ( counter.Value( ) == 4 ) && ( gauge.Value( ) == 1.5 ) ) ? 0 : -6;
+
+   /// -# A Diffie-Hellman exchange feeds the derive latency
+   status |= ( DiffieHellman::Session::GenerateParams( keySize, &dhParams ) == 0 ) ? 0 : -7;
+   if( dhParams != nullptr )
+   {
+      status |= ( ( Alice.Initialize( *dhParams ) == 0 ) && ( Bob.Initialize( *dhParams ) == 0 ) ) ? 0 : -8;
+      status |= ( ( Alice.Derive( *Bob.PublicKey( ) ) == 0 ) && ( Bob.Derive( *Alice.PublicKey( ) ) == 0 ) ) ? 0 : -9;
+   }
+   status |= ( derive.Count( ) == derives + 2 ) ? 0 : -10;
+
+   /// -# The exporter writes every family once in the Prometheus text format
+   status |= ( ( exporter.Start( path, 0 ) == 0 ) && ( exporter.Stop( ) == 0 ) ) ? 0 : -11;
+   if( ( length = Utility::ReadFile( path.c_str( ), &buffer ) ) > 0 )
+   {
+      text.assign( buffer, static_cast< size_t >( length ) );
+   }
+   status |= ( text.find( "# TYPE securemigration_test_total counter\nsecuremigration_test_total 4\n" ) != std::string::npos ) ? 0 : -12;
+   status |= ( text.find( "# TYPE securemigration_test_level gauge\nsecuremigration_test_level 1.5\n" ) != std::string::npos ) ? 0 : -13;
+   status |= ( text.find( "securemigration_test_latency_seconds{case=\"uniform\",quantile=\"0.5\"} 0.05" ) != std::string::npos ) ? 0 : -14;
+   status |= ( text.find( "securemigration_test_latency_seconds_count{case=\"uniform\"} 100000\n" ) != std::string::npos ) ? 0 : -15;
+   status |= ( text.find( "# TYPE securemigration_dh_latency_seconds summary" ) == text.rfind( "# TYPE securemigration_dh_latency_seconds" ) ) ? 0 : -16;
+
+   std::cout << "p50 " << latency.Quantile( 0.5 ) / 1e6 << " ms, p99 " << latency.Quantile( 0.99 ) / 1e6 << " ms of 1-100 ms, "
+             << text.size( ) << " bytes of Prometheus text" << std::endl;
+
+   delete dhParams;
+   delete[ ] buffer;
+   std::remove( path.c_str( ) );
+
+   return( status );
+}
+
+int UnitTest::TestPerf( int size )
+{
+   std::vector< unsigned char > key( 32, 0x11 );
+   std::vector< unsigned char > plaintext( static_cast< size_t >( size ), 0x22 );
+   std::vector< unsigned char > ciphertext( static_cast< size_t >( size ) + 32 );
+   Perf::Counters               counters;
+   Perf::Sample                 idle;
+   Perf::Sample                 sample;
+   bool                         opened;
+
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# Counters which were never opened return an invalid sample with a reason
+   counters.Start( );
+   idle = counters.Stop( );
+   status |= ( !idle.valid && ( idle.error != 0 ) ) ? 0 : -1;
+
+   /// -# Opened counters count the encryption, unavailable counters report why and count nothing
+   opened = ( counters.Initialize( ) == 0 );
+   counters.Start( );
+   status |= ( AES::Encrypt( plaintext.data( ), size, key.data( ), key.data( ), ciphertext.data( ) ) > 0 ) ? 0 : -2;
+   sample = counters.Stop( );
+   if( opened )
+   {
+      status |= ( sample.valid && ( sample.values[ Perf::Cycles ] > size ) && ( sample.values[ Perf::Instructions ] > 0 ) ) ? 0 : -3;
+   }
+   else
+   {
+      status |= ( !sample.valid && ( sample.error != 0 ) && ( sample.values[ Perf::Cycles ] == 0 ) ) ? 0 : -4;
+   }
+
+   /// -# Samples of several phases add up, and stay invalid when one is
+   idle.Add( sample );
+   status |= ( !idle.valid ) ? 0 : -5;
+   sample.Add( sample );
+
+   std::cout << "Encryption of " << size << " Bytes: " << sample.Describe( 2.0 * size, "Byte" ) << std::endl;
+
+   return( status );
+}
+
+int UnitTest::TestMemory( void )
+{
+   Memory::Phase       phase;
+   Memory::Usage       usage;
+   Memory::Usage       total;
+   void*               block;
+   void*               cryptoBlock;
+   CRYPTO_malloc_fn    cryptoMalloc = nullptr;
+   const unsigned char bytes[ 64 ]  = { };
+
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# A phase measured without accounting is invalid, blocks come from operator new directly since an unused
+   ///    new-expression may be elided
+   Memory::Enable( false );
+   phase.Start( );
+   block = ::operator new( 1024 );
+   usage = phase.Stop( );
+   ::operator delete( block );
+   status |= ( !usage.valid ) ? 0 : -1;
+
+   /// -# A block still allocated at the end of a phase is live, freeing it leaves nothing live
+   Memory::Enable( true );
+   phase.Start( );
+   block = ::operator new( 1000 );
+   usage = phase.Stop( );
+   status |= ( usage.valid && ( usage.allocations >= 1 ) && ( usage.bytes >= 1000 ) && ( usage.live >= 1000 ) &&
+               ( usage.peakLive >= 1000 ) ) ? 0 : -2;
+   total = usage;
+
+   phase.Start( );
+   ::operator delete( block );
+   usage = phase.Stop( );
+   status |= ( usage.valid && ( usage.allocations == 0 ) && ( usage.live == -1000 ) && ( usage.peakLive == 0 ) ) ? 0 : -3;
+
+   /// -# Phases add up to the net live bytes and the highest peak of the sequence
+   total.Add( usage );
+   status |= ( ( total.live == 0 ) && ( total.peakLive >= 1000 ) ) ? 0 : -4;
+
+   /// -# The peak covers a block freed before the end of the phase
+   phase.Start( );
+   block = ::operator new( 64 * 1024 );
+   ::operator delete( block );
+   usage = phase.Stop( );
+   status |= ( ( usage.live == 0 ) && ( usage.peakLive >= 64 * 1024 ) ) ? 0 : -5;
+
+   /// -# Keys and the Diffie-Hellman sessions built from parameters free everything they allocate
+   phase.Start( );
+   {
+      Key                    key( const_cast< unsigned char* >( bytes ), sizeof( bytes ) );
+      Key                    copy( key );
+      DiffieHellman::Session Alice;
+
+      copy = key;
+      status |= ( Alice.Initialize( *this->dhParams ) == 0 ) ? 0 : -6;
+      status |= ( Alice.Initialize( *this->dhParams ) == 0 ) ? 0 : -7;
+   }
+   usage = phase.Stop( );
+   std::cout << "Keys and Session: " << usage.Describe( ) << std::endl;
+   status |= ( usage.live == 0 ) ? 0 : -8;
+
+   /// -# OpenSSL's allocations are accounted when the allocator was installed before OpenSSL's first allocation
+   CRYPTO_get_mem_functions( &cryptoMalloc, nullptr, nullptr );
+   phase.Start( );
+   cryptoBlock = OPENSSL_malloc( 4096 );
+   usage = phase.Stop( );
+   OPENSSL_free( cryptoBlock );
+   if( cryptoMalloc != CRYPTO_malloc )
+   {
+      status |= ( ( usage.allocations == 1 ) && ( usage.live == 4096 ) ) ? 0 : -9;
+   }
+   std::cout << "OpenSSL Allocator: " << ( ( cryptoMalloc != CRYPTO_malloc ) ? "Accounted" : "Not accounted" ) << std::endl;
+
+   /// -# The resident set size is sampled from /proc on Linux
+   #if defined( __linux__ )
+   status |= ( ( Memory::Rss( ) > 0 ) && ( Memory::PeakRss( ) >= Memory::Rss( ) ) ) ? 0 : -10;
+   #endif
+   Memory::Enable( false );
+
+   return( status );
+}
+
+int UnitTest::TestProgress( int size )
+{
+   std::vector< unsigned char > key( 32, 0x33 );
+   std::vector< unsigned char > plaintext( static_cast< size_t >( size ), 0x44 );
+   std::vector< unsigned char > ciphertext( static_cast< size_t >( size ) + 32 );
+   std::vector< unsigned char > decrypted( static_cast< size_t >( size ) + 32 );
+   Recorder                     recorder;
+   int                          slices = ( size + Progress::SliceLen - 1 ) / Progress::SliceLen;
+   int                          length;
+
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# Without an observer nothing is reported
+   Progress::Begin( Progress::Phase::Encrypt, size );
+   Progress::Advance( size );
+   Progress::End( );
+   status |= ( ( recorder.began == 0 ) && ( recorder.ended == 0 ) ) ? 0 : -1;
+
+   /// -# Every slice of a sliced encryption is reported without an interval, and the output matches one update
+   Progress::Attach( &recorder, 0 );
+   Progress::Begin( Progress::Phase::Encrypt, size );
+   length = AES::Encrypt( plaintext.data( ), size, key.data( ), key.data( ), ciphertext.data( ) );
+   Progress::Begin( Progress::Phase::Decrypt, length );
+   status |= ( ( recorder.advanced == slices ) && ( recorder.ended == 1 ) && ( recorder.last.bytes == size ) &&
+               ( recorder.last.phase == Progress::Phase::Encrypt ) && ( recorder.last.rate > 0.0 ) ) ? 0 : -2;
+   status |= ( AES::Decrypt( ciphertext.data( ), length, key.data( ), key.data( ), decrypted.data( ) ) == size ) ? 0 : -3;
+   status |= ( std::memcmp( plaintext.data( ), decrypted.data( ), size ) == 0 ) ? 0 : -4;
+   Progress::End( );
+   status |= ( ( recorder.began == 2 ) && ( recorder.ended == 2 ) && ( recorder.last.bytes == length ) ) ? 0 : -5;
+
+   /// -# Bytes advanced outside of a phase are not counted, bytes of concurrent workers add up
+   Progress::Advance( size );
+   status |= ( recorder.ended == 2 ) ? 0 : -6;
+   Progress::Attach( &recorder, 60 * 1000 );
+   Progress::Begin( Progress::Phase::Transfer );
+   Utility::ParallelFor( 64, [ & ]( int chunk )
+   {
+      ( void )chunk;
+      Progress::Advance( 1000 );
+   } );
+   Progress::End( );
+   status |= ( ( recorder.last.bytes == 64 * 1000 ) && ( recorder.last.total == 0 ) ) ? 0 : -7;
+
+   /// -# Phase transitions are reported, a long interval reports no progress in between
+   status |= ( ( recorder.began == 3 ) && ( recorder.advanced == 2 * slices ) ) ? 0 : -8;
+   Progress::Attach( nullptr );
+
+   std::cout << "Encryption of " << size << " Bytes: " << slices << " Progress Reports, " << std::setprecision( 6 )
+             << recorder.last.rate << " MB/s Workers" << std::endl;
+
+   return( status );
+}
+
+int UnitTest::TestNetwork( void )
+{
+   Network::Emulator wan;
+   Network::Link     link;
+   Network::Usage    usage;
+   double            arrival;
+   double            previous = 0.0;
+   bool              inOrder  = true;
+   bool              inRange  = true;
+
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# Links parse as <RTT>,<Mbit/s>[,<Jitter>]
+   status |= ( ( Network::Parse( "80,1000,5", link ) == 0 ) && ( link.rtt == 80.0 ) && ( link.bandwidth == 1000.0 ) &&
+               ( link.jitter == 5.0 ) ) ? 0 : -1;
+   status |= ( ( Network::Parse( "2.5,0", link ) == 0 ) && ( link.rtt == 2.5 ) && ( link.jitter == 0.0 ) ) ? 0 : -1;
+   status |= ( ( Network::Parse( "80", link ) < 0 ) && ( Network::Parse( "80,x", link ) < 0 ) &&
+               ( Network::Parse( "-1,1000", link ) < 0 ) && ( Network::Parse( "80,1000,5,1", link ) < 0 ) ) ? 0 : -1;
+   status |= ( ( Network::ParseParty( "Carol" ) == Network::Carol ) && ( Network::ParseParty( "Eve" ) < 0 ) ) ? 0 : -1;
+
+   /// -# A message is serialized at the bandwidth and arrives half a round trip later, 8 Mbit/s send 1000 Bytes per millisecond
+   wan.Configure( Network::Link{ 80.0, 8.0, 0.0 } );
+   wan.Send( Network::Alice, Network::Bob, 1000 );
+   wan.Send( Network::Alice, Network::Bob, 1000 );
+   status |= ( ( wan.Receive( Network::Alice, Network::Bob ) == 0 ) && ( std::abs( wan.Clock( Network::Bob ) - 41.0 ) < 1e-9 ) ) ? 0 : -2;
+
+   /// -# A message queues behind the previous one on the link
+   status |= ( ( wan.Receive( Network::Alice, Network::Bob ) == 0 ) && ( std::abs( wan.Clock( Network::Bob ) - 42.0 ) < 1e-9 ) ) ? 0 : -3;
+   status |= ( wan.Receive( Network::Alice, Network::Bob ) < 0 ) ? 0 : -3;
+
+   /// -# The reply departs after the receiver computed, the sender waits for it, parties never go back in time
+   wan.Compute( Network::Bob, 10.0 );
+   wan.Send( Network::Bob, Network::Alice, 0 );
+   wan.Compute( Network::Alice, 100.0 );
+   status |= ( ( wan.Receive( Network::Bob, Network::Alice ) == 0 ) && ( wan.Clock( Network::Alice ) == 100.0 ) ) ? 0 : -4;
+   usage = wan.Measure( );
+   status |= ( ( usage.messages == 3 ) && ( usage.bytes == 2000 ) && ( usage.finish == 100.0 ) ) ? 0 : -4;
+
+   /// -# A pair configured apart keeps its own link in both directions, the others the default
+   wan.Configure( Network::Carol, Network::Bob, Network::Link{ 2.0, 0.0, 0.0 } );
+   wan.Send( Network::Bob, Network::Carol, 1000000 );
+   status |= ( ( wan.Receive( Network::Bob, Network::Carol ) == 0 ) && ( wan.Clock( Network::Carol ) == 1.0 ) ) ? 0 : -5;
+   status |= ( ( wan.Get( Network::Carol, Network::Bob ).rtt == 2.0 ) && ( wan.Get( Network::Alice, Network::Carol ).rtt == 80.0 ) ) ? 0 : -5;
+
+   /// -# Jittered messages arrive within the jitter of half the round trip, in order, and the same after a reset
+   wan.Configure( Network::Link{ 80.0, 0.0, 5.0 } );
+   for( int message = 0; message < 1000; message++ )
+   {
+      wan.Send( Network::Alice, Network::Carol, 0 );
+      ( void )wan.Receive( Network::Alice, Network::Carol );
+      arrival  = wan.Clock( Network::Carol );
+      inOrder  = inOrder && ( arrival >= previous );
+      inRange  = inRange && ( ( message > 0 ) || ( ( arrival >= 35.0 ) && ( arrival <= 45.0 ) ) );
+      previous = arrival;
+   }
+   wan.Reset( );
+   wan.Send( Network::Alice, Network::Carol, 0 );
+   ( void )wan.Receive( Network::Alice, Network::Carol );
+   arrival = wan.Clock( Network::Carol );
+   wan.Reset( );
+   wan.Send( Network::Alice, Network::Carol, 0 );
+   ( void )wan.Receive( Network::Alice, Network::Carol );
+   status |= ( inOrder && inRange && ( wan.Clock( Network::Carol ) == arrival ) ) ? 0 : -6;
+
+   std::cout << "Jittered Arrival: " << std::setprecision( 6 ) << arrival << " Milliseconds on " << wan.Describe( ) << std::endl;
+
+   return( status );
+}
+
+int UnitTest::TestProvider( void )
+{
+   const EVP_CIPHER*   implicit[ static_cast< int >( Provider::Cipher::Count ) ] =
+   {
+      EVP_aes_128_ecb( ), EVP_aes_128_cbc( ), EVP_aes_128_ctr( ), EVP_aes_192_ecb( ), EVP_aes_192_cbc( ), EVP_aes_192_ctr( ),
+      EVP_aes_256_ecb( ), EVP_aes_256_cbc( ), EVP_aes_256_ctr( ), EVP_chacha20_poly1305( ), EVP_chacha20( )
+   };
+   const unsigned char abc[ 3 ] = { 'a', 'b', 'c' };
+   const unsigned char sha256[ 32 ] =
+   {
+      0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+      0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD
+   };
+   const unsigned char ikm[ 22 ] =
+   {
+      0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B
+   };
+   const unsigned char salt[ 13 ] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C };
+   const std::string   info( "\xF0\xF1\xF2\xF3\xF4\xF5\xF6\xF7\xF8\xF9" );
+   const unsigned char okm[ 42 ] =
+   {
+      0x3C, 0xB2, 0x5F, 0x25, 0xFA, 0xAC, 0xD5, 0x7A, 0x90, 0x43, 0x4F, 0x64, 0xD0, 0x36, 0x2F, 0x2A, 0x2D, 0x2D, 0x0A, 0x90, 0xCF,
+      0x1A, 0x5A, 0x4C, 0x5D, 0xB0, 0x2D, 0x56, 0xEC, 0xC4, 0xC5, 0xBF, 0x34, 0x00, 0x72, 0x08, 0xD5, 0xB8, 0x87, 0x18, 0x58, 0x65
+   };
+   unsigned char       key[ 32 ] = { 0x46, 0x65, 0x74, 0x63, 0x68 };
+   unsigned char       iv[ 16 ]  = { 0x49, 0x56 };
+   unsigned char       plaintext[ 64 ] = { 0x50, 0x6C, 0x61, 0x69, 0x6E };
+   unsigned char       ciphertext[ 2 ][ 96 ];
+   unsigned char       digest[ 32 ];
+   unsigned char       derived[ 42 ];
+
+   int status = 0;
+
+   /// @par Process Design Language
+   /// -# The default provider is loaded into the library context and every algorithm is fetched once
+   status |= Provider::Loaded( ) ? 0 : -1;
+   status |= ( Provider::Get( Provider::Cipher::AES256CBC ) == Provider::Get( Provider::Cipher::AES256CBC ) ) ? 0 : -2;
+
+   /// -# Every fetched cipher encrypts like the implicitly fetched one
+   for( int cipher = 0; ( status == 0 ) && ( cipher < static_cast< int >( Provider::Cipher::Count ) ); cipher++ )
+   {
+      int lengths[ 2 ] = { -1, -1 };
+
+      for( int fetched = 0; fetched < 2; fetched++ )
+      {
+         EVP_CIPHER_CTX* context = EVP_CIPHER_CTX_new( );
+         int             length;
+         int             finalLen;
+
+         if( ( context != NULL ) &&
+             ( EVP_EncryptInit_ex( context, ( fetched == 1 ) ? Provider::Get( static_cast< Provider::Cipher >( cipher ) ) : implicit[ cipher ],
+                                   NULL, key, iv ) == 1 ) &&
+             ( EVP_EncryptUpdate( context, ciphertext[ fetched ], &length, plaintext, sizeof( plaintext ) ) == 1 ) &&
+             ( EVP_EncryptFinal_ex( context, ciphertext[ fetched ] + length, &finalLen ) == 1 ) )
+         {
+            lengths[ fetched ] = length + finalLen;
+         }
+         EVP_CIPHER_CTX_free( context );
+      }
+      status |= ( lengths[ 0 ] > 0 ) && ( lengths[ 0 ] == lengths[ 1 ] ) &&
+                ( std::memcmp( ciphertext[ 0 ], ciphertext[ 1 ], static_cast< size_t >( lengths[ 0 ] ) ) == 0 ) ? 0 : -3;
+   }
+
+   /// -# The fetched SHA-256 and HKDF reproduce the FIPS 180-2 and RFC 5869 test vectors
+   status |= ( EVP_Digest( abc, sizeof( abc ), digest, NULL, Provider::SHA256( ), NULL ) == 1 ) &&
+             ( std::memcmp( digest, sha256, sizeof( sha256 ) ) == 0 ) ? 0 : -4;
+   status |= ( Resumption::HKDF( ikm, sizeof( ikm ), salt, sizeof( salt ), info, derived, sizeof( derived ) ) == sizeof( derived ) ) &&
+             ( std::memcmp( derived, okm, sizeof( okm ) ) == 0 ) ? 0 : -5;
+
+   std::cout << static_cast< int >( Provider::Cipher::Count ) << " Ciphers, SHA-256, and HKDF fetched once from the library context"
+             << std::endl;
+
+   return( status );
+}
@@ -32,5 +32,27 @@ namespace SecureMigration
       int TestRSA3( int keySize );
       int TestECB( int size );
       int TestCBC( int size );
+      int TestChaCha( int size );
+      int TestCipher( int size );
+      int TestBatch( int size );
+      int TestCompression( int size );
+      int TestDeduplication( int size );
+      int TestIncremental( int size );
+      int TestJournal( int size );
+      int TestScheduler( int size );
+      int TestHandshake( int keySize );
+      int TestResumption( void );
+      int TestGroup( int keySize );
+      int TestPrimes( int keySize );
+      int TestMultiPrime( int keySize );
+      int TestManifest( int keySize );
+      int TestEd25519( void );
+      int TestTrace( int size );
+      int TestMetrics( int keySize );
+      int TestPerf( int size );
+      int TestMemory( void );
+      int TestProgress( int size );
+      int TestNetwork( void );
+      int TestProvider( void );
    };
 }
@@ -4,6 +4,19 @@
 // StdLib Includes
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#include <share.h>
+#else
+#include <unistd.h>
+#endif
 
 using namespace SecureMigration;
 
@@ -52,3 +65,126 @@ int Utility::ReadFile( const char* fileName, char** buffer )
    return( status );
 }
 
+
+void Utility::WriteU32( unsigned char* buffer, unsigned int value )
+{
+   buffer[ 0 ] = static_cast< unsigned char >( value >> 24 );
+   buffer[ 1 ] = static_cast< unsigned char >( value >> 16 );
+   buffer[ 2 ] = static_cast< unsigned char >( value >> 8 );
+   buffer[ 3 ] = static_cast< unsigned char >( value );
+}
+
+unsigned int Utility::ReadU32( const unsigned char* buffer )
+{
+   return( ( static_cast< unsigned int >( buffer[ 0 ] ) << 24 ) |
+           ( static_cast< unsigned int >( buffer[ 1 ] ) << 16 ) |
+           ( static_cast< unsigned int >( buffer[ 2 ] ) << 8 ) |
+           ( static_cast< unsigned int >( buffer[ 3 ] ) ) );
+}
+
+void Utility::ParallelFor( int count, const std::function< void( int ) >& work, unsigned int threads )
+{
+   std::atomic< int >         next( 0 );
+   std::vector< std::thread > workers;
+   auto                       worker = [ & ]( void )
+   {
+      for( int index = next++; index < count; index = next++ )
+      {
+         work( index );
+      }
+   };
+
+   /// @par Process Design Language
+   /// -# Default to one worker per hardware thread, never more workers than items
+   if( threads == 0 )
+   {
+      threads = std::max( 1u, std::thread::hardware_concurrency( ) );
+   }
+   threads = std::min( threads, static_cast< unsigned int >( std::max( count, 1 ) ) );
+
+   /// -# Start the additional workers, the calling thread is the last worker
+   for( unsigned int i = 1; i < threads; i++ )
+   {
+      workers.emplace_back( worker );
+   }
+   worker( );
+
+   /// -# Wait for all items to complete
+   for( std::thread& thread : workers )
+   {
+      thread.join( );
+   }
+}
+
+/**
+ * Flushes a file and forces its contents to stable storage.
+ *
+ * @return 0 on success, otherwise a negative value.
+ */
+int Utility::Sync( std::FILE* file )
+{
+   int status = 0;
+
+   if( std::fflush( file ) != 0 )
+   {
+      status = -1;
+   }
+   #ifdef _WIN32
+   else if( _commit( _fileno( file ) ) != 0 )
+   #else
+   else if( fsync( fileno( file ) ) != 0 )
+   #endif
+   {
+      status = -2;
+   }
+
+   return( status );
+}
+
+/**
+ * Creates or truncates a file for binary writing, readable and writable by its owner only, also when it
+ * already existed with wider permissions. Used for every file holding key material.
+ *
+ * @return The open file, or NULL on error.
+ */
+std::FILE* Utility::CreatePrivate( const char* fileName )
+{
+   int        fd;
+   std::FILE* file = NULL;
+
+   /// @par Process Design Language
+   /// -# Open the file with owner only permissions
+   #ifdef _WIN32
+   if( _sopen_s( &fd, fileName, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _SH_DENYRW, _S_IREAD | _S_IWRITE ) != 0 )
+   {
+      fd = -1;
+   }
+   #else
+   fd = open( fileName, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR );
+   if( ( fd >= 0 ) && ( fchmod( fd, S_IRUSR | S_IWUSR ) != 0 ) )
+   {
+      close( fd );
+      fd = -1;
+   }
+   #endif
+
+   /// -# Wrap the descriptor in a stream
+   if( fd >= 0 )
+   {
+      #ifdef _WIN32
+      file = _fdopen( fd, "wb" );
+      #else
+      file = fdopen( fd, "wb" );
+      #endif
+      if( file == NULL )
+      {
+         #ifdef _WIN32
+         _close( fd );
+         #else
+         close( fd );
+         #endif
+      }
+   }
+
+   return( file );
+}
@@ -1,11 +1,20 @@
 #pragma once
 
+// StdLib Includes
+#include <cstdio>
+#include <functional>
+
 namespace SecureMigration
 {
    namespace Utility
    {
       void PrintHEX( const unsigned char* buffer, int bytes, int bytesPerLine );
       int  ReadFile( const char* fileName, char** buffer );
+      void         WriteU32( unsigned char* buffer, unsigned int value );
+      unsigned int ReadU32( const unsigned char* buffer );
+      void ParallelFor( int count, const std::function< void( int ) >& work, unsigned int threads = 0 );
+      int  Sync( std::FILE* file );
+      std::FILE* CreatePrivate( const char* fileName );
    }
 }
 
@@ -3,44 +3,196 @@
 #include <Utility.h>
 #include <UnitTest.h>
 #include <Simulation.h>
+#include <Deduplication.h>
+#include <Resumption.h>
+#include <RSACryptosystem.h>
+#include <AES.h>
+#include <Trace.h>
+#include <Metrics.h>
+#include <Memory.h>
+#include <Network.h>
 
 // StdLib Includes
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
 #include <string>
 
 using namespace SecureMigration;
 
+static void parseOptions( int argc, char** argv, Simulation::Options& options, Deduplication::ChunkIndex& index,
+                          Resumption::Cache& cache, RSACryptosystem::Cipher& signer, Network::Emulator& wan );
+static bool parseLink( const std::string& arg, Network::Emulator& wan );
+
 int main( int argc, char** argv )
 {
    const unsigned int defKeySize = 1024;
 
-   int       status = 0;
-   int       dataLen = 0;
-   int       keyLen = 1024;
-   UnitTest* ut = NULL;
-   char*     buffer = NULL;
+   int                       status = 0;
+   int                       dataLen = 0;
+   int                       keyLen = 1024;
+   UnitTest*                 ut = NULL;
+   char*                     buffer = NULL;
+   Simulation::Options       options;
+   Deduplication::ChunkIndex carolIndex;   ///< Chunks held by Carol across migrations
+   Resumption::Cache         sessions;     ///< Master secrets shared by Alice, Bob, and Carol across migrations
+   RSACryptosystem::Cipher   bobSigner;    ///< Bob's manifest signing key
+   AES::Capabilities         host;         ///< Bulk cipher capabilities of this host
+   Metrics::Exporter         exporter;     ///< Writer of the metrics file
+   Console                   console;      ///< Renderer of the migration progress
+   Network::Emulator         wan;          ///< Emulated links between Alice, Bob, and Carol
+   bool                      accounted;    ///< OpenSSL allocates through the memory accounting
+
+   /// @par Process Design Language
+   /// -# Route OpenSSL's allocations through the memory accounting before OpenSSL allocates anything
+   accounted = ( Memory::Install( ) == 0 );
 
    if( argc == 1 )
    {
       ut = new UnitTest( defKeySize );
       status = ut->Run( );
+      delete ut;
    }
-   else if( argc == 4 )
+   else if( argc >= 4 )
    {
+      bool dh  = ( argv[ 1 ][ 0 ] == 'D' ) && ( argv[ 1 ][ 1 ] == 'H' );
+      bool rsa = ( argv[ 1 ][ 0 ] == 'R' ) && ( argv[ 1 ][ 1 ] == 'S' ) && ( argv[ 1 ][ 2 ] == 'A' );
+
       keyLen = std::stoi( argv[ 2 ] );
-      dataLen = Utility::ReadFile( argv[ 3 ], &buffer );
+      parseOptions( argc, argv, options, carolIndex, sessions, bobSigner, wan );
+
+      /// -# Probe the bulk ciphers and keep AES-256 unless the host lacks AES-NI or another cipher is forced
+      AES::Suite probed = AES::Probe( host );
+      AES::Select( ( options.cipher == "aes" ) ? AES::Suite::AES256 :
+                   ( options.cipher == "chacha20" ) ? AES::Suite::ChaCha20Poly1305 : probed );
+      AES::Use( ( options.backend == "native" ) ? AES::Backend::Native : AES::Backend::EVP );
+      options.capabilities = &host;
+
+      /// -# Count the allocations of every migration phase when requested
+      Memory::Enable( options.memory );
+      if( options.memory && !accounted )
+      {
+         std::cout << "OpenSSL allocations are not accounted" << std::endl;
+      }
+
+      /// -# Render the progress of every migration phase live when requested
+      if( options.progress > 0 )
+      {
+         Progress::Attach( &console, options.progress );
+      }
+
+      /// -# Record the protocol phases when a trace is requested
+      Trace::Enable( !options.trace.empty( ) );
+
+      /// -# Export the metrics periodically when a metrics file is requested
+      if( !options.metrics.empty( ) && ( exporter.Start( options.metrics, options.metricsInterval ) != 0 ) )
+      {
+         std::cout << "Failed to write the metrics " << options.metrics << std::endl;
+         status = -1;
+      }
+
+      /// -# Bob generates his signing key once, Carol knows his public key
+      if( ( options.signer != nullptr ) && ( bobSigner.Initialize( keyLen, options.keygen ) != 0 ) )
+      {
+         options.signer = nullptr;
+         status         = -1;
+      }
 
-      if( ( argv[ 1 ][ 0 ] == 'D' ) && ( argv[ 1 ][ 1 ] == 'H' ) )
+      if( options.primes > 0 )
+      {
+         if( !rsa )
+         {
+            status = Simulation::RunPrimes( keyLen, false, options );
+         }
+         if( !dh )
+         {
+            status |= Simulation::RunPrimes( keyLen, true, options );
+         }
+      }
+      else if( options.signedHandshakes > 0 )
+      {
+         status = Simulation::RunSigned( keyLen, options );
+      }
+      else if( options.unwraps > 0 )
       {
-         status = Simulation::RunDiffieHellman( reinterpret_cast< const unsigned char* >( buffer ), dataLen, keyLen );
+         status = Simulation::RunUnwrap( keyLen, options );
       }
-      else if( ( argv[ 1 ][ 0 ] == 'R' ) && ( argv[ 1 ][ 1 ] == 'S' ) && ( argv[ 1 ][ 2 ] == 'A' ) )
+      else if( options.derives > 0 )
       {
-         status = Simulation::RunRSA( reinterpret_cast< const unsigned char* >( buffer ), dataLen, keyLen );
+         status = Simulation::RunDerives( keyLen, options );
+      }
+      else if( options.fetches > 0 )
+      {
+         status = Simulation::RunFetch( options );
+      }
+      else if( options.multibuffer > 0 )
+      {
+         status = Simulation::RunMultiBuffer( options );
+      }
+      else if( options.backends > 0 )
+      {
+         status = Simulation::RunBackends( options );
+      }
+      else if( options.sessions > 0 )
+      {
+         if( !rsa )
+         {
+            status = Simulation::RunHandshakes( keyLen, false, options );
+         }
+         if( !dh )
+         {
+            status |= Simulation::RunHandshakes( keyLen, true, options );
+         }
+      }
+      else if( options.objects || std::filesystem::is_directory( argv[ 3 ] ) )
+      {
+         if( !rsa )
+         {
+            status = Simulation::RunObjects( argv[ 3 ], keyLen, false, options );
+         }
+         if( !dh )
+         {
+            status |= Simulation::RunObjects( argv[ 3 ], keyLen, true, options );
+         }
+      }
+      else if( ( dataLen = Utility::ReadFile( argv[ 3 ], &buffer ) ) < 0 )
+      {
+         status = -1;
       }
       else
       {
-         status = Simulation::RunDiffieHellman( reinterpret_cast< const unsigned char* >( buffer ), dataLen, keyLen );
-         status |= Simulation::RunRSA( reinterpret_cast< const unsigned char* >( buffer ), dataLen, keyLen );
+         for( int migration = 0; migration < options.migrations; migration++ )
+         {
+            if( !rsa )
+            {
+               status |= Simulation::RunDiffieHellman( reinterpret_cast< const unsigned char* >( buffer ), dataLen, keyLen, options );
+            }
+            if( !dh && !rsa )
+            {
+               carolIndex.Clear( );
+            }
+            if( !dh )
+            {
+               status |= Simulation::RunRSA( reinterpret_cast< const unsigned char* >( buffer ), dataLen, keyLen, options );
+            }
+         }
+      }
+
+      /// -# Write the final metrics and the trace of the runs
+      Progress::Attach( nullptr );
+      if( exporter.Stop( ) != 0 )
+      {
+         std::cout << "Failed to write the metrics " << options.metrics << std::endl;
+         status = -1;
+      }
+      if( !options.trace.empty( ) )
+      {
+         Trace::Enable( false );
+         if( Trace::Write( options.trace ) != 0 )
+         {
+            std::cout << "Failed to write the trace " << options.trace << std::endl;
+            status = -1;
+         }
       }
 
       delete[ ] buffer;
@@ -49,3 +201,440 @@ int main( int argc, char** argv )
    return( status );
 }
 
+Console::Console( void )
+{
+}
+
+void Console::Began( const Progress::Report& report )
+{
+   std::printf( "\r> %-12s started", Progress::Name( report.phase ) );
+   std::fflush( stdout );
+}
+
+/**
+ * Rewrites the line of the phase with the bytes processed, the rate since the previous report and, when
+ * the size of the phase is known, its share and the time left at that rate.
+ */
+void Console::Advanced( const Progress::Report& report )
+{
+   if( report.total > 0 )
+   {
+      std::printf( "\r> %-12s %10.2f of %.2f MB (%5.1f%%) %9.1f MB/s, %.1f s left   ", Progress::Name( report.phase ),
+                   report.bytes / 1e6, report.total / 1e6, 100.0 * report.bytes / report.total, report.rate,
+                   ( report.rate > 0.0 ) ? ( report.total - report.bytes ) / ( report.rate * 1e6 ) : 0.0 );
+   }
+   else
+   {
+      std::printf( "\r> %-12s %10.2f MB %9.1f MB/s   ", Progress::Name( report.phase ), report.bytes / 1e6, report.rate );
+   }
+   std::fflush( stdout );
+}
+
+/**
+ * Completes the line of the phase with its duration and average rate.
+ */
+void Console::Ended( const Progress::Report& report )
+{
+   if( report.bytes > 0 )
+   {
+      std::printf( "\r> %-12s %10.2f MB in %.3f ms (%.1f MB/s)%30s\n", Progress::Name( report.phase ), report.bytes / 1e6,
+                   report.elapsed, report.rate, "" );
+   }
+   else
+   {
+      std::printf( "\r> %-12s done in %.3f ms%50s\n", Progress::Name( report.phase ), report.elapsed, "" );
+   }
+   std::fflush( stdout );
+}
+
+/**
+ * Parses the optional simulation arguments following <Protocol> <KeyLength> <PathToFile>. The handshake
+ * benchmark takes no <PathToFile>, its options may directly follow <KeyLength>.
+ *
+ * @par Options
+ * - --compress[=<Level>]  Compress the plaintext before encryption (zlib level 1-9)
+ * - --chunk=<Bytes>       Uncompressed bytes per compression chunk
+ * - --dedup[=<Bytes>]     Deduplicate content-defined chunks of the given average size against Carol's index
+ * - --incremental[=<Path>] Migrate only the blocks changed since the previous migration, keeping the manifest
+ *                          and Carol's replica at the given path prefix (defaults to <PathToFile>)
+ * - --block=<Bytes>       Bytes per incremental migration block or resumable migration chunk
+ * - --resume[=<Path>]     Migrate in chunks recorded in a checkpoint journal at the given path prefix (defaults
+ *                         to <PathToFile>), resuming an interrupted migration without a new key exchange
+ * - --batch=<Chunks>      Chunk commits per checkpoint journal sync
+ * - --interrupt=<Chunks>  Interrupt a resumable migration after the given number of chunks
+ * - --objects             Migrate every object named in the list file <PathToFile>, one path per line, as when
+ *                         <PathToFile> is a directory
+ * - --split=<Bytes>       Bytes per chunk task of a multi-object migration
+ * - --threads=<Count>     Workers of a multi-object migration or of the handshake engine
+ * - --handshakes[=<Sessions>] Benchmark concurrent handshakes on the coroutine engine, quadrupling the number of
+ *                         simultaneous sessions from 1 up to the given maximum (default 1024)
+ * - --subgroup            Use Diffie-Hellman parameters (p,q,g) with a 256-bit prime order subgroup
+ * - --keygen[=<Threads>]   Search the primes of key generation racing on the given number of threads (default one
+ *                         per hardware thread) instead of OpenSSL's single-threaded search
+ * - --primes[=<Runs>]     Benchmark the key generation time distribution of OpenSSL's search against the race
+ *                         on --threads workers, the given number of generations each (default 16)
+ * - --multiprime[=<Primes>] Generate RSA keys of the given number of primes (default the most the key length
+ *                         allows: 3 below 4096 bits, 4 below 8192 bits)
+ * - --unwrap[=<Ops>]      Benchmark RSA decryption and signing with a two-prime key against a multi-prime key,
+ *                         the given number of operations each (default 256)
+ * - --derives[=<Count>]   Benchmark the batch Diffie-Hellman derive of the given number of sessions (default 256),
+ *                         paired on OpenSSL's multi-buffer kernel for 1024-bit keys only
+ * - --fetch[=<Messages>]  Benchmark small AES-256-CBC messages encrypted with the implicitly fetched cipher against
+ *                         the cipher fetched once, the given number of messages per thread (default 65536)
+ * - --multibuffer[=<Objects>] Benchmark the given number of 1-16 KiB objects (default 4096) encrypted and decrypted
+ *                         with one call per object against one batch call for all of them, in objects/s and cycles/byte
+ * - --backends[=<Bytes>]  Benchmark AES-256 ECB, CBC, and CTR on EVP against the native AES-NI and VAES kernels, on
+ *                         messages of 256 Bytes up to the given size (default 1048576), in MB/s and cycles/byte
+ * - --auth=<Scheme>       Sign the Diffie-Hellman public values with long-term keys, ed25519 or rsa<Bits>
+ * - --signed[=<Handshakes>] Benchmark two-party handshakes unsigned, Ed25519-signed, and RSA-2048/3072-signed,
+ *                         the given number of handshakes each (default 256)
+ * - --cipher=<Cipher>     Bulk cipher aes, chacha20, or auto (default) for AES-256 on hosts with AES-NI and the
+ *                         faster one probed at startup otherwise
+ * - --backend=<Backend>   Implementation of AES-256 evp (default) or native for the AES-NI/VAES kernels, EVP when
+ *                         the CPU has no AES instructions
+ * - --sign                Authenticate every migration with an RSA-PSS signed manifest of Bob's ciphertext
+ *                         messages (--block bytes each), verified by Carol in one batch
+ * - --resumption[=<Migrations>] Migrate the file the given number of times back to back (default 8), keying every
+ *                         migration after the first from the master secret cached by the first key exchange
+ * - --trace <Path>        Record the protocol phases of every party and the cipher calls they make, and write
+ *                         them as a Chrome trace (chrome://tracing or ui.perfetto.dev) to the given path
+ * - --perf                Count cycles, instructions, cache misses, and branch misses (Linux perf_event_open)
+ *                         of the key exchange and the ciphers, reported per exponentiation and per byte
+ * - --progress[=<Milliseconds>] Render the bytes, rate, and time left of every migration phase live on the
+ *                         console, updated at the given interval (default 250)
+ * - --memory              Count the allocations, allocated bytes, live bytes, and peak live bytes of parameter
+ *                         generation, key exchange, and transfer (global operator new/delete and OpenSSL), with
+ *                         the peak resident set size of each phase (Linux /proc)
+ * - --wan[=<RTT>,<Mbit/s>[,<Jitter>]] Emulate the links between Alice, Bob, and Carol on a virtual clock with the
+ *                         given round trip time and jitter in milliseconds and bandwidth (default 80 ms, 1000 Mbit/s),
+ *                         reporting the messages, bytes, and emulated time of the key setup and the transfer
+ * - --link=<Party>-<Party>:<RTT>,<Mbit/s>[,<Jitter>] Emulate the link between two parties differently, overriding
+ *                         --wan given before it
+ * - --metrics=<Path>      Write the counters, gauges, and latency histograms of the run as a Prometheus text file
+ *                         to the given path at exit
+ * - --metrics-interval=<Seconds> Also write the metrics file every given number of seconds during the run
+ */
+static void parseOptions( int argc, char** argv, Simulation::Options& options, Deduplication::ChunkIndex& index,
+                          Resumption::Cache& cache, RSACryptosystem::Cipher& signer, Network::Emulator& wan )
+{
+   for( int i = 3; i < argc; i++ )
+   {
+      std::string arg( argv[ i ] );
+
+      if( arg == "--compress" )
+      {
+         options.compress = true;
+      }
+      else if( arg.rfind( "--compress=", 0 ) == 0 )
+      {
+         options.compress = true;
+         options.level    = std::stoi( arg.substr( 11 ) );
+      }
+      else if( arg.rfind( "--chunk=", 0 ) == 0 )
+      {
+         int chunkSize = std::stoi( arg.substr( 8 ) );
+
+         if( chunkSize > 0 )
+         {
+            options.chunkSize = chunkSize;
+         }
+         else
+         {
+            std::cout << "Ignoring invalid chunk size " << arg << std::endl;
+         }
+      }
+      else if( arg == "--dedup" )
+      {
+         options.index = &index;
+      }
+      else if( arg.rfind( "--dedup=", 0 ) == 0 )
+      {
+         int average = std::stoi( arg.substr( 8 ) );
+
+         options.index = &index;
+         if( average >= Deduplication::AverageMin )
+         {
+            options.average = average;
+         }
+         else
+         {
+            std::cout << "Ignoring invalid average chunk size " << arg << std::endl;
+         }
+      }
+      else if( arg == "--incremental" )
+      {
+         options.state = argv[ 3 ];
+      }
+      else if( arg.rfind( "--incremental=", 0 ) == 0 )
+      {
+         options.state = arg.substr( 14 );
+      }
+      else if( arg.rfind( "--block=", 0 ) == 0 )
+      {
+         int blockSize = std::stoi( arg.substr( 8 ) );
+
+         if( blockSize > 0 )
+         {
+            options.blockSize = blockSize;
+         }
+         else
+         {
+            std::cout << "Ignoring invalid block size " << arg << std::endl;
+         }
+      }
+      else if( arg == "--resume" )
+      {
+         options.journal = argv[ 3 ];
+      }
+      else if( arg.rfind( "--resume=", 0 ) == 0 )
+      {
+         options.journal = arg.substr( 9 );
+      }
+      else if( arg.rfind( "--batch=", 0 ) == 0 )
+      {
+         int batch = std::stoi( arg.substr( 8 ) );
+
+         if( batch > 0 )
+         {
+            options.batch = batch;
+         }
+         else
+         {
+            std::cout << "Ignoring invalid batch " << arg << std::endl;
+         }
+      }
+      else if( arg.rfind( "--interrupt=", 0 ) == 0 )
+      {
+         options.interrupt = std::stoi( arg.substr( 12 ) );
+      }
+      else if( arg == "--objects" )
+      {
+         options.objects = true;
+      }
+      else if( arg.rfind( "--split=", 0 ) == 0 )
+      {
+         int split = std::stoi( arg.substr( 8 ) );
+
+         if( split > 0 )
+         {
+            options.split = split;
+         }
+         else
+         {
+            std::cout << "Ignoring invalid split size " << arg << std::endl;
+         }
+      }
+      else if( arg == "--handshakes" )
+      {
+         options.sessions = 1024;
+      }
+      else if( arg.rfind( "--handshakes=", 0 ) == 0 )
+      {
+         options.sessions = std::stoi( arg.substr( 13 ) );
+      }
+      else if( arg == "--subgroup" )
+      {
+         options.subgroup = true;
+      }
+      else if( arg == "--keygen" )
+      {
+         options.keygen = 0;
+      }
+      else if( arg.rfind( "--keygen=", 0 ) == 0 )
+      {
+         options.keygen = static_cast< unsigned int >( std::stoi( arg.substr( 9 ) ) );
+      }
+      else if( arg == "--primes" )
+      {
+         options.primes = 16;
+      }
+      else if( arg.rfind( "--primes=", 0 ) == 0 )
+      {
+         options.primes = std::stoi( arg.substr( 9 ) );
+      }
+      else if( arg == "--multiprime" )
+      {
+         options.rsaPrimes = 0;
+      }
+      else if( arg.rfind( "--multiprime=", 0 ) == 0 )
+      {
+         options.rsaPrimes = static_cast< unsigned int >( std::stoi( arg.substr( 13 ) ) );
+      }
+      else if( arg == "--unwrap" )
+      {
+         options.unwraps = 256;
+      }
+      else if( arg.rfind( "--unwrap=", 0 ) == 0 )
+      {
+         options.unwraps = std::stoi( arg.substr( 9 ) );
+      }
+      else if( arg == "--derives" )
+      {
+         options.derives = 256;
+      }
+      else if( arg.rfind( "--derives=", 0 ) == 0 )
+      {
+         options.derives = std::stoi( arg.substr( 10 ) );
+      }
+      else if( arg == "--fetch" )
+      {
+         options.fetches = 65536;
+      }
+      else if( arg.rfind( "--fetch=", 0 ) == 0 )
+      {
+         options.fetches = std::stoi( arg.substr( 8 ) );
+      }
+      else if( arg == "--multibuffer" )
+      {
+         options.multibuffer = 4096;
+      }
+      else if( arg.rfind( "--multibuffer=", 0 ) == 0 )
+      {
+         options.multibuffer = std::stoi( arg.substr( 14 ) );
+      }
+      else if( arg == "--backends" )
+      {
+         options.backends = 1024 * 1024;
+      }
+      else if( arg.rfind( "--backends=", 0 ) == 0 )
+      {
+         options.backends = std::stoi( arg.substr( 11 ) );
+      }
+      else if( arg == "--resumption" )
+      {
+         options.cache      = &cache;
+         options.migrations = 8;
+      }
+      else if( arg.rfind( "--resumption=", 0 ) == 0 )
+      {
+         options.cache      = &cache;
+         options.migrations = std::stoi( arg.substr( 13 ) );
+      }
+      else if( arg.rfind( "--auth=", 0 ) == 0 )
+      {
+         options.auth = arg.substr( 7 );
+      }
+      else if( arg == "--signed" )
+      {
+         options.signedHandshakes = 256;
+      }
+      else if( arg.rfind( "--signed=", 0 ) == 0 )
+      {
+         options.signedHandshakes = std::stoi( arg.substr( 9 ) );
+      }
+      else if( arg.rfind( "--cipher=", 0 ) == 0 )
+      {
+         options.cipher = arg.substr( 9 );
+      }
+      else if( arg.rfind( "--backend=", 0 ) == 0 )
+      {
+         options.backend = arg.substr( 10 );
+      }
+      else if( arg == "--sign" )
+      {
+         options.signer = &signer;
+      }
+      else if( ( arg == "--trace" ) && ( i + 1 < argc ) )
+      {
+         options.trace = argv[ ++i ];
+      }
+      else if( arg.rfind( "--trace=", 0 ) == 0 )
+      {
+         options.trace = arg.substr( 8 );
+      }
+      else if( arg == "--perf" )
+      {
+         options.perf = true;
+      }
+      else if( arg == "--progress" )
+      {
+         options.progress = Progress::IntervalDef;
+      }
+      else if( arg.rfind( "--progress=", 0 ) == 0 )
+      {
+         options.progress = std::stoi( arg.substr( 11 ) );
+      }
+      else if( arg == "--memory" )
+      {
+         options.memory = true;
+      }
+      else if( arg == "--wan" )
+      {
+         options.network = &wan;
+      }
+      else if( arg.rfind( "--wan=", 0 ) == 0 )
+      {
+         Network::Link link;
+
+         if( Network::Parse( arg.substr( 6 ), link ) == 0 )
+         {
+            wan.Configure( link );
+            options.network = &wan;
+         }
+         else
+         {
+            std::cout << "Ignoring invalid link " << arg << std::endl;
+         }
+      }
+      else if( arg.rfind( "--link=", 0 ) == 0 )
+      {
+         if( parseLink( arg.substr( 7 ), wan ) )
+         {
+            options.network = &wan;
+         }
+         else
+         {
+            std::cout << "Ignoring invalid link " << arg << std::endl;
+         }
+      }
+      else if( arg.rfind( "--metrics=", 0 ) == 0 )
+      {
+         options.metrics = arg.substr( 10 );
+      }
+      else if( arg.rfind( "--metrics-interval=", 0 ) == 0 )
+      {
+         options.metricsInterval = std::stoi( arg.substr( 19 ) );
+      }
+      else if( arg.rfind( "--threads=", 0 ) == 0 )
+      {
+         int threads = std::stoi( arg.substr( 10 ) );
+
+         if( threads > 0 )
+         {
+            options.threads = static_cast< unsigned int >( threads );
+         }
+         else
+         {
+            std::cout << "Ignoring invalid thread count " << arg << std::endl;
+         }
+      }
+   }
+}
+
+/**
+ * Parses the link between two parties given as <Party>-<Party>:<RTT>,<Mbit/s>[,<Jitter>] and sets it.
+ *
+ * @return True when the link was set.
+ */
+static bool parseLink( const std::string& arg, Network::Emulator& wan )
+{
+   size_t        dash  = arg.find( '-' );
+   size_t        colon = arg.find( ':' );
+   int           first;
+   int           second;
+   Network::Link link;
+
+   if( ( dash == std::string::npos ) || ( colon == std::string::npos ) || ( colon < dash ) )
+   {
+      return( false );
+   }
+   first  = Network::ParseParty( arg.substr( 0, dash ) );
+   second = Network::ParseParty( arg.substr( dash + 1, colon - dash - 1 ) );
+   if( ( first < 0 ) || ( second < 0 ) || ( first == second ) || ( Network::Parse( arg.substr( colon + 1 ), link ) != 0 ) )
+   {
+      return( false );
+   }
+   wan.Configure( static_cast< Network::Party >( first ), static_cast< Network::Party >( second ), link );
+
+   return( true );
+}
@@ -1 +1,29 @@
 #pragma once
+
+// Application Includes
+#include <Progress.h>
+
+namespace SecureMigration
+{
+   /**
+    * Live console rendering of the migration progress: one line per phase, rewritten in place with the
+    * bytes processed, the current rate, and the time left while the phase runs, and completed with the
+    * average rate when it ends.
+    *
+    * @details
+    * Lines are formatted into a fixed buffer, so rendering neither allocates nor locks.
+    */
+   class Console : public Progress::Observer
+   {
+   public:     // Public Methods
+      Console( void );
+
+      void Began( const Progress::Report& report ) override;
+      void Advanced( const Progress::Report& report ) override;
+      void Ended( const Progress::Report& report ) override;
+
+   private:    // Private Methods
+      Console( const Console& );              // Disabled
+      Console& operator=( const Console& );   // Disabled
+   };
+}